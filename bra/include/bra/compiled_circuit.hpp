@@ -0,0 +1,76 @@
+#ifndef BRA_COMPILED_CIRCUIT_HPP
+# define BRA_COMPILED_CIRCUIT_HPP
+
+# include <cstddef>
+# include <cstdint>
+# include <iosfwd>
+# include <vector>
+# include <string>
+# include <utility>
+# include <stdexcept>
+
+/*
+ * Format of compiled circuit files (.qcxb), whose integers are in the native byte order
+ *   header:       "QCXB" [version: uint32] [byte order mark 1: uint32] [number of strings: uint32] [number of instructions: uint64]
+ *   strings:      ([length: uint32] [characters]) * (number of strings)
+ *   instructions: ([number of columns: uint32] [index of string: uint32] * (number of columns)) * (number of instructions)
+ * Each instruction is a line of the qcx file without comments, which is split into columns, and whose first column is upper-cased.
+ */
+
+
+namespace bra
+{
+  class compiled_circuit_error
+    : public std::runtime_error
+  {
+   public:
+    explicit compiled_circuit_error(std::string const& message);
+  }; // class compiled_circuit_error
+
+  constexpr std::uint32_t compiled_circuit_version = 1u;
+
+  // Writes the circuit read from input_stream into output_stream in the compiled format
+  void compile_circuit(std::istream& input_stream, std::ostream& output_stream);
+
+  bool is_compiled_circuit(char const* first, char const* last);
+
+  // Reads instructions of a compiled circuit in [first, last), which should outlive this reader
+  class compiled_circuit_reader
+  {
+    std::vector<std::pair<char const*, std::uint32_t>> strings_;
+    char const* iter_;
+    char const* last_;
+    std::uint64_t num_instructions_;
+    std::uint64_t instruction_index_;
+
+   public:
+    compiled_circuit_reader(char const* first, char const* last);
+
+    std::uint64_t num_instructions() const noexcept { return num_instructions_; }
+
+    // Assigns the next instruction to columns and returns true, or returns false if no instruction remains
+    bool read_columns(std::vector<std::string>& columns);
+  }; // class compiled_circuit_reader
+
+  // Read-only contents of a file mapped into memory by mmap
+  class mapped_file
+  {
+    char const* data_;
+    std::size_t size_;
+
+   public:
+    explicit mapped_file(std::string const& path);
+    ~mapped_file() noexcept;
+
+    mapped_file(mapped_file const&) = delete;
+    mapped_file& operator=(mapped_file const&) = delete;
+    mapped_file(mapped_file&&) = delete;
+    mapped_file& operator=(mapped_file&&) = delete;
+
+    char const* data() const noexcept { return data_; }
+    std::size_t size() const noexcept { return size_; }
+  }; // class mapped_file
+} // namespace bra
+
+
+#endif // BRA_COMPILED_CIRCUIT_HPP
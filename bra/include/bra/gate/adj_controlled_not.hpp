@@ -2,6 +2,7 @@
 # define BRA_GATE_ADJ_CONTROLLED_NOT_HPP
 
 # include <string>
+# include <vector>
 # include <iosfwd>
 
 # include <bra/gate/gate.hpp>
@@ -41,6 +42,8 @@ namespace bra
       std::string const& do_name() const override;
       std::string do_representation(
         std::ostringstream& repr_stream, int const parameter_width) const override;
+      std::vector<qubit_type> do_operated_qubits() const override;
+      std::vector<complex_type> do_unitary_matrix() const override;
     }; // class adj_controlled_not
   } // namespace gate
 } // namespace bra
@@ -2,6 +2,7 @@
 # define BRA_GATE_ADJ_EXPONENTIAL_PAULI_XX_HPP
 
 # include <string>
+# include <vector>
 # include <iosfwd>
 
 # include <bra/gate/gate.hpp>
@@ -40,6 +41,8 @@ namespace bra
       std::string const& do_name() const override;
       std::string do_representation(
         std::ostringstream& repr_stream, int const parameter_width) const override;
+      std::vector<qubit_type> do_operated_qubits() const override;
+      std::vector<complex_type> do_unitary_matrix() const override;
     }; // class adj_exponential_pauli_xx
   } // namespace gate
 } // namespace bra
@@ -0,0 +1,58 @@
+#ifndef BRA_GATE_BLOCKED_HPP
+# define BRA_GATE_BLOCKED_HPP
+
+# include <cstddef>
+# include <vector>
+# include <string>
+# include <iosfwd>
+
+# include <bra/gate/gate.hpp>
+# include <bra/state.hpp>
+
+
+namespace bra
+{
+  namespace gate
+  {
+    // consecutive unitary gates operating only on qubits lower than num_block_qubits, which are applied block by block by ::bra::gates::block.
+    // This gate is not regarded as a unitary gate by ::bra::gates::fuse because its matrix would be too large
+    class blocked final
+      : public ::bra::gate::gate
+    {
+     public:
+      using qubit_type = ::bra::state::qubit_type;
+      using complex_type = ::bra::state::complex_type;
+      using bit_integer_type = ::bra::state::bit_integer_type;
+
+     private:
+      std::vector<std::vector<complex_type>> matrices_;
+      std::vector<std::vector<qubit_type>> qubits_;
+      bit_integer_type num_block_qubits_;
+
+      static std::string const name_;
+
+     public:
+      blocked(
+        std::vector<std::vector<complex_type>>&& matrices, std::vector<std::vector<qubit_type>>&& qubits,
+        bit_integer_type const num_block_qubits);
+
+      ~blocked() = default;
+      blocked(blocked const&) = delete;
+      blocked& operator=(blocked const&) = delete;
+      blocked(blocked&&) = delete;
+      blocked& operator=(blocked&&) = delete;
+
+      std::size_t num_blocked_gates() const { return matrices_.size(); }
+
+     private:
+      ::bra::state& do_apply(::bra::state& state) const override;
+      std::string const& do_name() const override;
+      std::string do_representation(
+        std::ostringstream& repr_stream, int const parameter_width) const override;
+      std::vector<qubit_type> do_operated_qubits() const override;
+    }; // class blocked
+  } // namespace gate
+} // namespace bra
+
+
+#endif // BRA_GATE_BLOCKED_HPP
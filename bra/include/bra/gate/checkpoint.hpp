@@ -0,0 +1,40 @@
+#ifndef BRA_GATE_CHECKPOINT_HPP
+# define BRA_GATE_CHECKPOINT_HPP
+
+# include <string>
+# include <iosfwd>
+
+# include <bra/gate/gate.hpp>
+# include <bra/state.hpp>
+
+
+namespace bra
+{
+  namespace gate
+  {
+    class checkpoint final
+      : public ::bra::gate::gate
+    {
+      std::string path_;
+
+      static std::string const name_;
+
+     public:
+      explicit checkpoint(std::string const& path);
+
+      ~checkpoint() = default;
+      checkpoint(checkpoint const&) = delete;
+      checkpoint& operator=(checkpoint const&) = delete;
+      checkpoint(checkpoint&&) = delete;
+      checkpoint& operator=(checkpoint&&) = delete;
+
+     private:
+      ::bra::state& do_apply(::bra::state& state) const override;
+      std::string const& do_name() const override;
+      std::string do_representation(std::ostringstream& repr_stream, int const parameter_width) const override;
+    }; // class checkpoint
+  } // namespace gate
+} // namespace bra
+
+
+#endif // BRA_GATE_CHECKPOINT_HPP
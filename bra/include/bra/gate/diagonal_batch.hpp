@@ -0,0 +1,57 @@
+#ifndef BRA_GATE_DIAGONAL_BATCH_HPP
+# define BRA_GATE_DIAGONAL_BATCH_HPP
+
+# include <cstddef>
+# include <vector>
+# include <string>
+# include <iosfwd>
+
+# include <bra/gate/gate.hpp>
+# include <bra/state.hpp>
+
+
+namespace bra
+{
+  namespace gate
+  {
+    // consecutive diagonal gates accumulated into tables of diagonal elements by ::bra::gates::batch_diagonal.
+    // This gate is not regarded as a unitary gate by ::bra::gates::fuse because its matrix may be too large
+    class diagonal_batch final
+      : public ::bra::gate::gate
+    {
+     public:
+      using qubit_type = ::bra::state::qubit_type;
+      using complex_type = ::bra::state::complex_type;
+
+     private:
+      std::vector<std::vector<complex_type>> tables_;
+      std::vector<std::vector<qubit_type>> qubits_;
+      std::size_t num_batched_gates_;
+
+      static std::string const name_;
+
+     public:
+      diagonal_batch(
+        std::vector<std::vector<complex_type>>&& tables, std::vector<std::vector<qubit_type>>&& qubits,
+        std::size_t const num_batched_gates);
+
+      ~diagonal_batch() = default;
+      diagonal_batch(diagonal_batch const&) = delete;
+      diagonal_batch& operator=(diagonal_batch const&) = delete;
+      diagonal_batch(diagonal_batch&&) = delete;
+      diagonal_batch& operator=(diagonal_batch&&) = delete;
+
+      std::size_t num_batched_gates() const { return num_batched_gates_; }
+
+     private:
+      ::bra::state& do_apply(::bra::state& state) const override;
+      std::string const& do_name() const override;
+      std::string do_representation(
+        std::ostringstream& repr_stream, int const parameter_width) const override;
+      std::vector<qubit_type> do_operated_qubits() const override;
+    }; // class diagonal_batch
+  } // namespace gate
+} // namespace bra
+
+
+#endif // BRA_GATE_DIAGONAL_BATCH_HPP
@@ -0,0 +1,57 @@
+#ifndef BRA_GATE_FUSED_HPP
+# define BRA_GATE_FUSED_HPP
+
+# include <cstddef>
+# include <vector>
+# include <string>
+# include <iosfwd>
+
+# include <bra/gate/gate.hpp>
+# include <bra/state.hpp>
+
+
+namespace bra
+{
+  namespace gate
+  {
+    // consecutive unitary gates fused into one dense unitary matrix by ::bra::gates::fuse
+    class fused final
+      : public ::bra::gate::gate
+    {
+     public:
+      using qubit_type = ::bra::state::qubit_type;
+      using complex_type = ::bra::state::complex_type;
+
+     private:
+      std::vector<qubit_type> qubits_;
+      std::vector<complex_type> matrix_;
+      std::size_t num_fused_gates_;
+
+      static std::string const name_;
+
+     public:
+      fused(
+        std::vector<qubit_type>&& qubits, std::vector<complex_type>&& matrix,
+        std::size_t const num_fused_gates);
+
+      ~fused() = default;
+      fused(fused const&) = delete;
+      fused& operator=(fused const&) = delete;
+      fused(fused&&) = delete;
+      fused& operator=(fused&&) = delete;
+
+      std::size_t num_fused_gates() const { return num_fused_gates_; }
+
+     private:
+      ::bra::state& do_apply(::bra::state& state) const override;
+      std::string const& do_name() const override;
+      std::string do_representation(
+        std::ostringstream& repr_stream, int const parameter_width) const override;
+      std::vector<qubit_type> do_operated_qubits() const override;
+      std::vector<complex_type> do_unitary_matrix() const override;
+    }; // class fused
+  } // namespace gate
+} // namespace bra
+
+
+#endif // BRA_GATE_FUSED_HPP
@@ -2,9 +2,11 @@
 # define BRA_GATE_GATE_HPP
 
 # include <string>
+# include <vector>
 # include <iosfwd>
 
 # include <bra/state.hpp>
+# include <bra/instruction.hpp>
 
 
 namespace bra
@@ -14,6 +16,9 @@ namespace bra
     class gate
     {
      public:
+      using qubit_type = ::bra::state::qubit_type;
+      using complex_type = ::bra::state::complex_type;
+
       gate() = default;
       virtual ~gate() = default;
 
@@ -26,11 +31,21 @@ namespace bra
       std::string const& name() const { return do_name(); }
       std::string representation() const;
 
+      // qubits on which this gate acts. If unitary_matrix() is not empty, they are in the order of bits of its row/column indices
+      std::vector<qubit_type> operated_qubits() const { return do_operated_qubits(); }
+      // row-major unitary matrix of this gate, or an empty vector if this gate is not a unitary gate
+      std::vector<complex_type> unitary_matrix() const { return do_unitary_matrix(); }
+      // assigns this gate to result and returns true, or returns false if this gate cannot be an instruction
+      bool instruction(::bra::instruction& result) const { return do_instruction(result); }
+
      protected:
       virtual ::bra::state& do_apply(::bra::state& state) const = 0;
       virtual std::string const& do_name() const = 0;
       virtual std::string do_representation(
         std::ostringstream& repr_stream, int const parameter_width) const = 0;
+      virtual std::vector<qubit_type> do_operated_qubits() const;
+      virtual std::vector<complex_type> do_unitary_matrix() const;
+      virtual bool do_instruction(::bra::instruction& result) const;
     }; // class gate
 
     inline ::bra::state& operator<<(::bra::state& state, ::bra::gate::gate const& gate)
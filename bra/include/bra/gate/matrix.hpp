@@ -0,0 +1,51 @@
+#ifndef BRA_GATE_MATRIX_HPP
+# define BRA_GATE_MATRIX_HPP
+
+# include <vector>
+# include <string>
+# include <iosfwd>
+
+# include <bra/gate/gate.hpp>
+# include <bra/state.hpp>
+
+
+namespace bra
+{
+  namespace gate
+  {
+    // arbitrary unitary gate given by a dense matrix (see ::ket::gate::matrix for its layout)
+    class matrix final
+      : public ::bra::gate::gate
+    {
+     public:
+      using qubit_type = ::bra::state::qubit_type;
+      using complex_type = ::bra::state::complex_type;
+
+     private:
+      std::vector<qubit_type> qubits_;
+      std::vector<complex_type> matrix_;
+
+      static std::string const name_;
+
+     public:
+      matrix(std::vector<qubit_type>&& qubits, std::vector<complex_type>&& matrix);
+
+      ~matrix() = default;
+      matrix(matrix const&) = delete;
+      matrix& operator=(matrix const&) = delete;
+      matrix(matrix&&) = delete;
+      matrix& operator=(matrix&&) = delete;
+
+     private:
+      ::bra::state& do_apply(::bra::state& state) const override;
+      std::string const& do_name() const override;
+      std::string do_representation(
+        std::ostringstream& repr_stream, int const parameter_width) const override;
+      std::vector<qubit_type> do_operated_qubits() const override;
+      std::vector<complex_type> do_unitary_matrix() const override;
+    }; // class matrix
+  } // namespace gate
+} // namespace bra
+
+
+#endif // BRA_GATE_MATRIX_HPP
@@ -0,0 +1,47 @@
+#ifndef BRA_GATE_PACKED_HPP
+# define BRA_GATE_PACKED_HPP
+
+# include <cstddef>
+# include <vector>
+# include <string>
+# include <iosfwd>
+
+# include <bra/gate/gate.hpp>
+# include <bra/state.hpp>
+# include <bra/instruction.hpp>
+
+
+namespace bra
+{
+  namespace gate
+  {
+    // consecutive gates which have instruction forms, which are packed into a contiguous array by ::bra::gates::pack
+    class packed final
+      : public ::bra::gate::gate
+    {
+      std::vector< ::bra::instruction > instructions_;
+
+      static std::string const name_;
+
+     public:
+      explicit packed(std::vector< ::bra::instruction >&& instructions);
+
+      ~packed() = default;
+      packed(packed const&) = delete;
+      packed& operator=(packed const&) = delete;
+      packed(packed&&) = delete;
+      packed& operator=(packed&&) = delete;
+
+      std::size_t num_packed_gates() const { return instructions_.size(); }
+
+     private:
+      ::bra::state& do_apply(::bra::state& state) const override;
+      std::string const& do_name() const override;
+      std::string do_representation(
+        std::ostringstream& repr_stream, int const parameter_width) const override;
+    }; // class packed
+  } // namespace gate
+} // namespace bra
+
+
+#endif // BRA_GATE_PACKED_HPP
@@ -0,0 +1,92 @@
+#ifndef BRA_GATE_STREAM_HPP
+# define BRA_GATE_STREAM_HPP
+
+# ifdef BRA_NO_MPI
+#   include <cstddef>
+#   include <iosfwd>
+#   include <memory>
+#   include <atomic>
+#   include <thread>
+#   include <mutex>
+#   include <condition_variable>
+#   include <exception>
+
+#   include <bra/state.hpp>
+#   include <bra/gates.hpp>
+#   include <bra/gate/gate.hpp>
+#   include <bra/utility/spsc_queue.hpp>
+
+// Maximal number of gates which have been read but not applied yet in ::bra::gate_stream
+#   ifndef BRA_GATE_STREAM_QUEUE_SIZE
+#     define BRA_GATE_STREAM_QUEUE_SIZE 4096
+#   endif // BRA_GATE_STREAM_QUEUE_SIZE
+
+// Number of tries before a thread of ::bra::gate_stream blocks until the other thread pushes or pops a gate
+#   ifndef BRA_GATE_STREAM_SPIN_COUNT
+#     define BRA_GATE_STREAM_SPIN_COUNT 1024
+#   endif // BRA_GATE_STREAM_SPIN_COUNT
+
+
+namespace bra
+{
+  // gate_stream reads instructions in another thread, and its gates are applied to a state while the following instructions are read.
+  // At most BRA_GATE_STREAM_QUEUE_SIZE gates are kept in memory at the same time.
+  class gate_stream
+  {
+   public:
+    using value_type = std::unique_ptr< ::bra::gate::gate >;
+    using bit_integer_type = ::bra::gates::bit_integer_type;
+    using state_integer_type = ::bra::gates::state_integer_type;
+
+   private:
+    ::bra::gates gates_; // used only by parser_, whose gates are moved into queue_ one by one
+    ::bra::utility::spsc_queue<value_type> queue_;
+    bit_integer_type num_qubits_;
+    state_integer_type initial_state_value_;
+    std::exception_ptr exception_;
+    bool is_header_valid_; // false if reading instructions before the first gate failed
+    std::atomic<bool> is_header_read_; // true if instructions before the first gate have been read
+    std::atomic<bool> is_finished_;
+    std::atomic<bool> is_cancelled_;
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    std::atomic<int> num_waiting_threads_;
+    std::thread parser_;
+
+   public:
+    explicit gate_stream(std::istream& input_stream);
+    ~gate_stream() noexcept;
+
+    gate_stream(gate_stream const&) = delete;
+    gate_stream& operator=(gate_stream const&) = delete;
+    gate_stream(gate_stream&&) = delete;
+    gate_stream& operator=(gate_stream&&) = delete;
+
+    // These wait until instructions before the first gate have been read
+    bit_integer_type num_qubits();
+    state_integer_type initial_state_value();
+
+    // Waits for the next gate and returns true, or returns false if all gates have been popped.
+    // An exception thrown while reading instructions is rethrown after all gates read before it are popped
+    bool pop(value_type& gate);
+
+   private:
+    void parse(std::istream& input_stream);
+    void push(value_type& gate);
+    void publish_header();
+    void wait_header();
+
+    // Tries predicate a few times, and then blocks until notify makes it true
+    template <typename Predicate>
+    void wait(Predicate predicate);
+    // Wakes up the other thread if it is blocked in wait
+    void notify();
+  }; // class gate_stream
+
+  ::bra::state& operator<<(::bra::state& state, ::bra::gate_stream& stream);
+} // namespace bra
+
+
+# endif // BRA_NO_MPI
+
+#endif // BRA_GATE_STREAM_HPP
@@ -2,6 +2,8 @@
 # define BRA_GATES_HPP
 
 # include <cassert>
+# include <cstddef>
+# include <cstdint>
 # include <iosfwd>
 # include <vector>
 # include <string>
@@ -28,6 +30,7 @@
 
 # include <bra/state.hpp>
 # include <bra/gate/gate.hpp>
+# include <bra/parameter_table.hpp>
 
 # if __cplusplus >= 201703L
 #   define BRA_is_nothrow_swappable std::is_nothrow_swappable
@@ -70,8 +73,17 @@ namespace bra
   enum class generate_statement : int { events };
   enum class depolarizing_statement : int { channel };
 
+# ifdef BRA_NO_MPI
+  class gate_stream;
+# endif // BRA_NO_MPI
+
   class gates
   {
+# ifdef BRA_NO_MPI
+    // gate_stream interprets instructions one by one
+    friend class ::bra::gate_stream;
+# endif // BRA_NO_MPI
+
     using value_type_ = std::unique_ptr< ::bra::gate::gate >;
 # ifndef BRA_NO_MPI
     using data_type = std::vector<value_type_, yampi::allocator<value_type_>>;
@@ -104,6 +116,7 @@ namespace bra
     state_integer_type initial_state_value_;
 # ifndef BRA_NO_MPI
     std::vector<permutated_qubit_type> initial_permutation_;
+    bool is_initial_permutation_assigned_;
 # endif
 
     using complex_type = ::bra::state::complex_type;
@@ -145,9 +158,19 @@ namespace bra
       yampi::rank const root = yampi::rank{},
       yampi::communicator const& communicator = yampi::communicator{::yampi::tags::world_communicator},
       size_type const num_reserved_gates = size_type{0u});
+    // [first, last) is a compiled circuit, which is used only in the root process
+    gates(
+      char const* first, char const* last,
+      bit_integer_type num_uqubits, unsigned int num_processes_per_unit,
+      yampi::environment const& environment,
+      yampi::rank const root = yampi::rank{},
+      yampi::communicator const& communicator = yampi::communicator{::yampi::tags::world_communicator},
+      size_type const num_reserved_gates = size_type{0u});
 # else // BRA_NO_MPI
     explicit gates(std::istream& input_stream);
     gates(std::istream& input_stream, size_type const num_reserved_gates);
+    // [first, last) is a compiled circuit
+    gates(char const* first, char const* last, size_type const num_reserved_gates = size_type{0u});
 # endif // BRA_NO_MPI
 
     bool operator==(gates const& other) const;
@@ -194,6 +217,36 @@ namespace bra
       std::istream& input_stream,
       size_type const num_reserved_gates = size_type{0u});
 # endif // BRA_NO_MPI
+# ifndef BRA_NO_MPI
+    void assign(
+      char const* first, char const* last, yampi::environment const& environment,
+      yampi::communicator const& communicator = yampi::communicator{yampi::tags::world_communicator},
+      size_type const num_reserved_gates = size_type{0u});
+# else // BRA_NO_MPI
+    void assign(
+      char const* first, char const* last,
+      size_type const num_reserved_gates = size_type{0u});
+    // Interprets instructions given by read_columns after replacing each column "$name" by the value of name in the row_index-th row of parameters,
+    // so that one circuit is read once and interpreted for each set of parameters
+    void assign(
+      std::vector<columns_type> const& instructions, ::bra::parameter_table const& parameters, std::size_t const row_index,
+      size_type const num_reserved_gates = size_type{0u});
+# endif // BRA_NO_MPI
+
+    // Reads the next nonempty line of input_stream without comments, splits it into columns, and upper-cases the first column.
+    // Returns false if no such line remains
+    static bool read_columns(std::istream& input_stream, std::string& line, columns_type& columns);
+
+   private:
+    // Interprets columns given by read_columns, and appends gates if any.
+    // Returns false if no more instructions should be interpreted, e.g. after EXIT
+# ifndef BRA_NO_MPI
+    bool interpret(columns_type& columns, yampi::environment const& environment, yampi::communicator const& communicator);
+# else // BRA_NO_MPI
+    bool interpret(columns_type& columns);
+# endif // BRA_NO_MPI
+
+   public:
     allocator_type get_allocator() const { return data_.get_allocator(); }
 
     // Element access
@@ -241,6 +294,14 @@ namespace bra
     { data_.emplace_back(std::forward<Arguments>(arguments)...); }
 */
     void pop_back() { data_.pop_back(); }
+    // Moves gates into function one by one and leaves no gate, so that gates are applied while the following instructions are interpreted
+    template <typename Function>
+    void consume(Function&& function)
+    {
+      for (auto& gate: data_)
+        function(std::move(gate));
+      data_.clear();
+    }
     //void resize(size_type const count) { data_.resize(count); }
     void swap(gates& other)
       noexcept(
@@ -249,6 +310,43 @@ namespace bra
         and BRA_is_nothrow_swappable<state_integer_type>::value
         and BRA_is_nothrow_swappable<qubit_type>::value);
 
+    // Returns FNV-1a hash of the number of qubits, the initial state, representation() and unitary_matrix() of each gate, and options,
+    // which are given by the caller, e.g. options of transformations applied later. Checkpoint files are identified by this hash
+    std::uint64_t hash(std::initializer_list<std::uint64_t> options) const;
+
+    // Removes pairs of gates canceling each other, e.g. H H, CNOT CNOT and S S+, merges rotations around the same axis, e.g. EX q a and EX q b,
+    // and removes rotations by zero angles. Gates commuting with the present gate are skipped when its counterpart is looked for.
+    // Returns the number of removed gates
+    size_type optimize();
+
+    // Replaces each run of consecutive diagonal gates, e.g. Z, S, T, U1, R, CR, EZ and EZZ, by one ::bra::gate::diagonal_batch gate,
+    // whose tables of diagonal elements operate on at most max_num_table_qubits qubits each. Nothing is done if max_num_table_qubits == 0
+    void batch_diagonal(bit_integer_type const max_num_table_qubits);
+
+    // Replaces each run of consecutive unitary gates, which operate on at most max_num_fused_qubits qubits in total,
+    // by one ::bra::gate::fused gate. Nothing is done if max_num_fused_qubits == 0
+    void fuse(bit_integer_type const max_num_fused_qubits);
+
+    // Replaces each run of consecutive unitary gates, which operate only on qubits lower than num_block_qubits,
+    // by one ::bra::gate::blocked gate, which applies the gates to each block of 2^num_block_qubits amplitudes in turn.
+    // Nothing is done if num_block_qubits == 0
+    void block(bit_integer_type const num_block_qubits);
+
+    // Replaces each run of consecutive gates which can be instructions, e.g. H, X, U1, EZZ and CNOT, by one ::bra::gate::packed gate,
+    // which stores the instructions contiguously and applies them without a virtual call of ::bra::gate::gate per gate
+    void pack();
+
+# ifndef BRA_NO_MPI
+    // Returns indices of gates operating on each qubit, which are used by MPI policies to choose qubits swapped out of local qubits.
+    // Gates without operated_qubits(), e.g. measurements, are not taken into account
+    ::ket::mpi::utility::lookahead make_lookahead() const;
+
+    // Reorders initial_permutation() among global qubits so that global qubits operated by more gates are mapped to lower bits of ranks,
+    // which are exchanged within a node if ranks are given by ::ket::mpi::utility::make_node_major_communicator
+    // Nothing is done if initial_permutation() is given by BIT ASSIGNMENT or if there are unit qubits, i.e. in unit_mpi mode
+    void order_global_qubits_by_use();
+# endif // BRA_NO_MPI
+
    private:
     bit_integer_type read_num_qubits(columns_type const& columns) const;
     state_integer_type read_initial_state_value(columns_type& columns) const;
@@ -283,6 +381,14 @@ namespace bra
     real_type read_multi_controls_multi_targets_phase(columns_type const& columns, std::vector<control_qubit_type>& controls, std::vector<qubit_type>& targets) const;
     std::tuple<qubit_type, qubit_type, real_type> read_multi_controls_2targets_phase(columns_type const& columns, std::vector<control_qubit_type>& controls) const;
 
+# ifndef BRA_NO_MPI
+    std::vector<complex_type> read_matrix(
+      columns_type const& columns, std::vector<qubit_type>& targets,
+      yampi::environment const& environment, yampi::communicator const& communicator) const;
+# else // BRA_NO_MPI
+    std::vector<complex_type> read_matrix(columns_type const& columns, std::vector<qubit_type>& targets) const;
+# endif // BRA_NO_MPI
+
     ::bra::begin_statement read_begin_statement(columns_type const& columns) const;
     ::bra::bit_statement read_bit_statement(columns_type const& columns) const;
     std::tuple<bit_integer_type, state_integer_type, state_integer_type> read_shor_box(columns_type const& columns) const;
@@ -318,6 +424,7 @@ namespace bra
     void add_roty(columns_type const& columns);
     void add_adj_roty(columns_type const& columns);
     void add_u(columns_type const& columns);
+    void add_adj_u(columns_type const& columns);
     void add_v(columns_type const& columns);
     void add_ex(columns_type const& columns);
     void add_exx(columns_type const& columns);
@@ -334,10 +441,16 @@ namespace bra
     void add_eswap(columns_type const& columns);
     void add_toffoli(columns_type const& columns);
     void add_m(columns_type const& columns);
+# ifndef BRA_NO_MPI
+    void add_matrix(columns_type const& columns, yampi::environment const& environment, yampi::communicator const& communicator);
+# else // BRA_NO_MPI
+    void add_matrix(columns_type const& columns);
+# endif // BRA_NO_MPI
     void add_shor_box(columns_type const& columns);
     void add_clear(columns_type const& columns);
     void add_set(columns_type const& columns);
     void add_depolarizing(columns_type const& columns, std::string const& mnemonic);
+    void add_checkpoint(columns_type const& columns);
 
     void interpret_controlled_gates(columns_type const& columns, std::string const& mnemonic);
     void add_ch(columns_type const& columns, int const num_control_qubits);
@@ -372,6 +485,7 @@ namespace bra
     void add_croty(columns_type const& columns, int const num_control_qubits);
     void add_adj_croty(columns_type const& columns, int const num_control_qubits);
     void add_cu(columns_type const& columns, int const num_control_qubits);
+    void add_adj_cu(columns_type const& columns, int const num_control_qubits);
     void add_cv(columns_type const& columns, int const num_control_qubits);
     void add_cex(columns_type const& columns, int const num_control_qubits);
     void add_cexs(columns_type const& columns, int const num_control_qubits, std::string const& noncontrol_mnemonic);
@@ -400,8 +514,19 @@ namespace bra
 
   inline ::bra::state& operator<<(::bra::state& state, ::bra::gates const& gates)
   {
-    for (auto const& gate_ptr: gates)
-      state << *gate_ptr;
+# ifndef BRA_NO_MPI
+    state.lookahead() = gates.make_lookahead();
+# endif // BRA_NO_MPI
+    // next_gate_index() is nonzero if state has been restarted from a checkpoint file
+    state.num_gates(gates.size());
+    for (auto gate_index = state.next_gate_index(); gate_index < gates.size(); ++gate_index)
+    {
+# ifndef BRA_NO_MPI
+      state.lookahead().present_operation_index(gate_index);
+# endif // BRA_NO_MPI
+      state.next_gate_index(gate_index + 1u);
+      state << *gates[gate_index];
+    }
     return state;
   }
 
@@ -0,0 +1,41 @@
+#ifndef BRA_INSTRUCTION_HPP
+# define BRA_INSTRUCTION_HPP
+
+# include <cstdint>
+
+# include <bra/state.hpp>
+
+
+namespace bra
+{
+  // Each opcode corresponds to a member function of ::bra::state with the same name
+  enum class opcode : std::uint8_t
+  {
+    hadamard, not_, pauli_x, pauli_y, pauli_z, swap,
+    u1, adj_u1, phase_shift, adj_phase_shift,
+    x_rotation_half_pi, adj_x_rotation_half_pi, y_rotation_half_pi, adj_y_rotation_half_pi,
+    exponential_pauli_x, adj_exponential_pauli_x, exponential_pauli_y, adj_exponential_pauli_y,
+    exponential_pauli_z, adj_exponential_pauli_z, exponential_pauli_zz, adj_exponential_pauli_zz,
+    controlled_not, controlled_pauli_z, controlled_phase_shift, adj_controlled_phase_shift
+  }; // enum class opcode
+
+  // Gate whose operands are stored inline, which is kept in a contiguous array by ::bra::gate::packed.
+  // Operands not used by opcode are left unspecified
+  struct instruction
+  {
+    using qubit_type = ::bra::state::qubit_type;
+    using control_qubit_type = ::bra::state::control_qubit_type;
+    using real_type = ::bra::state::real_type;
+    using complex_type = ::bra::state::complex_type;
+
+    ::bra::opcode opcode;
+    qubit_type qubit1; // target qubit of controlled gates
+    qubit_type qubit2;
+    control_qubit_type control_qubit;
+    real_type phase;
+    complex_type phase_coefficient;
+  }; // struct instruction
+} // namespace bra
+
+
+#endif // BRA_INSTRUCTION_HPP
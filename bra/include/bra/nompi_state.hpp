@@ -2,6 +2,7 @@
 # define BRA_NOMPI_STATE_HPP
 
 # ifdef BRA_NO_MPI
+#   include <cstddef>
 #   include <vector>
 
 #   include <ket/gate/projective_measurement.hpp>
@@ -48,6 +49,11 @@ namespace bra
     nompi_state& operator=(nompi_state&&) = delete;
 
    private:
+    std::size_t do_local_state_size() const override;
+    void do_copy_local_state_to(std::size_t const first_index, std::size_t const count, complex_type* out) const override;
+    void do_copy_local_state_from(std::size_t const first_index, std::size_t const count, complex_type const* in) override;
+    void do_reset(state_integer_type const initial_integer) override;
+
     void do_hadamard(qubit_type const qubit) override;
     void do_adj_hadamard(qubit_type const qubit) override;
     void do_not_(qubit_type const qubit) override;
@@ -302,6 +308,14 @@ namespace bra
     void do_adj_multi_controlled_exponential_swap(
       real_type const phase, qubit_type const target_qubit1, qubit_type const target_qubit2,
       std::vector<control_qubit_type> const& control_qubits) override;
+    void do_matrix(
+      std::vector<complex_type> const& matrix, std::vector<qubit_type> const& qubits) override;
+    void do_blocked_matrices(
+      std::vector<std::vector<complex_type>> const& matrices, std::vector<std::vector<qubit_type>> const& qubits,
+      bit_integer_type const num_block_qubits) override;
+    void do_diagonal_batch(
+      std::vector<std::vector<complex_type>> const& tables, std::vector<std::vector<qubit_type>> const& qubits) override;
+    void do_instructions(::bra::instruction const* const first, ::bra::instruction const* const last) override;
   }; // class nompi_state
 
   inline std::unique_ptr< ::bra::state > make_nompi_state(
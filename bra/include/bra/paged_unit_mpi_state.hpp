@@ -2,6 +2,7 @@
 # define BRA_PAGED_UNIT_MPI_STATE_HPP
 
 # ifndef BRA_NO_MPI
+#   include <cstddef>
 #   include <vector>
 
 #   include <ket/gate/projective_measurement.hpp>
@@ -64,6 +65,10 @@ namespace bra
    private:
     unsigned int do_num_page_qubits() const override;
     unsigned int do_num_pages() const override;
+    bool do_is_unit_mode() const override;
+    std::size_t do_local_state_size() const override;
+    void do_copy_local_state_to(std::size_t const first_index, std::size_t const count, complex_type* out) const override;
+    void do_copy_local_state_from(std::size_t const first_index, std::size_t const count, complex_type const* in) override;
 
     void do_hadamard(qubit_type const qubit) override;
     void do_adj_hadamard(qubit_type const qubit) override;
@@ -320,6 +325,13 @@ namespace bra
     void do_adj_multi_controlled_exponential_swap(
       real_type const phase, qubit_type const target_qubit1, qubit_type const target_qubit2,
       std::vector<control_qubit_type> const& control_qubits) override;
+    void do_matrix(
+      std::vector<complex_type> const& matrix, std::vector<qubit_type> const& qubits) override;
+    void do_blocked_matrices(
+      std::vector<std::vector<complex_type>> const& matrices, std::vector<std::vector<qubit_type>> const& qubits,
+      bit_integer_type const num_block_qubits) override;
+    void do_diagonal_batch(
+      std::vector<std::vector<complex_type>> const& tables, std::vector<std::vector<qubit_type>> const& qubits) override;
   }; // class paged_unit_mpi_state
 } // namespace bra
 
@@ -0,0 +1,46 @@
+#ifndef BRA_PARAMETER_TABLE_HPP
+# define BRA_PARAMETER_TABLE_HPP
+
+# include <cstddef>
+# include <iosfwd>
+# include <vector>
+# include <string>
+# include <stdexcept>
+
+/*
+ * Format of parameter files (.csv) given by params option
+ *   the first line:  names of parameters separated by commas, e.g. "theta0,theta1" or "$theta0,$theta1"
+ *   the other lines: values of the parameters in the same order, e.g. "0.5,1.25"
+ * Spaces around columns and empty lines are ignored. A column "$theta0" of an instruction, e.g. "EX 3 $theta0", is replaced by the value of theta0.
+ */
+
+
+namespace bra
+{
+  class parameter_table_error
+    : public std::runtime_error
+  {
+   public:
+    explicit parameter_table_error(std::string const& message);
+  }; // class parameter_table_error
+
+  class parameter_table
+  {
+    std::vector<std::string> names_;
+    std::vector<std::vector<std::string>> rows_;
+
+   public:
+    explicit parameter_table(std::istream& input_stream);
+
+    std::vector<std::string> const& names() const noexcept { return names_; }
+    std::vector<std::string> const& row(std::size_t const row_index) const { return rows_[row_index]; }
+    std::size_t size() const noexcept { return rows_.size(); }
+    bool empty() const noexcept { return rows_.empty(); }
+
+    // Replaces each column "$name" of columns by the value of the parameter name in the row_index-th row
+    void substitute(std::vector<std::string>& columns, std::size_t const row_index) const;
+  }; // class parameter_table
+} // namespace bra
+
+
+#endif // BRA_PARAMETER_TABLE_HPP
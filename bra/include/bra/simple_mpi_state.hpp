@@ -2,12 +2,17 @@
 # define BRA_SIMPLE_MPI_STATE_HPP
 
 # ifndef BRA_NO_MPI
+#   include <cstddef>
 #   include <vector>
 
 #   include <ket/gate/projective_measurement.hpp>
 #   include <ket/utility/parallel/loop_n.hpp>
 #   include <ket/mpi/utility/simple_mpi.hpp>
 
+#   ifdef KET_USE_SHARED_MEMORY_INTERCHANGE
+#     include <ket/mpi/utility/shared_memory.hpp>
+#   endif // KET_USE_SHARED_MEMORY_INTERCHANGE
+
 #   include <yampi/allocator.hpp>
 #   include <yampi/rank.hpp>
 #   include <yampi/communicator.hpp>
@@ -24,7 +29,12 @@ namespace bra
     ket::utility::policy::parallel<unsigned int> parallel_policy_;
     ket::mpi::utility::policy::simple_mpi mpi_policy_;
 
+#   ifndef KET_USE_SHARED_MEMORY_INTERCHANGE
     using data_type = std::vector<complex_type, yampi::allocator<complex_type>>;
+#   else // KET_USE_SHARED_MEMORY_INTERCHANGE
+    // processes on the same node swap amplitudes of data_ in place
+    using data_type = std::vector<complex_type, ket::mpi::utility::shared_memory_allocator<complex_type>>;
+#   endif // KET_USE_SHARED_MEMORY_INTERCHANGE
     data_type data_;
 
    public:
@@ -66,6 +76,10 @@ namespace bra
 
     unsigned int do_num_page_qubits() const override;
     unsigned int do_num_pages() const override;
+    bool do_is_unit_mode() const override;
+    std::size_t do_local_state_size() const override;
+    void do_copy_local_state_to(std::size_t const first_index, std::size_t const count, complex_type* out) const override;
+    void do_copy_local_state_from(std::size_t const first_index, std::size_t const count, complex_type const* in) override;
 
     void do_hadamard(qubit_type const qubit) override;
     void do_adj_hadamard(qubit_type const qubit) override;
@@ -322,6 +336,13 @@ namespace bra
     void do_adj_multi_controlled_exponential_swap(
       real_type const phase, qubit_type const target_qubit1, qubit_type const target_qubit2,
       std::vector<control_qubit_type> const& control_qubits) override;
+    void do_matrix(
+      std::vector<complex_type> const& matrix, std::vector<qubit_type> const& qubits) override;
+    void do_blocked_matrices(
+      std::vector<std::vector<complex_type>> const& matrices, std::vector<std::vector<qubit_type>> const& qubits,
+      bit_integer_type const num_block_qubits) override;
+    void do_diagonal_batch(
+      std::vector<std::vector<complex_type>> const& tables, std::vector<std::vector<qubit_type>> const& qubits) override;
   }; // class simple_mpi_state
 } // namespace bra
 
@@ -2,9 +2,11 @@
 # define BRA_STATE_HPP
 
 # include <cstddef>
+# include <cstdint>
 # include <complex>
 # include <vector>
 # include <array>
+# include <string>
 # include <utility>
 # ifdef BRA_NO_MPI
 #   include <chrono>
@@ -21,6 +23,7 @@
 # ifndef BRA_NO_MPI
 #   include <ket/mpi/permutated.hpp>
 #   include <ket/mpi/qubit_permutation.hpp>
+#   include <ket/mpi/utility/lookahead.hpp>
 
 #   include <yampi/allocator.hpp>
 #   include <yampi/datatype.hpp>
@@ -41,6 +44,8 @@ namespace bra
 {
   enum class finished_process : int { operations, begin_measurement, generate_events, ket_measure };
 
+  struct instruction;
+
   class too_many_qubits_error
     : public std::runtime_error
   {
@@ -48,6 +53,13 @@ namespace bra
     too_many_qubits_error(std::size_t const num_qubits);
   }; // class too_many_qubits_error
 
+  class checkpoint_error
+    : public std::runtime_error
+  {
+   public:
+    checkpoint_error(std::string const& path, std::string const& message);
+  }; // class checkpoint_error
+
   class state
   {
    public:
@@ -108,10 +120,15 @@ namespace bra
     yampi::datatype real_pair_datatype_;
     yampi::communicator const& communicator_;
     yampi::environment const& environment_;
+    ket::mpi::utility::lookahead lookahead_; // upcoming gates, which are referred by mpi_policy_ of derived classes
 # endif // BRA_NO_MPI
 
     std::vector<time_and_process_type> finish_times_and_processes_;
 
+    std::size_t next_gate_index_; // index of the gate applied after the present one in ::bra::gates
+    std::size_t num_gates_; // size of ::bra::gates applied to this state
+    std::uint64_t circuit_hash_; // ::bra::gates::hash() of the circuit applied to this state, which is checked by restart()
+
    public:
 # ifndef BRA_NO_MPI
     state(
@@ -167,8 +184,18 @@ namespace bra
 
     yampi::communicator const& communicator() const { return communicator_; }
     yampi::environment const& environment() const { return environment_; }
+
+    ket::mpi::utility::lookahead& lookahead() { return lookahead_; }
+    ket::mpi::utility::lookahead const& lookahead() const { return lookahead_; }
 # endif // BRA_NO_MPI
 
+    std::size_t const& next_gate_index() const { return next_gate_index_; }
+    void next_gate_index(std::size_t const new_next_gate_index) { next_gate_index_ = new_next_gate_index; }
+    std::size_t const& num_gates() const { return num_gates_; }
+    void num_gates(std::size_t const new_num_gates) { num_gates_ = new_num_gates; }
+    std::uint64_t const& circuit_hash() const { return circuit_hash_; }
+    void circuit_hash(std::uint64_t const new_circuit_hash) { circuit_hash_ = new_circuit_hash; }
+
     std::size_t num_finish_processes() const { return finish_times_and_processes_.size(); }
     time_and_process_type const& finish_time_and_process(std::size_t const n) const
     { return finish_times_and_processes_[n]; }
@@ -417,6 +444,20 @@ namespace bra
 
     ::bra::state& depolarizing_channel(real_type const px, real_type const py, real_type const pz, int const seed);
 
+    // writes the state vector, the qubit permutation, outcomes of measurements, the random number generator and next_gate_index() into path.
+    // In MPI versions, all processes write their local state vectors in parallel by collective MPI-IO
+    ::bra::state& checkpoint(std::string const& path);
+
+    // reads path written by checkpoint(), after which gates from next_gate_index() are applied by operator<<.
+    // num_gates() and circuit_hash() must be the same as those at checkpoint()
+    void restart(std::string const& path);
+
+# ifdef BRA_NO_MPI
+    // sets the state vector to |initial_integer> in place, clears outcomes of measurements, finished processes and next_gate_index(),
+    // and reseeds the random number generator, so that the same state object is used for several runs of circuits
+    void reset(state_integer_type const initial_integer, seed_type const seed);
+# endif // BRA_NO_MPI
+
     ::bra::state& controlled_hadamard(
       qubit_type const target_qubit, control_qubit_type const control_qubit)
     { do_controlled_hadamard(target_qubit, control_qubit); return *this; }
@@ -585,7 +626,7 @@ namespace bra
 
     ::bra::state& adj_controlled_x_rotation_half_pi(
       qubit_type const target_qubit, control_qubit_type const control_qubit)
-    { do_controlled_x_rotation_half_pi(target_qubit, control_qubit); return *this; }
+    { do_adj_controlled_x_rotation_half_pi(target_qubit, control_qubit); return *this; }
 
     ::bra::state& multi_controlled_x_rotation_half_pi(
       qubit_type const target_qubit, std::vector<control_qubit_type> const& control_qubits)
@@ -593,7 +634,7 @@ namespace bra
 
     ::bra::state& adj_multi_controlled_x_rotation_half_pi(
       qubit_type const target_qubit, std::vector<control_qubit_type> const& control_qubits)
-    { do_multi_controlled_x_rotation_half_pi(target_qubit, control_qubits); return *this; }
+    { do_adj_multi_controlled_x_rotation_half_pi(target_qubit, control_qubits); return *this; }
 
     ::bra::state& controlled_y_rotation_half_pi(
       qubit_type const target_qubit, control_qubit_type const control_qubit)
@@ -601,7 +642,7 @@ namespace bra
 
     ::bra::state& adj_controlled_y_rotation_half_pi(
       qubit_type const target_qubit, control_qubit_type const control_qubit)
-    { do_controlled_y_rotation_half_pi(target_qubit, control_qubit); return *this; }
+    { do_adj_controlled_y_rotation_half_pi(target_qubit, control_qubit); return *this; }
 
     ::bra::state& multi_controlled_y_rotation_half_pi(
       qubit_type const target_qubit, std::vector<control_qubit_type> const& control_qubits)
@@ -609,7 +650,7 @@ namespace bra
 
     ::bra::state& adj_multi_controlled_y_rotation_half_pi(
       qubit_type const target_qubit, std::vector<control_qubit_type> const& control_qubits)
-    { do_multi_controlled_y_rotation_half_pi(target_qubit, control_qubits); return *this; }
+    { do_adj_multi_controlled_y_rotation_half_pi(target_qubit, control_qubits); return *this; }
 
     ::bra::state& multi_controlled_v(
       complex_type const& phase_coefficient,
@@ -639,35 +680,35 @@ namespace bra
 
     ::bra::state& controlled_exponential_pauli_y(
       real_type const phase, qubit_type const target_qubit, control_qubit_type const control_qubit)
-    { do_controlled_exponential_pauli_x(phase, target_qubit, control_qubit); return *this; }
+    { do_controlled_exponential_pauli_y(phase, target_qubit, control_qubit); return *this; }
 
     ::bra::state& adj_controlled_exponential_pauli_y(
       real_type const phase, qubit_type const target_qubit, control_qubit_type const control_qubit)
-    { do_adj_controlled_exponential_pauli_x(phase, target_qubit, control_qubit); return *this; }
+    { do_adj_controlled_exponential_pauli_y(phase, target_qubit, control_qubit); return *this; }
 
     ::bra::state& multi_controlled_exponential_pauli_yn(
       real_type const phase, std::vector<qubit_type> const& target_qubits, std::vector<control_qubit_type> const& control_qubits)
-    { do_multi_controlled_exponential_pauli_xn(phase, target_qubits, control_qubits); return *this; }
+    { do_multi_controlled_exponential_pauli_yn(phase, target_qubits, control_qubits); return *this; }
 
     ::bra::state& adj_multi_controlled_exponential_pauli_yn(
       real_type const phase, std::vector<qubit_type> const& target_qubits, std::vector<control_qubit_type> const& control_qubits)
-    { do_adj_multi_controlled_exponential_pauli_xn(phase, target_qubits, control_qubits); return *this; }
+    { do_adj_multi_controlled_exponential_pauli_yn(phase, target_qubits, control_qubits); return *this; }
 
     ::bra::state& controlled_exponential_pauli_z(
       real_type const phase, qubit_type const target_qubit, control_qubit_type const control_qubit)
-    { do_controlled_exponential_pauli_x(phase, target_qubit, control_qubit); return *this; }
+    { do_controlled_exponential_pauli_z(phase, target_qubit, control_qubit); return *this; }
 
     ::bra::state& adj_controlled_exponential_pauli_z(
       real_type const phase, qubit_type const target_qubit, control_qubit_type const control_qubit)
-    { do_adj_controlled_exponential_pauli_x(phase, target_qubit, control_qubit); return *this; }
+    { do_adj_controlled_exponential_pauli_z(phase, target_qubit, control_qubit); return *this; }
 
     ::bra::state& multi_controlled_exponential_pauli_zn(
       real_type const phase, std::vector<qubit_type> const& target_qubits, std::vector<control_qubit_type> const& control_qubits)
-    { do_multi_controlled_exponential_pauli_xn(phase, target_qubits, control_qubits); return *this; }
+    { do_multi_controlled_exponential_pauli_zn(phase, target_qubits, control_qubits); return *this; }
 
     ::bra::state& adj_multi_controlled_exponential_pauli_zn(
       real_type const phase, std::vector<qubit_type> const& target_qubits, std::vector<control_qubit_type> const& control_qubits)
-    { do_adj_multi_controlled_exponential_pauli_xn(phase, target_qubits, control_qubits); return *this; }
+    { do_adj_multi_controlled_exponential_pauli_zn(phase, target_qubits, control_qubits); return *this; }
 
     ::bra::state& multi_controlled_exponential_swap(
       real_type const phase, qubit_type const target_qubit1, qubit_type const target_qubit2,
@@ -679,12 +720,41 @@ namespace bra
       std::vector<control_qubit_type> const& control_qubits)
     { do_adj_multi_controlled_exponential_swap(phase, target_qubit1, target_qubit2, control_qubits); return *this; }
 
+    // matrix: row-major 2^n x 2^n unitary matrix (n = qubits.size()), whose k-th bit of row/column indices corresponds to qubits[k]
+    ::bra::state& matrix(std::vector<complex_type> const& matrix, std::vector<qubit_type> const& qubits)
+    { do_matrix(matrix, qubits); return *this; }
+
+    // applies matrices[0] on qubits[0], matrices[1] on qubits[1], ... in this order, where all qubits are lower than num_block_qubits.
+    // The state may be processed block by block, each of which has 2^num_block_qubits amplitudes
+    ::bra::state& blocked_matrices(
+      std::vector<std::vector<complex_type>> const& matrices, std::vector<std::vector<qubit_type>> const& qubits,
+      bit_integer_type const num_block_qubits)
+    { do_blocked_matrices(matrices, qubits, num_block_qubits); return *this; }
+
+    // multiplies each amplitude a_i by tables[0][b_0(i)] tables[1][b_1(i)] ..., where the n-th bit of b_k(i) is the qubits[k][n]-th bit of i
+    ::bra::state& diagonal_batch(
+      std::vector<std::vector<complex_type>> const& tables, std::vector<std::vector<qubit_type>> const& qubits)
+    { do_diagonal_batch(tables, qubits); return *this; }
+
+    // applies the gates of [first, last) in this order. Derived classes may dispatch them to their own member functions directly
+    ::bra::state& instructions(::bra::instruction const* first, ::bra::instruction const* last)
+    { do_instructions(first, last); return *this; }
+
    private:
 # ifndef BRA_NO_MPI
     virtual unsigned int do_num_page_qubits() const = 0;
     virtual unsigned int do_num_pages() const = 0;
+    // true if local state vectors cannot be redistributed to a different number of processes
+    virtual bool do_is_unit_mode() const = 0;
 
 # endif
+    // local state vector seen as contiguous elements regardless of pages, which are used by checkpoint() and restart()
+    virtual std::size_t do_local_state_size() const = 0;
+    virtual void do_copy_local_state_to(std::size_t const first_index, std::size_t const count, complex_type* out) const = 0;
+    virtual void do_copy_local_state_from(std::size_t const first_index, std::size_t const count, complex_type const* in) = 0;
+# ifdef BRA_NO_MPI
+    virtual void do_reset(state_integer_type const initial_integer) = 0;
+# endif // BRA_NO_MPI
     virtual void do_hadamard(qubit_type const qubit) = 0;
     virtual void do_adj_hadamard(qubit_type const qubit) = 0;
     virtual void do_not_(qubit_type const qubit) = 0;
@@ -943,6 +1013,15 @@ namespace bra
     virtual void do_adj_multi_controlled_exponential_swap(
       real_type const phase, qubit_type const target_qubit1, qubit_type const target_qubit2,
       std::vector<control_qubit_type> const& control_qubits) = 0;
+    virtual void do_matrix(
+      std::vector<complex_type> const& matrix, std::vector<qubit_type> const& qubits) = 0;
+    virtual void do_blocked_matrices(
+      std::vector<std::vector<complex_type>> const& matrices, std::vector<std::vector<qubit_type>> const& qubits,
+      bit_integer_type const num_block_qubits) = 0;
+    virtual void do_diagonal_batch(
+      std::vector<std::vector<complex_type>> const& tables, std::vector<std::vector<qubit_type>> const& qubits) = 0;
+    // calls the member function corresponding to each opcode
+    virtual void do_instructions(::bra::instruction const* first, ::bra::instruction const* last);
   }; // class state
 } // namespace bra
 
@@ -0,0 +1,63 @@
+#ifndef BRA_UNITARY_MATRIX_HPP
+# define BRA_UNITARY_MATRIX_HPP
+
+# include <cstddef>
+# include <vector>
+
+# include <bra/state.hpp>
+
+
+namespace bra
+{
+  // Unitary matrices of gates, which are used to fuse consecutive gates into one gate.
+  // Every matrix is a row-major 2^n x 2^n matrix, whose k-th bit of row/column indices corresponds to the k-th operated qubit.
+  // Operated qubits of controlled gates are ordered as target qubits followed by control qubits.
+  namespace unitary_matrix
+  {
+    using qubit_type = ::bra::state::qubit_type;
+    using control_qubit_type = ::bra::state::control_qubit_type;
+    using real_type = ::bra::state::real_type;
+    using complex_type = ::bra::state::complex_type;
+    using matrix_type = std::vector<complex_type>;
+
+    matrix_type identity(std::size_t const num_qubits);
+    matrix_type hadamard();
+    matrix_type pauli_x();
+    matrix_type pauli_y();
+    matrix_type pauli_z();
+    matrix_type swap();
+    matrix_type phase_shift(complex_type const& phase_coefficient);
+    matrix_type u1(real_type const phase);
+    matrix_type u2(real_type const phase1, real_type const phase2);
+    matrix_type u3(real_type const phase1, real_type const phase2, real_type const phase3);
+    matrix_type x_rotation_half_pi();
+    matrix_type y_rotation_half_pi();
+    // target block of controlled V gates
+    matrix_type v(complex_type const& phase_coefficient);
+
+    matrix_type adjoint(matrix_type const& matrix);
+    // single-qubit matrix (x) ... (x) single-qubit matrix (num_qubits times)
+    matrix_type tensor_power(matrix_type const& matrix, std::size_t const num_qubits);
+    // exp(i phase P) = I cos(phase) + i P sin(phase), where P^2 = I
+    matrix_type exponential(real_type const phase, matrix_type const& matrix);
+    matrix_type controlled(matrix_type const& matrix, std::size_t const num_control_qubits);
+
+    std::vector<qubit_type> operated_qubits(
+      std::vector<qubit_type> target_qubits, std::vector<control_qubit_type> const& control_qubits);
+
+    // result = matrix * result, where qubits should be a subset of result_qubits
+    void multiply(
+      matrix_type& result, std::vector<qubit_type> const& result_qubits,
+      matrix_type const& matrix, std::vector<qubit_type> const& qubits);
+
+    // diagonal elements of matrix, or an empty vector if matrix has nonzero off-diagonal elements
+    std::vector<complex_type> diagonal(matrix_type const& matrix);
+    // result = diagonal * result for diagonal matrices given by their diagonal elements, where qubits should be a subset of result_qubits
+    void multiply_diagonal(
+      std::vector<complex_type>& result, std::vector<qubit_type> const& result_qubits,
+      std::vector<complex_type> const& diagonal, std::vector<qubit_type> const& qubits);
+  } // namespace unitary_matrix
+} // namespace bra
+
+
+#endif // BRA_UNITARY_MATRIX_HPP
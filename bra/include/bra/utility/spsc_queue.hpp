@@ -0,0 +1,63 @@
+#ifndef BRA_UTILITY_SPSC_QUEUE_HPP
+# define BRA_UTILITY_SPSC_QUEUE_HPP
+
+# include <cstddef>
+# include <vector>
+# include <atomic>
+# include <utility>
+
+// Size of the padding between indices of ::bra::utility::spsc_queue, which should be at least the cache line size
+# ifndef BRA_UTILITY_CACHE_LINE_SIZE
+#   define BRA_UTILITY_CACHE_LINE_SIZE 64
+# endif // BRA_UTILITY_CACHE_LINE_SIZE
+
+
+namespace bra
+{
+  namespace utility
+  {
+    // Bounded queue without locks, whose try_push is called only by one thread and try_pop is called only by another thread
+    template <typename T>
+    class spsc_queue
+    {
+      std::vector<T> slots_; // one slot is always empty to distinguish a full queue from an empty one
+      alignas(BRA_UTILITY_CACHE_LINE_SIZE) std::atomic<std::size_t> head_; // written only by the consumer
+      alignas(BRA_UTILITY_CACHE_LINE_SIZE) std::atomic<std::size_t> tail_; // written only by the producer
+
+     public:
+      explicit spsc_queue(std::size_t const capacity)
+        : slots_(capacity + std::size_t{1u}), head_{0u}, tail_{0u}
+      { }
+
+      spsc_queue(spsc_queue const&) = delete;
+      spsc_queue& operator=(spsc_queue const&) = delete;
+
+      // value is moved only if true is returned
+      bool try_push(T& value)
+      {
+        auto const tail = tail_.load(std::memory_order_relaxed);
+        auto const next_tail = tail + std::size_t{1u} == slots_.size() ? std::size_t{0u} : tail + std::size_t{1u};
+        if (next_tail == head_.load(std::memory_order_acquire))
+          return false;
+
+        slots_[tail] = std::move(value);
+        tail_.store(next_tail, std::memory_order_release);
+        return true;
+      }
+
+      bool try_pop(T& value)
+      {
+        auto const head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire))
+          return false;
+
+        value = std::move(slots_[head]);
+        head_.store(head + std::size_t{1u} == slots_.size() ? std::size_t{0u} : head + std::size_t{1u}, std::memory_order_release);
+        return true;
+      }
+    }; // class spsc_queue<T>
+  } // namespace utility
+} // namespace bra
+
+
+#endif // BRA_UTILITY_SPSC_QUEUE_HPP
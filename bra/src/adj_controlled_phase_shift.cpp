@@ -1,4 +1,5 @@
 #include <string>
+#include <vector>
 #include <ios>
 #include <iomanip>
 #include <sstream>
@@ -9,6 +10,8 @@
 #include <bra/gate/gate.hpp>
 #include <bra/gate/adj_controlled_phase_shift.hpp>
 #include <bra/state.hpp>
+#include <bra/instruction.hpp>
+#include <bra/unitary_matrix.hpp>
 
 
 namespace bra
@@ -30,6 +33,24 @@ namespace bra
     ::bra::state& adj_controlled_phase_shift::do_apply(::bra::state& state) const
     { return state.adj_controlled_phase_shift(phase_coefficient_, target_qubit_, control_qubit_); }
 
+    std::vector<adj_controlled_phase_shift::qubit_type> adj_controlled_phase_shift::do_operated_qubits() const
+    { return {target_qubit_, control_qubit_.qubit()}; }
+
+    std::vector<adj_controlled_phase_shift::complex_type> adj_controlled_phase_shift::do_unitary_matrix() const
+    {
+      return ::bra::unitary_matrix::adjoint(
+        ::bra::unitary_matrix::controlled(::bra::unitary_matrix::phase_shift(phase_coefficient_), 1u));
+    }
+
+    bool adj_controlled_phase_shift::do_instruction(::bra::instruction& result) const
+    {
+      result.opcode = ::bra::opcode::adj_controlled_phase_shift;
+      result.phase_coefficient = phase_coefficient_;
+      result.qubit1 = target_qubit_;
+      result.control_qubit = control_qubit_;
+      return true;
+    }
+
     std::string const& adj_controlled_phase_shift::do_name() const { return name_; }
     std::string adj_controlled_phase_shift::do_representation(
       std::ostringstream& repr_stream, int const parameter_width) const
@@ -1,4 +1,5 @@
 #include <string>
+#include <vector>
 #include <ios>
 #include <iomanip>
 #include <sstream>
@@ -9,6 +10,8 @@
 #include <bra/gate/gate.hpp>
 #include <bra/gate/adj_controlled_s_gate.hpp>
 #include <bra/state.hpp>
+#include <bra/instruction.hpp>
+#include <bra/unitary_matrix.hpp>
 
 
 namespace bra
@@ -29,6 +32,24 @@ namespace bra
     ::bra::state& adj_controlled_s_gate::do_apply(::bra::state& state) const
     { return state.adj_controlled_phase_shift(phase_coefficient_, target_qubit_, control_qubit_); }
 
+    std::vector<adj_controlled_s_gate::qubit_type> adj_controlled_s_gate::do_operated_qubits() const
+    { return {target_qubit_, control_qubit_.qubit()}; }
+
+    std::vector<adj_controlled_s_gate::complex_type> adj_controlled_s_gate::do_unitary_matrix() const
+    {
+      return ::bra::unitary_matrix::adjoint(
+        ::bra::unitary_matrix::controlled(::bra::unitary_matrix::phase_shift(phase_coefficient_), 1u));
+    }
+
+    bool adj_controlled_s_gate::do_instruction(::bra::instruction& result) const
+    {
+      result.opcode = ::bra::opcode::adj_controlled_phase_shift;
+      result.phase_coefficient = phase_coefficient_;
+      result.qubit1 = target_qubit_;
+      result.control_qubit = control_qubit_;
+      return true;
+    }
+
     std::string const& adj_controlled_s_gate::do_name() const { return name_; }
     std::string adj_controlled_s_gate::do_representation(
       std::ostringstream& repr_stream, int const parameter_width) const
@@ -1,4 +1,5 @@
 #include <string>
+#include <vector>
 #include <ios>
 #include <iomanip>
 #include <sstream>
@@ -9,6 +10,7 @@
 #include <bra/gate/gate.hpp>
 #include <bra/gate/adj_controlled_v_.hpp>
 #include <bra/state.hpp>
+#include <bra/unitary_matrix.hpp>
 
 
 namespace bra
@@ -30,6 +32,15 @@ namespace bra
     ::bra::state& adj_controlled_v_::do_apply(::bra::state& state) const
     { return state.adj_controlled_v(phase_coefficient_, target_qubit_, control_qubit_); }
 
+    std::vector<adj_controlled_v_::qubit_type> adj_controlled_v_::do_operated_qubits() const
+    { return {target_qubit_, control_qubit_.qubit()}; }
+
+    std::vector<adj_controlled_v_::complex_type> adj_controlled_v_::do_unitary_matrix() const
+    {
+      return ::bra::unitary_matrix::adjoint(
+        ::bra::unitary_matrix::controlled(::bra::unitary_matrix::v(phase_coefficient_), 1u));
+    }
+
     std::string const& adj_controlled_v_::do_name() const { return name_; }
     std::string adj_controlled_v_::do_representation(
       std::ostringstream& repr_stream, int const parameter_width) const
@@ -10,6 +10,7 @@
 #include <bra/gate/gate.hpp>
 #include <bra/gate/adj_exponential_pauli_xn.hpp>
 #include <bra/state.hpp>
+#include <bra/unitary_matrix.hpp>
 
 
 namespace bra
@@ -23,6 +24,16 @@ namespace bra
     ::bra::state& adj_exponential_pauli_xn::do_apply(::bra::state& state) const
     { return state.adj_exponential_pauli_xn(phase_, qubits_); }
 
+    std::vector<adj_exponential_pauli_xn::qubit_type> adj_exponential_pauli_xn::do_operated_qubits() const
+    { return qubits_; }
+
+    std::vector<adj_exponential_pauli_xn::complex_type> adj_exponential_pauli_xn::do_unitary_matrix() const
+    {
+      return ::bra::unitary_matrix::adjoint(
+        ::bra::unitary_matrix::exponential(
+          phase_, ::bra::unitary_matrix::tensor_power(::bra::unitary_matrix::pauli_x(), qubits_.size())));
+    }
+
     std::string const& adj_exponential_pauli_xn::do_name() const { return name_; }
     std::string adj_exponential_pauli_xn::do_representation(
       std::ostringstream& repr_stream, int const parameter_width) const
@@ -10,6 +10,7 @@
 #include <bra/gate/gate.hpp>
 #include <bra/gate/adj_exponential_pauli_zn.hpp>
 #include <bra/state.hpp>
+#include <bra/unitary_matrix.hpp>
 
 
 namespace bra
@@ -23,6 +24,16 @@ namespace bra
     ::bra::state& adj_exponential_pauli_zn::do_apply(::bra::state& state) const
     { return state.adj_exponential_pauli_zn(phase_, qubits_); }
 
+    std::vector<adj_exponential_pauli_zn::qubit_type> adj_exponential_pauli_zn::do_operated_qubits() const
+    { return qubits_; }
+
+    std::vector<adj_exponential_pauli_zn::complex_type> adj_exponential_pauli_zn::do_unitary_matrix() const
+    {
+      return ::bra::unitary_matrix::adjoint(
+        ::bra::unitary_matrix::exponential(
+          phase_, ::bra::unitary_matrix::tensor_power(::bra::unitary_matrix::pauli_z(), qubits_.size())));
+    }
+
     std::string const& adj_exponential_pauli_zn::do_name() const { return name_; }
     std::string adj_exponential_pauli_zn::do_representation(
       std::ostringstream& repr_stream, int const parameter_width) const
@@ -1,4 +1,5 @@
 #include <string>
+#include <vector>
 #include <ios>
 #include <iomanip>
 #include <sstream>
@@ -8,6 +9,7 @@
 #include <bra/gate/gate.hpp>
 #include <bra/gate/adj_exponential_swap.hpp>
 #include <bra/state.hpp>
+#include <bra/unitary_matrix.hpp>
 
 
 namespace bra
@@ -23,6 +25,15 @@ namespace bra
     ::bra::state& adj_exponential_swap::do_apply(::bra::state& state) const
     { return state.adj_exponential_swap(phase_, qubit1_, qubit2_); }
 
+    std::vector<adj_exponential_swap::qubit_type> adj_exponential_swap::do_operated_qubits() const
+    { return {qubit1_, qubit2_}; }
+
+    std::vector<adj_exponential_swap::complex_type> adj_exponential_swap::do_unitary_matrix() const
+    {
+      return ::bra::unitary_matrix::adjoint(
+        ::bra::unitary_matrix::exponential(phase_, ::bra::unitary_matrix::swap()));
+    }
+
     std::string const& adj_exponential_swap::do_name() const { return name_; }
     std::string adj_exponential_swap::do_representation(
       std::ostringstream& repr_stream, int const parameter_width) const
@@ -1,4 +1,5 @@
 #include <string>
+#include <vector>
 #include <ios>
 #include <iomanip>
 #include <sstream>
@@ -8,6 +9,7 @@
 #include <bra/gate/gate.hpp>
 #include <bra/gate/adj_hadamard.hpp>
 #include <bra/state.hpp>
+#include <bra/unitary_matrix.hpp>
 
 
 namespace bra
@@ -23,6 +25,12 @@ namespace bra
     ::bra::state& adj_hadamard::do_apply(::bra::state& state) const
     { return state.adj_hadamard(qubit_); }
 
+    std::vector<adj_hadamard::qubit_type> adj_hadamard::do_operated_qubits() const
+    { return {qubit_}; }
+
+    std::vector<adj_hadamard::complex_type> adj_hadamard::do_unitary_matrix() const
+    { return ::bra::unitary_matrix::adjoint(::bra::unitary_matrix::hadamard()); }
+
     std::string const& adj_hadamard::do_name() const { return name_; }
     std::string adj_hadamard::do_representation(
       std::ostringstream& repr_stream, int const parameter_width) const
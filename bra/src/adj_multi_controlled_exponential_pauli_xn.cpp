@@ -11,6 +11,7 @@
 #include <bra/gate/gate.hpp>
 #include <bra/gate/adj_multi_controlled_exponential_pauli_xn.hpp>
 #include <bra/state.hpp>
+#include <bra/unitary_matrix.hpp>
 
 
 namespace bra
@@ -27,6 +28,19 @@ namespace bra
     ::bra::state& adj_multi_controlled_exponential_pauli_xn::do_apply(::bra::state& state) const
     { return state.adj_multi_controlled_exponential_pauli_xn(phase_, target_qubits_, control_qubits_); }
 
+    std::vector<adj_multi_controlled_exponential_pauli_xn::qubit_type> adj_multi_controlled_exponential_pauli_xn::do_operated_qubits() const
+    { return ::bra::unitary_matrix::operated_qubits(target_qubits_, control_qubits_); }
+
+    std::vector<adj_multi_controlled_exponential_pauli_xn::complex_type> adj_multi_controlled_exponential_pauli_xn::do_unitary_matrix() const
+    {
+      return ::bra::unitary_matrix::adjoint(
+        ::bra::unitary_matrix::controlled(
+          ::bra::unitary_matrix::exponential(
+            phase_,
+            ::bra::unitary_matrix::tensor_power(::bra::unitary_matrix::pauli_x(), target_qubits_.size())),
+          control_qubits_.size()));
+    }
+
     std::string const& adj_multi_controlled_exponential_pauli_xn::do_name() const { return name_; }
     std::string adj_multi_controlled_exponential_pauli_xn::do_representation(
       std::ostringstream& repr_stream, int const parameter_width) const
@@ -11,6 +11,7 @@
 #include <bra/gate/gate.hpp>
 #include <bra/gate/adj_multi_controlled_t_gate.hpp>
 #include <bra/state.hpp>
+#include <bra/unitary_matrix.hpp>
 
 
 namespace bra
@@ -30,6 +31,16 @@ namespace bra
     ::bra::state& adj_multi_controlled_t_gate::do_apply(::bra::state& state) const
     { return state.adj_multi_controlled_phase_shift(phase_coefficient_, target_qubit_, control_qubits_); }
 
+    std::vector<adj_multi_controlled_t_gate::qubit_type> adj_multi_controlled_t_gate::do_operated_qubits() const
+    { return ::bra::unitary_matrix::operated_qubits({target_qubit_}, control_qubits_); }
+
+    std::vector<adj_multi_controlled_t_gate::complex_type> adj_multi_controlled_t_gate::do_unitary_matrix() const
+    {
+      return ::bra::unitary_matrix::adjoint(
+        ::bra::unitary_matrix::controlled(
+          ::bra::unitary_matrix::phase_shift(phase_coefficient_), control_qubits_.size()));
+    }
+
     std::string const& adj_multi_controlled_t_gate::do_name() const { return name_; }
     std::string adj_multi_controlled_t_gate::do_representation(
       std::ostringstream& repr_stream, int const parameter_width) const
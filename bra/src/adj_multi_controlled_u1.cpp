@@ -11,6 +11,7 @@
 #include <bra/gate/gate.hpp>
 #include <bra/gate/adj_multi_controlled_u1.hpp>
 #include <bra/state.hpp>
+#include <bra/unitary_matrix.hpp>
 
 
 namespace bra
@@ -27,6 +28,15 @@ namespace bra
     ::bra::state& adj_multi_controlled_u1::do_apply(::bra::state& state) const
     { return state.adj_multi_controlled_u1(phase_, target_qubit_, control_qubits_); }
 
+    std::vector<adj_multi_controlled_u1::qubit_type> adj_multi_controlled_u1::do_operated_qubits() const
+    { return ::bra::unitary_matrix::operated_qubits({target_qubit_}, control_qubits_); }
+
+    std::vector<adj_multi_controlled_u1::complex_type> adj_multi_controlled_u1::do_unitary_matrix() const
+    {
+      return ::bra::unitary_matrix::adjoint(
+        ::bra::unitary_matrix::controlled(::bra::unitary_matrix::u1(phase_), control_qubits_.size()));
+    }
+
     std::string const& adj_multi_controlled_u1::do_name() const { return name_; }
     std::string adj_multi_controlled_u1::do_representation(
       std::ostringstream& repr_stream, int const parameter_width) const
@@ -11,6 +11,7 @@
 #include <bra/gate/gate.hpp>
 #include <bra/gate/adj_multi_controlled_u3.hpp>
 #include <bra/state.hpp>
+#include <bra/unitary_matrix.hpp>
 
 
 namespace bra
@@ -29,6 +30,16 @@ namespace bra
     ::bra::state& adj_multi_controlled_u3::do_apply(::bra::state& state) const
     { return state.adj_multi_controlled_u3(phase1_, phase2_, phase3_, target_qubit_, control_qubits_); }
 
+    std::vector<adj_multi_controlled_u3::qubit_type> adj_multi_controlled_u3::do_operated_qubits() const
+    { return ::bra::unitary_matrix::operated_qubits({target_qubit_}, control_qubits_); }
+
+    std::vector<adj_multi_controlled_u3::complex_type> adj_multi_controlled_u3::do_unitary_matrix() const
+    {
+      return ::bra::unitary_matrix::adjoint(
+        ::bra::unitary_matrix::controlled(
+          ::bra::unitary_matrix::u3(phase1_, phase2_, phase3_), control_qubits_.size()));
+    }
+
     std::string const& adj_multi_controlled_u3::do_name() const { return name_; }
     std::string adj_multi_controlled_u3::do_representation(
       std::ostringstream& repr_stream, int const parameter_width) const
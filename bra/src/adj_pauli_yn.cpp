@@ -10,6 +10,7 @@
 #include <bra/gate/gate.hpp>
 #include <bra/gate/adj_pauli_yn.hpp>
 #include <bra/state.hpp>
+#include <bra/unitary_matrix.hpp>
 
 
 namespace bra
@@ -23,6 +24,15 @@ namespace bra
     ::bra::state& adj_pauli_yn::do_apply(::bra::state& state) const
     { return state.adj_pauli_yn(qubits_); }
 
+    std::vector<adj_pauli_yn::qubit_type> adj_pauli_yn::do_operated_qubits() const
+    { return qubits_; }
+
+    std::vector<adj_pauli_yn::complex_type> adj_pauli_yn::do_unitary_matrix() const
+    {
+      return ::bra::unitary_matrix::adjoint(
+        ::bra::unitary_matrix::tensor_power(::bra::unitary_matrix::pauli_y(), qubits_.size()));
+    }
+
     std::string const& adj_pauli_yn::do_name() const { return name_; }
     std::string adj_pauli_yn::do_representation(
       std::ostringstream& repr_stream, int const parameter_width) const
@@ -1,4 +1,5 @@
 #include <string>
+#include <vector>
 #include <ios>
 #include <iomanip>
 #include <sstream>
@@ -8,6 +9,7 @@
 #include <bra/gate/gate.hpp>
 #include <bra/gate/adj_pauli_yy.hpp>
 #include <bra/state.hpp>
+#include <bra/unitary_matrix.hpp>
 
 
 namespace bra
@@ -23,6 +25,15 @@ namespace bra
     ::bra::state& adj_pauli_yy::do_apply(::bra::state& state) const
     { return state.adj_pauli_yy(qubit1_, qubit2_); }
 
+    std::vector<adj_pauli_yy::qubit_type> adj_pauli_yy::do_operated_qubits() const
+    { return {qubit1_, qubit2_}; }
+
+    std::vector<adj_pauli_yy::complex_type> adj_pauli_yy::do_unitary_matrix() const
+    {
+      return ::bra::unitary_matrix::adjoint(
+        ::bra::unitary_matrix::tensor_power(::bra::unitary_matrix::pauli_y(), 2u));
+    }
+
     std::string const& adj_pauli_yy::do_name() const { return name_; }
     std::string adj_pauli_yy::do_representation(
       std::ostringstream& repr_stream, int const parameter_width) const
@@ -1,4 +1,5 @@
 #include <string>
+#include <vector>
 #include <ios>
 #include <iomanip>
 #include <sstream>
@@ -8,6 +9,7 @@
 #include <bra/gate/gate.hpp>
 #include <bra/gate/adj_pauli_z.hpp>
 #include <bra/state.hpp>
+#include <bra/unitary_matrix.hpp>
 
 
 namespace bra
@@ -23,6 +25,12 @@ namespace bra
     ::bra::state& adj_pauli_z::do_apply(::bra::state& state) const
     { return state.adj_pauli_z(qubit_); }
 
+    std::vector<adj_pauli_z::qubit_type> adj_pauli_z::do_operated_qubits() const
+    { return {qubit_}; }
+
+    std::vector<adj_pauli_z::complex_type> adj_pauli_z::do_unitary_matrix() const
+    { return ::bra::unitary_matrix::adjoint(::bra::unitary_matrix::pauli_z()); }
+
     std::string const& adj_pauli_z::do_name() const { return name_; }
     std::string adj_pauli_z::do_representation(
       std::ostringstream& repr_stream, int const parameter_width) const
@@ -1,4 +1,5 @@
 #include <string>
+#include <vector>
 #include <ios>
 #include <iomanip>
 #include <sstream>
@@ -8,6 +9,8 @@
 #include <bra/gate/gate.hpp>
 #include <bra/gate/adj_t_gate.hpp>
 #include <bra/state.hpp>
+#include <bra/instruction.hpp>
+#include <bra/unitary_matrix.hpp>
 
 
 namespace bra
@@ -24,6 +27,20 @@ namespace bra
     ::bra::state& adj_t_gate::do_apply(::bra::state& state) const
     { return state.adj_phase_shift(phase_coefficient_, qubit_); }
 
+    std::vector<adj_t_gate::qubit_type> adj_t_gate::do_operated_qubits() const
+    { return {qubit_}; }
+
+    std::vector<adj_t_gate::complex_type> adj_t_gate::do_unitary_matrix() const
+    { return ::bra::unitary_matrix::adjoint(::bra::unitary_matrix::phase_shift(phase_coefficient_)); }
+
+    bool adj_t_gate::do_instruction(::bra::instruction& result) const
+    {
+      result.opcode = ::bra::opcode::adj_phase_shift;
+      result.phase_coefficient = phase_coefficient_;
+      result.qubit1 = qubit_;
+      return true;
+    }
+
     std::string const& adj_t_gate::do_name() const { return name_; }
     std::string adj_t_gate::do_representation(
       std::ostringstream& repr_stream, int const parameter_width) const
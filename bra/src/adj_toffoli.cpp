@@ -1,4 +1,5 @@
 #include <string>
+#include <vector>
 #include <ios>
 #include <iomanip>
 #include <sstream>
@@ -9,6 +10,7 @@
 #include <bra/gate/gate.hpp>
 #include <bra/gate/adj_toffoli.hpp>
 #include <bra/state.hpp>
+#include <bra/unitary_matrix.hpp>
 
 
 namespace bra
@@ -26,6 +28,15 @@ namespace bra
     ::bra::state& adj_toffoli::do_apply(::bra::state& state) const
     { return state.adj_toffoli(target_qubit_, control_qubit1_, control_qubit2_); }
 
+    std::vector<adj_toffoli::qubit_type> adj_toffoli::do_operated_qubits() const
+    { return {target_qubit_, control_qubit1_.qubit(), control_qubit2_.qubit()}; }
+
+    std::vector<adj_toffoli::complex_type> adj_toffoli::do_unitary_matrix() const
+    {
+      return ::bra::unitary_matrix::adjoint(
+        ::bra::unitary_matrix::controlled(::bra::unitary_matrix::pauli_x(), 2u));
+    }
+
     std::string const& adj_toffoli::do_name() const { return name_; }
     std::string adj_toffoli::do_representation(
       std::ostringstream& repr_stream, int const parameter_width) const
@@ -1,4 +1,5 @@
 #include <string>
+#include <vector>
 #include <ios>
 #include <iomanip>
 #include <sstream>
@@ -8,6 +9,8 @@
 #include <bra/gate/gate.hpp>
 #include <bra/gate/adj_u1.hpp>
 #include <bra/state.hpp>
+#include <bra/instruction.hpp>
+#include <bra/unitary_matrix.hpp>
 
 
 namespace bra
@@ -24,6 +27,20 @@ namespace bra
     ::bra::state& adj_u1::do_apply(::bra::state& state) const
     { return state.adj_u1(phase_, qubit_); }
 
+    std::vector<adj_u1::qubit_type> adj_u1::do_operated_qubits() const
+    { return {qubit_}; }
+
+    std::vector<adj_u1::complex_type> adj_u1::do_unitary_matrix() const
+    { return ::bra::unitary_matrix::adjoint(::bra::unitary_matrix::u1(phase_)); }
+
+    bool adj_u1::do_instruction(::bra::instruction& result) const
+    {
+      result.opcode = ::bra::opcode::adj_u1;
+      result.phase = phase_;
+      result.qubit1 = qubit_;
+      return true;
+    }
+
     std::string const& adj_u1::do_name() const { return name_; }
     std::string adj_u1::do_representation(
       std::ostringstream& repr_stream, int const parameter_width) const
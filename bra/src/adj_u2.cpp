@@ -1,4 +1,5 @@
 #include <string>
+#include <vector>
 #include <ios>
 #include <iomanip>
 #include <sstream>
@@ -8,6 +9,7 @@
 #include <bra/gate/gate.hpp>
 #include <bra/gate/adj_u2.hpp>
 #include <bra/state.hpp>
+#include <bra/unitary_matrix.hpp>
 
 
 namespace bra
@@ -24,6 +26,12 @@ namespace bra
     ::bra::state& adj_u2::do_apply(::bra::state& state) const
     { return state.adj_u2(phase1_, phase2_, qubit_); }
 
+    std::vector<adj_u2::qubit_type> adj_u2::do_operated_qubits() const
+    { return {qubit_}; }
+
+    std::vector<adj_u2::complex_type> adj_u2::do_unitary_matrix() const
+    { return ::bra::unitary_matrix::adjoint(::bra::unitary_matrix::u2(phase1_, phase2_)); }
+
     std::string const& adj_u2::do_name() const { return name_; }
     std::string adj_u2::do_representation(
       std::ostringstream& repr_stream, int const parameter_width) const
@@ -1,4 +1,5 @@
 #include <string>
+#include <vector>
 #include <ios>
 #include <iomanip>
 #include <sstream>
@@ -8,6 +9,8 @@
 #include <bra/gate/gate.hpp>
 #include <bra/gate/adj_y_rotation_half_pi.hpp>
 #include <bra/state.hpp>
+#include <bra/instruction.hpp>
+#include <bra/unitary_matrix.hpp>
 
 
 namespace bra
@@ -23,6 +26,19 @@ namespace bra
     ::bra::state& adj_y_rotation_half_pi::do_apply(::bra::state& state) const
     { return state.adj_y_rotation_half_pi(qubit_); }
 
+    std::vector<adj_y_rotation_half_pi::qubit_type> adj_y_rotation_half_pi::do_operated_qubits() const
+    { return {qubit_}; }
+
+    std::vector<adj_y_rotation_half_pi::complex_type> adj_y_rotation_half_pi::do_unitary_matrix() const
+    { return ::bra::unitary_matrix::adjoint(::bra::unitary_matrix::y_rotation_half_pi()); }
+
+    bool adj_y_rotation_half_pi::do_instruction(::bra::instruction& result) const
+    {
+      result.opcode = ::bra::opcode::adj_y_rotation_half_pi;
+      result.qubit1 = qubit_;
+      return true;
+    }
+
     std::string const& adj_y_rotation_half_pi::do_name() const { return name_; }
     std::string adj_y_rotation_half_pi::do_representation(
       std::ostringstream& repr_stream, int const parameter_width) const
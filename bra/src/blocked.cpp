@@ -0,0 +1,53 @@
+#include <cstddef>
+#include <ios>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <iterator>
+#include <algorithm>
+#include <utility>
+
+#include <bra/gate/gate.hpp>
+#include <bra/gate/blocked.hpp>
+#include <bra/state.hpp>
+
+
+namespace bra
+{
+  namespace gate
+  {
+    std::string const blocked::name_ = "BLOCKED";
+
+    blocked::blocked(
+      std::vector<std::vector<complex_type>>&& matrices, std::vector<std::vector<qubit_type>>&& qubits,
+      bit_integer_type const num_block_qubits)
+      : ::bra::gate::gate{},
+        matrices_{std::move(matrices)}, qubits_{std::move(qubits)}, num_block_qubits_{num_block_qubits}
+    { }
+
+    ::bra::state& blocked::do_apply(::bra::state& state) const
+    { return state.blocked_matrices(matrices_, qubits_, num_block_qubits_); }
+
+    // union of qubits of the blocked gates, which is used by lookahead of MPI states.
+    // No unitary matrix is given for them because it would be too large
+    std::vector<blocked::qubit_type> blocked::do_operated_qubits() const
+    {
+      auto result = std::vector<qubit_type>{};
+      for (auto const& gate_qubits: qubits_)
+        for (auto const qubit: gate_qubits)
+          if (std::find(std::begin(result), std::end(result), qubit) == std::end(result))
+            result.push_back(qubit);
+      return result;
+    }
+
+    std::string const& blocked::do_name() const { return name_; }
+    std::string blocked::do_representation(
+      std::ostringstream& repr_stream, int const parameter_width) const
+    {
+      repr_stream << std::right << std::setw(parameter_width) << num_block_qubits_;
+      repr_stream << " (" << matrices_.size() << " gates)";
+      return repr_stream.str();
+    }
+  } // namespace gate
+} // namespace bra
@@ -1,9 +1,12 @@
 #include <cstddef>
 #include <cstdlib>
+#include <cstdint>
 #include <iostream>
 #include <fstream>
 #include <string>
+#include <vector>
 #include <utility>
+#include <memory>
 #include <random>
 #include <chrono>
 
@@ -18,18 +21,32 @@
 # include <yampi/communicator.hpp>
 # include <yampi/rank.hpp>
 # include <yampi/wall_clock.hpp>
+# include <yampi/buffer.hpp>
+# include <yampi/broadcast.hpp>
+# include <yampi/reduce.hpp>
+# include <yampi/binary_operation.hpp>
 #endif
 
 #include <ket/utility/integer_exp2.hpp>
 #include <ket/utility/integer_log2.hpp>
+#ifndef BRA_NO_MPI
+# include <ket/mpi/utility/topology.hpp>
+# include <ket/mpi/utility/detail/interchange_transport.hpp>
+# ifdef KET_USE_SHARED_MEMORY_INTERCHANGE
+#   include <ket/mpi/utility/shared_memory.hpp>
+# endif // KET_USE_SHARED_MEMORY_INTERCHANGE
+#endif
 
 #include <bra/gates.hpp>
 #include <bra/state.hpp>
+#include <bra/compiled_circuit.hpp>
 #ifndef BRA_NO_MPI
 # include <bra/make_simple_mpi_state.hpp>
 # include <bra/make_unit_mpi_state.hpp>
 #else
 # include <bra/nompi_state.hpp>
+# include <bra/gate_stream.hpp>
+# include <bra/parameter_table.hpp>
 #endif
 
 #ifndef BRA_NO_MPI
@@ -58,12 +75,142 @@ std::string integer_to_bits_string(StateInteger const integer, BitInteger const
   return result;
 }
 
+// files written by --compile option are distinguished by their extension
+bool is_compiled_circuit_file(std::string const& filename)
+{
+  auto const extension = std::string{".qcxb"};
+  return filename.size() >= extension.size()
+    and filename.compare(filename.size() - extension.size(), extension.size(), extension) == 0;
+}
+
+// Reports that filename is not a valid compiled circuit, and terminates the process
+[[noreturn]] void exit_with_invalid_compiled_circuit(
+  std::string const& filename, bra::compiled_circuit_error const& error, bool const is_io_root_rank)
+{
+  if (is_io_root_rank)
+    std::cerr << "ERROR: " << filename << " is not a valid compiled circuit: " << error.what() << std::endl;
+  std::exit(EXIT_FAILURE);
+}
+
 template <typename Clock, typename Duration>
 double duration_to_second(
   std::chrono::time_point<Clock, Duration> const& from,
   std::chrono::time_point<Clock, Duration> const& to)
 { return 0.000001 * std::chrono::duration_cast<std::chrono::microseconds>(to - from).count(); }
 
+#ifdef BRA_NO_MPI
+// Applies the circuit given by instructions for each row of parameters, and prints a CSV line of the parameters and the results for each row.
+// The gates and the state are reused by all rows, and the state is reset in place instead of being reallocated
+void sweep_parameters(
+  std::vector<bra::gates::columns_type> const& instructions, bra::parameter_table const& parameters,
+  bool const is_optimized, unsigned int const num_diagonal_qubits, unsigned int const num_fused_qubits, unsigned int const num_block_qubits,
+  unsigned int const num_threads, bra::state::seed_type const seed)
+{
+  auto gates = bra::gates{};
+  auto state_ptr = std::unique_ptr<bra::state>{};
+  auto line = std::string{};
+
+  for (auto row_index = std::size_t{0u}; row_index < parameters.size(); ++row_index)
+  {
+    gates.assign(instructions, parameters, row_index);
+    if (is_optimized)
+      gates.optimize();
+    gates.batch_diagonal(num_diagonal_qubits);
+    gates.fuse(num_fused_qubits);
+    gates.block(num_block_qubits);
+    gates.pack();
+
+    if (not state_ptr)
+      state_ptr = bra::make_nompi_state(gates.initial_state_value(), gates.num_qubits(), num_threads, seed);
+    else if (gates.num_qubits() != state_ptr->total_num_qubits())
+      throw bra::parameter_table_error{"the number of qubits depends on parameters"};
+    else
+      state_ptr->reset(gates.initial_state_value(), seed);
+
+    auto const start_time = BRA_clock::now();
+    *state_ptr << gates;
+    auto const finish_time = BRA_clock::now();
+
+    // the header line is written after the first row because its columns depend on the results
+    if (row_index == 0u)
+    {
+      line.clear();
+      for (auto const& name: parameters.names())
+      {
+        line += name;
+        line += ',';
+      }
+
+      auto const num_finish_processes = state_ptr->num_finish_processes();
+      for (auto index = decltype(num_finish_processes){0u}; index < num_finish_processes; ++index)
+      {
+        auto const finished_process = state_ptr->finish_time_and_process(index).second;
+        if (finished_process == bra::finished_process::begin_measurement)
+        {
+          for (auto qubit = bra::state::bit_integer_type{0u}; qubit < state_ptr->total_num_qubits(); ++qubit)
+            line += fmt::format("<Qx{0}>,<Qy{0}>,<Qz{0}>,", qubit);
+        }
+        else if (finished_process == bra::finished_process::ket_measure)
+        {
+          line += "measured,";
+          break;
+        }
+        else if (finished_process == bra::finished_process::generate_events)
+        {
+          line += "events,";
+          break;
+        }
+      }
+
+      line += "time\n";
+      std::cout << line;
+    }
+
+    line.clear();
+    for (auto const& value: parameters.row(row_index))
+    {
+      line += value;
+      line += ',';
+    }
+
+    auto const num_finish_processes = state_ptr->num_finish_processes();
+    for (auto index = decltype(num_finish_processes){0u}; index < num_finish_processes; ++index)
+    {
+      auto const finished_process = state_ptr->finish_time_and_process(index).second;
+      if (finished_process == bra::finished_process::begin_measurement)
+      {
+        for (auto const& spin: *(state_ptr->maybe_expectation_values()))
+          line += fmt::format(
+            "{},{},{},",
+            0.5 - static_cast<double>(spin[0u]), 0.5 - static_cast<double>(spin[1u]), 0.5 - static_cast<double>(spin[2u]));
+      }
+      else if (finished_process == bra::finished_process::ket_measure)
+      {
+        line += std::to_string(state_ptr->measured_value());
+        line += ',';
+        break;
+      }
+      else if (finished_process == bra::finished_process::generate_events)
+      {
+        // events are separated by spaces in one column
+        auto const num_events = state_ptr->generated_events().size();
+        for (auto index = decltype(num_events){0u}; index < num_events; ++index)
+        {
+          if (index > 0u)
+            line += ' ';
+          line += integer_to_bits_string(state_ptr->generated_events()[index], state_ptr->total_num_qubits());
+        }
+        line += ',';
+        break;
+      }
+    }
+
+    line += fmt::format("{}\n", duration_to_second(start_time, finish_time));
+    std::cout << line << std::flush;
+  }
+}
+#endif // BRA_NO_MPI
+
 int main(int argc, char* argv[])
 {
   std::ios::sync_with_stdio(false);
@@ -73,8 +220,12 @@ int main(int argc, char* argv[])
 
 #ifndef BRA_NO_MPI
   yampi::environment environment{argc, argv, yampi::thread_support::funneled};
-  auto communicator = yampi::communicator{yampi::tags::world_communicator};
-  auto const rank = communicator.rank(environment);
+# ifdef KET_USE_SHARED_MEMORY_INTERCHANGE
+  // the node communicator created by the state constructors is freed after the state is destroyed and before MPI_Finalize
+  auto const node_communicator_guard = ket::mpi::utility::node_communicator_guard{};
+# endif // KET_USE_SHARED_MEMORY_INTERCHANGE
+  auto const world_communicator = yampi::communicator{yampi::tags::world_communicator};
+  auto const rank = world_communicator.rank(environment);
   constexpr auto root_rank = yampi::rank{0};
   auto const is_io_root_rank = rank == root_rank and yampi::is_io_process(root_rank, environment);
 
@@ -90,7 +241,9 @@ int main(int argc, char* argv[])
   auto options = cxxopts::Options{"bra", "Massively parallel full-state simulator of quantum circuits"};
   options.add_options()
     ("m,mode", "set mode, \"simple\" or \"unit\"", cxxopts::value<std::string>()->default_value("simple"))
-    ("f,file", "set the name of input qcx file, or read from standard input if this option is unspecified", cxxopts::value<std::string>())
+    ("f,file", "set the name of input qcx file or qcxb file written by compile option, or read qcx from standard input if this option is unspecified", cxxopts::value<std::string>())
+    ("compile", "write the circuit in the given qcx file into the qcxb file given by output option, and exit", cxxopts::value<std::string>())
+    ("o,output", "set the name of qcxb file written by compile option", cxxopts::value<std::string>())
 #ifdef BRAKET_ENABLE_MULTIPLE_USES_OF_BUFFER_FOR_ONE_DATA_TRANSFER_IF_NO_PAGE_EXISTS
     ("buffer-size", "set the number of complex numbers in buffer (meaningful only if the value of page-qubits is 0)", cxxopts::value<unsigned int>()->default_value("65536"))
 #endif // BRAKET_ENABLE_MULTIPLE_USES_OF_BUFFER_FOR_ONE_DATA_TRANSFER_IF_NO_PAGE_EXISTS
@@ -98,15 +251,38 @@ int main(int argc, char* argv[])
     ("unit-processes", "set the number of MPI processes for each unit (meaningful only for unit mode)", cxxopts::value<unsigned int>())
     ("threads", "set the number of threads per process", cxxopts::value<unsigned int>()->default_value("1"))
     ("page-qubits", "set the number of page qubits", cxxopts::value<unsigned int>()->default_value("2"))
+    ("diagonal-qubits", "apply each run of consecutive diagonal gates in one sweep with tables of diagonal elements each operating on at most this number of qubits, or do not batch diagonal gates if the value is 0", cxxopts::value<unsigned int>()->default_value("0"))
+    ("fuse-qubits", "fuse consecutive gates operating on at most this number of qubits in total into one gate, or do not fuse gates if the value is 0", cxxopts::value<unsigned int>()->default_value("0"))
+    ("block-qubits", "apply each run of consecutive gates operating only on qubits lower than this number block by block, each of which has 2^(this number) elements, or do not block gates if the value is 0", cxxopts::value<unsigned int>()->default_value("0"))
     ("seed", "set seed of random number generator", cxxopts::value<seed_type>()->default_value("1"))
+    ("O,optimize", "remove pairs of gates canceling each other and identity gates, and merge rotations around the same axis before applying gates")
+    ("restart", "resume from a checkpoint file written by CHECKPOINT instruction, which requires the same circuit and the same optimize, diagonal-qubits, fuse-qubits and block-qubits", cxxopts::value<std::string>())
+    ("topology-aware", "renumber MPI processes so that processes on the same node have contiguous ranks, and map global qubits operated by more gates to lower bits of ranks unless BIT ASSIGNMENT is given or in unit mode")
+# ifdef KET_USE_INTERCHANGE_TRANSPORT
+    ("interchange-precision", "set the precision of amplitudes sent in interchanges of qubits, \"full\", \"single\" or \"bfloat16\"", cxxopts::value<std::string>()->default_value(
+      ket::mpi::utility::interchange_precision() == ket::mpi::utility::transport_precision::bfloat16
+        ? "bfloat16"
+        : ket::mpi::utility::interchange_precision() == ket::mpi::utility::transport_precision::single ? "single" : "full"))
+    ("interchange-compression", "send runs of zeros in interchanges of qubits as their lengths if it reduces the amount of data, \"true\" or \"false\"", cxxopts::value<bool>()->default_value(
+      ket::mpi::utility::is_interchange_compressed() ? "true" : "false"))
+# endif // KET_USE_INTERCHANGE_TRANSPORT
     ("h,help", "print this information")
     ;
 #else // BRA_NO_MPI
   auto options = cxxopts::Options{"bra", "Full-state simulator of quantum circuits (single-process ver.)"};
   options.add_options()
-    ("f,file", "set the name of input qcx file, or read from standard input if this option is unspecified", cxxopts::value<std::string>())
+    ("f,file", "set the name of input qcx file or qcxb file written by compile option, or read qcx from standard input if this option is unspecified", cxxopts::value<std::string>())
+    ("compile", "write the circuit in the given qcx file into the qcxb file given by output option, and exit", cxxopts::value<std::string>())
+    ("o,output", "set the name of qcxb file written by compile option", cxxopts::value<std::string>())
     ("threads", "set the number of threads", cxxopts::value<unsigned int>()->default_value("1"))
+    ("diagonal-qubits", "apply each run of consecutive diagonal gates in one sweep with tables of diagonal elements each operating on at most this number of qubits, or do not batch diagonal gates if the value is 0", cxxopts::value<unsigned int>()->default_value("0"))
+    ("fuse-qubits", "fuse consecutive gates operating on at most this number of qubits in total into one gate, or do not fuse gates if the value is 0", cxxopts::value<unsigned int>()->default_value("0"))
+    ("block-qubits", "apply each run of consecutive gates operating only on qubits lower than this number block by block, each of which has 2^(this number) elements, or do not block gates if the value is 0", cxxopts::value<unsigned int>()->default_value("0"))
     ("seed", "set seed of random number generator", cxxopts::value<seed_type>()->default_value("1"))
+    ("O,optimize", "remove pairs of gates canceling each other and identity gates, and merge rotations around the same axis before applying gates")
+    ("restart", "resume from a checkpoint file written by CHECKPOINT instruction, which requires the same circuit and the same optimize, diagonal-qubits, fuse-qubits and block-qubits", cxxopts::value<std::string>())
+    ("stream", "apply gates while the following instructions are read by another thread, which cannot be used with qcxb files, optimize, diagonal-qubits, fuse-qubits, block-qubits and restart options")
+    ("params", "run the circuit once for each row of the given CSV file, whose first line has names of parameters referred as $name in the circuit, and print a CSV line of results for each row", cxxopts::value<std::string>())
     ("h,help", "print this information")
     ;
 #endif // BRA_NO_MPI
@@ -124,6 +300,55 @@ int main(int argc, char* argv[])
     std::exit(EXIT_SUCCESS);
   }
 
+  if (parse_result.count("compile"))
+  {
+#ifndef BRA_NO_MPI
+    // only the root process writes the compiled circuit
+    if (rank != root_rank)
+      std::exit(EXIT_SUCCESS);
+#endif // BRA_NO_MPI
+
+    auto const input_filename = parse_result["compile"].as<std::string>();
+    if (not parse_result.count("output"))
+    {
+      std::cerr << "Error: output option is required by compile option\n" << options.help() << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+    auto const output_filename = parse_result["output"].as<std::string>();
+
+    auto qcx_stream = std::ifstream{input_filename};
+    if (not qcx_stream)
+    {
+      std::cerr << "ERROR: cannot open an input file " << input_filename << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+    auto qcxb_stream = std::ofstream{output_filename, std::ios::binary};
+    if (not qcxb_stream)
+    {
+      std::cerr << "ERROR: cannot open an output file " << output_filename << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+
+    try
+    {
+      bra::compile_circuit(qcx_stream, qcxb_stream);
+    }
+    catch (bra::compiled_circuit_error const& error)
+    {
+      std::cerr << "ERROR: cannot compile " << input_filename << ": " << error.what() << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // std::exit would not flush qcxb_stream, so it is closed explicitly to detect write errors
+    qcxb_stream.close();
+    if (qcxb_stream.fail())
+    {
+      std::cerr << "ERROR: cannot write an output file " << output_filename << std::endl;
+      return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+  }
+
 #ifndef BRA_NO_MPI
   auto const mpi_mode = parse_result["mode"].as<std::string>();
   auto const is_simple = mpi_mode == "simple";
@@ -147,6 +372,24 @@ int main(int argc, char* argv[])
   }
 #endif // BRAKET_ENABLE_MULTIPLE_USES_OF_BUFFER_FOR_ONE_DATA_TRANSFER_IF_NO_PAGE_EXISTS
 
+# ifdef KET_USE_INTERCHANGE_TRANSPORT
+  // each chunk records its precision and format, so processes need not agree on them
+  auto const interchange_precision = parse_result["interchange-precision"].as<std::string>();
+  if (interchange_precision == "full")
+    ket::mpi::utility::interchange_precision() = ket::mpi::utility::transport_precision::full;
+  else if (interchange_precision == "single")
+    ket::mpi::utility::interchange_precision() = ket::mpi::utility::transport_precision::single;
+  else if (interchange_precision == "bfloat16")
+    ket::mpi::utility::interchange_precision() = ket::mpi::utility::transport_precision::bfloat16;
+  else
+  {
+    if (is_io_root_rank)
+      std::cerr << "Error: wrong argument of interchange-precision\n" << options.help() << std::flush;
+    std::exit(EXIT_FAILURE);
+  }
+  ket::mpi::utility::is_interchange_compressed() = parse_result["interchange-compression"].as<bool>();
+# endif // KET_USE_INTERCHANGE_TRANSPORT
+
   auto num_unit_qubits = 0u;
   auto num_processes_per_unit = 1u;
 
@@ -168,33 +411,101 @@ int main(int argc, char* argv[])
       std::cerr << "Error: wrong argument\n" << options.help() << std::flush;
     std::exit(EXIT_FAILURE);
   }
+
+  // rank 0 is the same process in both communicators
+  auto const is_topology_aware = parse_result.count("topology-aware") > 0u;
+  auto const communicator
+    = is_topology_aware
+      ? ket::mpi::utility::make_node_major_communicator(world_communicator, environment)
+      : yampi::communicator{world_communicator, yampi::color{0}, rank.mpi_rank(), environment};
 #endif // BRA_NO_MPI
 
   auto const num_threads_per_process = parse_result["threads"].as<unsigned int>();
   auto const seed = parse_result["seed"].as<seed_type>();
+  auto const num_diagonal_qubits = parse_result["diagonal-qubits"].as<unsigned int>();
+  auto const num_fused_qubits = parse_result["fuse-qubits"].as<unsigned int>();
+  auto const num_block_qubits = parse_result["block-qubits"].as<unsigned int>();
 
   std::ifstream possible_input_stream;
+  // compiled circuit files are mapped into memory instead of being read by possible_input_stream
+  auto is_compiled = false;
+  auto maybe_mapped_file = std::unique_ptr<bra::mapped_file>{};
   if (parse_result.count("file"))
   {
     auto const filename = parse_result["file"].as<std::string>();
+    is_compiled = is_compiled_circuit_file(filename);
     if (not filename.empty())
     {
-      possible_input_stream.open(filename);
-      if (not possible_input_stream)
-      {
 #ifndef BRA_NO_MPI
+      // only the root process reads the input file, and bra::gates broadcasts the circuit
+      if (rank == root_rank)
+      {
+        if (is_compiled)
+        {
+          try
+          {
+            maybe_mapped_file.reset(new bra::mapped_file{filename});
+          }
+          catch (bra::compiled_circuit_error const& error)
+          { std::cerr << "ERROR: " << error.what() << std::endl; }
+        }
+        else
+          possible_input_stream.open(filename);
+      }
+      auto is_opened
+        = static_cast<int>(rank != root_rank or static_cast<bool>(maybe_mapped_file) or static_cast<bool>(possible_input_stream));
+      yampi::broadcast(yampi::make_buffer(is_opened), root_rank, communicator, environment);
+      if (not is_opened)
+      {
         if (is_io_root_rank)
           std::cerr << "ERROR: cannot open an input file " << filename << '\n' << options.help() << std::endl;
+        std::exit(EXIT_FAILURE);
+      }
 #else // BRA_NO_MPI
+      if (is_compiled)
+      {
+        try
+        {
+          maybe_mapped_file.reset(new bra::mapped_file{filename});
+        }
+        catch (bra::compiled_circuit_error const& error)
+        { std::cerr << "ERROR: " << error.what() << std::endl; }
+      }
+      else
+        possible_input_stream.open(filename);
+      if (not maybe_mapped_file and not possible_input_stream)
+      {
         std::cerr << "ERROR: cannot open an input file " << filename << '\n' << options.help() << std::endl;
-#endif // BRA_NO_MPI
         std::exit(EXIT_FAILURE);
       }
+#endif // BRA_NO_MPI
     }
   }
 
+  auto const circuit_first = maybe_mapped_file ? maybe_mapped_file->data() : nullptr;
+  auto const circuit_last = maybe_mapped_file ? maybe_mapped_file->data() + maybe_mapped_file->size() : nullptr;
 #ifndef BRA_NO_MPI
-  auto gates = bra::gates{parse_result.count("file") ? possible_input_stream : std::cin, num_unit_qubits, num_processes_per_unit, environment, root_rank, communicator};
+  // the whole compiled circuit is broadcast before being read, so every process throws the same error for an invalid file
+  auto gates
+    = [&]
+      {
+        try
+        {
+          return is_compiled
+            ? bra::gates{circuit_first, circuit_last, num_unit_qubits, num_processes_per_unit, environment, root_rank, communicator}
+            : bra::gates{parse_result.count("file") ? possible_input_stream : std::cin, num_unit_qubits, num_processes_per_unit, environment, root_rank, communicator};
+        }
+        catch (bra::compiled_circuit_error const& error)
+        { exit_with_invalid_compiled_circuit(parse_result["file"].as<std::string>(), error, is_io_root_rank); }
+      }();
+  if (parse_result.count("optimize"))
+  {
+    auto const num_removed_gates = gates.optimize();
+    if (is_io_root_rank)
+      std::clog << "Gates removed by optimization: " << num_removed_gates << std::endl;
+  }
+  if (is_topology_aware)
+    gates.order_global_qubits_by_use();
 # ifndef BRAKET_ENABLE_MULTIPLE_USES_OF_BUFFER_FOR_ONE_DATA_TRANSFER_IF_NO_PAGE_EXISTS
   auto state_ptr
     = is_unit
@@ -215,10 +526,107 @@ int main(int argc, char* argv[])
           num_threads_per_process, seed, num_elements_in_buffer, communicator, environment);
 # endif // BRAKET_ENABLE_MULTIPLE_USES_OF_BUFFER_FOR_ONE_DATA_TRANSFER_IF_NO_PAGE_EXISTS
 #else // BRA_NO_MPI
-  auto gates = bra::gates{parse_result.count("file") ? possible_input_stream : std::cin};
+  auto const is_streamed = parse_result.count("stream") > 0u;
+  if (is_streamed
+      and (is_compiled or parse_result.count("optimize") or num_diagonal_qubits > 0u or num_fused_qubits > 0u or num_block_qubits > 0u or parse_result.count("restart")))
+  {
+    std::cerr << "Error: wrong combination of options\n" << options.help() << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+
+  if (parse_result.count("params"))
+  {
+    if (is_streamed or parse_result.count("restart"))
+    {
+      std::cerr << "Error: wrong combination of options\n" << options.help() << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+
+    auto const params_filename = parse_result["params"].as<std::string>();
+    auto params_stream = std::ifstream{params_filename};
+    if (not params_stream)
+    {
+      std::cerr << "ERROR: cannot open an input file " << params_filename << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+    auto const parameters = bra::parameter_table{params_stream};
+
+    // the circuit is split into columns only once, and its gates are interpreted again for each row
+    auto instructions = std::vector<bra::gates::columns_type>{};
+    auto columns = bra::gates::columns_type{};
+    if (is_compiled)
+    {
+      try
+      {
+        auto reader = bra::compiled_circuit_reader{circuit_first, circuit_last};
+        instructions.reserve(static_cast<std::size_t>(reader.num_instructions()));
+        while (reader.read_columns(columns))
+          instructions.push_back(columns);
+      }
+      catch (bra::compiled_circuit_error const& error)
+      { exit_with_invalid_compiled_circuit(parse_result["file"].as<std::string>(), error, true); }
+    }
+    else
+    {
+      auto line = std::string{};
+      auto& input_stream = parse_result.count("file") ? possible_input_stream : std::cin;
+      while (bra::gates::read_columns(input_stream, line, columns))
+        instructions.push_back(columns);
+    }
+
+    sweep_parameters(
+      instructions, parameters, parse_result.count("optimize") > 0u, num_diagonal_qubits, num_fused_qubits, num_block_qubits,
+      num_threads_per_process, seed);
+    return EXIT_SUCCESS;
+  }
+
+  // if stream option is specified, gates is empty and maybe_gate_stream reads instructions instead
+  auto maybe_gate_stream = std::unique_ptr<bra::gate_stream>{};
+  if (is_streamed)
+    maybe_gate_stream.reset(new bra::gate_stream{parse_result.count("file") ? possible_input_stream : std::cin});
+  auto gates
+    = [&]
+      {
+        try
+        {
+          return is_streamed
+            ? bra::gates{}
+            : is_compiled
+              ? bra::gates{circuit_first, circuit_last}
+              : bra::gates{parse_result.count("file") ? possible_input_stream : std::cin};
+        }
+        catch (bra::compiled_circuit_error const& error)
+        { exit_with_invalid_compiled_circuit(parse_result["file"].as<std::string>(), error, true); }
+      }();
+  if (parse_result.count("optimize"))
+    std::clog << "Gates removed by optimization: " << gates.optimize() << std::endl;
   auto state_ptr
-    = bra::make_nompi_state(gates.initial_state_value(), gates.num_qubits(), num_threads_per_process, seed);
+    = is_streamed
+      ? bra::make_nompi_state(maybe_gate_stream->initial_state_value(), maybe_gate_stream->num_qubits(), num_threads_per_process, seed)
+      : bra::make_nompi_state(gates.initial_state_value(), gates.num_qubits(), num_threads_per_process, seed);
+#endif // BRA_NO_MPI
+#ifndef BRA_NO_MPI
+  // MPI versions do not pack gates because gates without operated qubits are not taken into account by their lookahead
+  constexpr auto is_packed = false;
+#else // BRA_NO_MPI
+  constexpr auto is_packed = true;
 #endif // BRA_NO_MPI
+  // checkpoint files record the circuit and the options of the following transformations, which restart requires to be the same
+  state_ptr->circuit_hash(
+    gates.hash({
+      static_cast<std::uint64_t>(parse_result.count("optimize") > 0u), std::uint64_t{num_diagonal_qubits},
+      std::uint64_t{num_fused_qubits}, std::uint64_t{num_block_qubits}, static_cast<std::uint64_t>(is_packed)}));
+  gates.batch_diagonal(num_diagonal_qubits);
+  gates.fuse(num_fused_qubits);
+  gates.block(num_block_qubits);
+  if (is_packed)
+    gates.pack();
+
+  if (parse_result.count("restart"))
+  {
+    state_ptr->num_gates(gates.size());
+    state_ptr->restart(parse_result["restart"].as<std::string>());
+  }
 
 #ifndef BRA_NO_MPI
   auto const start_time = BRA_clock::now(environment);
@@ -227,9 +635,25 @@ int main(int argc, char* argv[])
 #endif
   auto last_processed_time = start_time;
 
+#ifndef BRA_NO_MPI
   *state_ptr << gates;
+#else // BRA_NO_MPI
+  if (maybe_gate_stream)
+    *state_ptr << *maybe_gate_stream;
+  else
+    *state_ptr << gates;
+#endif // BRA_NO_MPI
 
 #ifndef BRA_NO_MPI
+# ifdef KET_USE_INTERCHANGE_TRANSPORT
+  // squared norm of rounding errors of amplitudes sent in interchanges of qubits, summed over all processes
+  auto const local_interchange_error = static_cast<double>(ket::mpi::utility::interchange_error());
+  auto interchange_error = 0.0;
+  yampi::reduce(
+    yampi::make_buffer(local_interchange_error), std::addressof(interchange_error), yampi::binary_operation(yampi::plus_t()),
+    root_rank, communicator, environment);
+# endif // KET_USE_INTERCHANGE_TRANSPORT
+
   if (not is_io_root_rank)
     return EXIT_SUCCESS;
 #endif
@@ -284,10 +708,18 @@ int main(int argc, char* argv[])
     }
     else if (finish_time_and_process.second == ::bra::finished_process::generate_events)
     {
-      std::cout << "Events:\n";
+      // all events are written into one string, which is output at once
       auto const num_events = state_ptr->generated_events().size();
+      auto events_string = std::string{"Events:\n"};
+      events_string.reserve(events_string.size() + num_events * (state_ptr->total_num_qubits() + 12u));
       for (auto index = decltype(num_events){0u}; index < num_events; ++index)
-        std::cout << index << ' ' << integer_to_bits_string(state_ptr->generated_events()[index], state_ptr->total_num_qubits()) << '\n';
+      {
+        events_string += std::to_string(index);
+        events_string += ' ';
+        events_string += integer_to_bits_string(state_ptr->generated_events()[index], state_ptr->total_num_qubits());
+        events_string += '\n';
+      }
+      std::cout << events_string;
       std::cout
         << "Events finished: "
         << duration_to_second(start_time, finish_time_and_process.first)
@@ -298,6 +730,10 @@ int main(int argc, char* argv[])
       break;
     }
   }
+
+#if !defined(BRA_NO_MPI) && defined(KET_USE_INTERCHANGE_TRANSPORT)
+  std::cout << "Interchange error (squared norm): " << interchange_error << std::endl;
+#endif // !defined(BRA_NO_MPI) && defined(KET_USE_INTERCHANGE_TRANSPORT)
 }
 
 
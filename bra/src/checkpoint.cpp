@@ -0,0 +1,34 @@
+#include <string>
+#include <ios>
+#include <iomanip>
+#include <sstream>
+
+#include <bra/gate/gate.hpp>
+#include <bra/gate/checkpoint.hpp>
+#include <bra/state.hpp>
+
+
+namespace bra
+{
+  namespace gate
+  {
+    std::string const checkpoint::name_ = "CHECKPOINT";
+
+    checkpoint::checkpoint(std::string const& path)
+      : ::bra::gate::gate{}, path_{path}
+    { }
+
+    ::bra::state& checkpoint::do_apply(::bra::state& state) const
+    { return state.checkpoint(path_); }
+
+    std::string const& checkpoint::do_name() const { return name_; }
+    std::string checkpoint::do_representation(
+      std::ostringstream& repr_stream, int const parameter_width) const
+    {
+      repr_stream
+        << std::right
+        << std::setw(parameter_width) << path_;
+      return repr_stream.str();
+    }
+  } // namespace gate
+} // namespace bra
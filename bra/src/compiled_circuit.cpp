@@ -0,0 +1,179 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <memory>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <bra/compiled_circuit.hpp>
+#include <bra/gates.hpp>
+
+
+namespace bra
+{
+  namespace compiled_circuit_detail
+  {
+    constexpr char magic[4] = {'Q', 'C', 'X', 'B'};
+    constexpr std::uint32_t byte_order_mark = 1u;
+    constexpr std::size_t header_size = sizeof(magic) + 3u * sizeof(std::uint32_t) + sizeof(std::uint64_t);
+
+    template <typename Integer>
+    void write(std::ostream& output_stream, Integer const value)
+    { output_stream.write(reinterpret_cast<char const*>(std::addressof(value)), sizeof(Integer)); }
+
+    template <typename Integer>
+    Integer read(char const*& iter, char const* const last)
+    {
+      if (static_cast<std::size_t>(last - iter) < sizeof(Integer))
+        throw ::bra::compiled_circuit_error{"compiled circuit is truncated"};
+
+      auto result = Integer{};
+      std::memcpy(std::addressof(result), iter, sizeof(Integer));
+      iter += sizeof(Integer);
+      return result;
+    }
+  } // namespace compiled_circuit_detail
+
+  compiled_circuit_error::compiled_circuit_error(std::string const& message)
+    : std::runtime_error{message}
+  { }
+
+  void compile_circuit(std::istream& input_stream, std::ostream& output_stream)
+  {
+    // each distinct column, e.g. a mnemonic or a qubit, is stored once
+    auto strings = std::vector<std::string>{};
+    auto string_indices = std::unordered_map<std::string, std::uint32_t>{};
+    auto instructions = std::vector<std::uint32_t>{};
+    auto num_instructions = std::uint64_t{0u};
+
+    auto line = std::string{};
+    auto columns = ::bra::gates::columns_type{};
+    columns.reserve(10u);
+    while (::bra::gates::read_columns(input_stream, line, columns))
+    {
+      instructions.push_back(static_cast<std::uint32_t>(columns.size()));
+      for (auto const& column: columns)
+      {
+        auto const found = string_indices.emplace(column, static_cast<std::uint32_t>(strings.size()));
+        if (found.second)
+          strings.push_back(column);
+        instructions.push_back(found.first->second);
+      }
+      ++num_instructions;
+    }
+
+    using ::bra::compiled_circuit_detail::write;
+    output_stream.write(::bra::compiled_circuit_detail::magic, sizeof(::bra::compiled_circuit_detail::magic));
+    write(output_stream, ::bra::compiled_circuit_version);
+    write(output_stream, ::bra::compiled_circuit_detail::byte_order_mark);
+    write(output_stream, static_cast<std::uint32_t>(strings.size()));
+    write(output_stream, num_instructions);
+
+    for (auto const& string: strings)
+    {
+      write(output_stream, static_cast<std::uint32_t>(string.size()));
+      output_stream.write(string.data(), static_cast<std::streamsize>(string.size()));
+    }
+
+    output_stream.write(
+      reinterpret_cast<char const*>(instructions.data()),
+      static_cast<std::streamsize>(instructions.size() * sizeof(std::uint32_t)));
+  }
+
+  bool is_compiled_circuit(char const* const first, char const* const last)
+  {
+    return static_cast<std::size_t>(last - first) >= sizeof(::bra::compiled_circuit_detail::magic)
+      and std::memcmp(first, ::bra::compiled_circuit_detail::magic, sizeof(::bra::compiled_circuit_detail::magic)) == 0;
+  }
+
+  compiled_circuit_reader::compiled_circuit_reader(char const* const first, char const* const last)
+    : strings_{}, iter_{first}, last_{last}, num_instructions_{}, instruction_index_{0u}
+  {
+    if (not ::bra::is_compiled_circuit(first, last))
+      throw ::bra::compiled_circuit_error{"not a compiled circuit"};
+    iter_ += sizeof(::bra::compiled_circuit_detail::magic);
+
+    using ::bra::compiled_circuit_detail::read;
+    if (read<std::uint32_t>(iter_, last_) != ::bra::compiled_circuit_version)
+      throw ::bra::compiled_circuit_error{"unsupported version of compiled circuit"};
+    if (read<std::uint32_t>(iter_, last_) != ::bra::compiled_circuit_detail::byte_order_mark)
+      throw ::bra::compiled_circuit_error{"compiled circuit has a different byte order"};
+    auto const num_strings = read<std::uint32_t>(iter_, last_);
+    num_instructions_ = read<std::uint64_t>(iter_, last_);
+
+    strings_.reserve(num_strings);
+    for (auto index = std::uint32_t{0u}; index < num_strings; ++index)
+    {
+      auto const size = read<std::uint32_t>(iter_, last_);
+      if (static_cast<std::size_t>(last_ - iter_) < size)
+        throw ::bra::compiled_circuit_error{"compiled circuit is truncated"};
+      strings_.emplace_back(iter_, size);
+      iter_ += size;
+    }
+  }
+
+  bool compiled_circuit_reader::read_columns(std::vector<std::string>& columns)
+  {
+    if (instruction_index_ == num_instructions_)
+      return false;
+
+    using ::bra::compiled_circuit_detail::read;
+    auto const num_columns = read<std::uint32_t>(iter_, last_);
+    columns.resize(num_columns);
+    for (auto& column: columns)
+    {
+      auto const string_index = read<std::uint32_t>(iter_, last_);
+      if (string_index >= strings_.size())
+        throw ::bra::compiled_circuit_error{"wrong index of string in compiled circuit"};
+      column.assign(strings_[string_index].first, strings_[string_index].second);
+    }
+
+    ++instruction_index_;
+    return true;
+  }
+
+  mapped_file::mapped_file(std::string const& path)
+    : data_{nullptr}, size_{0u}
+  {
+    auto const file_descriptor = ::open(path.c_str(), O_RDONLY);
+    if (file_descriptor < 0)
+      throw ::bra::compiled_circuit_error{"cannot open " + path};
+
+    struct ::stat status;
+    if (::fstat(file_descriptor, std::addressof(status)) != 0)
+    {
+      ::close(file_descriptor);
+      throw ::bra::compiled_circuit_error{"cannot get the size of " + path};
+    }
+    size_ = static_cast<std::size_t>(status.st_size);
+
+    if (size_ > 0u)
+    {
+      auto const address = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+      if (address == MAP_FAILED)
+      {
+        ::close(file_descriptor);
+        throw ::bra::compiled_circuit_error{"cannot map " + path};
+      }
+      // instructions are read from the beginning to the end only once
+      ::madvise(address, size_, MADV_SEQUENTIAL);
+      data_ = static_cast<char const*>(address);
+    }
+    ::close(file_descriptor);
+  }
+
+  mapped_file::~mapped_file() noexcept
+  {
+    if (data_ != nullptr)
+      ::munmap(const_cast<char*>(data_), size_);
+  }
+} // namespace bra
@@ -1,4 +1,5 @@
 #include <string>
+#include <vector>
 #include <ios>
 #include <iomanip>
 #include <sstream>
@@ -9,6 +10,8 @@
 #include <bra/gate/gate.hpp>
 #include <bra/gate/controlled_not.hpp>
 #include <bra/state.hpp>
+#include <bra/instruction.hpp>
+#include <bra/unitary_matrix.hpp>
 
 
 namespace bra
@@ -26,6 +29,20 @@ namespace bra
     ::bra::state& controlled_not::do_apply(::bra::state& state) const
     { return state.controlled_not(target_qubit_, control_qubit_); }
 
+    std::vector<controlled_not::qubit_type> controlled_not::do_operated_qubits() const
+    { return {target_qubit_, control_qubit_.qubit()}; }
+
+    std::vector<controlled_not::complex_type> controlled_not::do_unitary_matrix() const
+    { return ::bra::unitary_matrix::controlled(::bra::unitary_matrix::pauli_x(), 1u); }
+
+    bool controlled_not::do_instruction(::bra::instruction& result) const
+    {
+      result.opcode = ::bra::opcode::controlled_not;
+      result.qubit1 = target_qubit_;
+      result.control_qubit = control_qubit_;
+      return true;
+    }
+
     std::string const& controlled_not::do_name() const { return name_; }
     std::string controlled_not::do_representation(
       std::ostringstream& repr_stream, int const parameter_width) const
@@ -1,4 +1,5 @@
 #include <string>
+#include <vector>
 #include <ios>
 #include <iomanip>
 #include <sstream>
@@ -9,6 +10,7 @@
 #include <bra/gate/gate.hpp>
 #include <bra/gate/controlled_pauli_y.hpp>
 #include <bra/state.hpp>
+#include <bra/unitary_matrix.hpp>
 
 
 namespace bra
@@ -26,6 +28,12 @@ namespace bra
     ::bra::state& controlled_pauli_y::do_apply(::bra::state& state) const
     { return state.controlled_pauli_y(target_qubit_, control_qubit_); }
 
+    std::vector<controlled_pauli_y::qubit_type> controlled_pauli_y::do_operated_qubits() const
+    { return {target_qubit_, control_qubit_.qubit()}; }
+
+    std::vector<controlled_pauli_y::complex_type> controlled_pauli_y::do_unitary_matrix() const
+    { return ::bra::unitary_matrix::controlled(::bra::unitary_matrix::pauli_y(), 1u); }
+
     std::string const& controlled_pauli_y::do_name() const { return name_; }
     std::string controlled_pauli_y::do_representation(
       std::ostringstream& repr_stream, int const parameter_width) const
@@ -1,4 +1,5 @@
 #include <string>
+#include <vector>
 #include <ios>
 #include <iomanip>
 #include <sstream>
@@ -9,6 +10,7 @@
 #include <bra/gate/gate.hpp>
 #include <bra/gate/controlled_u2.hpp>
 #include <bra/state.hpp>
+#include <bra/unitary_matrix.hpp>
 
 
 namespace bra
@@ -26,6 +28,12 @@ namespace bra
     ::bra::state& controlled_u2::do_apply(::bra::state& state) const
     { return state.controlled_u2(phase1_, phase2_, target_qubit_, control_qubit_); }
 
+    std::vector<controlled_u2::qubit_type> controlled_u2::do_operated_qubits() const
+    { return {target_qubit_, control_qubit_.qubit()}; }
+
+    std::vector<controlled_u2::complex_type> controlled_u2::do_unitary_matrix() const
+    { return ::bra::unitary_matrix::controlled(::bra::unitary_matrix::u2(phase1_, phase2_), 1u); }
+
     std::string const& controlled_u2::do_name() const { return name_; }
     std::string controlled_u2::do_representation(
       std::ostringstream& repr_stream, int const parameter_width) const
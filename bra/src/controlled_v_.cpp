@@ -1,4 +1,5 @@
 #include <string>
+#include <vector>
 #include <ios>
 #include <iomanip>
 #include <sstream>
@@ -9,6 +10,7 @@
 #include <bra/gate/gate.hpp>
 #include <bra/gate/controlled_v_.hpp>
 #include <bra/state.hpp>
+#include <bra/unitary_matrix.hpp>
 
 
 namespace bra
@@ -30,6 +32,12 @@ namespace bra
     ::bra::state& controlled_v_::do_apply(::bra::state& state) const
     { return state.controlled_v(phase_coefficient_, target_qubit_, control_qubit_); }
 
+    std::vector<controlled_v_::qubit_type> controlled_v_::do_operated_qubits() const
+    { return {target_qubit_, control_qubit_.qubit()}; }
+
+    std::vector<controlled_v_::complex_type> controlled_v_::do_unitary_matrix() const
+    { return ::bra::unitary_matrix::controlled(::bra::unitary_matrix::v(phase_coefficient_), 1u); }
+
     std::string const& controlled_v_::do_name() const { return name_; }
     std::string controlled_v_::do_representation(
       std::ostringstream& repr_stream, int const parameter_width) const
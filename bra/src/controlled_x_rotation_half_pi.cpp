@@ -1,4 +1,5 @@
 #include <string>
+#include <vector>
 #include <ios>
 #include <iomanip>
 #include <sstream>
@@ -9,6 +10,7 @@
 #include <bra/gate/gate.hpp>
 #include <bra/gate/controlled_x_rotation_half_pi.hpp>
 #include <bra/state.hpp>
+#include <bra/unitary_matrix.hpp>
 
 
 namespace bra
@@ -26,6 +28,12 @@ namespace bra
     ::bra::state& controlled_x_rotation_half_pi::do_apply(::bra::state& state) const
     { return state.controlled_x_rotation_half_pi(target_qubit_, control_qubit_); }
 
+    std::vector<controlled_x_rotation_half_pi::qubit_type> controlled_x_rotation_half_pi::do_operated_qubits() const
+    { return {target_qubit_, control_qubit_.qubit()}; }
+
+    std::vector<controlled_x_rotation_half_pi::complex_type> controlled_x_rotation_half_pi::do_unitary_matrix() const
+    { return ::bra::unitary_matrix::controlled(::bra::unitary_matrix::x_rotation_half_pi(), 1u); }
+
     std::string const& controlled_x_rotation_half_pi::do_name() const { return name_; }
     std::string controlled_x_rotation_half_pi::do_representation(
       std::ostringstream& repr_stream, int const parameter_width) const
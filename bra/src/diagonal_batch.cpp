@@ -0,0 +1,52 @@
+#include <cstddef>
+#include <ios>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <iterator>
+#include <algorithm>
+#include <utility>
+
+#include <bra/gate/gate.hpp>
+#include <bra/gate/diagonal_batch.hpp>
+#include <bra/state.hpp>
+
+
+namespace bra
+{
+  namespace gate
+  {
+    std::string const diagonal_batch::name_ = "DIAGONAL_BATCH";
+
+    diagonal_batch::diagonal_batch(
+      std::vector<std::vector<complex_type>>&& tables, std::vector<std::vector<qubit_type>>&& qubits,
+      std::size_t const num_batched_gates)
+      : ::bra::gate::gate{},
+        tables_{std::move(tables)}, qubits_{std::move(qubits)}, num_batched_gates_{num_batched_gates}
+    { }
+
+    ::bra::state& diagonal_batch::do_apply(::bra::state& state) const
+    { return state.diagonal_batch(tables_, qubits_); }
+
+    // union of qubits of the tables. No unitary matrix is given for them because it may be too large
+    std::vector<diagonal_batch::qubit_type> diagonal_batch::do_operated_qubits() const
+    {
+      auto result = std::vector<qubit_type>{};
+      for (auto const& table_qubits: qubits_)
+        for (auto const qubit: table_qubits)
+          if (std::find(std::begin(result), std::end(result), qubit) == std::end(result))
+            result.push_back(qubit);
+      return result;
+    }
+
+    std::string const& diagonal_batch::do_name() const { return name_; }
+    std::string diagonal_batch::do_representation(
+      std::ostringstream& repr_stream, int const parameter_width) const
+    {
+      repr_stream << std::right << std::setw(parameter_width) << tables_.size();
+      repr_stream << " (" << num_batched_gates_ << " gates)";
+      return repr_stream.str();
+    }
+  } // namespace gate
+} // namespace bra
@@ -10,6 +10,7 @@
 #include <bra/gate/gate.hpp>
 #include <bra/gate/exponential_pauli_xn.hpp>
 #include <bra/state.hpp>
+#include <bra/unitary_matrix.hpp>
 
 
 namespace bra
@@ -23,6 +24,15 @@ namespace bra
     ::bra::state& exponential_pauli_xn::do_apply(::bra::state& state) const
     { return state.exponential_pauli_xn(phase_, qubits_); }
 
+    std::vector<exponential_pauli_xn::qubit_type> exponential_pauli_xn::do_operated_qubits() const
+    { return qubits_; }
+
+    std::vector<exponential_pauli_xn::complex_type> exponential_pauli_xn::do_unitary_matrix() const
+    {
+      return ::bra::unitary_matrix::exponential(
+        phase_, ::bra::unitary_matrix::tensor_power(::bra::unitary_matrix::pauli_x(), qubits_.size()));
+    }
+
     std::string const& exponential_pauli_xn::do_name() const { return name_; }
     std::string exponential_pauli_xn::do_representation(
       std::ostringstream& repr_stream, int const parameter_width) const
@@ -1,4 +1,5 @@
 #include <string>
+#include <vector>
 #include <ios>
 #include <iomanip>
 #include <sstream>
@@ -8,6 +9,7 @@
 #include <bra/gate/gate.hpp>
 #include <bra/gate/exponential_pauli_xx.hpp>
 #include <bra/state.hpp>
+#include <bra/unitary_matrix.hpp>
 
 
 namespace bra
@@ -23,6 +25,15 @@ namespace bra
     ::bra::state& exponential_pauli_xx::do_apply(::bra::state& state) const
     { return state.exponential_pauli_xx(phase_, qubit1_, qubit2_); }
 
+    std::vector<exponential_pauli_xx::qubit_type> exponential_pauli_xx::do_operated_qubits() const
+    { return {qubit1_, qubit2_}; }
+
+    std::vector<exponential_pauli_xx::complex_type> exponential_pauli_xx::do_unitary_matrix() const
+    {
+      return ::bra::unitary_matrix::exponential(
+        phase_, ::bra::unitary_matrix::tensor_power(::bra::unitary_matrix::pauli_x(), 2u));
+    }
+
     std::string const& exponential_pauli_xx::do_name() const { return name_; }
     std::string exponential_pauli_xx::do_representation(
       std::ostringstream& repr_stream, int const parameter_width) const
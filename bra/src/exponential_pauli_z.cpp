@@ -1,4 +1,5 @@
 #include <string>
+#include <vector>
 #include <ios>
 #include <iomanip>
 #include <sstream>
@@ -8,6 +9,8 @@
 #include <bra/gate/gate.hpp>
 #include <bra/gate/exponential_pauli_z.hpp>
 #include <bra/state.hpp>
+#include <bra/instruction.hpp>
+#include <bra/unitary_matrix.hpp>
 
 
 namespace bra
@@ -23,6 +26,20 @@ namespace bra
     ::bra::state& exponential_pauli_z::do_apply(::bra::state& state) const
     { return state.exponential_pauli_z(phase_, qubit_); }
 
+    std::vector<exponential_pauli_z::qubit_type> exponential_pauli_z::do_operated_qubits() const
+    { return {qubit_}; }
+
+    std::vector<exponential_pauli_z::complex_type> exponential_pauli_z::do_unitary_matrix() const
+    { return ::bra::unitary_matrix::exponential(phase_, ::bra::unitary_matrix::pauli_z()); }
+
+    bool exponential_pauli_z::do_instruction(::bra::instruction& result) const
+    {
+      result.opcode = ::bra::opcode::exponential_pauli_z;
+      result.phase = phase_;
+      result.qubit1 = qubit_;
+      return true;
+    }
+
     std::string const& exponential_pauli_z::do_name() const { return name_; }
     std::string exponential_pauli_z::do_representation(
       std::ostringstream& repr_stream, int const parameter_width) const
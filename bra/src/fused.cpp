@@ -0,0 +1,48 @@
+#include <cstddef>
+#include <ios>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <utility>
+
+#include <ket/qubit_io.hpp>
+
+#include <bra/gate/gate.hpp>
+#include <bra/gate/fused.hpp>
+#include <bra/state.hpp>
+
+
+namespace bra
+{
+  namespace gate
+  {
+    std::string const fused::name_ = "FUSED";
+
+    fused::fused(
+      std::vector<qubit_type>&& qubits, std::vector<complex_type>&& matrix,
+      std::size_t const num_fused_gates)
+      : ::bra::gate::gate{},
+        qubits_{std::move(qubits)}, matrix_{std::move(matrix)}, num_fused_gates_{num_fused_gates}
+    { }
+
+    ::bra::state& fused::do_apply(::bra::state& state) const
+    { return state.matrix(matrix_, qubits_); }
+
+    std::vector<fused::qubit_type> fused::do_operated_qubits() const
+    { return qubits_; }
+
+    std::vector<fused::complex_type> fused::do_unitary_matrix() const
+    { return matrix_; }
+
+    std::string const& fused::do_name() const { return name_; }
+    std::string fused::do_representation(
+      std::ostringstream& repr_stream, int const parameter_width) const
+    {
+      for (auto&& qubit: qubits_)
+        repr_stream << std::right << std::setw(parameter_width) << qubit;
+      repr_stream << " (" << num_fused_gates_ << " gates)";
+      return repr_stream.str();
+    }
+  } // namespace gate
+} // namespace bra
@@ -1,9 +1,11 @@
 #include <string>
+#include <vector>
 #include <ios>
 #include <iomanip>
 #include <sstream>
 
 #include <bra/gate/gate.hpp>
+#include <bra/instruction.hpp>
 
 
 namespace bra
@@ -16,5 +18,9 @@ namespace bra
       repr_stream << std::left << std::setw(10) << this->name();
       return this->do_representation(repr_stream, 4);
     }
+
+    std::vector<gate::qubit_type> gate::do_operated_qubits() const { return {}; }
+    std::vector<gate::complex_type> gate::do_unitary_matrix() const { return {}; }
+    bool gate::do_instruction(::bra::instruction&) const { return false; }
   } // namespace gate
 } // namespace bra
@@ -0,0 +1,169 @@
+#ifdef BRA_NO_MPI
+# include <cstddef>
+# include <istream>
+# include <string>
+# include <memory>
+# include <atomic>
+# include <thread>
+# include <mutex>
+# include <condition_variable>
+# include <exception>
+# include <utility>
+
+# include <bra/gate_stream.hpp>
+# include <bra/gates.hpp>
+# include <bra/state.hpp>
+
+
+namespace bra
+{
+  gate_stream::gate_stream(std::istream& input_stream)
+    : gates_{}, queue_{BRA_GATE_STREAM_QUEUE_SIZE},
+      num_qubits_{}, initial_state_value_{}, exception_{}, is_header_valid_{false},
+      is_header_read_{false}, is_finished_{false}, is_cancelled_{false},
+      mutex_{}, condition_{}, num_waiting_threads_{0}, parser_{}
+  { parser_ = std::thread{[this, &input_stream] { parse(input_stream); }}; }
+
+  gate_stream::~gate_stream() noexcept
+  {
+    // parser_ stops after reading the current line if gates are not popped anymore, e.g. due to an exception
+    is_cancelled_.store(true, std::memory_order_relaxed);
+    notify();
+    if (parser_.joinable())
+      parser_.join();
+  }
+
+  template <typename Predicate>
+  void gate_stream::wait(Predicate predicate)
+  {
+    for (auto count = 0; count < BRA_GATE_STREAM_SPIN_COUNT; ++count)
+    {
+      if (predicate())
+        return;
+
+      std::this_thread::yield();
+    }
+
+    std::unique_lock<std::mutex> lock{mutex_};
+    num_waiting_threads_.fetch_add(1, std::memory_order_seq_cst);
+    // either predicate sees the change made by the other thread, or notify sees num_waiting_threads_ incremented
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    condition_.wait(lock, predicate);
+    num_waiting_threads_.fetch_sub(1, std::memory_order_relaxed);
+  }
+
+  void gate_stream::notify()
+  {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (num_waiting_threads_.load(std::memory_order_relaxed) == 0)
+      return;
+
+    // locking mutex_ ensures that the waiting thread is either before testing predicate or blocked in condition_.wait
+    { std::lock_guard<std::mutex> lock{mutex_}; }
+    condition_.notify_all();
+  }
+
+  gate_stream::bit_integer_type gate_stream::num_qubits()
+  {
+    wait_header();
+    return num_qubits_;
+  }
+
+  gate_stream::state_integer_type gate_stream::initial_state_value()
+  {
+    wait_header();
+    return initial_state_value_;
+  }
+
+  bool gate_stream::pop(gate_stream::value_type& gate)
+  {
+    auto is_popped = false;
+    wait([this, &gate, &is_popped] { return (is_popped = queue_.try_pop(gate)) or is_finished_.load(std::memory_order_acquire); });
+
+    // gates might be pushed between the failed try_pop and the load of is_finished_
+    if (is_popped or queue_.try_pop(gate))
+    {
+      notify();
+      return true;
+    }
+
+    if (exception_)
+      std::rethrow_exception(exception_);
+    return false;
+  }
+
+  void gate_stream::parse(std::istream& input_stream)
+  {
+    try
+    {
+      auto line = std::string{};
+      auto columns = ::bra::gates::columns_type{};
+      columns.reserve(10u);
+
+      auto is_continued = true;
+      while (is_continued and not is_cancelled_.load(std::memory_order_relaxed)
+             and ::bra::gates::read_columns(input_stream, line, columns))
+      {
+        is_continued = gates_.interpret(columns);
+        gates_.consume(
+          [this](value_type&& gate)
+          {
+            publish_header();
+            push(gate);
+          });
+      }
+    }
+    catch (...)
+    { exception_ = std::current_exception(); }
+
+    publish_header();
+    is_finished_.store(true, std::memory_order_release);
+    notify();
+  }
+
+  void gate_stream::push(gate_stream::value_type& gate)
+  {
+    auto is_pushed = false;
+    wait([this, &gate, &is_pushed] { return (is_pushed = queue_.try_push(gate)) or is_cancelled_.load(std::memory_order_relaxed); });
+    if (is_pushed)
+      notify();
+  }
+
+  // QUBITS and INITIAL STATE should appear before the first gate, and instructions after it do not change the state
+  void gate_stream::publish_header()
+  {
+    if (is_header_read_.load(std::memory_order_relaxed))
+      return;
+
+    num_qubits_ = gates_.num_qubits();
+    initial_state_value_ = gates_.initial_state_value();
+    // exception_ is not modified after this if it is set here
+    is_header_valid_ = not exception_;
+    is_header_read_.store(true, std::memory_order_release);
+    notify();
+  }
+
+  void gate_stream::wait_header()
+  {
+    wait([this] { return is_header_read_.load(std::memory_order_acquire); });
+
+    if (not is_header_valid_)
+      std::rethrow_exception(exception_);
+  }
+
+  ::bra::state& operator<<(::bra::state& state, ::bra::gate_stream& stream)
+  {
+    auto gate = ::bra::gate_stream::value_type{};
+    while (stream.pop(gate))
+    {
+      state.next_gate_index(state.next_gate_index() + 1u);
+      state << *gate;
+      gate.reset();
+    }
+
+    return state;
+  }
+} // namespace bra
+
+
+#endif // BRA_NO_MPI
@@ -1,4 +1,8 @@
+#include <cstddef>
+#include <cstdint>
 #include <istream>
+#include <sstream>
+#include <fstream>
 #include <string>
 #include <vector>
 #include <tuple>
@@ -26,6 +30,8 @@
 #ifndef BRA_NO_MPI
 # include <yampi/communicator.hpp>
 # include <yampi/environment.hpp>
+# include <yampi/buffer.hpp>
+# include <yampi/broadcast.hpp>
 #endif // BRA_NO_MPI
 
 #include <ket/qubit.hpp>
@@ -36,7 +42,11 @@
 
 #include <bra/gates.hpp>
 #include <bra/state.hpp>
+#include <bra/instruction.hpp>
+#include <bra/compiled_circuit.hpp>
+#include <bra/parameter_table.hpp>
 #include <bra/utility/to_integer.hpp>
+#include <bra/unitary_matrix.hpp>
 #include <bra/gate/gate.hpp>
 #include <bra/gate/hadamard.hpp>
 #include <bra/gate/not_.hpp>
@@ -78,6 +88,7 @@
 #include <bra/gate/exponential_pauli_zn.hpp>
 #include <bra/gate/exponential_swap.hpp>
 #include <bra/gate/toffoli.hpp>
+#include <bra/gate/matrix.hpp>
 #include <bra/gate/projective_measurement.hpp>
 #include <bra/gate/measurement.hpp>
 #include <bra/gate/generate_events.hpp>
@@ -85,6 +96,7 @@
 #include <bra/gate/clear.hpp>
 #include <bra/gate/set.hpp>
 #include <bra/gate/depolarizing_channel.hpp>
+#include <bra/gate/checkpoint.hpp>
 #include <bra/gate/exit.hpp>
 #include <bra/gate/controlled_hadamard.hpp>
 #include <bra/gate/multi_controlled_hadamard.hpp>
@@ -136,6 +148,10 @@
 #include <bra/gate/controlled_exponential_pauli_z.hpp>
 #include <bra/gate/multi_controlled_exponential_pauli_zn.hpp>
 #include <bra/gate/multi_controlled_exponential_swap.hpp>
+#include <bra/gate/fused.hpp>
+#include <bra/gate/blocked.hpp>
+#include <bra/gate/packed.hpp>
+#include <bra/gate/diagonal_batch.hpp>
 
 # if __cplusplus >= 201703L
 #   define BRA_is_nothrow_swappable std::is_nothrow_swappable
@@ -143,6 +159,11 @@
 #   define BRA_is_nothrow_swappable boost::is_nothrow_swappable
 # endif
 
+// Maximal number of preceding gates compared with each gate by bra::gates::optimize
+#ifndef BRA_MAX_NUM_OPTIMIZATION_LOOKBACK_GATES
+# define BRA_MAX_NUM_OPTIMIZATION_LOOKBACK_GATES 64
+#endif // BRA_MAX_NUM_OPTIMIZATION_LOOKBACK_GATES
+
 
 namespace bra
 {
@@ -177,12 +198,12 @@ namespace bra
 #ifndef BRA_NO_MPI
   gates::gates()
     : data_{}, num_qubits_{}, num_lqubits_{}, num_uqubits_{}, num_processes_per_unit_{1u},
-      initial_state_value_{}, initial_permutation_{}, phase_coefficients_{}, root_{}
+      initial_state_value_{}, initial_permutation_{}, is_initial_permutation_assigned_{false}, phase_coefficients_{}, root_{}
   { }
 
   gates::gates(gates::allocator_type const& allocator)
     : data_{allocator}, num_qubits_{}, num_lqubits_{}, num_uqubits_{}, num_processes_per_unit_{1u},
-      initial_state_value_{}, initial_permutation_{}, phase_coefficients_{}, root_{}
+      initial_state_value_{}, initial_permutation_{}, is_initial_permutation_assigned_{false}, phase_coefficients_{}, root_{}
   { }
 
   gates::gates(gates&& other, gates::allocator_type const& allocator)
@@ -193,6 +214,7 @@ namespace bra
         num_processes_per_unit_{std::move(other.num_processes_per_unit_)},
         initial_state_value_{std::move(other.initial_state_value_)},
         initial_permutation_{std::move(other.initial_permutation_)},
+        is_initial_permutation_assigned_{std::move(other.is_initial_permutation_assigned_)},
         phase_coefficients_{std::move(other.phase_coefficients_)},
         root_{std::move(other.root_)}
   { }
@@ -224,7 +246,7 @@ namespace bra
     size_type const num_reserved_gates)
     : data_{}, num_qubits_{}, num_lqubits_{},
       num_uqubits_{num_uqubits}, num_processes_per_unit_{num_processes_per_unit},
-      initial_state_value_{}, initial_permutation_{}, phase_coefficients_{}, root_{root}
+      initial_state_value_{}, initial_permutation_{}, is_initial_permutation_assigned_{false}, phase_coefficients_{}, root_{root}
   {
     assert(num_processes_per_unit >= 1u);
     assign(input_stream, environment, communicator, num_reserved_gates);
@@ -241,6 +263,27 @@ namespace bra
   { assign(input_stream, num_reserved_gates); }
 #endif // BRA_NO_MPI
 
+#ifndef BRA_NO_MPI
+  gates::gates(
+    char const* const first, char const* const last,
+    bit_integer_type num_uqubits, unsigned int num_processes_per_unit,
+    yampi::environment const& environment,
+    yampi::rank const root, yampi::communicator const& communicator,
+    size_type const num_reserved_gates)
+    : data_{}, num_qubits_{}, num_lqubits_{},
+      num_uqubits_{num_uqubits}, num_processes_per_unit_{num_processes_per_unit},
+      initial_state_value_{}, initial_permutation_{}, is_initial_permutation_assigned_{false}, phase_coefficients_{}, root_{root}
+  {
+    assert(num_processes_per_unit >= 1u);
+    assign(first, last, environment, communicator, num_reserved_gates);
+  }
+#else // BRA_NO_MPI
+  gates::gates(char const* const first, char const* const last, size_type const num_reserved_gates)
+    : data_{}, num_qubits_{},
+      initial_state_value_{}, phase_coefficients_{}
+  { assign(first, last, num_reserved_gates); }
+#endif // BRA_NO_MPI
+
   bool gates::operator==(gates const& other) const
   {
 #ifndef BRA_NO_MPI
@@ -251,6 +294,7 @@ namespace bra
       and num_processes_per_unit_ == other.num_processes_per_unit_
       and initial_state_value_ == other.initial_state_value_
       and initial_permutation_ == other.initial_permutation_
+      and is_initial_permutation_assigned_ == other.is_initial_permutation_assigned_
       and phase_coefficients_ == other.phase_coefficients_
       and root_ == other.root_;
 #else // BRA_NO_MPI
@@ -304,6 +348,7 @@ namespace bra
     initial_permutation_.reserve(num_qubits_);
     for (auto bit = bit_integer_type{0u}; bit < num_qubits_; ++bit)
       initial_permutation_.push_back(permutated_qubit_type{bit});
+    is_initial_permutation_assigned_ = false;
   }
 #else // BRA_NO_MPI
   void gates::set_num_qubits_params(bit_integer_type const new_num_qubits)
@@ -317,9 +362,20 @@ namespace bra
   void gates::assign(
     std::istream& input_stream, yampi::environment const& environment,
     yampi::communicator const& communicator, size_type const num_reserved_gates)
+  {
+    // Only the root process reads and compiles input_stream, and the other processes only decode the broadcast compiled circuit
+    auto circuit = std::string{};
+    if (communicator.rank(environment) == root_)
+    {
+      auto compiled_stream = std::ostringstream{};
+      ::bra::compile_circuit(input_stream, compiled_stream);
+      circuit = compiled_stream.str();
+    }
+
+    assign(circuit.data(), circuit.data() + circuit.size(), environment, communicator, num_reserved_gates);
+  }
 #else // BRA_NO_MPI
   void gates::assign(std::istream& input_stream, size_type const num_reserved_gates)
-#endif // BRA_NO_MPI
   {
     data_.clear();
     data_.reserve(num_reserved_gates);
@@ -328,6 +384,77 @@ namespace bra
     auto columns = columns_type{};
     columns.reserve(10u);
 
+    while (read_columns(input_stream, line, columns))
+      if (not interpret(columns))
+        break;
+  }
+#endif // BRA_NO_MPI
+
+#ifndef BRA_NO_MPI
+  void gates::assign(
+    char const* const first, char const* const last, yampi::environment const& environment,
+    yampi::communicator const& communicator, size_type const num_reserved_gates)
+#else // BRA_NO_MPI
+  void gates::assign(char const* const first, char const* const last, size_type const num_reserved_gates)
+#endif // BRA_NO_MPI
+  {
+    data_.clear();
+
+#ifndef BRA_NO_MPI
+    // Only the root process reads [first, last), and the compiled circuit is broadcast to the other processes
+    auto const is_root = communicator.rank(environment) == root_;
+    auto circuit_size = is_root ? static_cast<unsigned long>(last - first) : 0ul;
+    yampi::broadcast(yampi::make_buffer(circuit_size), root_, communicator, environment);
+
+    auto received_circuit = std::vector<char>(is_root ? std::size_t{0u} : static_cast<std::size_t>(circuit_size));
+    // the root process only sends [first, last), which is not modified
+    auto const circuit_first = is_root ? const_cast<char*>(first) : received_circuit.data();
+    if (circuit_size > 0u)
+      yampi::broadcast(yampi::make_buffer(circuit_first, circuit_first + circuit_size), root_, communicator, environment);
+
+    auto reader = ::bra::compiled_circuit_reader{circuit_first, circuit_first + circuit_size};
+#else // BRA_NO_MPI
+    auto reader = ::bra::compiled_circuit_reader{first, last};
+#endif // BRA_NO_MPI
+    data_.reserve(std::max(num_reserved_gates, static_cast<size_type>(reader.num_instructions())));
+
+    auto columns = columns_type{};
+    columns.reserve(10u);
+
+#ifndef BRA_NO_MPI
+    while (reader.read_columns(columns))
+      if (not interpret(columns, environment, communicator))
+        break;
+#else // BRA_NO_MPI
+    while (reader.read_columns(columns))
+      if (not interpret(columns))
+        break;
+#endif // BRA_NO_MPI
+  }
+
+#ifdef BRA_NO_MPI
+  void gates::assign(
+    std::vector<columns_type> const& instructions, ::bra::parameter_table const& parameters, std::size_t const row_index,
+    size_type const num_reserved_gates)
+  {
+    data_.clear();
+    data_.reserve(std::max(num_reserved_gates, static_cast<size_type>(instructions.size())));
+
+    auto columns = columns_type{};
+    columns.reserve(10u);
+
+    for (auto const& instruction: instructions)
+    {
+      columns = instruction;
+      parameters.substitute(columns, row_index);
+      if (not interpret(columns))
+        break;
+    }
+  }
+
+#endif // BRA_NO_MPI
+  bool gates::read_columns(std::istream& input_stream, std::string& line, columns_type& columns)
+  {
     while (std::getline(input_stream, line))
     {
       if (line.empty())
@@ -346,274 +473,299 @@ namespace bra
         continue;
 
       boost::algorithm::to_upper(columns.front());
-      auto const& mnemonic = columns.front();
-      if (mnemonic == "QUBITS")
-      {
+      return true;
+    }
+
+    return false;
+  }
+
 #ifndef BRA_NO_MPI
-        num_qubits(
-          static_cast< ::bra::state::bit_integer_type >(read_num_qubits(columns)),
-          communicator, environment);
+  bool gates::interpret(
+    columns_type& columns, yampi::environment const& environment, yampi::communicator const& communicator)
 #else // BRA_NO_MPI
-        num_qubits(
-          static_cast< ::bra::state::bit_integer_type >(read_num_qubits(columns)));
+  bool gates::interpret(columns_type& columns)
 #endif // BRA_NO_MPI
-      }
-      else if (mnemonic == "INITIAL") // INITIAL STATE
-        initial_state_value_
-          = static_cast< ::bra::state::state_integer_type >(read_initial_state_value(columns));
-      else if (mnemonic == "MPIPROCESSES")
-      {
-        read_num_mpi_processes(columns);
-        // ignore this statement
-      }
-      else if (mnemonic == "MPISWAPBUFFER")
-      {
-        read_mpi_buffer_size(columns);
-        // ignore this statement
-      }
-      else if (mnemonic == "BIT") // BIT ASSIGNMENT
-      {
-        if (boost::size(columns) <= 1u)
-          throw wrong_mnemonics_error{columns};
-        boost::algorithm::to_upper(columns[1u]);
+  {
+    auto const& mnemonic = columns.front();
+    if (mnemonic == "QUBITS")
+    {
+#ifndef BRA_NO_MPI
+      num_qubits(
+        static_cast< ::bra::state::bit_integer_type >(read_num_qubits(columns)),
+        communicator, environment);
+#else // BRA_NO_MPI
+      num_qubits(
+        static_cast< ::bra::state::bit_integer_type >(read_num_qubits(columns)));
+#endif // BRA_NO_MPI
+    }
+    else if (mnemonic == "INITIAL") // INITIAL STATE
+      initial_state_value_
+        = static_cast< ::bra::state::state_integer_type >(read_initial_state_value(columns));
+    else if (mnemonic == "MPIPROCESSES")
+    {
+      read_num_mpi_processes(columns);
+      // ignore this statement
+    }
+    else if (mnemonic == "MPISWAPBUFFER")
+    {
+      read_mpi_buffer_size(columns);
+      // ignore this statement
+    }
+    else if (mnemonic == "BIT") // BIT ASSIGNMENT
+    {
+      if (boost::size(columns) <= 1u)
+        throw wrong_mnemonics_error{columns};
+      boost::algorithm::to_upper(columns[1u]);
 
-        auto const statement = read_bit_statement(columns);
+      auto const statement = read_bit_statement(columns);
 
-        if (statement == ::bra::bit_statement::assignment)
-        {
+      if (statement == ::bra::bit_statement::assignment)
+      {
 #ifndef BRA_NO_MPI
-          initial_permutation_ = read_initial_permutation(columns);
+        initial_permutation_ = read_initial_permutation(columns);
+        is_initial_permutation_assigned_ = true;
 #endif
-        }
       }
-      else if (mnemonic == "PERMUTATION")
-        throw unsupported_mnemonic_error{mnemonic};
-      else if (mnemonic == "RANDOM") // RANDOM PERMUTATION
-        throw unsupported_mnemonic_error{mnemonic};
-      else if (mnemonic == "I")
-        continue;
-      else if (mnemonic == "H")
-        add_h(columns);
-      else if (mnemonic == "NOT")
-        add_not(columns);
-      else if (mnemonic == "X")
-        add_x(columns);
-      else if (mnemonic == "XX")
-        add_xx(columns);
-      else if (mnemonic.size() >= 3u
-               and std::all_of(
-                     std::begin(mnemonic), std::end(mnemonic),
-                     [](char const character) { return character == 'X'; }))
-        add_xs(columns, mnemonic);
-      else if (mnemonic.size() >= 2u and mnemonic.front() == 'X')
-        add_xn(columns, mnemonic);
-      else if (mnemonic == "Y")
-        add_y(columns);
-      else if (mnemonic == "YY")
-        add_yy(columns);
-      else if (mnemonic.size() >= 3u
-               and std::all_of(
-                     std::begin(mnemonic), std::end(mnemonic),
-                     [](char const character) { return character == 'Y'; }))
-        add_ys(columns, mnemonic);
-      else if (mnemonic.size() >= 2u and mnemonic.front() == 'Y')
-        add_yn(columns, mnemonic);
-      else if (mnemonic == "Z")
-        add_z(columns);
-      else if (mnemonic == "ZZ")
-        add_zz(columns);
-      else if (mnemonic.size() >= 3u
-               and std::all_of(
-                     std::begin(mnemonic), std::end(mnemonic),
-                     [](char const character) { return character == 'Z'; }))
-        add_zs(columns, mnemonic);
-      else if (mnemonic.size() >= 2u and mnemonic.front() == 'Z')
-        add_zn(columns, mnemonic);
-      else if (mnemonic == "SWAP")
-        add_swap(columns);
-      else if (mnemonic == "S")
-        add_s(columns);
-      else if (mnemonic == "S+")
-        add_adj_s(columns);
-      else if (mnemonic == "T")
-        add_t(columns);
-      else if (mnemonic == "T+")
-        add_adj_t(columns);
-      else if (mnemonic == "U1")
-        add_u1(columns);
-      else if (mnemonic == "U2")
-        add_u2(columns);
-      else if (mnemonic == "U3")
-        add_u3(columns);
-      else if (mnemonic == "R" or mnemonic == "+R")
-        add_r(columns);
-      else if (mnemonic == "-R")
-        add_adj_r(columns);
-      else if (mnemonic == "+X")
-        add_rotx(columns);
-      else if (mnemonic == "-X")
-        add_adj_rotx(columns);
-      else if (mnemonic == "+Y")
-        add_roty(columns);
-      else if (mnemonic == "-Y")
-        add_adj_roty(columns);
-      else if (mnemonic == "U")
-        add_u(columns);
-      else if (mnemonic == "V")
-        add_v(columns);
-      else if (mnemonic == "EX")
-        add_ex(columns);
-      else if (mnemonic == "EXX")
-        add_exx(columns);
-      else if (mnemonic.size() >= 4u and mnemonic.front() == 'E'
-               and std::all_of(
-                     std::next(std::begin(mnemonic)), std::end(mnemonic),
-                     [](char const character) { return character == 'X'; }))
-        add_exs(columns, mnemonic);
-      else if (mnemonic.size() >= 3u and mnemonic[0] == 'E' and mnemonic[1] == 'X')
-        add_exn(columns, mnemonic);
-      else if (mnemonic == "EY")
-        add_ey(columns);
-      else if (mnemonic == "EYY")
-        add_eyy(columns);
-      else if (mnemonic.size() >= 4u and mnemonic.front() == 'E'
-               and std::all_of(
-                     std::next(std::begin(mnemonic)), std::end(mnemonic),
-                     [](char const character) { return character == 'Y'; }))
-        add_eys(columns, mnemonic);
-      else if (mnemonic.size() >= 3u and mnemonic[0] == 'E' and mnemonic[1] == 'Y')
-        add_eyn(columns, mnemonic);
-      else if (mnemonic == "EZ")
-        add_ez(columns);
-      else if (mnemonic == "EZZ")
-        add_ezz(columns);
-      else if (mnemonic.size() >= 4u and mnemonic.front() == 'E'
-               and std::all_of(
-                     std::next(std::begin(mnemonic)), std::end(mnemonic),
-                     [](char const character) { return character == 'Z'; }))
-        add_ezs(columns, mnemonic);
-      else if (mnemonic.size() >= 3u and mnemonic[0] == 'E' and mnemonic[1] == 'Z')
-        add_ezn(columns, mnemonic);
-      else if (mnemonic == "ESWAP")
-        add_eswap(columns);
-      else if (mnemonic == "TOFFOLI")
-        add_toffoli(columns);
-      else if (mnemonic == "M")
-        add_m(columns);
-      else if (mnemonic == "SHORBOX")
-        add_shor_box(columns);
-      else if (mnemonic == "BEGIN") // BEGIN MEASUREMENT/LEARNING MACHINE
-      {
-        if (columns.size() <= 1u)
-          throw wrong_mnemonics_error{columns};
+    }
+    else if (mnemonic == "PERMUTATION")
+      throw unsupported_mnemonic_error{mnemonic};
+    else if (mnemonic == "RANDOM") // RANDOM PERMUTATION
+      throw unsupported_mnemonic_error{mnemonic};
+    else if (mnemonic == "I")
+      return true;
+    else if (mnemonic == "H")
+      add_h(columns);
+    else if (mnemonic == "NOT")
+      add_not(columns);
+    else if (mnemonic == "X")
+      add_x(columns);
+    else if (mnemonic == "XX")
+      add_xx(columns);
+    else if (mnemonic.size() >= 3u
+             and std::all_of(
+                   std::begin(mnemonic), std::end(mnemonic),
+                   [](char const character) { return character == 'X'; }))
+      add_xs(columns, mnemonic);
+    else if (mnemonic.size() >= 2u and mnemonic.front() == 'X')
+      add_xn(columns, mnemonic);
+    else if (mnemonic == "Y")
+      add_y(columns);
+    else if (mnemonic == "YY")
+      add_yy(columns);
+    else if (mnemonic.size() >= 3u
+             and std::all_of(
+                   std::begin(mnemonic), std::end(mnemonic),
+                   [](char const character) { return character == 'Y'; }))
+      add_ys(columns, mnemonic);
+    else if (mnemonic.size() >= 2u and mnemonic.front() == 'Y')
+      add_yn(columns, mnemonic);
+    else if (mnemonic == "Z")
+      add_z(columns);
+    else if (mnemonic == "ZZ")
+      add_zz(columns);
+    else if (mnemonic.size() >= 3u
+             and std::all_of(
+                   std::begin(mnemonic), std::end(mnemonic),
+                   [](char const character) { return character == 'Z'; }))
+      add_zs(columns, mnemonic);
+    else if (mnemonic.size() >= 2u and mnemonic.front() == 'Z')
+      add_zn(columns, mnemonic);
+    else if (mnemonic == "SWAP")
+      add_swap(columns);
+    else if (mnemonic == "S")
+      add_s(columns);
+    else if (mnemonic == "S+")
+      add_adj_s(columns);
+    else if (mnemonic == "T")
+      add_t(columns);
+    else if (mnemonic == "T+")
+      add_adj_t(columns);
+    else if (mnemonic == "U1")
+      add_u1(columns);
+    else if (mnemonic == "U2")
+      add_u2(columns);
+    else if (mnemonic == "U3")
+      add_u3(columns);
+    else if (mnemonic == "R" or mnemonic == "+R")
+      add_r(columns);
+    else if (mnemonic == "-R" or mnemonic == "R+")
+      add_adj_r(columns);
+    else if (mnemonic == "+X")
+      add_rotx(columns);
+    else if (mnemonic == "-X")
+      add_adj_rotx(columns);
+    else if (mnemonic == "+Y")
+      add_roty(columns);
+    else if (mnemonic == "-Y")
+      add_adj_roty(columns);
+    else if (mnemonic == "U")
+      add_u(columns);
+    else if (mnemonic == "U+")
+      add_adj_u(columns);
+    else if (mnemonic == "V")
+      add_v(columns);
+    else if (mnemonic == "EX")
+      add_ex(columns);
+    else if (mnemonic == "EXX")
+      add_exx(columns);
+    else if (mnemonic.size() >= 4u and mnemonic.front() == 'E'
+             and std::all_of(
+                   std::next(std::begin(mnemonic)), std::end(mnemonic),
+                   [](char const character) { return character == 'X'; }))
+      add_exs(columns, mnemonic);
+    else if (mnemonic.size() >= 3u and mnemonic[0] == 'E' and mnemonic[1] == 'X')
+      add_exn(columns, mnemonic);
+    else if (mnemonic == "EY")
+      add_ey(columns);
+    else if (mnemonic == "EYY")
+      add_eyy(columns);
+    else if (mnemonic.size() >= 4u and mnemonic.front() == 'E'
+             and std::all_of(
+                   std::next(std::begin(mnemonic)), std::end(mnemonic),
+                   [](char const character) { return character == 'Y'; }))
+      add_eys(columns, mnemonic);
+    else if (mnemonic.size() >= 3u and mnemonic[0] == 'E' and mnemonic[1] == 'Y')
+      add_eyn(columns, mnemonic);
+    else if (mnemonic == "EZ")
+      add_ez(columns);
+    else if (mnemonic == "EZZ")
+      add_ezz(columns);
+    else if (mnemonic.size() >= 4u and mnemonic.front() == 'E'
+             and std::all_of(
+                   std::next(std::begin(mnemonic)), std::end(mnemonic),
+                   [](char const character) { return character == 'Z'; }))
+      add_ezs(columns, mnemonic);
+    else if (mnemonic.size() >= 3u and mnemonic[0] == 'E' and mnemonic[1] == 'Z')
+      add_ezn(columns, mnemonic);
+    else if (mnemonic == "ESWAP")
+      add_eswap(columns);
+    else if (mnemonic == "TOFFOLI")
+      add_toffoli(columns);
+    else if (mnemonic == "MATRIX")
+#ifndef BRA_NO_MPI
+      add_matrix(columns, environment, communicator);
+#else // BRA_NO_MPI
+      add_matrix(columns);
+#endif // BRA_NO_MPI
+    else if (mnemonic == "M")
+      add_m(columns);
+    else if (mnemonic == "SHORBOX")
+      add_shor_box(columns);
+    else if (mnemonic == "BEGIN") // BEGIN MEASUREMENT/LEARNING MACHINE
+    {
+      if (columns.size() <= 1u)
+        throw wrong_mnemonics_error{columns};
 
-        std::for_each(
-          std::next(std::begin(columns)), std::end(columns),
-          [](std::string& str) { boost::algorithm::to_upper(str); });
+      std::for_each(
+        std::next(std::begin(columns)), std::end(columns),
+        [](std::string& str) { boost::algorithm::to_upper(str); });
 
-        auto const statement = read_begin_statement(columns);
+      auto const statement = read_begin_statement(columns);
 
-        if (statement == ::bra::begin_statement::measurement)
-        {
+      if (statement == ::bra::begin_statement::measurement)
+      {
 #ifndef BRA_NO_MPI
-          data_.push_back(
-            std::unique_ptr< ::bra::gate::gate >{new ::bra::gate::measurement{root_}});
+        data_.push_back(
+          std::unique_ptr< ::bra::gate::gate >{new ::bra::gate::measurement{root_}});
 #else // BRA_NO_MPI
-          data_.push_back(
-            std::unique_ptr< ::bra::gate::gate >{new ::bra::gate::measurement{}});
+        data_.push_back(
+          std::unique_ptr< ::bra::gate::gate >{new ::bra::gate::measurement{}});
 #endif // BRA_NO_MPI
-        }
-        else if (statement == ::bra::begin_statement::learning_machine)
-          throw unsupported_mnemonic_error{mnemonic};
       }
-      else if (mnemonic == "DO") // DO MEASUREMENT
-      {
-        /*
-        auto const statement = read_do_statement(columns);
+      else if (statement == ::bra::begin_statement::learning_machine)
+        throw unsupported_mnemonic_error{mnemonic};
+    }
+    else if (mnemonic == "DO") // DO MEASUREMENT
+    {
+      /*
+      auto const statement = read_do_statement(columns);
 
-        if (statement == do_statement::error)
-          throw wrong_mnemonics_error{columns};
-        else if (statement == do_statement::measurement)
-          throw unsupported_mnemonic_error{mnemonic};
-          */
+      if (statement == do_statement::error)
+        throw wrong_mnemonics_error{columns};
+      else if (statement == do_statement::measurement)
         throw unsupported_mnemonic_error{mnemonic};
-      }
-      else if (mnemonic == "END") // END MEASUREMENT/LEARNING MACHINE
-      {
-        /*
-        auto const statement = read_end_statement(columns);
+        */
+      throw unsupported_mnemonic_error{mnemonic};
+    }
+    else if (mnemonic == "END") // END MEASUREMENT/LEARNING MACHINE
+    {
+      /*
+      auto const statement = read_end_statement(columns);
 
-        if (statement == ::bra::end_statement::measurement)
-        {
+      if (statement == ::bra::end_statement::measurement)
+      {
 #ifndef BRA_NO_MPI
-          data_.push_back(std::make_unique< ::bra::gate::measurement >(root_));
+        data_.push_back(std::make_unique< ::bra::gate::measurement >(root_));
 #else // BRA_NO_MPI
-          data_.push_back(std::make_unique< ::bra::gate::measurement >());
+        data_.push_back(std::make_unique< ::bra::gate::measurement >());
 #endif // BRA_NO_MPI
-        }
-        else if (statement == ::bra::end_statement::learning_machine)
-          throw unsupported_mnemonic_error{mnemonic};
-*/
-        throw unsupported_mnemonic_error{mnemonic};
       }
-      else if (mnemonic == "GENERATE") // GENERATE EVENTS
-      {
-        if (boost::size(columns) != 4u)
-          throw wrong_mnemonics_error{columns};
+      else if (statement == ::bra::end_statement::learning_machine)
+        throw unsupported_mnemonic_error{mnemonic};
+*/
+      throw unsupported_mnemonic_error{mnemonic};
+    }
+    else if (mnemonic == "GENERATE") // GENERATE EVENTS
+    {
+      if (boost::size(columns) != 4u)
+        throw wrong_mnemonics_error{columns};
 
-        boost::algorithm::to_upper(columns[1u]);
+      boost::algorithm::to_upper(columns[1u]);
 
-        auto statement = ::bra::generate_statement{};
-        auto num_events = int{};
-        auto seed = int{};
-        std::tie(statement, num_events, seed) = read_generate_statement(columns);
+      auto statement = ::bra::generate_statement{};
+      auto num_events = int{};
+      auto seed = int{};
+      std::tie(statement, num_events, seed) = read_generate_statement(columns);
 
-        if (statement == ::bra::generate_statement::events)
-        {
+      if (statement == ::bra::generate_statement::events)
+      {
 #ifndef BRA_NO_MPI
-          data_.push_back(
-            std::unique_ptr< ::bra::gate::gate >{
-              new ::bra::gate::generate_events{root_, num_events, seed}});
+        data_.push_back(
+          std::unique_ptr< ::bra::gate::gate >{
+            new ::bra::gate::generate_events{root_, num_events, seed}});
 #else // BRA_NO_MPI
-          data_.push_back(
-            std::unique_ptr< ::bra::gate::gate >{
-              new ::bra::gate::generate_events{num_events, seed}});
+        data_.push_back(
+          std::unique_ptr< ::bra::gate::gate >{
+            new ::bra::gate::generate_events{num_events, seed}});
 #endif // BRA_NO_MPI
-          break;
-        }
+        return false;
       }
-      else if (mnemonic == "CLEAR")
-        add_clear(columns);
-      else if (mnemonic == "SET")
-        add_set(columns);
-      else if (mnemonic == "DEPOLARIZING")
-      {
-        if (boost::size(columns) <= 2u)
-          throw wrong_mnemonics_error{columns};
+    }
+    else if (mnemonic == "CLEAR")
+      add_clear(columns);
+    else if (mnemonic == "SET")
+      add_set(columns);
+    else if (mnemonic == "DEPOLARIZING")
+    {
+      if (boost::size(columns) <= 2u)
+        throw wrong_mnemonics_error{columns};
 
-        boost::algorithm::to_upper(columns[1u]);
+      boost::algorithm::to_upper(columns[1u]);
 
-        add_depolarizing(columns, mnemonic);
-      }
-      else if (mnemonic == "EXIT")
-      {
-        if (boost::size(columns) != 1u)
-          throw wrong_mnemonics_error{columns};
+      add_depolarizing(columns, mnemonic);
+    }
+    else if (mnemonic == "CHECKPOINT")
+      add_checkpoint(columns);
+    else if (mnemonic == "EXIT")
+    {
+      if (boost::size(columns) != 1u)
+        throw wrong_mnemonics_error{columns};
 
 #ifndef BRA_NO_MPI
-        data_.push_back(
-          std::unique_ptr< ::bra::gate::gate >{new ::bra::gate::exit{root_}});
+      data_.push_back(
+        std::unique_ptr< ::bra::gate::gate >{new ::bra::gate::exit{root_}});
 #else // BRA_NO_MPI
-        data_.push_back(
-          std::unique_ptr< ::bra::gate::gate >{new ::bra::gate::exit{}});
+      data_.push_back(
+        std::unique_ptr< ::bra::gate::gate >{new ::bra::gate::exit{}});
 #endif // BRA_NO_MPI
-        break;
-      }
-      else if (mnemonic.size() >= 2u and mnemonic.front() == 'C') // controlled gates
-        interpret_controlled_gates(columns, mnemonic);
-      else
-        throw unsupported_mnemonic_error{mnemonic};
+      return false;
     }
+    else if (mnemonic.size() >= 2u and mnemonic.front() == 'C') // controlled gates
+      interpret_controlled_gates(columns, mnemonic);
+    else
+      throw unsupported_mnemonic_error{mnemonic};
+
+    return true;
   }
 
   void gates::swap(gates& other)
@@ -630,6 +782,7 @@ namespace bra
     swap(num_lqubits_, other.num_lqubits_);
     swap(initial_state_value_, other.initial_state_value_);
     swap(initial_permutation_, other.initial_permutation_);
+    swap(is_initial_permutation_assigned_, other.is_initial_permutation_assigned_);
     swap(phase_coefficients_, other.phase_coefficients_);
     swap(root_, other.root_);
 #else // BRA_NO_MPI
@@ -640,6 +793,643 @@ namespace bra
 #endif // BRA_NO_MPI
   }
 
+  namespace gates_detail
+  {
+    enum class axis : int { z, x, general };
+
+    // The gate of instruction on qubit is diagonal in the basis of Z or X, or otherwise general
+    inline ::bra::gates_detail::axis axis_on(::bra::instruction const& instruction, ::bra::instruction::qubit_type const qubit)
+    {
+      switch (instruction.opcode)
+      {
+       case ::bra::opcode::pauli_z:
+       case ::bra::opcode::u1:
+       case ::bra::opcode::adj_u1:
+       case ::bra::opcode::phase_shift:
+       case ::bra::opcode::adj_phase_shift:
+       case ::bra::opcode::exponential_pauli_z:
+       case ::bra::opcode::adj_exponential_pauli_z:
+       case ::bra::opcode::exponential_pauli_zz:
+       case ::bra::opcode::adj_exponential_pauli_zz:
+       case ::bra::opcode::controlled_pauli_z:
+       case ::bra::opcode::controlled_phase_shift:
+       case ::bra::opcode::adj_controlled_phase_shift:
+        return ::bra::gates_detail::axis::z;
+
+       case ::bra::opcode::not_:
+       case ::bra::opcode::pauli_x:
+       case ::bra::opcode::x_rotation_half_pi:
+       case ::bra::opcode::adj_x_rotation_half_pi:
+       case ::bra::opcode::exponential_pauli_x:
+       case ::bra::opcode::adj_exponential_pauli_x:
+        return ::bra::gates_detail::axis::x;
+
+       case ::bra::opcode::controlled_not:
+        return qubit == instruction.qubit1 ? ::bra::gates_detail::axis::x : ::bra::gates_detail::axis::z;
+
+       default:
+        return ::bra::gates_detail::axis::general;
+      }
+    }
+
+    // Gates commute if both are diagonal in the same basis on each qubit they share
+    inline bool commute(
+      ::bra::instruction const& lhs, std::vector< ::bra::instruction::qubit_type > const& lhs_qubits,
+      ::bra::instruction const& rhs, std::vector< ::bra::instruction::qubit_type > const& rhs_qubits)
+    {
+      for (auto const qubit: lhs_qubits)
+      {
+        if (std::find(std::begin(rhs_qubits), std::end(rhs_qubits), qubit) == std::end(rhs_qubits))
+          continue;
+
+        auto const lhs_axis = ::bra::gates_detail::axis_on(lhs, qubit);
+        if (lhs_axis == ::bra::gates_detail::axis::general or lhs_axis != ::bra::gates_detail::axis_on(rhs, qubit))
+          return false;
+      }
+
+      return true;
+    }
+
+    inline bool is_same_pair(
+      ::bra::instruction::qubit_type const lhs1, ::bra::instruction::qubit_type const lhs2,
+      ::bra::instruction::qubit_type const rhs1, ::bra::instruction::qubit_type const rhs2)
+    { return (lhs1 == rhs1 and lhs2 == rhs2) or (lhs1 == rhs2 and lhs2 == rhs1); }
+
+    // Returns the rotation axis of a gate exp(-i phase P) and sets its phase, where the phase of an adjoint gate is negated
+    inline ::bra::opcode rotation(::bra::instruction const& instruction, ::bra::instruction::real_type& phase)
+    {
+      switch (instruction.opcode)
+      {
+       case ::bra::opcode::adj_u1:
+        phase = -instruction.phase;
+        return ::bra::opcode::u1;
+
+       case ::bra::opcode::adj_exponential_pauli_x:
+        phase = -instruction.phase;
+        return ::bra::opcode::exponential_pauli_x;
+
+       case ::bra::opcode::adj_exponential_pauli_y:
+        phase = -instruction.phase;
+        return ::bra::opcode::exponential_pauli_y;
+
+       case ::bra::opcode::adj_exponential_pauli_z:
+        phase = -instruction.phase;
+        return ::bra::opcode::exponential_pauli_z;
+
+       case ::bra::opcode::adj_exponential_pauli_zz:
+        phase = -instruction.phase;
+        return ::bra::opcode::exponential_pauli_zz;
+
+       default:
+        phase = instruction.phase;
+        return instruction.opcode;
+      }
+    }
+
+    inline bool is_rotation(::bra::opcode const opcode)
+    {
+      return opcode == ::bra::opcode::u1 or opcode == ::bra::opcode::exponential_pauli_x
+        or opcode == ::bra::opcode::exponential_pauli_y or opcode == ::bra::opcode::exponential_pauli_z
+        or opcode == ::bra::opcode::exponential_pauli_zz;
+    }
+
+    inline bool is_identity(::bra::instruction const& instruction)
+    {
+      auto phase = ::bra::instruction::real_type{};
+      if (::bra::gates_detail::is_rotation(::bra::gates_detail::rotation(instruction, phase)))
+        return phase == ::bra::instruction::real_type{0};
+
+      switch (instruction.opcode)
+      {
+       case ::bra::opcode::phase_shift:
+       case ::bra::opcode::adj_phase_shift:
+       case ::bra::opcode::controlled_phase_shift:
+       case ::bra::opcode::adj_controlled_phase_shift:
+        return instruction.phase_coefficient == ::bra::instruction::complex_type{1};
+
+       default:
+        return false;
+      }
+    }
+
+    // true if the gate of lhs followed by the gate of rhs is the identity
+    inline bool is_inverse(::bra::instruction const& lhs, ::bra::instruction const& rhs)
+    {
+      auto const is_adjoint_pair
+        = [&lhs, &rhs](::bra::opcode const opcode, ::bra::opcode const adj_opcode)
+          {
+            return (lhs.opcode == opcode and rhs.opcode == adj_opcode)
+              or (lhs.opcode == adj_opcode and rhs.opcode == opcode);
+          };
+      auto const is_x = [](::bra::opcode const opcode) { return opcode == ::bra::opcode::not_ or opcode == ::bra::opcode::pauli_x; };
+
+      if (is_x(lhs.opcode) and is_x(rhs.opcode))
+        return lhs.qubit1 == rhs.qubit1;
+      if (lhs.opcode == rhs.opcode
+          and (lhs.opcode == ::bra::opcode::hadamard or lhs.opcode == ::bra::opcode::pauli_y or lhs.opcode == ::bra::opcode::pauli_z))
+        return lhs.qubit1 == rhs.qubit1;
+      if (lhs.opcode == ::bra::opcode::swap and rhs.opcode == ::bra::opcode::swap)
+        return ::bra::gates_detail::is_same_pair(lhs.qubit1, lhs.qubit2, rhs.qubit1, rhs.qubit2);
+      if (lhs.opcode == ::bra::opcode::controlled_not and rhs.opcode == ::bra::opcode::controlled_not)
+        return lhs.qubit1 == rhs.qubit1 and lhs.control_qubit == rhs.control_qubit;
+      if (lhs.opcode == ::bra::opcode::controlled_pauli_z and rhs.opcode == ::bra::opcode::controlled_pauli_z)
+        return ::bra::gates_detail::is_same_pair(lhs.qubit1, lhs.control_qubit.qubit(), rhs.qubit1, rhs.control_qubit.qubit());
+      if (is_adjoint_pair(::bra::opcode::x_rotation_half_pi, ::bra::opcode::adj_x_rotation_half_pi)
+          or is_adjoint_pair(::bra::opcode::y_rotation_half_pi, ::bra::opcode::adj_y_rotation_half_pi))
+        return lhs.qubit1 == rhs.qubit1;
+      if (is_adjoint_pair(::bra::opcode::phase_shift, ::bra::opcode::adj_phase_shift))
+        return lhs.qubit1 == rhs.qubit1 and lhs.phase_coefficient == rhs.phase_coefficient;
+      if (is_adjoint_pair(::bra::opcode::controlled_phase_shift, ::bra::opcode::adj_controlled_phase_shift))
+        return lhs.qubit1 == rhs.qubit1 and lhs.control_qubit == rhs.control_qubit
+          and lhs.phase_coefficient == rhs.phase_coefficient;
+
+      return false;
+    }
+
+    // Returns a gate equivalent to the gate of lhs followed by the gate of rhs if both are rotations around the same axis, or nullptr otherwise.
+    // The returned gate is nullptr also if its phase is 0, and then is_identity is set to true
+    inline std::unique_ptr< ::bra::gate::gate > merge_rotations(
+      ::bra::instruction const& lhs, ::bra::instruction const& rhs, ::bra::instruction& merged, bool& is_identity)
+    {
+      is_identity = false;
+
+      auto lhs_phase = ::bra::instruction::real_type{};
+      auto rhs_phase = ::bra::instruction::real_type{};
+      auto const opcode = ::bra::gates_detail::rotation(lhs, lhs_phase);
+      if (not ::bra::gates_detail::is_rotation(opcode) or opcode != ::bra::gates_detail::rotation(rhs, rhs_phase))
+        return nullptr;
+
+      if (opcode == ::bra::opcode::exponential_pauli_zz
+          ? not ::bra::gates_detail::is_same_pair(lhs.qubit1, lhs.qubit2, rhs.qubit1, rhs.qubit2)
+          : lhs.qubit1 != rhs.qubit1)
+        return nullptr;
+
+      merged = lhs;
+      merged.opcode = opcode;
+      merged.phase = lhs_phase + rhs_phase;
+      if (merged.phase == ::bra::instruction::real_type{0})
+      {
+        is_identity = true;
+        return nullptr;
+      }
+
+      switch (opcode)
+      {
+       case ::bra::opcode::u1:
+        return std::unique_ptr< ::bra::gate::gate >{new ::bra::gate::u1{merged.phase, merged.qubit1}};
+
+       case ::bra::opcode::exponential_pauli_x:
+        return std::unique_ptr< ::bra::gate::gate >{new ::bra::gate::exponential_pauli_x{merged.phase, merged.qubit1}};
+
+       case ::bra::opcode::exponential_pauli_y:
+        return std::unique_ptr< ::bra::gate::gate >{new ::bra::gate::exponential_pauli_y{merged.phase, merged.qubit1}};
+
+       case ::bra::opcode::exponential_pauli_z:
+        return std::unique_ptr< ::bra::gate::gate >{new ::bra::gate::exponential_pauli_z{merged.phase, merged.qubit1}};
+
+       default:
+        return std::unique_ptr< ::bra::gate::gate >{
+          new ::bra::gate::exponential_pauli_zz{merged.phase, merged.qubit1, merged.qubit2}};
+      }
+    }
+  } // namespace gates_detail
+
+  namespace gates_detail
+  {
+    // FNV-1a
+    constexpr auto hash_offset_basis = std::uint64_t{0xCBF29CE484222325u};
+    constexpr auto hash_prime = std::uint64_t{0x100000001B3u};
+
+    inline std::uint64_t hash_bytes(std::uint64_t hash, void const* const data, std::size_t const size)
+    {
+      auto const bytes = static_cast<unsigned char const*>(data);
+      for (auto index = std::size_t{0u}; index < size; ++index)
+      {
+        hash ^= static_cast<std::uint64_t>(bytes[index]);
+        hash *= ::bra::gates_detail::hash_prime;
+      }
+      return hash;
+    }
+
+    inline std::uint64_t hash_value(std::uint64_t const hash, std::uint64_t const value)
+    { return ::bra::gates_detail::hash_bytes(hash, std::addressof(value), sizeof(std::uint64_t)); }
+  } // namespace gates_detail
+
+  std::uint64_t gates::hash(std::initializer_list<std::uint64_t> const options) const
+  {
+    auto result = ::bra::gates_detail::hash_offset_basis;
+    result = ::bra::gates_detail::hash_value(result, static_cast<std::uint64_t>(num_qubits_));
+    result = ::bra::gates_detail::hash_value(result, static_cast<std::uint64_t>(initial_state_value_));
+
+    // parameters are printed in representation() with limited precision, but matrix elements of unitary gates are hashed exactly
+    for (auto const& gate_ptr: data_)
+    {
+      auto const representation = gate_ptr->representation();
+      result = ::bra::gates_detail::hash_value(result, static_cast<std::uint64_t>(representation.size()));
+      result = ::bra::gates_detail::hash_bytes(result, representation.data(), representation.size());
+      auto const unitary_matrix = gate_ptr->unitary_matrix();
+      result = ::bra::gates_detail::hash_value(result, static_cast<std::uint64_t>(unitary_matrix.size()));
+      if (not unitary_matrix.empty())
+        result = ::bra::gates_detail::hash_bytes(result, unitary_matrix.data(), unitary_matrix.size() * sizeof(unitary_matrix.front()));
+    }
+
+    for (auto const option: options)
+      result = ::bra::gates_detail::hash_value(result, option);
+    return result;
+  }
+
+  gates::size_type gates::optimize()
+  {
+    auto const num_gates = data_.size();
+
+    auto result = data_type{data_.get_allocator()};
+    result.reserve(num_gates);
+    // indices of instructions and operated_qubits are the same as result, and removed gates in result become nullptr
+    auto is_instructions = std::vector<bool>{};
+    auto instructions = std::vector< ::bra::instruction >{};
+    auto operated_qubits = std::vector<std::vector<qubit_type>>{};
+    is_instructions.reserve(num_gates);
+    instructions.reserve(num_gates);
+    operated_qubits.reserve(num_gates);
+
+    for (auto& gate_ptr: data_)
+    {
+      auto instruction = ::bra::instruction{};
+      auto const is_instruction = gate_ptr->instruction(instruction);
+      auto qubits = gate_ptr->operated_qubits();
+
+      if (is_instruction and ::bra::gates_detail::is_identity(instruction))
+        continue;
+
+      // look back over gates commuting with this gate for a gate cancelled or merged with it
+      auto is_absorbed = false;
+      if (is_instruction)
+      {
+        auto index = result.size();
+        auto num_looked_gates = std::size_t{0u};
+        while (index > std::size_t{0u} and num_looked_gates < std::size_t{BRA_MAX_NUM_OPTIMIZATION_LOOKBACK_GATES})
+        {
+          --index;
+          if (not result[index])
+            continue;
+          ++num_looked_gates;
+
+          // non-unitary gates, e.g. measurements, do not commute with any gate
+          if (operated_qubits[index].empty())
+            break;
+
+          auto const is_disjoint
+            = std::none_of(
+                std::begin(qubits), std::end(qubits),
+                [&operated_qubits, index](qubit_type const qubit)
+                {
+                  return std::find(std::begin(operated_qubits[index]), std::end(operated_qubits[index]), qubit)
+                    != std::end(operated_qubits[index]);
+                });
+          if (is_disjoint)
+            continue;
+
+          if (not is_instructions[index])
+            break;
+
+          if (::bra::gates_detail::is_inverse(instructions[index], instruction))
+          {
+            result[index].reset();
+            is_absorbed = true;
+            break;
+          }
+
+          auto merged = ::bra::instruction{};
+          auto is_identity = false;
+          auto merged_gate_ptr = ::bra::gates_detail::merge_rotations(instructions[index], instruction, merged, is_identity);
+          if (is_identity or merged_gate_ptr)
+          {
+            result[index] = std::move(merged_gate_ptr);
+            instructions[index] = merged;
+            is_absorbed = true;
+            break;
+          }
+
+          if (not ::bra::gates_detail::commute(instructions[index], operated_qubits[index], instruction, qubits))
+            break;
+        }
+      }
+
+      if (is_absorbed)
+        continue;
+
+      result.push_back(std::move(gate_ptr));
+      is_instructions.push_back(is_instruction);
+      instructions.push_back(instruction);
+      operated_qubits.push_back(std::move(qubits));
+    }
+
+    result.erase(
+      std::remove_if(
+        std::begin(result), std::end(result),
+        [](value_type_ const& gate_ptr) { return not gate_ptr; }),
+      std::end(result));
+    data_ = std::move(result);
+
+    return num_gates - data_.size();
+  }
+
+  void gates::batch_diagonal(bit_integer_type const max_num_table_qubits)
+  {
+    if (max_num_table_qubits == bit_integer_type{0u})
+      return;
+
+    auto result = data_type{data_.get_allocator()};
+    result.reserve(data_.size());
+
+    // tables of diagonal elements of gates in [first_gate_iter, gate_iter) and their qubits
+    auto tables = std::vector<std::vector<complex_type>>{};
+    auto table_qubits = std::vector<std::vector<qubit_type>>{};
+    auto const flush
+      = [&result, &tables, &table_qubits](iterator const first, iterator const last)
+        {
+          if (last - first == 1)
+            result.push_back(std::move(*first));
+          else if (last - first > 1)
+            result.push_back(
+              std::unique_ptr< ::bra::gate::gate >{
+                new ::bra::gate::diagonal_batch{std::move(tables), std::move(table_qubits), static_cast<std::size_t>(last - first)}});
+
+          tables.clear();
+          table_qubits.clear();
+        };
+
+    auto first_gate_iter = std::begin(data_);
+    auto const last_gate_iter = std::end(data_);
+    for (auto gate_iter = first_gate_iter; gate_iter != last_gate_iter; ++gate_iter)
+    {
+      auto const operated_qubits = (*gate_iter)->operated_qubits();
+      auto diagonal
+        = operated_qubits.empty() or operated_qubits.size() > max_num_table_qubits
+          ? std::vector<complex_type>{}
+          : ::bra::unitary_matrix::diagonal((*gate_iter)->unitary_matrix());
+
+      // non-unitary gates, non-diagonal gates and too large gates are not batched
+      if (diagonal.empty())
+      {
+        flush(first_gate_iter, gate_iter);
+        result.push_back(std::move(*gate_iter));
+        first_gate_iter = std::next(gate_iter);
+        continue;
+      }
+
+      auto sorted_operated_qubits = operated_qubits;
+      std::sort(std::begin(sorted_operated_qubits), std::end(sorted_operated_qubits));
+
+      // the gate is merged into the table whose number of qubits grows least, or it becomes a new table
+      auto merged_table_index = tables.size();
+      auto merged_qubits = std::vector<qubit_type>{};
+      auto num_merged_new_qubits = std::size_t{0u};
+      for (auto table_index = std::size_t{0u}; table_index < tables.size(); ++table_index)
+      {
+        auto new_qubits = std::vector<qubit_type>{};
+        std::set_union(
+          std::begin(table_qubits[table_index]), std::end(table_qubits[table_index]),
+          std::begin(sorted_operated_qubits), std::end(sorted_operated_qubits),
+          std::back_inserter(new_qubits));
+        auto const num_new_qubits = new_qubits.size() - table_qubits[table_index].size();
+
+        if (new_qubits.size() <= max_num_table_qubits
+            and (merged_table_index == tables.size() or num_new_qubits < num_merged_new_qubits))
+        {
+          merged_table_index = table_index;
+          merged_qubits = std::move(new_qubits);
+          num_merged_new_qubits = num_new_qubits;
+        }
+      }
+
+      if (merged_table_index == tables.size())
+      {
+        tables.push_back(std::vector<complex_type>(diagonal.size(), complex_type{1}));
+        ::bra::unitary_matrix::multiply_diagonal(tables.back(), sorted_operated_qubits, diagonal, operated_qubits);
+        table_qubits.push_back(std::move(sorted_operated_qubits));
+        continue;
+      }
+
+      auto table = std::vector<complex_type>(std::size_t{1u} << merged_qubits.size(), complex_type{1});
+      ::bra::unitary_matrix::multiply_diagonal(table, merged_qubits, tables[merged_table_index], table_qubits[merged_table_index]);
+      ::bra::unitary_matrix::multiply_diagonal(table, merged_qubits, diagonal, operated_qubits);
+      tables[merged_table_index] = std::move(table);
+      table_qubits[merged_table_index] = std::move(merged_qubits);
+    }
+    flush(first_gate_iter, last_gate_iter);
+
+    data_ = std::move(result);
+  }
+
+  void gates::fuse(bit_integer_type const max_num_fused_qubits)
+  {
+    if (max_num_fused_qubits == bit_integer_type{0u})
+      return;
+
+    auto result = data_type{data_.get_allocator()};
+    result.reserve(data_.size());
+
+    // sorted union of operated qubits of gates in [first_gate_iter, gate_iter)
+    auto fused_qubits = std::vector<qubit_type>{};
+    auto const flush
+      = [&result, &fused_qubits](iterator const first, iterator const last)
+        {
+          if (last - first == 1)
+            result.push_back(std::move(*first));
+          else if (last - first > 1)
+          {
+            auto matrix = ::bra::unitary_matrix::identity(fused_qubits.size());
+            for (auto iter = first; iter != last; ++iter)
+              ::bra::unitary_matrix::multiply(matrix, fused_qubits, (*iter)->unitary_matrix(), (*iter)->operated_qubits());
+
+            result.push_back(
+              std::unique_ptr< ::bra::gate::gate >{
+                new ::bra::gate::fused{std::move(fused_qubits), std::move(matrix), static_cast<std::size_t>(last - first)}});
+          }
+
+          fused_qubits.clear();
+        };
+
+    auto first_gate_iter = std::begin(data_);
+    auto const last_gate_iter = std::end(data_);
+    for (auto gate_iter = first_gate_iter; gate_iter != last_gate_iter; ++gate_iter)
+    {
+      auto operated_qubits = (*gate_iter)->operated_qubits();
+      std::sort(std::begin(operated_qubits), std::end(operated_qubits));
+
+      // non-unitary gates, too large gates and gates without their matrices, e.g. ::bra::gate::diagonal_batch, are not fused
+      if (operated_qubits.empty() or operated_qubits.size() > max_num_fused_qubits or (*gate_iter)->unitary_matrix().empty())
+      {
+        flush(first_gate_iter, gate_iter);
+        result.push_back(std::move(*gate_iter));
+        first_gate_iter = std::next(gate_iter);
+        continue;
+      }
+
+      auto new_fused_qubits = std::vector<qubit_type>{};
+      new_fused_qubits.reserve(fused_qubits.size() + operated_qubits.size());
+      std::set_union(
+        std::begin(fused_qubits), std::end(fused_qubits),
+        std::begin(operated_qubits), std::end(operated_qubits),
+        std::back_inserter(new_fused_qubits));
+
+      if (new_fused_qubits.size() > max_num_fused_qubits)
+      {
+        flush(first_gate_iter, gate_iter);
+        first_gate_iter = gate_iter;
+        new_fused_qubits = std::move(operated_qubits);
+      }
+
+      fused_qubits = std::move(new_fused_qubits);
+    }
+    flush(first_gate_iter, last_gate_iter);
+
+    data_ = std::move(result);
+  }
+
+  void gates::block(bit_integer_type const num_block_qubits)
+  {
+    if (num_block_qubits == bit_integer_type{0u})
+      return;
+
+    auto result = data_type{data_.get_allocator()};
+    result.reserve(data_.size());
+
+    auto const flush
+      = [&result, num_block_qubits](iterator const first, iterator const last)
+        {
+          if (last - first == 1)
+            result.push_back(std::move(*first));
+          else if (last - first > 1)
+          {
+            auto matrices = std::vector<std::vector<complex_type>>{};
+            auto qubits = std::vector<std::vector<qubit_type>>{};
+            matrices.reserve(last - first);
+            qubits.reserve(last - first);
+            for (auto iter = first; iter != last; ++iter)
+            {
+              matrices.push_back((*iter)->unitary_matrix());
+              qubits.push_back((*iter)->operated_qubits());
+            }
+
+            result.push_back(
+              std::unique_ptr< ::bra::gate::gate >{
+                new ::bra::gate::blocked{std::move(matrices), std::move(qubits), num_block_qubits}});
+          }
+        };
+
+    auto first_gate_iter = std::begin(data_);
+    auto const last_gate_iter = std::end(data_);
+    for (auto gate_iter = first_gate_iter; gate_iter != last_gate_iter; ++gate_iter)
+    {
+      auto const operated_qubits = (*gate_iter)->operated_qubits();
+
+      // non-unitary gates, gates operating on high qubits and gates without their matrices are not blocked
+      if (operated_qubits.empty()
+          or static_cast<bit_integer_type>(*std::max_element(std::begin(operated_qubits), std::end(operated_qubits))) >= num_block_qubits
+          or (*gate_iter)->unitary_matrix().empty())
+      {
+        flush(first_gate_iter, gate_iter);
+        result.push_back(std::move(*gate_iter));
+        first_gate_iter = std::next(gate_iter);
+      }
+    }
+    flush(first_gate_iter, last_gate_iter);
+
+    data_ = std::move(result);
+  }
+
+  void gates::pack()
+  {
+    auto result = data_type{data_.get_allocator()};
+    result.reserve(data_.size());
+
+    auto instructions = std::vector< ::bra::instruction >{};
+    auto const flush
+      = [&result, &instructions](iterator const first, iterator const last)
+        {
+          if (last - first == 1)
+            result.push_back(std::move(*first));
+          else if (last - first > 1)
+            result.push_back(
+              std::unique_ptr< ::bra::gate::gate >{new ::bra::gate::packed{std::move(instructions)}});
+          instructions.clear();
+        };
+
+    auto instruction = ::bra::instruction{};
+    auto first_gate_iter = std::begin(data_);
+    auto const last_gate_iter = std::end(data_);
+    for (auto gate_iter = first_gate_iter; gate_iter != last_gate_iter; ++gate_iter)
+    {
+      if ((*gate_iter)->instruction(instruction))
+      {
+        instructions.push_back(instruction);
+        continue;
+      }
+
+      flush(first_gate_iter, gate_iter);
+      result.push_back(std::move(*gate_iter));
+      first_gate_iter = std::next(gate_iter);
+    }
+    flush(first_gate_iter, last_gate_iter);
+
+    data_ = std::move(result);
+  }
+
+#ifndef BRA_NO_MPI
+  ::ket::mpi::utility::lookahead gates::make_lookahead() const
+  {
+    auto result = ::ket::mpi::utility::lookahead{static_cast<std::size_t>(num_qubits_)};
+
+    auto gate_index = std::size_t{0u};
+    for (auto const& gate_ptr: data_)
+    {
+      for (auto const qubit: gate_ptr->operated_qubits())
+        result.add_use(static_cast<std::size_t>(static_cast<bit_integer_type>(qubit)), gate_index);
+      ++gate_index;
+    }
+
+    return result;
+  }
+
+  void gates::order_global_qubits_by_use()
+  {
+    // an explicit BIT ASSIGNMENT is kept as it is, and ranks of unit_mpi are not simply given by global qubits
+    if (is_initial_permutation_assigned_ or num_uqubits_ > bit_integer_type{0u})
+      return;
+
+    auto num_uses = std::vector<std::size_t>(num_qubits_, std::size_t{0u});
+    for (auto const& gate_ptr: data_)
+      for (auto const qubit: gate_ptr->operated_qubits())
+        ++num_uses[static_cast<bit_integer_type>(qubit)];
+
+    auto const num_nonglobal_qubits = num_lqubits_ + num_uqubits_;
+    auto global_qubits = std::vector<bit_integer_type>{};
+    auto permutated_global_qubits = std::vector<permutated_qubit_type>{};
+    for (auto qubit = bit_integer_type{0u}; qubit < num_qubits_; ++qubit)
+      if (initial_permutation_[qubit] >= permutated_qubit_type{num_nonglobal_qubits})
+      {
+        global_qubits.push_back(qubit);
+        permutated_global_qubits.push_back(initial_permutation_[qubit]);
+      }
+
+    // ties are broken by the present order, so that all processes have the same permutation
+    std::sort(
+      std::begin(global_qubits), std::end(global_qubits),
+      [this, &num_uses](bit_integer_type const lhs, bit_integer_type const rhs)
+      {
+        return num_uses[lhs] != num_uses[rhs]
+          ? num_uses[lhs] > num_uses[rhs]
+          : initial_permutation_[lhs] < initial_permutation_[rhs];
+      });
+    std::sort(std::begin(permutated_global_qubits), std::end(permutated_global_qubits));
+
+    for (auto index = std::size_t{0u}; index < global_qubits.size(); ++index)
+      initial_permutation_[global_qubits[index]] = permutated_global_qubits[index];
+  }
+#endif // BRA_NO_MPI
+
   gates::bit_integer_type gates::read_num_qubits(gates::columns_type const& columns) const
   {
     if (boost::size(columns) != 2u)
@@ -1129,6 +1919,74 @@ namespace bra
        phase);
   }
 
+#ifndef BRA_NO_MPI
+  std::vector<gates::complex_type> gates::read_matrix(
+    gates::columns_type const& columns, std::vector<gates::qubit_type>& targets,
+    yampi::environment const& environment, yampi::communicator const& communicator) const
+#else // BRA_NO_MPI
+  std::vector<gates::complex_type> gates::read_matrix(gates::columns_type const& columns, std::vector<gates::qubit_type>& targets) const
+#endif // BRA_NO_MPI
+  {
+    if (boost::size(columns) < 3u)
+      throw wrong_mnemonics_error{columns};
+
+    targets.clear();
+    targets.reserve(boost::size(columns) - 2u);
+    auto const filename_iter = std::prev(std::end(columns));
+    for (auto iter = std::next(std::begin(columns)); iter != filename_iter; ++iter)
+    {
+      auto const target = boost::lexical_cast<bit_integer_type>(*iter);
+      targets.push_back(ket::make_qubit<state_integer_type>(target));
+    }
+
+    auto sorted_targets = targets;
+    std::sort(std::begin(sorted_targets), std::end(sorted_targets));
+    if (std::adjacent_find(std::begin(sorted_targets), std::end(sorted_targets)) != std::end(sorted_targets))
+      throw wrong_mnemonics_error{columns};
+
+    // elements of the row-major matrix in the format of operator>> of std::complex, e.g. "0.5", "(0.5)", or "(0.5,-0.5)"
+#ifndef BRA_NO_MPI
+    // Only the root process reads the matrix file, and its contents are broadcast to the other processes
+    auto contents = std::string{};
+    auto is_opened = 1;
+    if (communicator.rank(environment) == root_)
+    {
+      std::ifstream matrix_file{*filename_iter};
+      is_opened = static_cast<int>(static_cast<bool>(matrix_file));
+      if (matrix_file)
+        contents.assign(std::istreambuf_iterator<char>{matrix_file}, std::istreambuf_iterator<char>{});
+    }
+
+    yampi::broadcast(yampi::make_buffer(is_opened), root_, communicator, environment);
+    if (not is_opened)
+      throw wrong_mnemonics_error{columns};
+
+    auto contents_size = static_cast<unsigned long>(contents.size());
+    yampi::broadcast(yampi::make_buffer(contents_size), root_, communicator, environment);
+    contents.resize(contents_size);
+    if (contents_size > 0u)
+      yampi::broadcast(yampi::make_buffer(std::begin(contents), std::end(contents)), root_, communicator, environment);
+
+    auto matrix_stream = std::istringstream{contents};
+#else // BRA_NO_MPI
+    std::ifstream matrix_stream{*filename_iter};
+    if (not matrix_stream)
+      throw wrong_mnemonics_error{columns};
+#endif // BRA_NO_MPI
+
+    auto const dimension = ket::utility::integer_exp2<std::size_t>(targets.size());
+    auto result = std::vector<complex_type>{};
+    result.reserve(dimension * dimension);
+    auto element = complex_type{};
+    while (matrix_stream >> element)
+      result.push_back(element);
+
+    if (not matrix_stream.eof() or result.size() != dimension * dimension)
+      throw wrong_mnemonics_error{columns};
+
+    return result;
+  }
+
   ::bra::begin_statement gates::read_begin_statement(gates::columns_type const& columns) const
   {
     auto const column_size = boost::size(columns);
@@ -1639,6 +2497,28 @@ namespace bra
     }
   }
 
+  void gates::add_adj_u(gates::columns_type const& columns)
+  {
+    auto control = control_qubit_type{};
+    auto target = qubit_type{};
+    auto phase_exponent = int{};
+    std::tie(control, target, phase_exponent) = read_control_target_phaseexp(columns);
+
+    if (phase_exponent >= 0)
+      data_.push_back(
+        std::unique_ptr< ::bra::gate::gate >{
+          new ::bra::gate::adj_controlled_phase_shift{
+            phase_exponent, phase_coefficients_[phase_exponent], target, control}});
+    else
+    {
+      phase_exponent *= -1;
+      data_.push_back(
+        std::unique_ptr< ::bra::gate::gate >{
+          new ::bra::gate::controlled_phase_shift{
+            phase_exponent, phase_coefficients_[phase_exponent], target, control}});
+    }
+  }
+
   void gates::add_v(gates::columns_type const& columns)
   {
     auto control = control_qubit_type{};
@@ -1929,6 +2809,24 @@ namespace bra
 #endif // BRA_NO_MPI
   }
 
+#ifndef BRA_NO_MPI
+  void gates::add_matrix(
+    gates::columns_type const& columns, yampi::environment const& environment, yampi::communicator const& communicator)
+  {
+    auto targets = std::vector<qubit_type>{};
+    auto matrix = read_matrix(columns, targets, environment, communicator);
+#else // BRA_NO_MPI
+  void gates::add_matrix(gates::columns_type const& columns)
+  {
+    auto targets = std::vector<qubit_type>{};
+    auto matrix = read_matrix(columns, targets);
+#endif // BRA_NO_MPI
+
+    data_.push_back(
+      std::unique_ptr< ::bra::gate::gate >{
+        new ::bra::gate::matrix{std::move(targets), std::move(matrix)}});
+  }
+
   void gates::add_shor_box(gates::columns_type const& columns)
   {
     auto num_exponent_qubits = bit_integer_type{};
@@ -1955,6 +2853,16 @@ namespace bra
         new ::bra::gate::set{read_target(columns)}});
   }
 
+  void gates::add_checkpoint(gates::columns_type const& columns)
+  {
+    if (boost::size(columns) != 2u)
+      throw wrong_mnemonics_error{columns};
+
+    data_.push_back(
+      std::unique_ptr< ::bra::gate::gate >{
+        new ::bra::gate::checkpoint{columns[1u]}});
+  }
+
   void gates::add_depolarizing(gates::columns_type const& columns, std::string const& mnemonic)
   {
     auto statement = ::bra::depolarizing_statement{};
@@ -2048,7 +2956,7 @@ namespace bra
       add_cu3(columns, num_control_qubits);
     else if (noncontrol_mnemonic == "R" or noncontrol_mnemonic == "+R")
       add_cr(columns, num_control_qubits);
-    else if (noncontrol_mnemonic == "-R")
+    else if (noncontrol_mnemonic == "-R" or noncontrol_mnemonic == "R+")
       add_adj_cr(columns, num_control_qubits);
     else if (noncontrol_mnemonic == "+X")
       add_crotx(columns, num_control_qubits);
@@ -2060,6 +2968,8 @@ namespace bra
       add_adj_croty(columns, num_control_qubits);
     else if (noncontrol_mnemonic == "U")
       add_cu(columns, num_control_qubits);
+    else if (noncontrol_mnemonic == "U+")
+      add_adj_cu(columns, num_control_qubits);
     else if (noncontrol_mnemonic == "V")
       add_cv(columns, num_control_qubits);
     else if (noncontrol_mnemonic == "EX")
@@ -2781,6 +3691,52 @@ namespace bra
     }
   }
 
+  void gates::add_adj_cu(gates::columns_type const& columns, int const num_control_qubits)
+  {
+    if (num_control_qubits == 1)
+    {
+      auto control = control_qubit_type{};
+      auto target = qubit_type{};
+      auto phase_exponent = int{};
+      std::tie(control, target, phase_exponent) = read_control_target_phaseexp(columns);
+
+      if (phase_exponent >= 0)
+        data_.push_back(
+          std::unique_ptr< ::bra::gate::gate >{
+            new ::bra::gate::adj_controlled_phase_shift_cu{
+              phase_exponent, phase_coefficients_[phase_exponent], target, control}});
+      else
+      {
+        phase_exponent *= -1;
+        data_.push_back(
+          std::unique_ptr< ::bra::gate::gate >{
+            new ::bra::gate::controlled_phase_shift_cu{
+              phase_exponent, phase_coefficients_[phase_exponent], target, control}});
+      }
+    }
+    else // num_control_qubits >= 2
+    {
+      auto controls = std::vector<control_qubit_type>(num_control_qubits);
+      auto target = qubit_type{};
+      auto phase_exponent = int{};
+      std::tie(target, phase_exponent) = read_multi_controls_target_phaseexp(columns, controls);
+
+      if (phase_exponent >= 0)
+        data_.push_back(
+          std::unique_ptr< ::bra::gate::gate >{
+            new ::bra::gate::adj_multi_controlled_phase_shift{
+              phase_exponent, phase_coefficients_[phase_exponent], target, std::move(controls)}});
+      else
+      {
+        phase_exponent *= -1;
+        data_.push_back(
+          std::unique_ptr< ::bra::gate::gate >{
+            new ::bra::gate::multi_controlled_phase_shift{
+              phase_exponent, phase_coefficients_[phase_exponent], target, std::move(controls)}});
+      }
+    }
+  }
+
   void gates::add_cv(gates::columns_type const& columns, int const num_control_qubits)
   {
     if (num_control_qubits == 1)
@@ -1,4 +1,5 @@
 #include <string>
+#include <vector>
 #include <ios>
 #include <iomanip>
 #include <sstream>
@@ -8,6 +9,8 @@
 #include <bra/gate/gate.hpp>
 #include <bra/gate/hadamard.hpp>
 #include <bra/state.hpp>
+#include <bra/instruction.hpp>
+#include <bra/unitary_matrix.hpp>
 
 
 namespace bra
@@ -23,6 +26,19 @@ namespace bra
     ::bra::state& hadamard::do_apply(::bra::state& state) const
     { return state.hadamard(qubit_); }
 
+    std::vector<hadamard::qubit_type> hadamard::do_operated_qubits() const
+    { return {qubit_}; }
+
+    std::vector<hadamard::complex_type> hadamard::do_unitary_matrix() const
+    { return ::bra::unitary_matrix::hadamard(); }
+
+    bool hadamard::do_instruction(::bra::instruction& result) const
+    {
+      result.opcode = ::bra::opcode::hadamard;
+      result.qubit1 = qubit_;
+      return true;
+    }
+
     std::string const& hadamard::do_name() const { return name_; }
     std::string hadamard::do_representation(
       std::ostringstream& repr_stream, int const parameter_width) const
@@ -0,0 +1,43 @@
+#include <ios>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <utility>
+
+#include <ket/qubit_io.hpp>
+
+#include <bra/gate/gate.hpp>
+#include <bra/gate/matrix.hpp>
+#include <bra/state.hpp>
+
+
+namespace bra
+{
+  namespace gate
+  {
+    std::string const matrix::name_ = "MATRIX";
+
+    matrix::matrix(std::vector<qubit_type>&& qubits, std::vector<complex_type>&& matrix)
+      : ::bra::gate::gate{}, qubits_{std::move(qubits)}, matrix_{std::move(matrix)}
+    { }
+
+    ::bra::state& matrix::do_apply(::bra::state& state) const
+    { return state.matrix(matrix_, qubits_); }
+
+    std::vector<matrix::qubit_type> matrix::do_operated_qubits() const
+    { return qubits_; }
+
+    std::vector<matrix::complex_type> matrix::do_unitary_matrix() const
+    { return matrix_; }
+
+    std::string const& matrix::do_name() const { return name_; }
+    std::string matrix::do_representation(
+      std::ostringstream& repr_stream, int const parameter_width) const
+    {
+      for (auto&& qubit: qubits_)
+        repr_stream << std::right << std::setw(parameter_width) << qubit;
+      return repr_stream.str();
+    }
+  } // namespace gate
+} // namespace bra
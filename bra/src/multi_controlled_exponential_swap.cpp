@@ -11,6 +11,7 @@
 #include <bra/gate/gate.hpp>
 #include <bra/gate/multi_controlled_exponential_swap.hpp>
 #include <bra/state.hpp>
+#include <bra/unitary_matrix.hpp>
 
 
 namespace bra
@@ -28,6 +29,15 @@ namespace bra
     ::bra::state& multi_controlled_exponential_swap::do_apply(::bra::state& state) const
     { return state.multi_controlled_exponential_swap(phase_, target_qubit1_, target_qubit2_, control_qubits_); }
 
+    std::vector<multi_controlled_exponential_swap::qubit_type> multi_controlled_exponential_swap::do_operated_qubits() const
+    { return ::bra::unitary_matrix::operated_qubits({target_qubit1_, target_qubit2_}, control_qubits_); }
+
+    std::vector<multi_controlled_exponential_swap::complex_type> multi_controlled_exponential_swap::do_unitary_matrix() const
+    {
+      return ::bra::unitary_matrix::controlled(
+        ::bra::unitary_matrix::exponential(phase_, ::bra::unitary_matrix::swap()), control_qubits_.size());
+    }
+
     std::string const& multi_controlled_exponential_swap::do_name() const { return name_; }
     std::string multi_controlled_exponential_swap::do_representation(
       std::ostringstream& repr_stream, int const parameter_width) const
@@ -11,6 +11,7 @@
 #include <bra/gate/gate.hpp>
 #include <bra/gate/multi_controlled_pauli_yn.hpp>
 #include <bra/state.hpp>
+#include <bra/unitary_matrix.hpp>
 
 
 namespace bra
@@ -27,6 +28,16 @@ namespace bra
     ::bra::state& multi_controlled_pauli_yn::do_apply(::bra::state& state) const
     { return state.multi_controlled_pauli_yn(target_qubits_, control_qubits_); }
 
+    std::vector<multi_controlled_pauli_yn::qubit_type> multi_controlled_pauli_yn::do_operated_qubits() const
+    { return ::bra::unitary_matrix::operated_qubits(target_qubits_, control_qubits_); }
+
+    std::vector<multi_controlled_pauli_yn::complex_type> multi_controlled_pauli_yn::do_unitary_matrix() const
+    {
+      return ::bra::unitary_matrix::controlled(
+        ::bra::unitary_matrix::tensor_power(::bra::unitary_matrix::pauli_y(), target_qubits_.size()),
+        control_qubits_.size());
+    }
+
     std::string const& multi_controlled_pauli_yn::do_name() const { return name_; }
     std::string multi_controlled_pauli_yn::do_representation(
       std::ostringstream& repr_stream, int const parameter_width) const
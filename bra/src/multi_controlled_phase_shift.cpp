@@ -11,6 +11,7 @@
 #include <bra/gate/gate.hpp>
 #include <bra/gate/multi_controlled_phase_shift.hpp>
 #include <bra/state.hpp>
+#include <bra/unitary_matrix.hpp>
 
 
 namespace bra
@@ -31,6 +32,15 @@ namespace bra
     ::bra::state& multi_controlled_phase_shift::do_apply(::bra::state& state) const
     { return state.multi_controlled_phase_shift(phase_coefficient_, target_qubit_, control_qubits_); }
 
+    std::vector<multi_controlled_phase_shift::qubit_type> multi_controlled_phase_shift::do_operated_qubits() const
+    { return ::bra::unitary_matrix::operated_qubits({target_qubit_}, control_qubits_); }
+
+    std::vector<multi_controlled_phase_shift::complex_type> multi_controlled_phase_shift::do_unitary_matrix() const
+    {
+      return ::bra::unitary_matrix::controlled(
+        ::bra::unitary_matrix::phase_shift(phase_coefficient_), control_qubits_.size());
+    }
+
     std::string const& multi_controlled_phase_shift::do_name() const { return name_; }
     std::string multi_controlled_phase_shift::do_representation(
       std::ostringstream& repr_stream, int const parameter_width) const
@@ -1,5 +1,8 @@
 #ifdef BRA_NO_MPI
+# include <cstddef>
 # include <vector>
+# include <iterator>
+# include <algorithm>
 
 # include <ket/gate/hadamard.hpp>
 # include <ket/gate/not_.hpp>
@@ -17,6 +20,9 @@
 # include <ket/gate/exponential_pauli_z.hpp>
 # include <ket/gate/exponential_swap.hpp>
 # include <ket/gate/toffoli.hpp>
+# include <ket/gate/matrix.hpp>
+# include <ket/gate/blocked.hpp>
+# include <ket/gate/diagonal_batch.hpp>
 # include <ket/gate/projective_measurement.hpp>
 # include <ket/gate/clear.hpp>
 # include <ket/gate/set.hpp>
@@ -27,10 +33,137 @@
 
 # include <bra/nompi_state.hpp>
 # include <bra/state.hpp>
+# include <bra/instruction.hpp>
+
+// Packed instructions are applied sequentially if the state vector has fewer elements than this value
+# ifndef BRA_NOMPI_STATE_MIN_PARALLEL_SIZE
+#   define BRA_NOMPI_STATE_MIN_PARALLEL_SIZE 16384
+# endif // BRA_NOMPI_STATE_MIN_PARALLEL_SIZE
 
 
 namespace bra
 {
+  namespace nompi_state_detail
+  {
+    // each opcode calls ket::gate::ranges directly rather than a virtual member function of ::bra::state
+    template <typename ParallelPolicy, typename RandomAccessRange>
+    void apply_instructions(
+      ParallelPolicy const parallel_policy, RandomAccessRange& data,
+      ::bra::instruction const* const first, ::bra::instruction const* const last)
+    {
+      for (auto iter = first; iter != last; ++iter)
+      {
+        auto const& instruction = *iter;
+        switch (instruction.opcode)
+        {
+         case ::bra::opcode::hadamard:
+          ket::gate::ranges::hadamard(parallel_policy, data, instruction.qubit1);
+          break;
+
+         case ::bra::opcode::not_:
+          ket::gate::ranges::not_(parallel_policy, data, instruction.qubit1);
+          break;
+
+         case ::bra::opcode::pauli_x:
+          ket::gate::ranges::pauli_x(parallel_policy, data, instruction.qubit1);
+          break;
+
+         case ::bra::opcode::pauli_y:
+          ket::gate::ranges::pauli_y(parallel_policy, data, instruction.qubit1);
+          break;
+
+         case ::bra::opcode::pauli_z:
+          ket::gate::ranges::pauli_z(parallel_policy, data, instruction.qubit1);
+          break;
+
+         case ::bra::opcode::swap:
+          ket::gate::ranges::swap(parallel_policy, data, instruction.qubit1, instruction.qubit2);
+          break;
+
+         case ::bra::opcode::u1:
+          ket::gate::ranges::phase_shift(parallel_policy, data, instruction.phase, instruction.qubit1);
+          break;
+
+         case ::bra::opcode::adj_u1:
+          ket::gate::ranges::adj_phase_shift(parallel_policy, data, instruction.phase, instruction.qubit1);
+          break;
+
+         case ::bra::opcode::phase_shift:
+          ket::gate::ranges::phase_shift_coeff(parallel_policy, data, instruction.phase_coefficient, instruction.qubit1);
+          break;
+
+         case ::bra::opcode::adj_phase_shift:
+          ket::gate::ranges::adj_phase_shift_coeff(parallel_policy, data, instruction.phase_coefficient, instruction.qubit1);
+          break;
+
+         case ::bra::opcode::x_rotation_half_pi:
+          ket::gate::ranges::x_rotation_half_pi(parallel_policy, data, instruction.qubit1);
+          break;
+
+         case ::bra::opcode::adj_x_rotation_half_pi:
+          ket::gate::ranges::adj_x_rotation_half_pi(parallel_policy, data, instruction.qubit1);
+          break;
+
+         case ::bra::opcode::y_rotation_half_pi:
+          ket::gate::ranges::y_rotation_half_pi(parallel_policy, data, instruction.qubit1);
+          break;
+
+         case ::bra::opcode::adj_y_rotation_half_pi:
+          ket::gate::ranges::adj_y_rotation_half_pi(parallel_policy, data, instruction.qubit1);
+          break;
+
+         case ::bra::opcode::exponential_pauli_x:
+          ket::gate::ranges::exponential_pauli_x(parallel_policy, data, instruction.phase, instruction.qubit1);
+          break;
+
+         case ::bra::opcode::adj_exponential_pauli_x:
+          ket::gate::ranges::adj_exponential_pauli_x(parallel_policy, data, instruction.phase, instruction.qubit1);
+          break;
+
+         case ::bra::opcode::exponential_pauli_y:
+          ket::gate::ranges::exponential_pauli_y(parallel_policy, data, instruction.phase, instruction.qubit1);
+          break;
+
+         case ::bra::opcode::adj_exponential_pauli_y:
+          ket::gate::ranges::adj_exponential_pauli_y(parallel_policy, data, instruction.phase, instruction.qubit1);
+          break;
+
+         case ::bra::opcode::exponential_pauli_z:
+          ket::gate::ranges::exponential_pauli_z(parallel_policy, data, instruction.phase, instruction.qubit1);
+          break;
+
+         case ::bra::opcode::adj_exponential_pauli_z:
+          ket::gate::ranges::adj_exponential_pauli_z(parallel_policy, data, instruction.phase, instruction.qubit1);
+          break;
+
+         case ::bra::opcode::exponential_pauli_zz:
+          ket::gate::ranges::exponential_pauli_z(parallel_policy, data, instruction.phase, instruction.qubit1, instruction.qubit2);
+          break;
+
+         case ::bra::opcode::adj_exponential_pauli_zz:
+          ket::gate::ranges::adj_exponential_pauli_z(parallel_policy, data, instruction.phase, instruction.qubit1, instruction.qubit2);
+          break;
+
+         case ::bra::opcode::controlled_not:
+          ket::gate::ranges::not_(parallel_policy, data, instruction.qubit1, instruction.control_qubit);
+          break;
+
+         case ::bra::opcode::controlled_pauli_z:
+          ket::gate::ranges::pauli_z(parallel_policy, data, instruction.qubit1, instruction.control_qubit);
+          break;
+
+         case ::bra::opcode::controlled_phase_shift:
+          ket::gate::ranges::phase_shift_coeff(parallel_policy, data, instruction.phase_coefficient, instruction.qubit1, instruction.control_qubit);
+          break;
+
+         case ::bra::opcode::adj_controlled_phase_shift:
+          ket::gate::ranges::adj_phase_shift_coeff(parallel_policy, data, instruction.phase_coefficient, instruction.qubit1, instruction.control_qubit);
+          break;
+        }
+      }
+    }
+  } // namespace nompi_state_detail
+
   nompi_state::nompi_state(
     ::bra::state::state_integer_type const initial_integer,
     unsigned int const total_num_qubits,
@@ -40,6 +173,25 @@ namespace bra
       data_{make_initial_data(initial_integer, total_num_qubits)}
   { }
 
+  std::size_t nompi_state::do_local_state_size() const
+  { return data_.size(); }
+
+  void nompi_state::do_copy_local_state_to(std::size_t const first_index, std::size_t const count, complex_type* out) const
+  { std::copy_n(std::begin(data_) + first_index, count, out); }
+
+  void nompi_state::do_copy_local_state_from(std::size_t const first_index, std::size_t const count, complex_type const* in)
+  { std::copy_n(in, count, std::begin(data_) + first_index); }
+
+  void nompi_state::do_reset(state_integer_type const initial_integer)
+  {
+    // zeroing 2^n elements is memory-bound, so that all threads share it
+    auto const first = std::begin(data_);
+    ket::utility::loop_n(
+      parallel_policy_, data_.size(),
+      [first](std::size_t const index, int const) { *(first + index) = complex_type{real_type{0}}; });
+    data_[initial_integer] = complex_type{real_type{1}};
+  }
+
   void nompi_state::do_hadamard(qubit_type const qubit)
   { ket::gate::ranges::hadamard(parallel_policy_, data_, qubit); }
 
@@ -579,11 +731,11 @@ namespace bra
   {
     if (seed < 0)
       ket::ranges::generate_events(
-        ket::utility::policy::make_sequential(), // parallel_policy_,
+        parallel_policy_,
         generated_events_, data_, num_events, random_number_generator_);
     else
       ket::ranges::generate_events(
-        ket::utility::policy::make_sequential(), // parallel_policy_,
+        parallel_policy_,
         generated_events_, data_, num_events, random_number_generator_, static_cast<seed_type>(seed));
   }
 
@@ -2752,6 +2904,47 @@ namespace bra
       throw bra::too_many_qubits_error{num_control_qubits + 2u};
     }
   }
+
+  void nompi_state::do_matrix(
+    std::vector<complex_type> const& matrix, std::vector<qubit_type> const& qubits)
+  { ket::gate::ranges::matrix(parallel_policy_, data_, matrix, qubits); }
+
+  void nompi_state::do_blocked_matrices(
+    std::vector<std::vector<complex_type>> const& matrices, std::vector<std::vector<qubit_type>> const& qubits,
+    bit_integer_type const num_block_qubits)
+  {
+    auto const num_gates = matrices.size();
+    assert(qubits.size() == num_gates);
+
+    // blocking would leave some threads idle
+    if ((data_.size() >> num_block_qubits) < static_cast<data_type::size_type>(ket::utility::num_threads(parallel_policy_)))
+    {
+      for (auto index = std::size_t{0u}; index < num_gates; ++index)
+        ket::gate::ranges::matrix(parallel_policy_, data_, matrices[index], qubits[index]);
+      return;
+    }
+
+    ket::gate::ranges::blocked(
+      parallel_policy_, data_, num_block_qubits,
+      [&matrices, &qubits, num_gates](data_type::iterator const first, data_type::iterator const last)
+      {
+        for (auto index = std::size_t{0u}; index < num_gates; ++index)
+          ket::gate::matrix(ket::utility::policy::make_sequential(), first, last, matrices[index], qubits[index]);
+      });
+  }
+
+  void nompi_state::do_diagonal_batch(
+    std::vector<std::vector<complex_type>> const& tables, std::vector<std::vector<qubit_type>> const& qubits)
+  { ket::gate::ranges::diagonal_batch(parallel_policy_, data_, tables, qubits); }
+
+  void nompi_state::do_instructions(::bra::instruction const* const first, ::bra::instruction const* const last)
+  {
+    // a sweep of a small state vector is not worth being parallelized
+    if (data_.size() < static_cast<data_type::size_type>(BRA_NOMPI_STATE_MIN_PARALLEL_SIZE))
+      ::bra::nompi_state_detail::apply_instructions(ket::utility::policy::make_sequential(), data_, first, last);
+    else
+      ::bra::nompi_state_detail::apply_instructions(parallel_policy_, data_, first, last);
+  }
 } // namespace bra
 
 
@@ -1,4 +1,5 @@
 #include <string>
+#include <vector>
 #include <ios>
 #include <iomanip>
 #include <sstream>
@@ -8,6 +9,8 @@
 #include <bra/gate/gate.hpp>
 #include <bra/gate/not_.hpp>
 #include <bra/state.hpp>
+#include <bra/instruction.hpp>
+#include <bra/unitary_matrix.hpp>
 
 
 namespace bra
@@ -23,6 +26,19 @@ namespace bra
     ::bra::state& not_::do_apply(::bra::state& state) const
     { return state.not_(qubit_); }
 
+    std::vector<not_::qubit_type> not_::do_operated_qubits() const
+    { return {qubit_}; }
+
+    std::vector<not_::complex_type> not_::do_unitary_matrix() const
+    { return ::bra::unitary_matrix::pauli_x(); }
+
+    bool not_::do_instruction(::bra::instruction& result) const
+    {
+      result.opcode = ::bra::opcode::not_;
+      result.qubit1 = qubit_;
+      return true;
+    }
+
     std::string const& not_::do_name() const { return name_; }
     std::string not_::do_representation(
       std::ostringstream& repr_stream, int const parameter_width) const
@@ -0,0 +1,35 @@
+#include <ios>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <utility>
+
+#include <bra/gate/gate.hpp>
+#include <bra/gate/packed.hpp>
+#include <bra/state.hpp>
+#include <bra/instruction.hpp>
+
+
+namespace bra
+{
+  namespace gate
+  {
+    std::string const packed::name_ = "PACKED";
+
+    packed::packed(std::vector< ::bra::instruction >&& instructions)
+      : ::bra::gate::gate{}, instructions_{std::move(instructions)}
+    { }
+
+    ::bra::state& packed::do_apply(::bra::state& state) const
+    { return state.instructions(instructions_.data(), instructions_.data() + instructions_.size()); }
+
+    std::string const& packed::do_name() const { return name_; }
+    std::string packed::do_representation(
+      std::ostringstream& repr_stream, int const parameter_width) const
+    {
+      repr_stream << std::right << std::setw(parameter_width) << instructions_.size() << " gates";
+      return repr_stream.str();
+    }
+  } // namespace gate
+} // namespace bra
@@ -1,5 +1,8 @@
 #ifndef BRA_NO_MPI
+# include <cstddef>
 # include <vector>
+# include <iterator>
+# include <algorithm>
 
 # include <yampi/communicator.hpp>
 # include <yampi/environment.hpp>
@@ -20,6 +23,7 @@
 # include <ket/mpi/gate/exponential_pauli_z.hpp>
 # include <ket/mpi/gate/exponential_swap.hpp>
 # include <ket/mpi/gate/toffoli.hpp>
+# include <ket/mpi/gate/matrix.hpp>
 # include <ket/mpi/gate/projective_measurement.hpp>
 # include <ket/mpi/gate/clear.hpp>
 # include <ket/mpi/gate/set.hpp>
@@ -40,6 +44,24 @@ namespace bra
   unsigned int paged_unit_mpi_state::do_num_pages() const
   { return data_.num_pages(); }
 
+  bool paged_unit_mpi_state::do_is_unit_mode() const
+  { return true; }
+
+  std::size_t paged_unit_mpi_state::do_local_state_size() const
+  { return data_.size(); }
+
+  void paged_unit_mpi_state::do_copy_local_state_to(std::size_t const first_index, std::size_t const count, complex_type* out) const
+  {
+    data_.complete_page_interchanges();
+    std::copy_n(std::begin(data_) + first_index, count, out);
+  }
+
+  void paged_unit_mpi_state::do_copy_local_state_from(std::size_t const first_index, std::size_t const count, complex_type const* in)
+  {
+    data_.complete_page_interchanges();
+    std::copy_n(in, count, std::begin(data_) + first_index);
+  }
+
   paged_unit_mpi_state::paged_unit_mpi_state(
     ::bra::state::state_integer_type const initial_integer,
     unsigned int const num_local_qubits,
@@ -53,7 +75,7 @@ namespace bra
     yampi::environment const& environment)
     : ::bra::state{total_num_qubits, seed, communicator, environment},
       parallel_policy_{num_threads_per_process},
-      mpi_policy_{num_unit_qubits, num_processes_per_unit},
+      mpi_policy_{num_unit_qubits, num_processes_per_unit, lookahead_},
       data_{
         mpi_policy_, num_local_qubits, num_page_qubits, initial_integer,
         permutation_, communicator, environment}
@@ -72,7 +94,7 @@ namespace bra
     yampi::environment const& environment)
     : ::bra::state{initial_permutation, seed, communicator, environment},
       parallel_policy_{num_threads_per_process},
-      mpi_policy_{num_unit_qubits, num_processes_per_unit},
+      mpi_policy_{num_unit_qubits, num_processes_per_unit, lookahead_},
       data_{
         mpi_policy_, num_local_qubits, num_page_qubits, initial_integer,
         permutation_, communicator, environment}
@@ -904,12 +926,12 @@ namespace bra
   {
     if (seed < 0)
       ket::mpi::generate_events(
-        mpi_policy_, ket::utility::policy::make_sequential(), // parallel_policy_,
+        mpi_policy_, parallel_policy_,
         generated_events_, data_, num_events, random_number_generator_, permutation_,
         communicator_, environment_);
     else
       ket::mpi::generate_events(
-        mpi_policy_, ket::utility::policy::make_sequential(), // parallel_policy_,
+        mpi_policy_, parallel_policy_,
         generated_events_, data_, num_events, random_number_generator_, static_cast<seed_type>(seed), permutation_,
         communicator_, environment_);
   }
@@ -3682,6 +3704,83 @@ namespace bra
       throw bra::too_many_qubits_error{num_control_qubits + 2u};
     }
   }
+
+  void paged_unit_mpi_state::do_matrix(
+    std::vector<complex_type> const& matrix, std::vector<qubit_type> const& qubits)
+  {
+    auto const num_qubits = qubits.size();
+    assert(num_qubits > 0u);
+
+    switch (num_qubits)
+    {
+     case 1u:
+      ket::mpi::gate::matrix(
+        mpi_policy_, parallel_policy_,
+        data_, permutation_, buffer_, communicator_, environment_, matrix, qubits[0u]);
+      break;
+
+     case 2u:
+      ket::mpi::gate::matrix(
+        mpi_policy_, parallel_policy_,
+        data_, permutation_, buffer_, communicator_, environment_, matrix, qubits[0u], qubits[1u]);
+      break;
+
+     case 3u:
+      ket::mpi::gate::matrix(
+        mpi_policy_, parallel_policy_,
+        data_, permutation_, buffer_, communicator_, environment_, matrix, qubits[0u], qubits[1u], qubits[2u]);
+      break;
+
+     case 4u:
+      ket::mpi::gate::matrix(
+        mpi_policy_, parallel_policy_,
+        data_, permutation_, buffer_, communicator_, environment_, matrix, qubits[0u], qubits[1u], qubits[2u], qubits[3u]);
+      break;
+
+     case 5u:
+      ket::mpi::gate::matrix(
+        mpi_policy_, parallel_policy_,
+        data_, permutation_, buffer_, communicator_, environment_, matrix, qubits[0u], qubits[1u], qubits[2u], qubits[3u], qubits[4u]);
+      break;
+
+     case 6u:
+      ket::mpi::gate::matrix(
+        mpi_policy_, parallel_policy_,
+        data_, permutation_, buffer_, communicator_, environment_, matrix, qubits[0u], qubits[1u], qubits[2u], qubits[3u], qubits[4u], qubits[5u]);
+      break;
+
+     default:
+      // qubits are interchanged one by one
+      ket::mpi::gate::matrix(
+        mpi_policy_, parallel_policy_,
+        data_, permutation_, buffer_, communicator_, environment_, matrix, qubits);
+    }
+  }
+
+  // local qubits depend on the permutation, so the matrices are applied one by one
+  void paged_unit_mpi_state::do_blocked_matrices(
+    std::vector<std::vector<complex_type>> const& matrices, std::vector<std::vector<qubit_type>> const& qubits,
+    bit_integer_type const)
+  {
+    assert(matrices.size() == qubits.size());
+    for (auto index = std::size_t{0u}; index < matrices.size(); ++index)
+      do_matrix(matrices[index], qubits[index]);
+  }
+
+  // each table is applied as a diagonal matrix because local qubits depend on the permutation
+  void paged_unit_mpi_state::do_diagonal_batch(
+    std::vector<std::vector<complex_type>> const& tables, std::vector<std::vector<qubit_type>> const& qubits)
+  {
+    assert(tables.size() == qubits.size());
+    for (auto index = std::size_t{0u}; index < tables.size(); ++index)
+    {
+      auto const dim = tables[index].size();
+      auto matrix = std::vector<complex_type>(dim * dim);
+      for (auto diagonal_index = std::size_t{0u}; diagonal_index < dim; ++diagonal_index)
+        matrix[diagonal_index * dim + diagonal_index] = tables[index][diagonal_index];
+      do_matrix(matrix, qubits[index]);
+    }
+  }
 } // namespace bra
 
 
@@ -0,0 +1,92 @@
+#include <cstddef>
+#include <istream>
+#include <vector>
+#include <string>
+#include <iterator>
+#include <algorithm>
+
+#include <boost/algorithm/string/trim.hpp>
+#include <boost/algorithm/string/split.hpp>
+#include <boost/algorithm/string/classification.hpp>
+
+#include <bra/parameter_table.hpp>
+
+
+namespace bra
+{
+  parameter_table_error::parameter_table_error(std::string const& message)
+    : std::runtime_error{message}
+  { }
+
+  namespace parameter_table_detail
+  {
+    // Reads the next nonempty line of input_stream, and splits it into columns separated by commas.
+    // Returns false if no such line remains
+    bool read_columns(std::istream& input_stream, std::string& line, std::vector<std::string>& columns)
+    {
+      while (std::getline(input_stream, line))
+      {
+        boost::algorithm::trim(line);
+        if (line.empty())
+          continue;
+
+        boost::algorithm::split(columns, line, boost::algorithm::is_any_of(","));
+        for (auto& column: columns)
+          boost::algorithm::trim(column);
+        return true;
+      }
+
+      return false;
+    }
+  } // namespace parameter_table_detail
+
+  parameter_table::parameter_table(std::istream& input_stream)
+    : names_{}, rows_{}
+  {
+    auto line = std::string{};
+    if (not ::bra::parameter_table_detail::read_columns(input_stream, line, names_))
+      throw ::bra::parameter_table_error{"no names of parameters"};
+
+    for (auto iter = std::begin(names_), last = std::end(names_); iter != last; ++iter)
+    {
+      if (not iter->empty() and iter->front() == '$')
+        iter->erase(0u, 1u);
+
+      if (iter->empty())
+        throw ::bra::parameter_table_error{"empty name of a parameter"};
+      if (std::find(std::begin(names_), iter, *iter) != iter)
+        throw ::bra::parameter_table_error{"parameter " + *iter + " appears twice"};
+    }
+
+    auto columns = std::vector<std::string>{};
+    columns.reserve(names_.size());
+    while (::bra::parameter_table_detail::read_columns(input_stream, line, columns))
+    {
+      if (columns.size() != names_.size())
+        throw ::bra::parameter_table_error{
+          "row " + std::to_string(rows_.size()) + " has " + std::to_string(columns.size())
+            + " values for " + std::to_string(names_.size()) + " parameters"};
+
+      rows_.push_back(columns);
+    }
+  }
+
+  void parameter_table::substitute(std::vector<std::string>& columns, std::size_t const row_index) const
+  {
+    auto const& values = rows_[row_index];
+    for (auto& column: columns)
+    {
+      if (column.empty() or column.front() != '$')
+        continue;
+
+      auto const found
+        = std::find_if(
+            std::begin(names_), std::end(names_),
+            [&column](std::string const& name) { return column.compare(1u, std::string::npos, name) == 0; });
+      if (found == std::end(names_))
+        throw ::bra::parameter_table_error{"parameter " + column.substr(1u) + " is not given"};
+
+      column = values[static_cast<std::size_t>(found - std::begin(names_))];
+    }
+  }
+} // namespace bra
@@ -1,4 +1,5 @@
 #include <string>
+#include <vector>
 #include <ios>
 #include <iomanip>
 #include <sstream>
@@ -8,6 +9,8 @@
 #include <bra/gate/gate.hpp>
 #include <bra/gate/pauli_y.hpp>
 #include <bra/state.hpp>
+#include <bra/instruction.hpp>
+#include <bra/unitary_matrix.hpp>
 
 
 namespace bra
@@ -23,6 +26,19 @@ namespace bra
     ::bra::state& pauli_y::do_apply(::bra::state& state) const
     { return state.pauli_y(qubit_); }
 
+    std::vector<pauli_y::qubit_type> pauli_y::do_operated_qubits() const
+    { return {qubit_}; }
+
+    std::vector<pauli_y::complex_type> pauli_y::do_unitary_matrix() const
+    { return ::bra::unitary_matrix::pauli_y(); }
+
+    bool pauli_y::do_instruction(::bra::instruction& result) const
+    {
+      result.opcode = ::bra::opcode::pauli_y;
+      result.qubit1 = qubit_;
+      return true;
+    }
+
     std::string const& pauli_y::do_name() const { return name_; }
     std::string pauli_y::do_representation(
       std::ostringstream& repr_stream, int const parameter_width) const
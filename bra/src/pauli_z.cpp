@@ -1,4 +1,5 @@
 #include <string>
+#include <vector>
 #include <ios>
 #include <iomanip>
 #include <sstream>
@@ -8,6 +9,8 @@
 #include <bra/gate/gate.hpp>
 #include <bra/gate/pauli_z.hpp>
 #include <bra/state.hpp>
+#include <bra/instruction.hpp>
+#include <bra/unitary_matrix.hpp>
 
 
 namespace bra
@@ -23,6 +26,19 @@ namespace bra
     ::bra::state& pauli_z::do_apply(::bra::state& state) const
     { return state.pauli_z(qubit_); }
 
+    std::vector<pauli_z::qubit_type> pauli_z::do_operated_qubits() const
+    { return {qubit_}; }
+
+    std::vector<pauli_z::complex_type> pauli_z::do_unitary_matrix() const
+    { return ::bra::unitary_matrix::pauli_z(); }
+
+    bool pauli_z::do_instruction(::bra::instruction& result) const
+    {
+      result.opcode = ::bra::opcode::pauli_z;
+      result.qubit1 = qubit_;
+      return true;
+    }
+
     std::string const& pauli_z::do_name() const { return name_; }
     std::string pauli_z::do_representation(
       std::ostringstream& repr_stream, int const parameter_width) const
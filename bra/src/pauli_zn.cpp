@@ -10,6 +10,7 @@
 #include <bra/gate/gate.hpp>
 #include <bra/gate/pauli_zn.hpp>
 #include <bra/state.hpp>
+#include <bra/unitary_matrix.hpp>
 
 
 namespace bra
@@ -23,6 +24,12 @@ namespace bra
     ::bra::state& pauli_zn::do_apply(::bra::state& state) const
     { return state.pauli_zn(qubits_); }
 
+    std::vector<pauli_zn::qubit_type> pauli_zn::do_operated_qubits() const
+    { return qubits_; }
+
+    std::vector<pauli_zn::complex_type> pauli_zn::do_unitary_matrix() const
+    { return ::bra::unitary_matrix::tensor_power(::bra::unitary_matrix::pauli_z(), qubits_.size()); }
+
     std::string const& pauli_zn::do_name() const { return name_; }
     std::string pauli_zn::do_representation(
       std::ostringstream& repr_stream, int const parameter_width) const
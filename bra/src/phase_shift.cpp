@@ -1,4 +1,5 @@
 #include <string>
+#include <vector>
 #include <ios>
 #include <iomanip>
 #include <sstream>
@@ -8,6 +9,8 @@
 #include <bra/gate/gate.hpp>
 #include <bra/gate/phase_shift.hpp>
 #include <bra/state.hpp>
+#include <bra/instruction.hpp>
+#include <bra/unitary_matrix.hpp>
 
 
 namespace bra
@@ -25,6 +28,20 @@ namespace bra
     ::bra::state& phase_shift::do_apply(::bra::state& state) const
     { return state.phase_shift(phase_coefficient_, qubit_); }
 
+    std::vector<phase_shift::qubit_type> phase_shift::do_operated_qubits() const
+    { return {qubit_}; }
+
+    std::vector<phase_shift::complex_type> phase_shift::do_unitary_matrix() const
+    { return ::bra::unitary_matrix::phase_shift(phase_coefficient_); }
+
+    bool phase_shift::do_instruction(::bra::instruction& result) const
+    {
+      result.opcode = ::bra::opcode::phase_shift;
+      result.phase_coefficient = phase_coefficient_;
+      result.qubit1 = qubit_;
+      return true;
+    }
+
     std::string const& phase_shift::do_name() const { return name_; }
     std::string phase_shift::do_representation(
       std::ostringstream& repr_stream, int const parameter_width) const
@@ -1,22 +1,37 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <vector>
+#include <string>
 #include <random>
 #include <iterator>
+#include <algorithm>
+#include <numeric>
+#include <memory>
+#include <sstream>
 #ifdef BRA_NO_MPI
 # include <chrono>
-# include <memory>
+# include <fstream>
 #endif
 #include <stdexcept>
 
 #ifndef BRA_NO_MPI
+# include <mpi.h>
+
 # include <yampi/communicator.hpp>
 # include <yampi/environment.hpp>
+# include <yampi/rank.hpp>
 # include <yampi/wall_clock.hpp>
 # include <yampi/predefined_datatype.hpp>
 #endif // BRA_NO_MPI
 
 #include <ket/qubit.hpp>
+#ifndef BRA_NO_MPI
+# include <ket/mpi/utility/detail/check_mpi_error.hpp>
+#endif // BRA_NO_MPI
 
 #include <bra/state.hpp>
+#include <bra/instruction.hpp>
 #include <bra/utility/closest_floating_point_of.hpp>
 
 #ifndef BRA_NO_MPI
@@ -25,6 +40,11 @@
 # define BRA_clock std::chrono::system_clock
 #endif
 
+// Number of elements of the state vector written or read at once in bra::state::checkpoint and bra::state::restart
+#ifndef BRA_CHECKPOINT_CHUNK_SIZE
+# define BRA_CHECKPOINT_CHUNK_SIZE 1048576
+#endif // BRA_CHECKPOINT_CHUNK_SIZE
+
 
 namespace bra
 {
@@ -32,6 +52,119 @@ namespace bra
     : std::runtime_error{std::string{"the number of qubits "}.append(std::to_string(num_qubits)).append(" is larger than 6").c_str()}
   { }
 
+  checkpoint_error::checkpoint_error(std::string const& path, std::string const& message)
+    : std::runtime_error{std::string{"checkpoint file "}.append(path).append(": ").append(message).c_str()}
+  { }
+
+  namespace
+  {
+    // Checkpoint files consist of checkpoint_header, permutation of qubits (std::uint64_t per qubit),
+    // outcomes of measurements (std::int64_t per qubit), the random number generator of the root process in text,
+    // and the state vector from data_offset, in which local state vectors are placed in rank order.
+    // In simple mode the state vector is therefore in the order of permutated qubit values, and any number of processes can read it
+    struct checkpoint_header
+    {
+      std::uint64_t magic;
+      std::uint64_t complex_size;
+      std::uint64_t total_num_qubits;
+      std::uint64_t next_gate_index;
+      std::uint64_t num_gates;
+      std::uint64_t circuit_hash;
+      std::uint64_t num_processes;
+      std::uint64_t is_unit_mode;
+      std::uint64_t num_elements;
+      std::uint64_t random_number_generator_size;
+      std::uint64_t data_offset;
+    }; // struct checkpoint_header
+
+    constexpr auto checkpoint_magic = std::uint64_t{0x3254504B43415242u}; // "BRACKPT2"
+    constexpr auto checkpoint_alignment = std::uint64_t{4096u};
+
+    std::uint64_t metadata_size(checkpoint_header const& header)
+    {
+      return sizeof(checkpoint_header)
+        + header.total_num_qubits * (sizeof(std::uint64_t) + sizeof(std::int64_t))
+        + header.random_number_generator_size;
+    }
+
+    template <typename Value>
+    char* put(char* out, Value const& value)
+    {
+      std::memcpy(out, std::addressof(value), sizeof(Value));
+      return out + sizeof(Value);
+    }
+
+    template <typename Value>
+    char const* get(char const* in, Value& value)
+    {
+      std::memcpy(std::addressof(value), in, sizeof(Value));
+      return in + sizeof(Value);
+    }
+
+    std::vector<char> make_metadata(
+      checkpoint_header& header,
+      std::vector<std::uint64_t> const& permutated_bits, std::vector<ket::gate::outcome> const& outcomes,
+      std::string const& random_number_generator_string)
+    {
+      header.random_number_generator_size = random_number_generator_string.size();
+      header.data_offset
+        = (metadata_size(header) + checkpoint_alignment - std::uint64_t{1u}) / checkpoint_alignment * checkpoint_alignment;
+
+      auto result = std::vector<char>(metadata_size(header));
+      auto iter = put(result.data(), header);
+      for (auto const permutated_bit: permutated_bits)
+        iter = put(iter, permutated_bit);
+      for (auto const outcome: outcomes)
+        iter = put(iter, static_cast<std::int64_t>(outcome));
+      std::copy(std::begin(random_number_generator_string), std::end(random_number_generator_string), iter);
+      return result;
+    }
+
+    void read_metadata(
+      std::vector<char> const& metadata, checkpoint_header const& header,
+      std::vector<std::uint64_t>& permutated_bits, std::vector<ket::gate::outcome>& outcomes,
+      std::string& random_number_generator_string)
+    {
+      auto iter = metadata.data() + sizeof(checkpoint_header);
+      permutated_bits.resize(header.total_num_qubits);
+      for (auto& permutated_bit: permutated_bits)
+        iter = get(iter, permutated_bit);
+      outcomes.resize(header.total_num_qubits);
+      for (auto& outcome: outcomes)
+      {
+        auto value = std::int64_t{};
+        iter = get(iter, value);
+        outcome = static_cast<ket::gate::outcome>(value);
+      }
+      random_number_generator_string.assign(iter, iter + header.random_number_generator_size);
+    }
+
+    // returns an empty string if header is consistent with the present state
+    std::string check_header(
+      checkpoint_header const& header, std::uint64_t const complex_size,
+      std::uint64_t const total_num_qubits, std::uint64_t const num_gates, std::uint64_t const circuit_hash,
+      std::uint64_t const num_processes, std::uint64_t const is_unit_mode, std::uint64_t const num_elements)
+    {
+      if (header.magic != checkpoint_magic)
+        return "not a checkpoint file of bra";
+      if (header.complex_size != complex_size)
+        return "the type of complex numbers differs";
+      if (header.total_num_qubits != total_num_qubits)
+        return "the number of qubits differs";
+      if (header.num_gates != num_gates)
+        return "the number of gates differs, which requires the same circuit and the same --optimize, --diagonal-qubits, --fuse-qubits and --block-qubits options";
+      if (header.circuit_hash != circuit_hash)
+        return "the circuit differs, which requires the same circuit and the same --optimize, --diagonal-qubits, --fuse-qubits and --block-qubits options";
+      if (header.is_unit_mode != is_unit_mode)
+        return "the mode differs";
+      if (is_unit_mode != std::uint64_t{0u} and header.num_processes != num_processes)
+        return "the number of processes must be the same in unit mode";
+      if (header.num_elements != num_elements)
+        return "the size of the state vector differs";
+      return std::string{};
+    }
+  } // namespace
+
 #ifndef BRA_NO_MPI
   state::state(
     bit_integer_type const total_num_qubits,
@@ -49,7 +182,11 @@ namespace bra
       real_pair_datatype_{yampi::predefined_datatype<real_type>(), yampi::count{2}, environment},
       communicator_{communicator},
       environment_{environment},
-      finish_times_and_processes_{}
+      lookahead_{},
+      finish_times_and_processes_{},
+      next_gate_index_{0u},
+      num_gates_{0u},
+      circuit_hash_{0u}
   { finish_times_and_processes_.reserve(2u); }
 
   state::state(
@@ -69,7 +206,11 @@ namespace bra
       real_pair_datatype_{yampi::predefined_datatype<real_type>(), yampi::count{2}, environment},
       communicator_{communicator},
       environment_{environment},
-      finish_times_and_processes_{}
+      lookahead_{},
+      finish_times_and_processes_{},
+      next_gate_index_{0u},
+      num_gates_{0u},
+      circuit_hash_{0u}
   { finish_times_and_processes_.reserve(2u); }
 
   state::state(
@@ -89,7 +230,11 @@ namespace bra
       real_pair_datatype_{yampi::predefined_datatype<real_type>(), yampi::count{2}, environment},
       communicator_{communicator},
       environment_{environment},
-      finish_times_and_processes_{}
+      lookahead_{},
+      finish_times_and_processes_{},
+      next_gate_index_{0u},
+      num_gates_{0u},
+      circuit_hash_{0u}
   { finish_times_and_processes_.reserve(2u); }
 
   state::state(
@@ -110,7 +255,11 @@ namespace bra
       real_pair_datatype_{yampi::predefined_datatype<real_type>(), yampi::count{2}, environment},
       communicator_{communicator},
       environment_{environment},
-      finish_times_and_processes_{}
+      lookahead_{},
+      finish_times_and_processes_{},
+      next_gate_index_{0u},
+      num_gates_{0u},
+      circuit_hash_{0u}
   { finish_times_and_processes_.reserve(2u); }
 #else // BRA_NO_MPI
   state::state(bit_integer_type const total_num_qubits, seed_type const seed)
@@ -120,7 +269,10 @@ namespace bra
       measured_value_{},
       generated_events_{},
       random_number_generator_{seed},
-      finish_times_and_processes_{}
+      finish_times_and_processes_{},
+      next_gate_index_{0u},
+      num_gates_{0u},
+      circuit_hash_{0u}
   { finish_times_and_processes_.reserve(2u); }
 #endif // BRA_NO_MPI
 
@@ -274,6 +426,385 @@ namespace bra
 
     return *this;
   }
+#ifndef BRA_NO_MPI
+  ::bra::state& state::checkpoint(std::string const& path)
+  {
+    auto const mpi_communicator = communicator_.mpi_comm();
+    auto const num_local_elements = static_cast<std::uint64_t>(do_local_state_size());
+
+    // MPI_Exscan leaves the result of rank 0 undefined
+    auto first_element_index = std::uint64_t{0u};
+    ::ket::mpi::utility::detail::check_mpi_error(
+      MPI_Exscan(&num_local_elements, &first_element_index, 1, MPI_UINT64_T, MPI_SUM, mpi_communicator),
+      "MPI_Exscan");
+    auto const is_root = communicator_.rank(environment_) == yampi::rank{0};
+    if (is_root)
+      first_element_index = std::uint64_t{0u};
+
+    auto num_elements = std::uint64_t{};
+    ::ket::mpi::utility::detail::check_mpi_error(
+      MPI_Allreduce(&num_local_elements, &num_elements, 1, MPI_UINT64_T, MPI_SUM, mpi_communicator),
+      "MPI_Allreduce");
+
+    auto header = checkpoint_header{};
+    header.magic = checkpoint_magic;
+    header.complex_size = sizeof(complex_type);
+    header.total_num_qubits = total_num_qubits_;
+    header.next_gate_index = next_gate_index_;
+    header.num_gates = num_gates_;
+    header.circuit_hash = circuit_hash_;
+    header.num_processes = static_cast<std::uint64_t>(communicator_.size(environment_));
+    header.is_unit_mode = static_cast<std::uint64_t>(do_is_unit_mode());
+    header.num_elements = num_elements;
+
+    auto permutated_bits = std::vector<std::uint64_t>{};
+    permutated_bits.reserve(total_num_qubits_);
+    for (auto const& permutated_qubit: permutation_)
+      permutated_bits.push_back(static_cast<std::uint64_t>(static_cast<bit_integer_type>(permutated_qubit.qubit())));
+
+    auto random_number_generator_stream = std::ostringstream{};
+    random_number_generator_stream << random_number_generator_;
+    auto const metadata = make_metadata(header, permutated_bits, last_outcomes_, random_number_generator_stream.str());
+
+    auto file = MPI_File{};
+    ::ket::mpi::utility::detail::check_mpi_error(
+      MPI_File_open(mpi_communicator, path.c_str(), MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL, &file),
+      "MPI_File_open: " + path);
+    ::ket::mpi::utility::detail::check_mpi_error(
+      MPI_File_set_size(file, static_cast<MPI_Offset>(header.data_offset + num_elements * sizeof(complex_type))),
+      "MPI_File_set_size: " + path);
+
+    if (is_root)
+      ::ket::mpi::utility::detail::check_mpi_error(
+        MPI_File_write_at(
+          file, 0, metadata.data(), static_cast<int>(metadata.size()), MPI_BYTE, MPI_STATUS_IGNORE),
+        "MPI_File_write_at: " + path);
+
+    // all processes call MPI_File_write_at_all the same number of times even if their local state vectors have different sizes
+    auto const chunk_size = std::uint64_t{BRA_CHECKPOINT_CHUNK_SIZE};
+    auto const num_local_chunks = (num_local_elements + chunk_size - std::uint64_t{1u}) / chunk_size;
+    auto num_chunks = std::uint64_t{};
+    ::ket::mpi::utility::detail::check_mpi_error(
+      MPI_Allreduce(&num_local_chunks, &num_chunks, 1, MPI_UINT64_T, MPI_MAX, mpi_communicator),
+      "MPI_Allreduce");
+
+    auto chunk = std::vector<complex_type>(std::min(chunk_size, num_local_elements));
+    for (auto chunk_index = std::uint64_t{0u}; chunk_index < num_chunks; ++chunk_index)
+    {
+      auto const first_index = std::min(chunk_index * chunk_size, num_local_elements);
+      auto const count = std::min(chunk_size, num_local_elements - first_index);
+      do_copy_local_state_to(first_index, count, chunk.data());
+      ::ket::mpi::utility::detail::check_mpi_error(
+        MPI_File_write_at_all(
+          file, static_cast<MPI_Offset>(header.data_offset + (first_element_index + first_index) * sizeof(complex_type)),
+          chunk.data(), static_cast<int>(count * sizeof(complex_type)), MPI_BYTE, MPI_STATUS_IGNORE),
+        "MPI_File_write_at_all: " + path);
+    }
+
+    ::ket::mpi::utility::detail::check_mpi_error(MPI_File_close(&file), "MPI_File_close: " + path);
+    return *this;
+  }
+
+  void state::restart(std::string const& path)
+  {
+    auto const mpi_communicator = communicator_.mpi_comm();
+    auto const num_local_elements = static_cast<std::uint64_t>(do_local_state_size());
+
+    auto first_element_index = std::uint64_t{0u};
+    ::ket::mpi::utility::detail::check_mpi_error(
+      MPI_Exscan(&num_local_elements, &first_element_index, 1, MPI_UINT64_T, MPI_SUM, mpi_communicator),
+      "MPI_Exscan");
+    if (communicator_.rank(environment_) == yampi::rank{0})
+      first_element_index = std::uint64_t{0u};
+
+    auto num_elements = std::uint64_t{};
+    ::ket::mpi::utility::detail::check_mpi_error(
+      MPI_Allreduce(&num_local_elements, &num_elements, 1, MPI_UINT64_T, MPI_SUM, mpi_communicator),
+      "MPI_Allreduce");
+
+    auto file = MPI_File{};
+    if (MPI_File_open(mpi_communicator, path.c_str(), MPI_MODE_RDONLY, MPI_INFO_NULL, &file) != MPI_SUCCESS)
+      throw ::bra::checkpoint_error{path, "cannot open"};
+
+    // every process reads the same header, so that all processes throw the same exception if any
+    auto header = checkpoint_header{};
+    ::ket::mpi::utility::detail::check_mpi_error(
+      MPI_File_read_at_all(file, 0, &header, static_cast<int>(sizeof(checkpoint_header)), MPI_BYTE, MPI_STATUS_IGNORE),
+      "MPI_File_read_at_all: " + path);
+    auto const error_message
+      = check_header(
+          header, sizeof(complex_type), total_num_qubits_, num_gates_, circuit_hash_,
+          static_cast<std::uint64_t>(communicator_.size(environment_)),
+          static_cast<std::uint64_t>(do_is_unit_mode()), num_elements);
+    if (not error_message.empty())
+    {
+      MPI_File_close(&file);
+      throw ::bra::checkpoint_error{path, error_message};
+    }
+
+    auto metadata = std::vector<char>(metadata_size(header));
+    ::ket::mpi::utility::detail::check_mpi_error(
+      MPI_File_read_at_all(file, 0, metadata.data(), static_cast<int>(metadata.size()), MPI_BYTE, MPI_STATUS_IGNORE),
+      "MPI_File_read_at_all: " + path);
+
+    auto const chunk_size = std::uint64_t{BRA_CHECKPOINT_CHUNK_SIZE};
+    auto const num_local_chunks = (num_local_elements + chunk_size - std::uint64_t{1u}) / chunk_size;
+    auto num_chunks = std::uint64_t{};
+    ::ket::mpi::utility::detail::check_mpi_error(
+      MPI_Allreduce(&num_local_chunks, &num_chunks, 1, MPI_UINT64_T, MPI_MAX, mpi_communicator),
+      "MPI_Allreduce");
+
+    auto chunk = std::vector<complex_type>(std::min(chunk_size, num_local_elements));
+    for (auto chunk_index = std::uint64_t{0u}; chunk_index < num_chunks; ++chunk_index)
+    {
+      auto const first_index = std::min(chunk_index * chunk_size, num_local_elements);
+      auto const count = std::min(chunk_size, num_local_elements - first_index);
+      ::ket::mpi::utility::detail::check_mpi_error(
+        MPI_File_read_at_all(
+          file, static_cast<MPI_Offset>(header.data_offset + (first_element_index + first_index) * sizeof(complex_type)),
+          chunk.data(), static_cast<int>(count * sizeof(complex_type)), MPI_BYTE, MPI_STATUS_IGNORE),
+        "MPI_File_read_at_all: " + path);
+      do_copy_local_state_from(first_index, count, chunk.data());
+    }
+
+    ::ket::mpi::utility::detail::check_mpi_error(MPI_File_close(&file), "MPI_File_close: " + path);
+
+    auto permutated_bits = std::vector<std::uint64_t>{};
+    auto random_number_generator_string = std::string{};
+    read_metadata(metadata, header, permutated_bits, last_outcomes_, random_number_generator_string);
+
+    auto permutated_qubits = std::vector<permutated_qubit_type>{};
+    permutated_qubits.reserve(permutated_bits.size());
+    for (auto const permutated_bit: permutated_bits)
+      permutated_qubits.push_back(permutated_qubit_type{static_cast<bit_integer_type>(permutated_bit)});
+    permutation_.assign(std::begin(permutated_qubits), std::end(permutated_qubits));
+
+    auto random_number_generator_stream = std::istringstream{random_number_generator_string};
+    random_number_generator_stream >> random_number_generator_;
+
+    next_gate_index_ = static_cast<std::size_t>(header.next_gate_index);
+  }
+#else // BRA_NO_MPI
+  ::bra::state& state::checkpoint(std::string const& path)
+  {
+    auto const num_elements = static_cast<std::uint64_t>(do_local_state_size());
+
+    auto header = checkpoint_header{};
+    header.magic = checkpoint_magic;
+    header.complex_size = sizeof(complex_type);
+    header.total_num_qubits = total_num_qubits_;
+    header.next_gate_index = next_gate_index_;
+    header.num_gates = num_gates_;
+    header.circuit_hash = circuit_hash_;
+    header.num_processes = std::uint64_t{1u};
+    header.is_unit_mode = std::uint64_t{0u};
+    header.num_elements = num_elements;
+
+    auto permutated_bits = std::vector<std::uint64_t>(total_num_qubits_);
+    std::iota(std::begin(permutated_bits), std::end(permutated_bits), std::uint64_t{0u});
+
+    auto random_number_generator_stream = std::ostringstream{};
+    random_number_generator_stream << random_number_generator_;
+    auto const metadata = make_metadata(header, permutated_bits, last_outcomes_, random_number_generator_stream.str());
+
+    auto file = std::ofstream{path, std::ios::binary | std::ios::trunc};
+    if (not file)
+      throw ::bra::checkpoint_error{path, "cannot open"};
+    file.write(metadata.data(), static_cast<std::streamsize>(metadata.size()));
+    file.seekp(static_cast<std::streamoff>(header.data_offset));
+
+    auto const chunk_size = std::uint64_t{BRA_CHECKPOINT_CHUNK_SIZE};
+    auto chunk = std::vector<complex_type>(std::min(chunk_size, num_elements));
+    for (auto first_index = std::uint64_t{0u}; first_index < num_elements; first_index += chunk_size)
+    {
+      auto const count = std::min(chunk_size, num_elements - first_index);
+      do_copy_local_state_to(first_index, count, chunk.data());
+      file.write(reinterpret_cast<char const*>(chunk.data()), static_cast<std::streamsize>(count * sizeof(complex_type)));
+    }
+
+    if (not file)
+      throw ::bra::checkpoint_error{path, "cannot write"};
+    return *this;
+  }
+
+  void state::restart(std::string const& path)
+  {
+    auto const num_elements = static_cast<std::uint64_t>(do_local_state_size());
+
+    auto file = std::ifstream{path, std::ios::binary};
+    if (not file)
+      throw ::bra::checkpoint_error{path, "cannot open"};
+
+    auto header = checkpoint_header{};
+    file.read(reinterpret_cast<char*>(std::addressof(header)), static_cast<std::streamsize>(sizeof(checkpoint_header)));
+    if (not file)
+      throw ::bra::checkpoint_error{path, "cannot read"};
+    auto const error_message
+      = check_header(
+          header, sizeof(complex_type), total_num_qubits_, num_gates_, circuit_hash_,
+          header.num_processes, std::uint64_t{0u}, num_elements);
+    if (not error_message.empty())
+      throw ::bra::checkpoint_error{path, error_message};
+
+    auto metadata = std::vector<char>(metadata_size(header));
+    file.seekg(0);
+    file.read(metadata.data(), static_cast<std::streamsize>(metadata.size()));
+
+    auto permutated_bits = std::vector<std::uint64_t>{};
+    auto random_number_generator_string = std::string{};
+    read_metadata(metadata, header, permutated_bits, last_outcomes_, random_number_generator_string);
+
+    // the state vector written by MPI versions is in the order of permutated qubit values
+    for (auto bit = std::uint64_t{0u}; bit < permutated_bits.size(); ++bit)
+      if (permutated_bits[bit] != bit)
+        throw ::bra::checkpoint_error{path, "qubits are permutated, which cannot be read by the nompi version"};
+
+    file.seekg(static_cast<std::streamoff>(header.data_offset));
+    auto const chunk_size = std::uint64_t{BRA_CHECKPOINT_CHUNK_SIZE};
+    auto chunk = std::vector<complex_type>(std::min(chunk_size, num_elements));
+    for (auto first_index = std::uint64_t{0u}; first_index < num_elements; first_index += chunk_size)
+    {
+      auto const count = std::min(chunk_size, num_elements - first_index);
+      file.read(reinterpret_cast<char*>(chunk.data()), static_cast<std::streamsize>(count * sizeof(complex_type)));
+      do_copy_local_state_from(first_index, count, chunk.data());
+    }
+
+    if (not file)
+      throw ::bra::checkpoint_error{path, "cannot read"};
+
+    auto random_number_generator_stream = std::istringstream{random_number_generator_string};
+    random_number_generator_stream >> random_number_generator_;
+
+    next_gate_index_ = static_cast<std::size_t>(header.next_gate_index);
+  }
+
+  void state::reset(state_integer_type const initial_integer, seed_type const seed)
+  {
+    do_reset(initial_integer);
+
+    std::fill(std::begin(last_outcomes_), std::end(last_outcomes_), ket::gate::outcome::unspecified);
+    maybe_expectation_values_ = boost::none;
+    measured_value_ = state_integer_type{};
+    generated_events_.clear();
+    random_number_generator_.seed(seed);
+    finish_times_and_processes_.clear();
+    next_gate_index_ = std::size_t{0u};
+  }
+#endif // BRA_NO_MPI
+
+  void state::do_instructions(::bra::instruction const* const first, ::bra::instruction const* const last)
+  {
+    for (auto iter = first; iter != last; ++iter)
+    {
+      auto const& instruction = *iter;
+      switch (instruction.opcode)
+      {
+       case ::bra::opcode::hadamard:
+        hadamard(instruction.qubit1);
+        break;
+
+       case ::bra::opcode::not_:
+        not_(instruction.qubit1);
+        break;
+
+       case ::bra::opcode::pauli_x:
+        pauli_x(instruction.qubit1);
+        break;
+
+       case ::bra::opcode::pauli_y:
+        pauli_y(instruction.qubit1);
+        break;
+
+       case ::bra::opcode::pauli_z:
+        pauli_z(instruction.qubit1);
+        break;
+
+       case ::bra::opcode::swap:
+        swap(instruction.qubit1, instruction.qubit2);
+        break;
+
+       case ::bra::opcode::u1:
+        u1(instruction.phase, instruction.qubit1);
+        break;
+
+       case ::bra::opcode::adj_u1:
+        adj_u1(instruction.phase, instruction.qubit1);
+        break;
+
+       case ::bra::opcode::phase_shift:
+        phase_shift(instruction.phase_coefficient, instruction.qubit1);
+        break;
+
+       case ::bra::opcode::adj_phase_shift:
+        adj_phase_shift(instruction.phase_coefficient, instruction.qubit1);
+        break;
+
+       case ::bra::opcode::x_rotation_half_pi:
+        x_rotation_half_pi(instruction.qubit1);
+        break;
+
+       case ::bra::opcode::adj_x_rotation_half_pi:
+        adj_x_rotation_half_pi(instruction.qubit1);
+        break;
+
+       case ::bra::opcode::y_rotation_half_pi:
+        y_rotation_half_pi(instruction.qubit1);
+        break;
+
+       case ::bra::opcode::adj_y_rotation_half_pi:
+        adj_y_rotation_half_pi(instruction.qubit1);
+        break;
+
+       case ::bra::opcode::exponential_pauli_x:
+        exponential_pauli_x(instruction.phase, instruction.qubit1);
+        break;
+
+       case ::bra::opcode::adj_exponential_pauli_x:
+        adj_exponential_pauli_x(instruction.phase, instruction.qubit1);
+        break;
+
+       case ::bra::opcode::exponential_pauli_y:
+        exponential_pauli_y(instruction.phase, instruction.qubit1);
+        break;
+
+       case ::bra::opcode::adj_exponential_pauli_y:
+        adj_exponential_pauli_y(instruction.phase, instruction.qubit1);
+        break;
+
+       case ::bra::opcode::exponential_pauli_z:
+        exponential_pauli_z(instruction.phase, instruction.qubit1);
+        break;
+
+       case ::bra::opcode::adj_exponential_pauli_z:
+        adj_exponential_pauli_z(instruction.phase, instruction.qubit1);
+        break;
+
+       case ::bra::opcode::exponential_pauli_zz:
+        exponential_pauli_zz(instruction.phase, instruction.qubit1, instruction.qubit2);
+        break;
+
+       case ::bra::opcode::adj_exponential_pauli_zz:
+        adj_exponential_pauli_zz(instruction.phase, instruction.qubit1, instruction.qubit2);
+        break;
+
+       case ::bra::opcode::controlled_not:
+        controlled_not(instruction.qubit1, instruction.control_qubit);
+        break;
+
+       case ::bra::opcode::controlled_pauli_z:
+        controlled_pauli_z(instruction.qubit1, instruction.control_qubit);
+        break;
+
+       case ::bra::opcode::controlled_phase_shift:
+        controlled_phase_shift(instruction.phase_coefficient, instruction.qubit1, instruction.control_qubit);
+        break;
+
+       case ::bra::opcode::adj_controlled_phase_shift:
+        adj_controlled_phase_shift(instruction.phase_coefficient, instruction.qubit1, instruction.control_qubit);
+        break;
+      }
+    }
+  }
 } // namespace bra
 
 
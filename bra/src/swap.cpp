@@ -1,4 +1,5 @@
 #include <string>
+#include <vector>
 #include <ios>
 #include <iomanip>
 #include <sstream>
@@ -8,6 +9,8 @@
 #include <bra/gate/gate.hpp>
 #include <bra/gate/swap.hpp>
 #include <bra/state.hpp>
+#include <bra/instruction.hpp>
+#include <bra/unitary_matrix.hpp>
 
 
 namespace bra
@@ -23,6 +26,20 @@ namespace bra
     ::bra::state& swap::do_apply(::bra::state& state) const
     { return state.swap(qubit1_, qubit2_); }
 
+    std::vector<swap::qubit_type> swap::do_operated_qubits() const
+    { return {qubit1_, qubit2_}; }
+
+    std::vector<swap::complex_type> swap::do_unitary_matrix() const
+    { return ::bra::unitary_matrix::swap(); }
+
+    bool swap::do_instruction(::bra::instruction& result) const
+    {
+      result.opcode = ::bra::opcode::swap;
+      result.qubit1 = qubit1_;
+      result.qubit2 = qubit2_;
+      return true;
+    }
+
     std::string const& swap::do_name() const { return name_; }
     std::string swap::do_representation(
       std::ostringstream& repr_stream, int const parameter_width) const
@@ -1,4 +1,5 @@
 #include <string>
+#include <vector>
 #include <ios>
 #include <iomanip>
 #include <sstream>
@@ -9,6 +10,7 @@
 #include <bra/gate/gate.hpp>
 #include <bra/gate/toffoli.hpp>
 #include <bra/state.hpp>
+#include <bra/unitary_matrix.hpp>
 
 
 namespace bra
@@ -26,6 +28,12 @@ namespace bra
     ::bra::state& toffoli::do_apply(::bra::state& state) const
     { return state.toffoli(target_qubit_, control_qubit1_, control_qubit2_); }
 
+    std::vector<toffoli::qubit_type> toffoli::do_operated_qubits() const
+    { return {target_qubit_, control_qubit1_.qubit(), control_qubit2_.qubit()}; }
+
+    std::vector<toffoli::complex_type> toffoli::do_unitary_matrix() const
+    { return ::bra::unitary_matrix::controlled(::bra::unitary_matrix::pauli_x(), 2u); }
+
     std::string const& toffoli::do_name() const { return name_; }
     std::string toffoli::do_representation(
       std::ostringstream& repr_stream, int const parameter_width) const
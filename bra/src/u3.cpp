@@ -1,4 +1,5 @@
 #include <string>
+#include <vector>
 #include <ios>
 #include <iomanip>
 #include <sstream>
@@ -8,6 +9,7 @@
 #include <bra/gate/gate.hpp>
 #include <bra/gate/u3.hpp>
 #include <bra/state.hpp>
+#include <bra/unitary_matrix.hpp>
 
 
 namespace bra
@@ -24,6 +26,12 @@ namespace bra
     ::bra::state& u3::do_apply(::bra::state& state) const
     { return state.u3(phase1_, phase2_, phase3_, qubit_); }
 
+    std::vector<u3::qubit_type> u3::do_operated_qubits() const
+    { return {qubit_}; }
+
+    std::vector<u3::complex_type> u3::do_unitary_matrix() const
+    { return ::bra::unitary_matrix::u3(phase1_, phase2_, phase3_); }
+
     std::string const& u3::do_name() const { return name_; }
     std::string u3::do_representation(
       std::ostringstream& repr_stream, int const parameter_width) const
@@ -1,5 +1,8 @@
 #ifndef BRA_NO_MPI
+# include <cstddef>
 # include <vector>
+# include <iterator>
+# include <algorithm>
 
 # include <yampi/communicator.hpp>
 # include <yampi/environment.hpp>
@@ -20,6 +23,8 @@
 # include <ket/mpi/gate/exponential_pauli_z.hpp>
 # include <ket/mpi/gate/exponential_swap.hpp>
 # include <ket/mpi/gate/toffoli.hpp>
+# include <ket/mpi/gate/matrix.hpp>
+# include <ket/mpi/gate/diagonal_batch.hpp>
 # include <ket/mpi/gate/projective_measurement.hpp>
 # include <ket/mpi/gate/clear.hpp>
 # include <ket/mpi/gate/set.hpp>
@@ -40,6 +45,18 @@ namespace bra
   unsigned int unit_mpi_state::do_num_pages() const
   { return 1u; }
 
+  bool unit_mpi_state::do_is_unit_mode() const
+  { return true; }
+
+  std::size_t unit_mpi_state::do_local_state_size() const
+  { return data_.size(); }
+
+  void unit_mpi_state::do_copy_local_state_to(std::size_t const first_index, std::size_t const count, complex_type* out) const
+  { std::copy_n(std::begin(data_) + first_index, count, out); }
+
+  void unit_mpi_state::do_copy_local_state_from(std::size_t const first_index, std::size_t const count, complex_type const* in)
+  { std::copy_n(in, count, std::begin(data_) + first_index); }
+
 # ifndef BRAKET_ENABLE_MULTIPLE_USES_OF_BUFFER_FOR_ONE_DATA_TRANSFER_IF_NO_PAGE_EXISTS
   unit_mpi_state::unit_mpi_state(
     ::bra::state::state_integer_type const initial_integer,
@@ -53,7 +70,7 @@ namespace bra
     yampi::environment const& environment)
     : ::bra::state{total_num_qubits, seed, communicator, environment},
       parallel_policy_{num_threads_per_process},
-      mpi_policy_{num_unit_qubits, num_processes_per_unit},
+      mpi_policy_{num_unit_qubits, num_processes_per_unit, lookahead_},
       data_{generate_initial_data(num_local_qubits, initial_integer, communicator, environment)}
   { }
 
@@ -69,7 +86,7 @@ namespace bra
     yampi::environment const& environment)
     : ::bra::state{initial_permutation, seed, communicator, environment},
       parallel_policy_{num_threads_per_process},
-      mpi_policy_{num_unit_qubits, num_processes_per_unit},
+      mpi_policy_{num_unit_qubits, num_processes_per_unit, lookahead_},
       data_{generate_initial_data(num_local_qubits, initial_integer, communicator, environment)}
   { }
 # else // BRAKET_ENABLE_MULTIPLE_USES_OF_BUFFER_FOR_ONE_DATA_TRANSFER_IF_NO_PAGE_EXISTS
@@ -86,7 +103,7 @@ namespace bra
     yampi::environment const& environment)
     : ::bra::state{total_num_qubits, seed, num_elements_in_buffer, communicator, environment},
       parallel_policy_{num_threads_per_process},
-      mpi_policy_{num_unit_qubits, num_processes_per_unit},
+      mpi_policy_{num_unit_qubits, num_processes_per_unit, lookahead_},
       data_{generate_initial_data(num_local_qubits, initial_integer, communicator, environment)}
   { }
 
@@ -103,7 +120,7 @@ namespace bra
     yampi::environment const& environment)
     : ::bra::state{initial_permutation, seed, num_elements_in_buffer, communicator, environment},
       parallel_policy_{num_threads_per_process},
-      mpi_policy_{num_unit_qubits, num_processes_per_unit},
+      mpi_policy_{num_unit_qubits, num_processes_per_unit, lookahead_},
       data_{generate_initial_data(num_local_qubits, initial_integer, communicator, environment)}
   { }
 # endif // BRAKET_ENABLE_MULTIPLE_USES_OF_BUFFER_FOR_ONE_DATA_TRANSFER_IF_NO_PAGE_EXISTS
@@ -113,11 +130,22 @@ namespace bra
     ::bra::state::state_integer_type const initial_integer,
     yampi::communicator const& communicator, yampi::environment const& environment) const
   {
+# ifndef KET_USE_SHARED_MEMORY_INTERCHANGE
     auto result
       = data_type(
           ket::utility::integer_exp2<std::size_t>(num_local_qubits)
             * ket::mpi::utility::policy::num_data_blocks(mpi_policy_, communicator, environment),
           complex_type{0});
+# else // KET_USE_SHARED_MEMORY_INTERCHANGE
+    // the node communicator is created here, not in the allocation, because creating it is collective over MPI_COMM_WORLD
+    ket::mpi::utility::create_node_communicator();
+    // the window remembers communicator, with which amplitudes are swapped in place
+    auto result
+      = data_type(
+          ket::utility::integer_exp2<std::size_t>(num_local_qubits)
+            * ket::mpi::utility::policy::num_data_blocks(mpi_policy_, communicator, environment),
+          complex_type{0}, data_type::allocator_type{communicator});
+# endif // KET_USE_SHARED_MEMORY_INTERCHANGE
 
     auto const rank_index
       = ket::mpi::utility::qubit_value_to_rank_index(
@@ -955,12 +983,12 @@ namespace bra
   {
     if (seed < 0)
       ket::mpi::generate_events(
-        mpi_policy_, ket::utility::policy::make_sequential(), // parallel_policy_,
+        mpi_policy_, parallel_policy_,
         generated_events_, data_, num_events, random_number_generator_, permutation_,
         communicator_, environment_);
     else
       ket::mpi::generate_events(
-        mpi_policy_, ket::utility::policy::make_sequential(), // parallel_policy_,
+        mpi_policy_, parallel_policy_,
         generated_events_, data_, num_events, random_number_generator_, static_cast<seed_type>(seed), permutation_,
         communicator_, environment_);
   }
@@ -3733,6 +3761,121 @@ namespace bra
       throw bra::too_many_qubits_error{num_control_qubits + 2u};
     }
   }
+
+  void unit_mpi_state::do_matrix(
+    std::vector<complex_type> const& matrix, std::vector<qubit_type> const& qubits)
+  {
+    auto const num_qubits = qubits.size();
+    assert(num_qubits > 0u);
+
+    switch (num_qubits)
+    {
+     case 1u:
+      ket::mpi::gate::matrix(
+        mpi_policy_, parallel_policy_,
+        data_, permutation_, buffer_, communicator_, environment_, matrix, qubits[0u]);
+      break;
+
+     case 2u:
+      ket::mpi::gate::matrix(
+        mpi_policy_, parallel_policy_,
+        data_, permutation_, buffer_, communicator_, environment_, matrix, qubits[0u], qubits[1u]);
+      break;
+
+     case 3u:
+      ket::mpi::gate::matrix(
+        mpi_policy_, parallel_policy_,
+        data_, permutation_, buffer_, communicator_, environment_, matrix, qubits[0u], qubits[1u], qubits[2u]);
+      break;
+
+     case 4u:
+      ket::mpi::gate::matrix(
+        mpi_policy_, parallel_policy_,
+        data_, permutation_, buffer_, communicator_, environment_, matrix, qubits[0u], qubits[1u], qubits[2u], qubits[3u]);
+      break;
+
+     case 5u:
+      ket::mpi::gate::matrix(
+        mpi_policy_, parallel_policy_,
+        data_, permutation_, buffer_, communicator_, environment_, matrix, qubits[0u], qubits[1u], qubits[2u], qubits[3u], qubits[4u]);
+      break;
+
+     case 6u:
+      ket::mpi::gate::matrix(
+        mpi_policy_, parallel_policy_,
+        data_, permutation_, buffer_, communicator_, environment_, matrix, qubits[0u], qubits[1u], qubits[2u], qubits[3u], qubits[4u], qubits[5u]);
+      break;
+
+     default:
+      // qubits are interchanged one by one
+      ket::mpi::gate::matrix(
+        mpi_policy_, parallel_policy_,
+        data_, permutation_, buffer_, communicator_, environment_, matrix, qubits);
+    }
+  }
+
+  // local qubits depend on the permutation, so the matrices are applied one by one
+  void unit_mpi_state::do_blocked_matrices(
+    std::vector<std::vector<complex_type>> const& matrices, std::vector<std::vector<qubit_type>> const& qubits,
+    bit_integer_type const)
+  {
+    assert(matrices.size() == qubits.size());
+    for (auto index = std::size_t{0u}; index < matrices.size(); ++index)
+      do_matrix(matrices[index], qubits[index]);
+  }
+
+  // consecutive tables are applied in one sweep as long as all their qubits can be local qubits at once
+  void unit_mpi_state::do_diagonal_batch(
+    std::vector<std::vector<complex_type>> const& tables, std::vector<std::vector<qubit_type>> const& qubits)
+  {
+    assert(tables.size() == qubits.size());
+    auto const num_local_qubits
+      = static_cast<std::size_t>(ket::mpi::utility::policy::num_local_qubits(mpi_policy_, data_, communicator_, environment_));
+
+    auto operated_qubits = std::vector<qubit_type>{};
+    for (auto const& table_qubits: qubits)
+      for (auto const qubit: table_qubits)
+        if (std::find(std::begin(operated_qubits), std::end(operated_qubits), qubit) == std::end(operated_qubits))
+          operated_qubits.push_back(qubit);
+    if (operated_qubits.size() <= num_local_qubits)
+    {
+      ket::mpi::gate::diagonal_batch(
+        mpi_policy_, parallel_policy_,
+        data_, permutation_, buffer_, communicator_, environment_, tables, qubits);
+      return;
+    }
+
+    auto first_index = std::size_t{0u};
+    operated_qubits.clear();
+    for (auto index = std::size_t{0u}; index <= tables.size(); ++index)
+    {
+      auto const num_new_qubits
+        = index == tables.size()
+          ? std::size_t{0u}
+          : static_cast<std::size_t>(std::count_if(
+              std::begin(qubits[index]), std::end(qubits[index]),
+              [&operated_qubits](qubit_type const qubit)
+              { return std::find(std::begin(operated_qubits), std::end(operated_qubits), qubit) == std::end(operated_qubits); }));
+      if (index < tables.size() and operated_qubits.size() + num_new_qubits <= num_local_qubits)
+      {
+        for (auto const qubit: qubits[index])
+          if (std::find(std::begin(operated_qubits), std::end(operated_qubits), qubit) == std::end(operated_qubits))
+            operated_qubits.push_back(qubit);
+        continue;
+      }
+
+      ket::mpi::gate::diagonal_batch(
+        mpi_policy_, parallel_policy_,
+        data_, permutation_, buffer_, communicator_, environment_,
+        std::vector<std::vector<complex_type>>(std::begin(tables) + first_index, std::begin(tables) + index),
+        std::vector<std::vector<qubit_type>>(std::begin(qubits) + first_index, std::begin(qubits) + index));
+
+      first_index = index;
+      operated_qubits.clear();
+      if (index < tables.size())
+        operated_qubits.assign(std::begin(qubits[index]), std::end(qubits[index]));
+    }
+  }
 } // namespace bra
 
 
@@ -0,0 +1,256 @@
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <complex>
+#include <vector>
+#include <iterator>
+#include <algorithm>
+#include <utility>
+
+#include <ket/utility/exp_i.hpp>
+#include <ket/utility/imaginary_unit.hpp>
+#include <ket/utility/integer_exp2.hpp>
+#include <ket/utility/integer_log2.hpp>
+
+#include <bra/unitary_matrix.hpp>
+#include <bra/state.hpp>
+
+
+namespace bra
+{
+  namespace unitary_matrix
+  {
+    namespace
+    {
+      std::size_t dimension(matrix_type const& matrix)
+      {
+        auto const result = static_cast<std::size_t>(std::sqrt(static_cast<double>(matrix.size())) + 0.5);
+        assert(result * result == matrix.size());
+        return result;
+      }
+
+      real_type one_div_root_two() { using std::sqrt; return real_type{1} / sqrt(real_type{2}); }
+    } // namespace
+
+    matrix_type identity(std::size_t const num_qubits)
+    {
+      auto const dim = ket::utility::integer_exp2<std::size_t>(num_qubits);
+      auto result = matrix_type(dim * dim);
+      for (auto index = std::size_t{0u}; index < dim; ++index)
+        result[index * dim + index] = complex_type{real_type{1}};
+      return result;
+    }
+
+    matrix_type hadamard()
+    {
+      auto const x = one_div_root_two();
+      return {x, x, x, -x};
+    }
+
+    matrix_type pauli_x()
+    { return {real_type{0}, real_type{1}, real_type{1}, real_type{0}}; }
+
+    matrix_type pauli_y()
+    {
+      auto const i = ket::utility::imaginary_unit<complex_type>();
+      return {real_type{0}, -i, i, real_type{0}};
+    }
+
+    matrix_type pauli_z()
+    { return {real_type{1}, real_type{0}, real_type{0}, real_type{-1}}; }
+
+    matrix_type swap()
+    {
+      auto result = identity(2u);
+      std::swap(result[0b01u * 4u + 0b01u], result[0b01u * 4u + 0b10u]);
+      std::swap(result[0b10u * 4u + 0b10u], result[0b10u * 4u + 0b01u]);
+      return result;
+    }
+
+    matrix_type phase_shift(complex_type const& phase_coefficient)
+    { return {real_type{1}, real_type{0}, real_type{0}, phase_coefficient}; }
+
+    matrix_type u1(real_type const phase)
+    { return phase_shift(ket::utility::exp_i<complex_type>(phase)); }
+
+    // U2(theta, theta') = [[1, -e^{i theta'}], [e^{i theta}, e^{i(theta + theta')}]]/sqrt(2)
+    matrix_type u2(real_type const phase1, real_type const phase2)
+    {
+      auto const x = one_div_root_two();
+      return {
+        complex_type{x}, -x * ket::utility::exp_i<complex_type>(phase2),
+        x * ket::utility::exp_i<complex_type>(phase1), x * ket::utility::exp_i<complex_type>(phase1 + phase2)};
+    }
+
+    // U3(theta, theta', theta'') = [[cos(theta/2), -e^{i theta''} sin(theta/2)], [e^{i theta'} sin(theta/2), e^{i(theta' + theta'')} cos(theta/2)]]
+    matrix_type u3(real_type const phase1, real_type const phase2, real_type const phase3)
+    {
+      using std::cos;
+      using std::sin;
+      auto const cosine = cos(real_type{0.5} * phase1);
+      auto const sine = sin(real_type{0.5} * phase1);
+      return {
+        complex_type{cosine}, -sine * ket::utility::exp_i<complex_type>(phase3),
+        sine * ket::utility::exp_i<complex_type>(phase2), cosine * ket::utility::exp_i<complex_type>(phase2 + phase3)};
+    }
+
+    matrix_type x_rotation_half_pi()
+    {
+      auto const x = one_div_root_two();
+      auto const ix = x * ket::utility::imaginary_unit<complex_type>();
+      return {complex_type{x}, ix, ix, complex_type{x}};
+    }
+
+    matrix_type y_rotation_half_pi()
+    {
+      auto const x = one_div_root_two();
+      return {x, x, -x, x};
+    }
+
+    matrix_type v(complex_type const& phase_coefficient)
+    {
+      auto const diagonal = real_type{0.5} * (real_type{1} + phase_coefficient);
+      auto const off_diagonal = real_type{0.5} * (real_type{1} - phase_coefficient);
+      return {diagonal, off_diagonal, off_diagonal, diagonal};
+    }
+
+    matrix_type adjoint(matrix_type const& matrix)
+    {
+      auto const dim = dimension(matrix);
+      auto result = matrix_type(matrix.size());
+      for (auto row = std::size_t{0u}; row < dim; ++row)
+        for (auto column = std::size_t{0u}; column < dim; ++column)
+          result[column * dim + row] = std::conj(matrix[row * dim + column]);
+      return result;
+    }
+
+    matrix_type tensor_power(matrix_type const& matrix, std::size_t const num_qubits)
+    {
+      assert(matrix.size() == 4u);
+      auto const dim = ket::utility::integer_exp2<std::size_t>(num_qubits);
+      auto result = matrix_type(dim * dim, complex_type{real_type{1}});
+      for (auto row = std::size_t{0u}; row < dim; ++row)
+        for (auto column = std::size_t{0u}; column < dim; ++column)
+          for (auto qubit_index = std::size_t{0u}; qubit_index < num_qubits; ++qubit_index)
+            result[row * dim + column]
+              *= matrix[((row >> qubit_index) bitand std::size_t{1u}) * 2u + ((column >> qubit_index) bitand std::size_t{1u})];
+      return result;
+    }
+
+    matrix_type exponential(real_type const phase, matrix_type const& matrix)
+    {
+      using std::cos;
+      using std::sin;
+      auto const num_qubits = ket::utility::integer_log2<std::size_t>(dimension(matrix));
+      auto result = identity(num_qubits);
+      auto const cosine = cos(phase);
+      auto const i_sine = sin(phase) * ket::utility::imaginary_unit<complex_type>();
+      std::transform(
+        std::begin(result), std::end(result), std::begin(matrix), std::begin(result),
+        [cosine, i_sine](complex_type const& identity_element, complex_type const& element)
+        { return cosine * identity_element + i_sine * element; });
+      return result;
+    }
+
+    matrix_type controlled(matrix_type const& matrix, std::size_t const num_control_qubits)
+    {
+      auto const dim = dimension(matrix);
+      auto const num_target_qubits = ket::utility::integer_log2<std::size_t>(dim);
+      auto result = identity(num_target_qubits + num_control_qubits);
+      auto const result_dim = dim << num_control_qubits;
+      // 0b11...1x...x
+      auto const offset = result_dim - dim;
+      for (auto row = std::size_t{0u}; row < dim; ++row)
+        for (auto column = std::size_t{0u}; column < dim; ++column)
+          result[(offset + row) * result_dim + (offset + column)] = matrix[row * dim + column];
+      return result;
+    }
+
+    std::vector<qubit_type> operated_qubits(
+      std::vector<qubit_type> target_qubits, std::vector<control_qubit_type> const& control_qubits)
+    {
+      target_qubits.reserve(target_qubits.size() + control_qubits.size());
+      std::transform(
+        std::begin(control_qubits), std::end(control_qubits), std::back_inserter(target_qubits),
+        [](control_qubit_type const control_qubit) { return control_qubit.qubit(); });
+      return target_qubits;
+    }
+
+    void multiply(
+      matrix_type& result, std::vector<qubit_type> const& result_qubits,
+      matrix_type const& matrix, std::vector<qubit_type> const& qubits)
+    {
+      auto const result_dim = dimension(result);
+      auto const dim = dimension(matrix);
+
+      // offsets[i]: index of result whose bits are those of i at the positions of qubits in result_qubits
+      auto offsets = std::vector<std::size_t>(dim, std::size_t{0u});
+      for (auto qubit_index = std::size_t{0u}; qubit_index < qubits.size(); ++qubit_index)
+      {
+        auto const found = std::find(std::begin(result_qubits), std::end(result_qubits), qubits[qubit_index]);
+        assert(found != std::end(result_qubits));
+        auto const mask = std::size_t{1u} << (found - std::begin(result_qubits));
+        for (auto index = std::size_t{0u}; index < dim; ++index)
+          if (((index >> qubit_index) bitand std::size_t{1u}) != std::size_t{0u})
+            offsets[index] |= mask;
+      }
+      auto const qubits_mask = offsets.back();
+
+      auto new_column = std::vector<complex_type>(result_dim);
+      for (auto column = std::size_t{0u}; column < result_dim; ++column)
+      {
+        for (auto base_index = std::size_t{0u}; base_index < result_dim; ++base_index)
+        {
+          if ((base_index bitand qubits_mask) != std::size_t{0u})
+            continue;
+
+          for (auto row = std::size_t{0u}; row < dim; ++row)
+          {
+            auto value = complex_type{};
+            for (auto index = std::size_t{0u}; index < dim; ++index)
+              value += matrix[row * dim + index] * result[(base_index bitor offsets[index]) * result_dim + column];
+            new_column[base_index bitor offsets[row]] = value;
+          }
+        }
+
+        for (auto row = std::size_t{0u}; row < result_dim; ++row)
+          result[row * result_dim + column] = new_column[row];
+      }
+    }
+
+    std::vector<complex_type> diagonal(matrix_type const& matrix)
+    {
+      auto const dim = dimension(matrix);
+      auto result = std::vector<complex_type>(dim);
+      for (auto row = std::size_t{0u}; row < dim; ++row)
+        for (auto column = std::size_t{0u}; column < dim; ++column)
+          if (row == column)
+            result[row] = matrix[row * dim + column];
+          else if (matrix[row * dim + column] != complex_type{})
+            return {};
+      return result;
+    }
+
+    void multiply_diagonal(
+      std::vector<complex_type>& result, std::vector<qubit_type> const& result_qubits,
+      std::vector<complex_type> const& diagonal, std::vector<qubit_type> const& qubits)
+    {
+      // positions[i]: position of qubits[i] in result_qubits
+      auto positions = std::vector<std::size_t>(qubits.size());
+      for (auto qubit_index = std::size_t{0u}; qubit_index < qubits.size(); ++qubit_index)
+      {
+        auto const found = std::find(std::begin(result_qubits), std::end(result_qubits), qubits[qubit_index]);
+        assert(found != std::end(result_qubits));
+        positions[qubit_index] = static_cast<std::size_t>(found - std::begin(result_qubits));
+      }
+
+      for (auto result_index = std::size_t{0u}; result_index < result.size(); ++result_index)
+      {
+        auto index = std::size_t{0u};
+        for (auto qubit_index = std::size_t{0u}; qubit_index < qubits.size(); ++qubit_index)
+          index |= ((result_index >> positions[qubit_index]) bitand std::size_t{1u}) << qubit_index;
+        result[result_index] *= diagonal[index];
+      }
+    }
+  } // namespace unitary_matrix
+} // namespace bra
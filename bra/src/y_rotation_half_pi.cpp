@@ -1,4 +1,5 @@
 #include <string>
+#include <vector>
 #include <ios>
 #include <iomanip>
 #include <sstream>
@@ -8,6 +9,8 @@
 #include <bra/gate/gate.hpp>
 #include <bra/gate/y_rotation_half_pi.hpp>
 #include <bra/state.hpp>
+#include <bra/instruction.hpp>
+#include <bra/unitary_matrix.hpp>
 
 
 namespace bra
@@ -23,6 +26,19 @@ namespace bra
     ::bra::state& y_rotation_half_pi::do_apply(::bra::state& state) const
     { return state.y_rotation_half_pi(qubit_); }
 
+    std::vector<y_rotation_half_pi::qubit_type> y_rotation_half_pi::do_operated_qubits() const
+    { return {qubit_}; }
+
+    std::vector<y_rotation_half_pi::complex_type> y_rotation_half_pi::do_unitary_matrix() const
+    { return ::bra::unitary_matrix::y_rotation_half_pi(); }
+
+    bool y_rotation_half_pi::do_instruction(::bra::instruction& result) const
+    {
+      result.opcode = ::bra::opcode::y_rotation_half_pi;
+      result.qubit1 = qubit_;
+      return true;
+    }
+
     std::string const& y_rotation_half_pi::do_name() const { return name_; }
     std::string y_rotation_half_pi::do_representation(
       std::ostringstream& repr_stream, int const parameter_width) const
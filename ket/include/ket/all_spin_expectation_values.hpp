@@ -2,23 +2,191 @@
 # define KET_ALL_EXPECTATION_VALUES_HPP
 
 # include <cassert>
+# include <cstddef>
 # include <vector>
 # include <array>
 # include <iterator>
+# include <algorithm>
+# include <functional>
+# include <type_traits>
 
 # include <boost/range/value_type.hpp>
+# include <boost/math/constants/constants.hpp>
 
-# include <ket/spin_expectation_value.hpp>
 # include <ket/meta/bit_integer_of.hpp>
+# include <ket/meta/state_integer_of.hpp>
+# include <ket/utility/loop_n.hpp>
+# include <ket/utility/per_thread.hpp>
 # include <ket/utility/integer_log2.hpp>
-# ifndef NDEBUG
-#   include <ket/utility/integer_exp2.hpp>
-# endif
+# include <ket/utility/integer_exp2.hpp>
 # include <ket/utility/meta/real_of.hpp>
 
+// Number of qubits of each block of consecutive amplitudes, which should fit in the cache, in ::ket::all_spin_expectation_values
+# ifndef KET_ALL_SPIN_EXPECTATION_VALUES_BLOCK_QUBITS
+#   define KET_ALL_SPIN_EXPECTATION_VALUES_BLOCK_QUBITS 14
+# endif // KET_ALL_SPIN_EXPECTATION_VALUES_BLOCK_QUBITS
+
 
 namespace ket
 {
+  namespace all_spin_expectation_values_detail
+  {
+    // contiguous amplitudes of each sub-block are loaded together in the passes for high bits
+    constexpr std::size_t num_sub_block_qubits = 3u;
+
+    template <typename Complex>
+    inline void add_pair_spin(Complex const& zero_value, Complex const& one_value, long double* spin)
+    {
+      using std::conj;
+      auto const conj_zero_times_one = conj(zero_value) * one_value;
+
+      using std::real;
+      spin[0u] += static_cast<long double>(real(conj_zero_times_one));
+      using std::imag;
+      spin[1u] += static_cast<long double>(imag(conj_zero_times_one));
+      using std::norm;
+      spin[2u] += static_cast<long double>(norm(zero_value)) - static_cast<long double>(norm(one_value));
+    }
+
+    // For each bit k of indices of [first, last) in bits_mask, adds sum Re(a_0^* a_1), sum Im(a_0^* a_1) and sum (|a_0|^2 - |a_1|^2)
+    // to spins[3k], spins[3k+1] and spins[3k+2], where a_0 and a_1 are amplitudes whose indices differ only in bit k.
+    // sum |a|^2 is added to spins[3L], where 2^L = last - first. The other elements of spins are unspecified.
+    // The state is read in one pass of blocks of 2^KET_ALL_SPIN_EXPECTATION_VALUES_BLOCK_QUBITS amplitudes for low bits and z components of all bits,
+    // and in one more pass for each KET_ALL_SPIN_EXPECTATION_VALUES_BLOCK_QUBITS - 3 high bits,
+    // rather than one pass for each bit.
+    template <typename ParallelPolicy, typename RandomAccessIterator, typename StateInteger>
+    inline void add_spins(
+      ParallelPolicy const parallel_policy,
+      RandomAccessIterator const first, RandomAccessIterator const last,
+      StateInteger const bits_mask, std::vector<long double>& spins)
+    {
+      static_assert(std::is_unsigned<StateInteger>::value, "StateInteger should be unsigned");
+      static_assert(
+        KET_ALL_SPIN_EXPECTATION_VALUES_BLOCK_QUBITS > static_cast<int>(num_sub_block_qubits),
+        "KET_ALL_SPIN_EXPECTATION_VALUES_BLOCK_QUBITS should be greater than 3");
+      auto const state_size = static_cast<StateInteger>(last - first);
+      auto const num_bits = ::ket::utility::integer_log2<std::size_t>(state_size);
+      assert(::ket::utility::integer_exp2<StateInteger>(num_bits) == state_size);
+      assert(spins.size() == 3u * num_bits + 1u);
+
+      auto const num_block_bits = std::min(num_bits, static_cast<std::size_t>(KET_ALL_SPIN_EXPECTATION_VALUES_BLOCK_QUBITS));
+      auto const block_size = StateInteger{1u} << num_block_bits;
+      auto spins_in_threads = ::ket::utility::per_thread<std::vector<long double>>(parallel_policy, std::vector<long double>(spins.size()));
+
+      // low bits, z components of high bits and the norm
+      using ::ket::utility::loop_n;
+      loop_n(
+        parallel_policy, state_size >> num_block_bits,
+        [first, bits_mask, num_bits, num_block_bits, block_size, &spins_in_threads](
+          StateInteger const block_index, int const thread_index)
+        {
+          auto& thread_spins = spins_in_threads[thread_index];
+          auto const block_first = first + block_index * block_size;
+
+          for (auto bit = std::size_t{0u}; bit < num_block_bits; ++bit)
+          {
+            if (((bits_mask >> bit) bitand StateInteger{1u}) == StateInteger{0u})
+              continue;
+
+            long double spin[3u] = {0.0l, 0.0l, 0.0l};
+            auto const bit_mask = StateInteger{1u} << bit;
+            for (auto zero_index = StateInteger{0u}; zero_index < block_size; ++zero_index)
+              if ((zero_index bitand bit_mask) == StateInteger{0u})
+                ::ket::all_spin_expectation_values_detail::add_pair_spin(
+                  block_first[zero_index], block_first[zero_index bitor bit_mask], spin);
+
+            thread_spins[3u * bit] += spin[0u];
+            thread_spins[3u * bit + 1u] += spin[1u];
+            thread_spins[3u * bit + 2u] += spin[2u];
+          }
+
+          auto block_norm = 0.0l;
+          for (auto index = StateInteger{0u}; index < block_size; ++index)
+          {
+            using std::norm;
+            block_norm += static_cast<long double>(norm(block_first[index]));
+          }
+
+          auto const block_first_index = block_index << num_block_bits;
+          for (auto bit = num_block_bits; bit < num_bits; ++bit)
+            thread_spins[3u * bit + 2u] += ((block_first_index >> bit) bitand StateInteger{1u}) == StateInteger{0u} ? block_norm : -block_norm;
+          thread_spins.back() += block_norm;
+        });
+
+      // x and y components of high bits: amplitudes whose indices differ only in group_bits are loaded in sub-blocks
+      auto high_bits = std::vector<std::size_t>{};
+      for (auto bit = num_block_bits; bit < num_bits; ++bit)
+        if (((bits_mask >> bit) bitand StateInteger{1u}) != StateInteger{0u})
+          high_bits.push_back(bit);
+
+      auto const max_num_group_bits = num_block_bits - num_sub_block_qubits;
+      auto const sub_block_size = StateInteger{1u} << num_sub_block_qubits;
+      for (auto high_bits_first = std::begin(high_bits); high_bits_first != std::end(high_bits); )
+      {
+        auto const high_bits_last
+          = high_bits_first + std::min(static_cast<std::size_t>(std::end(high_bits) - high_bits_first), max_num_group_bits);
+        auto const group_bits = std::vector<std::size_t>(high_bits_first, high_bits_last);
+        auto const num_group_bits = group_bits.size();
+        high_bits_first = high_bits_last;
+
+        // offsets[j]: bitwise OR of 2^group_bits[k] for all set bits k of j
+        auto const num_sub_blocks = std::size_t{1u} << num_group_bits;
+        auto offsets = std::vector<StateInteger>(num_sub_blocks, StateInteger{0u});
+        for (auto group_bit_index = std::size_t{0u}; group_bit_index < num_group_bits; ++group_bit_index)
+          for (auto sub_block_index = std::size_t{0u}; sub_block_index < (std::size_t{1u} << group_bit_index); ++sub_block_index)
+            offsets[(std::size_t{1u} << group_bit_index) + sub_block_index]
+              = offsets[sub_block_index] bitor (StateInteger{1u} << group_bits[group_bit_index]);
+
+        loop_n(
+          parallel_policy, state_size >> (num_sub_block_qubits + num_group_bits),
+          [first, sub_block_size, num_sub_blocks, &group_bits, &offsets, &spins_in_threads](
+            StateInteger const group_index, int const thread_index)
+          {
+            // xx0xx0xx000
+            auto group_first_index = group_index << num_sub_block_qubits;
+            for (auto const group_bit: group_bits)
+              group_first_index
+                = ((group_first_index >> group_bit) << (group_bit + 1u))
+                  bitor (group_first_index bitand ((StateInteger{1u} << group_bit) - StateInteger{1u}));
+            auto const group_first = first + group_first_index;
+
+            auto& thread_spins = spins_in_threads[thread_index];
+            for (auto group_bit_index = std::size_t{0u}; group_bit_index < group_bits.size(); ++group_bit_index)
+            {
+              long double spin[3u] = {0.0l, 0.0l, 0.0l};
+              auto const sub_block_mask = std::size_t{1u} << group_bit_index;
+              for (auto zero_sub_block_index = std::size_t{0u}; zero_sub_block_index < num_sub_blocks; ++zero_sub_block_index)
+              {
+                if ((zero_sub_block_index bitand sub_block_mask) != std::size_t{0u})
+                  continue;
+
+                auto const zero_first = group_first + offsets[zero_sub_block_index];
+                auto const one_first = group_first + offsets[zero_sub_block_index bitor sub_block_mask];
+                for (auto index = StateInteger{0u}; index < sub_block_size; ++index)
+                  ::ket::all_spin_expectation_values_detail::add_pair_spin(zero_first[index], one_first[index], spin);
+              }
+
+              // z components are already added in the first pass
+              auto const bit = group_bits[group_bit_index];
+              thread_spins[3u * bit] += spin[0u];
+              thread_spins[3u * bit + 1u] += spin[1u];
+            }
+          });
+      }
+
+      auto const total_spins
+        = spins_in_threads.reduce(
+            [](std::vector<long double> accumulated_spins, std::vector<long double> const& thread_spins)
+            {
+              std::transform(
+                std::begin(accumulated_spins), std::end(accumulated_spins), std::begin(thread_spins),
+                std::begin(accumulated_spins), std::plus<long double>{});
+              return accumulated_spins;
+            });
+      std::transform(std::begin(spins), std::end(spins), std::begin(total_spins), std::begin(spins), std::plus<long double>{});
+    }
+  } // namespace all_spin_expectation_values_detail
+
   template <typename Qubit, typename ParallelPolicy, typename RandomAccessIterator>
   inline
   std::vector<
@@ -30,21 +198,27 @@ namespace ket
     RandomAccessIterator const first, RandomAccessIterator const last)
   {
     using bit_integer_type = typename ::ket::meta::bit_integer_of<Qubit>::type;
+    using state_integer_type = typename ::ket::meta::state_integer_of<Qubit>::type;
     auto const num_qubits = ::ket::utility::integer_log2<bit_integer_type>(last - first);
     assert(
-      ::ket::utility::integer_exp2<bit_integer_type>(num_qubits)
-        == static_cast<bit_integer_type>(last - first));
+      ::ket::utility::integer_exp2<state_integer_type>(num_qubits)
+        == static_cast<state_integer_type>(last - first));
+
+    auto spins = std::vector<long double>(3u * num_qubits + 1u);
+    ::ket::all_spin_expectation_values_detail::add_spins(
+      parallel_policy, first, last, compl state_integer_type{0u}, spins);
 
     using complex_type = typename std::iterator_traits<RandomAccessIterator>::value_type;
     using real_type = typename ::ket::utility::meta::real_of<complex_type>::type;
     using spin_type = std::array<real_type, 3u>;
-    auto result = std::vector<spin_type>{};
-    result.reserve(num_qubits);
-
-    auto const last_qubit = Qubit{num_qubits};
-    for (auto qubit = Qubit{bit_integer_type{0u}}; qubit < last_qubit; ++qubit)
-      result.push_back(
-        ::ket::spin_expectation_value(parallel_policy, first, last, qubit));
+    auto result = std::vector<spin_type>(num_qubits);
+    using boost::math::constants::half;
+    for (auto qubit = std::size_t{0u}; qubit < num_qubits; ++qubit)
+    {
+      result[qubit][0u] = static_cast<real_type>(spins[3u * qubit]);
+      result[qubit][1u] = static_cast<real_type>(spins[3u * qubit + 1u]);
+      result[qubit][2u] = half<real_type>() * static_cast<real_type>(spins[3u * qubit + 2u]);
+    }
 
     return result;
   }
@@ -0,0 +1,86 @@
+#ifndef KET_GATE_BLOCKED_HPP
+# define KET_GATE_BLOCKED_HPP
+
+# include <cassert>
+# include <cstddef>
+# include <iterator>
+# include <algorithm>
+# include <utility>
+# include <type_traits>
+
+# include <ket/utility/loop_n.hpp>
+# include <ket/utility/integer_exp2.hpp>
+# ifndef NDEBUG
+#   include <ket/utility/integer_log2.hpp>
+# endif
+
+
+namespace ket
+{
+  namespace gate
+  {
+    // blocked(parallel_policy, first, last, num_block_qubits, function) calls function(block_first, block_last)
+    // for each block [block_first, block_last) of 2^num_block_qubits consecutive amplitudes, and each block is processed by one thread.
+    // A gate which operates only on qubits lower than num_block_qubits can be applied to each block independently
+    // by calling the gate function with block_first, block_last and the sequential policy in function.
+    // Thus a run of such gates is applied while each block is resident in cache,
+    // so that the state is loaded from memory once per run rather than once per gate.
+    template <typename ParallelPolicy, typename RandomAccessIterator, typename BitInteger, typename Function>
+    inline void blocked(
+      ParallelPolicy const parallel_policy,
+      RandomAccessIterator const first, RandomAccessIterator const last,
+      BitInteger const num_block_qubits, Function&& function)
+    {
+      static_assert(std::is_unsigned<BitInteger>::value, "BitInteger should be unsigned");
+      assert(
+        ::ket::utility::integer_exp2<std::size_t>(::ket::utility::integer_log2<BitInteger>(last - first))
+        == static_cast<std::size_t>(last - first));
+
+      auto const state_size = static_cast<std::size_t>(last - first);
+      auto const block_size = std::min(::ket::utility::integer_exp2<std::size_t>(num_block_qubits), state_size);
+
+      using ::ket::utility::loop_n;
+      loop_n(
+        parallel_policy,
+        state_size / block_size,
+        [first, block_size, &function](std::size_t const block_index, int const)
+        {
+          auto const block_first = first + block_index * block_size;
+          function(block_first, block_first + block_size);
+        });
+    }
+
+    template <typename RandomAccessIterator, typename BitInteger, typename Function>
+    inline void blocked(
+      RandomAccessIterator const first, RandomAccessIterator const last,
+      BitInteger const num_block_qubits, Function&& function)
+    {
+      ::ket::gate::blocked(
+        ::ket::utility::policy::make_sequential(), first, last, num_block_qubits, std::forward<Function>(function));
+    }
+
+    namespace ranges
+    {
+      template <typename ParallelPolicy, typename RandomAccessRange, typename BitInteger, typename Function>
+      inline RandomAccessRange& blocked(
+        ParallelPolicy const parallel_policy, RandomAccessRange& state,
+        BitInteger const num_block_qubits, Function&& function)
+      {
+        ::ket::gate::blocked(
+          parallel_policy, std::begin(state), std::end(state), num_block_qubits, std::forward<Function>(function));
+        return state;
+      }
+
+      template <typename RandomAccessRange, typename BitInteger, typename Function>
+      inline RandomAccessRange& blocked(
+        RandomAccessRange& state, BitInteger const num_block_qubits, Function&& function)
+      {
+        return ::ket::gate::ranges::blocked(
+          ::ket::utility::policy::make_sequential(), state, num_block_qubits, std::forward<Function>(function));
+      }
+    } // namespace ranges
+  } // namespace gate
+} // namespace ket
+
+
+#endif // KET_GATE_BLOCKED_HPP
@@ -0,0 +1,635 @@
+#ifndef KET_GATE_DETAIL_SIMD_HPP
+# define KET_GATE_DETAIL_SIMD_HPP
+
+# include <cstddef>
+# include <complex>
+# include <array>
+# include <iterator>
+# include <algorithm>
+# include <memory>
+# include <type_traits>
+# if !defined(KET_NO_SIMD) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#   define KET_GATE_DETAIL_SIMD_X86
+#   include <immintrin.h>
+# endif
+
+# include <ket/qubit.hpp>
+# include <ket/utility/loop_n.hpp>
+# include <ket/utility/integer_exp2.hpp>
+# include <ket/utility/instruction_set.hpp>
+
+# ifdef KET_GATE_DETAIL_SIMD_X86
+#   define KET_GATE_DETAIL_SIMD_AVX2 __attribute__((target("avx2,fma")))
+#   define KET_GATE_DETAIL_SIMD_AVX512 __attribute__((target("avx512f")))
+# endif
+
+
+// Hand-vectorized single-qubit kernels for states of std::complex<double> stored contiguously.
+// Every function returns false without touching the state if it cannot handle the state,
+// e.g. the CPU supports neither AVX2 nor AVX-512F, and the caller should apply the gate by itself.
+// Every 2x2 matrix is given by its elements, (coefficient00, coefficient01; coefficient10, coefficient11).
+// An AVX2 register holds 2 amplitudes and an AVX-512 register holds 4 amplitudes,
+// so the pair of amplitudes of qubit 0 (and qubit 1 for AVX-512) is in one register and treated specially.
+namespace ket
+{
+  namespace gate
+  {
+    namespace detail
+    {
+      namespace simd
+      {
+        template <typename Iterator>
+        struct is_contiguous_iterator
+          : std::is_pointer<Iterator>
+        { };
+
+# ifdef __GLIBCXX__
+        template <typename Pointer, typename Container>
+        struct is_contiguous_iterator< ::__gnu_cxx::__normal_iterator<Pointer, Container> >
+          : std::true_type
+        { };
+# endif // __GLIBCXX__
+# ifdef _LIBCPP_VERSION
+        template <typename Pointer>
+        struct is_contiguous_iterator< std::__wrap_iter<Pointer> >
+          : std::true_type
+        { };
+# endif // _LIBCPP_VERSION
+
+        template <typename RandomAccessIterator>
+        struct is_vectorizable
+# ifdef KET_GATE_DETAIL_SIMD_X86
+          : std::integral_constant<
+              bool,
+              ::ket::gate::detail::simd::is_contiguous_iterator<RandomAccessIterator>::value
+              and std::is_same<typename std::iterator_traits<RandomAccessIterator>::value_type, std::complex<double> >::value>
+# else
+          : std::false_type
+# endif
+        { };
+
+# ifdef KET_GATE_DETAIL_SIMD_X86
+        // loop_n over blocks of iterations reduces the number of calls of non-inlined vectorized functions
+        template <typename ParallelPolicy, typename StateInteger, typename Function>
+        inline void loop_blocks(ParallelPolicy const parallel_policy, StateInteger const num_iterations, Function&& function)
+        {
+          constexpr auto block_size = StateInteger{1024u};
+
+          using ::ket::utility::loop_n;
+          loop_n(
+            parallel_policy,
+            (num_iterations + block_size - StateInteger{1u}) / block_size,
+            [num_iterations, &function](StateInteger const block_index, int const)
+            {
+              auto const first = block_index * block_size;
+              function(first, std::min(first + block_size, num_iterations));
+            });
+        }
+
+        template <typename StateInteger>
+        inline StateInteger insert_zero(
+          StateInteger const value_wo_qubit, StateInteger const lower_bits_mask, StateInteger const upper_bits_mask)
+        { return ((value_wo_qubit bitand upper_bits_mask) << 1u) bitor (value_wo_qubit bitand lower_bits_mask); }
+
+        namespace avx2
+        {
+          // (x_r, x_i) * (c_r, c_i) for each complex number
+          KET_GATE_DETAIL_SIMD_AVX2
+          inline __m256d multiply(__m256d const x, __m256d const real, __m256d const imag)
+          { return _mm256_fmaddsub_pd(x, real, _mm256_mul_pd(_mm256_permute_pd(x, 0b0101), imag)); }
+
+          // (x_0, x_1) -> (x_1, x_0)
+          KET_GATE_DETAIL_SIMD_AVX2
+          inline __m256d swap_pair(__m256d const x)
+          { return _mm256_permute2f128_pd(x, x, 0x01); }
+
+          // coefficient vectors: real parts, imaginary parts, ... in the order of {c_0, c_1, c_2, c_3}
+          // where c_k = coefficients[k] for registers (a_0, a_1) and c_k = (coefficients[k], coefficients[k])
+          KET_GATE_DETAIL_SIMD_AVX2
+          inline void set_coefficients(__m256d* const result, std::complex<double> const* coefficients, std::size_t const num_coefficients)
+          {
+            for (auto index = std::size_t{0u}; index < num_coefficients; ++index)
+            {
+              result[2u * index] = _mm256_set1_pd(coefficients[index].real());
+              result[2u * index + 1u] = _mm256_set1_pd(coefficients[index].imag());
+            }
+          }
+
+          // result = (c_0, c_1) for qubit 0
+          KET_GATE_DETAIL_SIMD_AVX2
+          inline void set_coefficient_pair(
+            __m256d* const result, std::complex<double> const& coefficient0, std::complex<double> const& coefficient1)
+          {
+            result[0u] = _mm256_setr_pd(coefficient0.real(), coefficient0.real(), coefficient1.real(), coefficient1.real());
+            result[1u] = _mm256_setr_pd(coefficient0.imag(), coefficient0.imag(), coefficient1.imag(), coefficient1.imag());
+          }
+
+          template <typename StateInteger>
+          KET_GATE_DETAIL_SIMD_AVX2
+          inline void unitary(
+            double* const data, StateInteger const qubit_mask,
+            std::complex<double> const* const matrix, StateInteger const first, StateInteger const last)
+          {
+            if (qubit_mask == StateInteger{1u})
+            {
+              __m256d coefficients[4u];
+              // (m_00 a_0, m_11 a_1) + (m_01 a_1, m_10 a_0)
+              ::ket::gate::detail::simd::avx2::set_coefficient_pair(coefficients, matrix[0u], matrix[3u]);
+              ::ket::gate::detail::simd::avx2::set_coefficient_pair(coefficients + 2, matrix[1u], matrix[2u]);
+
+              for (auto index = first; index < last; ++index)
+              {
+                auto const pointer = data + (index << 2u);
+                auto const x = _mm256_loadu_pd(pointer);
+                _mm256_storeu_pd(
+                  pointer,
+                  _mm256_add_pd(
+                    ::ket::gate::detail::simd::avx2::multiply(x, coefficients[0u], coefficients[1u]),
+                    ::ket::gate::detail::simd::avx2::multiply(
+                      ::ket::gate::detail::simd::avx2::swap_pair(x), coefficients[2u], coefficients[3u])));
+              }
+              return;
+            }
+
+            __m256d coefficients[8u];
+            ::ket::gate::detail::simd::avx2::set_coefficients(coefficients, matrix, 4u);
+
+            auto const lower_bits_mask = qubit_mask - StateInteger{1u};
+            auto const upper_bits_mask = compl lower_bits_mask;
+            for (auto index = first; index < last; ++index)
+            {
+              auto const zero_pointer
+                = data + (::ket::gate::detail::simd::insert_zero(index << 1u, lower_bits_mask, upper_bits_mask) << 1u);
+              auto const one_pointer = zero_pointer + (qubit_mask << 1u);
+              auto const x0 = _mm256_loadu_pd(zero_pointer);
+              auto const x1 = _mm256_loadu_pd(one_pointer);
+              _mm256_storeu_pd(
+                zero_pointer,
+                _mm256_add_pd(
+                  ::ket::gate::detail::simd::avx2::multiply(x0, coefficients[0u], coefficients[1u]),
+                  ::ket::gate::detail::simd::avx2::multiply(x1, coefficients[2u], coefficients[3u])));
+              _mm256_storeu_pd(
+                one_pointer,
+                _mm256_add_pd(
+                  ::ket::gate::detail::simd::avx2::multiply(x0, coefficients[4u], coefficients[5u]),
+                  ::ket::gate::detail::simd::avx2::multiply(x1, coefficients[6u], coefficients[7u])));
+            }
+          }
+
+          template <typename StateInteger>
+          KET_GATE_DETAIL_SIMD_AVX2
+          inline void diagonal(
+            double* const data, StateInteger const qubit_mask,
+            std::complex<double> const* const diagonal, bool const is_zero_coefficient_one,
+            StateInteger const first, StateInteger const last)
+          {
+            if (qubit_mask == StateInteger{1u})
+            {
+              __m256d coefficients[2u];
+              ::ket::gate::detail::simd::avx2::set_coefficient_pair(coefficients, diagonal[0u], diagonal[1u]);
+
+              for (auto index = first; index < last; ++index)
+              {
+                auto const pointer = data + (index << 2u);
+                _mm256_storeu_pd(
+                  pointer,
+                  ::ket::gate::detail::simd::avx2::multiply(_mm256_loadu_pd(pointer), coefficients[0u], coefficients[1u]));
+              }
+              return;
+            }
+
+            __m256d coefficients[4u];
+            ::ket::gate::detail::simd::avx2::set_coefficients(coefficients, diagonal, 2u);
+
+            auto const lower_bits_mask = qubit_mask - StateInteger{1u};
+            auto const upper_bits_mask = compl lower_bits_mask;
+            for (auto index = first; index < last; ++index)
+            {
+              auto const zero_pointer
+                = data + (::ket::gate::detail::simd::insert_zero(index << 1u, lower_bits_mask, upper_bits_mask) << 1u);
+              auto const one_pointer = zero_pointer + (qubit_mask << 1u);
+              // amplitudes which are not changed are not even loaded
+              if (not is_zero_coefficient_one)
+                _mm256_storeu_pd(
+                  zero_pointer,
+                  ::ket::gate::detail::simd::avx2::multiply(_mm256_loadu_pd(zero_pointer), coefficients[0u], coefficients[1u]));
+              _mm256_storeu_pd(
+                one_pointer,
+                ::ket::gate::detail::simd::avx2::multiply(_mm256_loadu_pd(one_pointer), coefficients[2u], coefficients[3u]));
+            }
+          }
+
+          template <typename StateInteger>
+          KET_GATE_DETAIL_SIMD_AVX2
+          inline void anti_diagonal(
+            double* const data, StateInteger const qubit_mask,
+            std::complex<double> const* const anti_diagonal, StateInteger const first, StateInteger const last)
+          {
+            if (qubit_mask == StateInteger{1u})
+            {
+              __m256d coefficients[2u];
+              ::ket::gate::detail::simd::avx2::set_coefficient_pair(coefficients, anti_diagonal[0u], anti_diagonal[1u]);
+
+              for (auto index = first; index < last; ++index)
+              {
+                auto const pointer = data + (index << 2u);
+                _mm256_storeu_pd(
+                  pointer,
+                  ::ket::gate::detail::simd::avx2::multiply(
+                    ::ket::gate::detail::simd::avx2::swap_pair(_mm256_loadu_pd(pointer)), coefficients[0u], coefficients[1u]));
+              }
+              return;
+            }
+
+            __m256d coefficients[4u];
+            ::ket::gate::detail::simd::avx2::set_coefficients(coefficients, anti_diagonal, 2u);
+
+            auto const lower_bits_mask = qubit_mask - StateInteger{1u};
+            auto const upper_bits_mask = compl lower_bits_mask;
+            for (auto index = first; index < last; ++index)
+            {
+              auto const zero_pointer
+                = data + (::ket::gate::detail::simd::insert_zero(index << 1u, lower_bits_mask, upper_bits_mask) << 1u);
+              auto const one_pointer = zero_pointer + (qubit_mask << 1u);
+              auto const x0 = _mm256_loadu_pd(zero_pointer);
+              auto const x1 = _mm256_loadu_pd(one_pointer);
+              _mm256_storeu_pd(zero_pointer, ::ket::gate::detail::simd::avx2::multiply(x1, coefficients[0u], coefficients[1u]));
+              _mm256_storeu_pd(one_pointer, ::ket::gate::detail::simd::avx2::multiply(x0, coefficients[2u], coefficients[3u]));
+            }
+          }
+        } // namespace avx2
+
+        namespace avx512
+        {
+          // Unmasked _mm512_permute_pd and _mm512_shuffle_f64x2 of GCC 12 pass _mm512_undefined_pd() as the source of masked-out elements,
+          // which causes -Wmaybe-uninitialized. Their masked versions with all elements selected give the same results without it
+          constexpr __mmask8 all_elements = 0xFF;
+
+          // (x_r, x_i) * (c_r, c_i) for each complex number
+          KET_GATE_DETAIL_SIMD_AVX512
+          inline __m512d multiply(__m512d const x, __m512d const real, __m512d const imag)
+          {
+            return _mm512_fmaddsub_pd(
+              x, real, _mm512_mul_pd(_mm512_mask_permute_pd(x, ::ket::gate::detail::simd::avx512::all_elements, x, 0x55), imag));
+          }
+
+          // qubit 0: (x_0, x_1, x_2, x_3) -> (x_1, x_0, x_3, x_2)
+          // qubit 1: (x_0, x_1, x_2, x_3) -> (x_2, x_3, x_0, x_1)
+          KET_GATE_DETAIL_SIMD_AVX512
+          inline __m512d swap_pair(__m512d const x, bool const is_qubit0)
+          {
+            return is_qubit0
+              ? _mm512_mask_shuffle_f64x2(x, ::ket::gate::detail::simd::avx512::all_elements, x, x, _MM_SHUFFLE(2, 3, 0, 1))
+              : _mm512_mask_shuffle_f64x2(x, ::ket::gate::detail::simd::avx512::all_elements, x, x, _MM_SHUFFLE(1, 0, 3, 2));
+          }
+
+          KET_GATE_DETAIL_SIMD_AVX512
+          inline void set_coefficients(__m512d* const result, std::complex<double> const* coefficients, std::size_t const num_coefficients)
+          {
+            for (auto index = std::size_t{0u}; index < num_coefficients; ++index)
+            {
+              result[2u * index] = _mm512_set1_pd(coefficients[index].real());
+              result[2u * index + 1u] = _mm512_set1_pd(coefficients[index].imag());
+            }
+          }
+
+          // qubit 0: result = (c_0, c_1, c_0, c_1)
+          // qubit 1: result = (c_0, c_0, c_1, c_1)
+          KET_GATE_DETAIL_SIMD_AVX512
+          inline void set_coefficient_pair(
+            __m512d* const result, std::complex<double> const& coefficient0, std::complex<double> const& coefficient1,
+            bool const is_qubit0)
+          {
+            auto const r0 = coefficient0.real();
+            auto const i0 = coefficient0.imag();
+            auto const r1 = coefficient1.real();
+            auto const i1 = coefficient1.imag();
+            if (is_qubit0)
+            {
+              result[0u] = _mm512_setr_pd(r0, r0, r1, r1, r0, r0, r1, r1);
+              result[1u] = _mm512_setr_pd(i0, i0, i1, i1, i0, i0, i1, i1);
+            }
+            else
+            {
+              result[0u] = _mm512_setr_pd(r0, r0, r0, r0, r1, r1, r1, r1);
+              result[1u] = _mm512_setr_pd(i0, i0, i0, i0, i1, i1, i1, i1);
+            }
+          }
+
+          template <typename StateInteger>
+          KET_GATE_DETAIL_SIMD_AVX512
+          inline void unitary(
+            double* const data, StateInteger const qubit_mask,
+            std::complex<double> const* const matrix, StateInteger const first, StateInteger const last)
+          {
+            if (qubit_mask <= StateInteger{2u})
+            {
+              auto const is_qubit0 = qubit_mask == StateInteger{1u};
+              __m512d coefficients[4u];
+              ::ket::gate::detail::simd::avx512::set_coefficient_pair(coefficients, matrix[0u], matrix[3u], is_qubit0);
+              ::ket::gate::detail::simd::avx512::set_coefficient_pair(coefficients + 2, matrix[1u], matrix[2u], is_qubit0);
+
+              for (auto index = first; index < last; ++index)
+              {
+                auto const pointer = data + (index << 3u);
+                auto const x = _mm512_loadu_pd(pointer);
+                _mm512_storeu_pd(
+                  pointer,
+                  _mm512_add_pd(
+                    ::ket::gate::detail::simd::avx512::multiply(x, coefficients[0u], coefficients[1u]),
+                    ::ket::gate::detail::simd::avx512::multiply(
+                      ::ket::gate::detail::simd::avx512::swap_pair(x, is_qubit0), coefficients[2u], coefficients[3u])));
+              }
+              return;
+            }
+
+            __m512d coefficients[8u];
+            ::ket::gate::detail::simd::avx512::set_coefficients(coefficients, matrix, 4u);
+
+            auto const lower_bits_mask = qubit_mask - StateInteger{1u};
+            auto const upper_bits_mask = compl lower_bits_mask;
+            for (auto index = first; index < last; ++index)
+            {
+              auto const zero_pointer
+                = data + (::ket::gate::detail::simd::insert_zero(index << 2u, lower_bits_mask, upper_bits_mask) << 1u);
+              auto const one_pointer = zero_pointer + (qubit_mask << 1u);
+              auto const x0 = _mm512_loadu_pd(zero_pointer);
+              auto const x1 = _mm512_loadu_pd(one_pointer);
+              _mm512_storeu_pd(
+                zero_pointer,
+                _mm512_add_pd(
+                  ::ket::gate::detail::simd::avx512::multiply(x0, coefficients[0u], coefficients[1u]),
+                  ::ket::gate::detail::simd::avx512::multiply(x1, coefficients[2u], coefficients[3u])));
+              _mm512_storeu_pd(
+                one_pointer,
+                _mm512_add_pd(
+                  ::ket::gate::detail::simd::avx512::multiply(x0, coefficients[4u], coefficients[5u]),
+                  ::ket::gate::detail::simd::avx512::multiply(x1, coefficients[6u], coefficients[7u])));
+            }
+          }
+
+          template <typename StateInteger>
+          KET_GATE_DETAIL_SIMD_AVX512
+          inline void diagonal(
+            double* const data, StateInteger const qubit_mask,
+            std::complex<double> const* const diagonal, bool const is_zero_coefficient_one,
+            StateInteger const first, StateInteger const last)
+          {
+            if (qubit_mask <= StateInteger{2u})
+            {
+              __m512d coefficients[2u];
+              ::ket::gate::detail::simd::avx512::set_coefficient_pair(
+                coefficients, diagonal[0u], diagonal[1u], qubit_mask == StateInteger{1u});
+
+              for (auto index = first; index < last; ++index)
+              {
+                auto const pointer = data + (index << 3u);
+                _mm512_storeu_pd(
+                  pointer,
+                  ::ket::gate::detail::simd::avx512::multiply(_mm512_loadu_pd(pointer), coefficients[0u], coefficients[1u]));
+              }
+              return;
+            }
+
+            __m512d coefficients[4u];
+            ::ket::gate::detail::simd::avx512::set_coefficients(coefficients, diagonal, 2u);
+
+            auto const lower_bits_mask = qubit_mask - StateInteger{1u};
+            auto const upper_bits_mask = compl lower_bits_mask;
+            for (auto index = first; index < last; ++index)
+            {
+              auto const zero_pointer
+                = data + (::ket::gate::detail::simd::insert_zero(index << 2u, lower_bits_mask, upper_bits_mask) << 1u);
+              auto const one_pointer = zero_pointer + (qubit_mask << 1u);
+              // amplitudes which are not changed are not even loaded
+              if (not is_zero_coefficient_one)
+                _mm512_storeu_pd(
+                  zero_pointer,
+                  ::ket::gate::detail::simd::avx512::multiply(_mm512_loadu_pd(zero_pointer), coefficients[0u], coefficients[1u]));
+              _mm512_storeu_pd(
+                one_pointer,
+                ::ket::gate::detail::simd::avx512::multiply(_mm512_loadu_pd(one_pointer), coefficients[2u], coefficients[3u]));
+            }
+          }
+
+          template <typename StateInteger>
+          KET_GATE_DETAIL_SIMD_AVX512
+          inline void anti_diagonal(
+            double* const data, StateInteger const qubit_mask,
+            std::complex<double> const* const anti_diagonal, StateInteger const first, StateInteger const last)
+          {
+            if (qubit_mask <= StateInteger{2u})
+            {
+              auto const is_qubit0 = qubit_mask == StateInteger{1u};
+              __m512d coefficients[2u];
+              ::ket::gate::detail::simd::avx512::set_coefficient_pair(coefficients, anti_diagonal[0u], anti_diagonal[1u], is_qubit0);
+
+              for (auto index = first; index < last; ++index)
+              {
+                auto const pointer = data + (index << 3u);
+                _mm512_storeu_pd(
+                  pointer,
+                  ::ket::gate::detail::simd::avx512::multiply(
+                    ::ket::gate::detail::simd::avx512::swap_pair(_mm512_loadu_pd(pointer), is_qubit0),
+                    coefficients[0u], coefficients[1u]));
+              }
+              return;
+            }
+
+            __m512d coefficients[4u];
+            ::ket::gate::detail::simd::avx512::set_coefficients(coefficients, anti_diagonal, 2u);
+
+            auto const lower_bits_mask = qubit_mask - StateInteger{1u};
+            auto const upper_bits_mask = compl lower_bits_mask;
+            for (auto index = first; index < last; ++index)
+            {
+              auto const zero_pointer
+                = data + (::ket::gate::detail::simd::insert_zero(index << 2u, lower_bits_mask, upper_bits_mask) << 1u);
+              auto const one_pointer = zero_pointer + (qubit_mask << 1u);
+              auto const x0 = _mm512_loadu_pd(zero_pointer);
+              auto const x1 = _mm512_loadu_pd(one_pointer);
+              _mm512_storeu_pd(zero_pointer, ::ket::gate::detail::simd::avx512::multiply(x1, coefficients[0u], coefficients[1u]));
+              _mm512_storeu_pd(one_pointer, ::ket::gate::detail::simd::avx512::multiply(x0, coefficients[2u], coefficients[3u]));
+            }
+          }
+        } // namespace avx512
+
+        // num_iterations: the number of registers (AVX2: 2 amplitudes, AVX-512: 4 amplitudes) for each kind of amplitudes,
+        // or 0 if the state is too small
+        template <typename StateInteger>
+        inline StateInteger num_iterations(
+          ::ket::utility::instruction_set const instruction_set, StateInteger const num_amplitudes, StateInteger const qubit_mask)
+        {
+          if (instruction_set == ::ket::utility::instruction_set::avx512)
+          {
+            if (num_amplitudes < StateInteger{8u})
+              return StateInteger{0u};
+            return qubit_mask <= StateInteger{2u} ? num_amplitudes >> 2u : num_amplitudes >> 3u;
+          }
+
+          if (instruction_set == ::ket::utility::instruction_set::avx2)
+          {
+            if (num_amplitudes < StateInteger{4u})
+              return StateInteger{0u};
+            return qubit_mask == StateInteger{1u} ? num_amplitudes >> 1u : num_amplitudes >> 2u;
+          }
+
+          return StateInteger{0u};
+        }
+
+        template <typename ParallelPolicy, typename RandomAccessIterator, typename StateInteger, typename BitInteger>
+        inline bool do_unitary(
+          ParallelPolicy const parallel_policy,
+          RandomAccessIterator const first, RandomAccessIterator const last,
+          ::ket::qubit<StateInteger, BitInteger> const qubit, std::array<std::complex<double>, 4u> const& matrix,
+          std::true_type const)
+        {
+          auto const instruction_set = ::ket::utility::supported_instruction_set();
+          auto const qubit_mask = ::ket::utility::integer_exp2<StateInteger>(qubit);
+          auto const num_iterations
+            = ::ket::gate::detail::simd::num_iterations(instruction_set, static_cast<StateInteger>(last - first), qubit_mask);
+          if (num_iterations == StateInteger{0u})
+            return false;
+
+          auto const data = reinterpret_cast<double*>(std::addressof(*first));
+          auto const matrix_data = matrix.data();
+          if (instruction_set == ::ket::utility::instruction_set::avx512)
+            ::ket::gate::detail::simd::loop_blocks(
+              parallel_policy, num_iterations,
+              [data, qubit_mask, matrix_data](StateInteger const first, StateInteger const last)
+              { ::ket::gate::detail::simd::avx512::unitary(data, qubit_mask, matrix_data, first, last); });
+          else
+            ::ket::gate::detail::simd::loop_blocks(
+              parallel_policy, num_iterations,
+              [data, qubit_mask, matrix_data](StateInteger const first, StateInteger const last)
+              { ::ket::gate::detail::simd::avx2::unitary(data, qubit_mask, matrix_data, first, last); });
+          return true;
+        }
+
+        template <typename ParallelPolicy, typename RandomAccessIterator, typename StateInteger, typename BitInteger>
+        inline bool do_diagonal(
+          ParallelPolicy const parallel_policy,
+          RandomAccessIterator const first, RandomAccessIterator const last,
+          ::ket::qubit<StateInteger, BitInteger> const qubit, std::array<std::complex<double>, 2u> const& diagonal,
+          std::true_type const)
+        {
+          auto const instruction_set = ::ket::utility::supported_instruction_set();
+          auto const qubit_mask = ::ket::utility::integer_exp2<StateInteger>(qubit);
+          auto const num_iterations
+            = ::ket::gate::detail::simd::num_iterations(instruction_set, static_cast<StateInteger>(last - first), qubit_mask);
+          if (num_iterations == StateInteger{0u})
+            return false;
+
+          auto const data = reinterpret_cast<double*>(std::addressof(*first));
+          auto const diagonal_data = diagonal.data();
+          auto const is_zero_coefficient_one = diagonal[0u] == std::complex<double>{1.0};
+          if (instruction_set == ::ket::utility::instruction_set::avx512)
+            ::ket::gate::detail::simd::loop_blocks(
+              parallel_policy, num_iterations,
+              [data, qubit_mask, diagonal_data, is_zero_coefficient_one](StateInteger const first, StateInteger const last)
+              { ::ket::gate::detail::simd::avx512::diagonal(data, qubit_mask, diagonal_data, is_zero_coefficient_one, first, last); });
+          else
+            ::ket::gate::detail::simd::loop_blocks(
+              parallel_policy, num_iterations,
+              [data, qubit_mask, diagonal_data, is_zero_coefficient_one](StateInteger const first, StateInteger const last)
+              { ::ket::gate::detail::simd::avx2::diagonal(data, qubit_mask, diagonal_data, is_zero_coefficient_one, first, last); });
+          return true;
+        }
+
+        template <typename ParallelPolicy, typename RandomAccessIterator, typename StateInteger, typename BitInteger>
+        inline bool do_anti_diagonal(
+          ParallelPolicy const parallel_policy,
+          RandomAccessIterator const first, RandomAccessIterator const last,
+          ::ket::qubit<StateInteger, BitInteger> const qubit, std::array<std::complex<double>, 2u> const& anti_diagonal,
+          std::true_type const)
+        {
+          auto const instruction_set = ::ket::utility::supported_instruction_set();
+          auto const qubit_mask = ::ket::utility::integer_exp2<StateInteger>(qubit);
+          auto const num_iterations
+            = ::ket::gate::detail::simd::num_iterations(instruction_set, static_cast<StateInteger>(last - first), qubit_mask);
+          if (num_iterations == StateInteger{0u})
+            return false;
+
+          auto const data = reinterpret_cast<double*>(std::addressof(*first));
+          auto const anti_diagonal_data = anti_diagonal.data();
+          if (instruction_set == ::ket::utility::instruction_set::avx512)
+            ::ket::gate::detail::simd::loop_blocks(
+              parallel_policy, num_iterations,
+              [data, qubit_mask, anti_diagonal_data](StateInteger const first, StateInteger const last)
+              { ::ket::gate::detail::simd::avx512::anti_diagonal(data, qubit_mask, anti_diagonal_data, first, last); });
+          else
+            ::ket::gate::detail::simd::loop_blocks(
+              parallel_policy, num_iterations,
+              [data, qubit_mask, anti_diagonal_data](StateInteger const first, StateInteger const last)
+              { ::ket::gate::detail::simd::avx2::anti_diagonal(data, qubit_mask, anti_diagonal_data, first, last); });
+          return true;
+        }
+# endif // KET_GATE_DETAIL_SIMD_X86
+
+        template <typename ParallelPolicy, typename RandomAccessIterator, typename StateInteger, typename BitInteger, typename Complex>
+        inline bool do_unitary(
+          ParallelPolicy const, RandomAccessIterator const, RandomAccessIterator const,
+          ::ket::qubit<StateInteger, BitInteger> const, std::array<Complex, 4u> const&, std::false_type const)
+        { return false; }
+
+        template <typename ParallelPolicy, typename RandomAccessIterator, typename StateInteger, typename BitInteger, typename Complex>
+        inline bool do_diagonal(
+          ParallelPolicy const, RandomAccessIterator const, RandomAccessIterator const,
+          ::ket::qubit<StateInteger, BitInteger> const, std::array<Complex, 2u> const&, std::false_type const)
+        { return false; }
+
+        template <typename ParallelPolicy, typename RandomAccessIterator, typename StateInteger, typename BitInteger, typename Complex>
+        inline bool do_anti_diagonal(
+          ParallelPolicy const, RandomAccessIterator const, RandomAccessIterator const,
+          ::ket::qubit<StateInteger, BitInteger> const, std::array<Complex, 2u> const&, std::false_type const)
+        { return false; }
+
+        // U_i = (coefficient00, coefficient01; coefficient10, coefficient11)
+        template <typename ParallelPolicy, typename RandomAccessIterator, typename StateInteger, typename BitInteger, typename Complex>
+        inline bool unitary(
+          ParallelPolicy const parallel_policy,
+          RandomAccessIterator const first, RandomAccessIterator const last,
+          ::ket::qubit<StateInteger, BitInteger> const qubit,
+          Complex const& coefficient00, Complex const& coefficient01, Complex const& coefficient10, Complex const& coefficient11)
+        {
+          return ::ket::gate::detail::simd::do_unitary(
+            parallel_policy, first, last, qubit,
+            std::array<Complex, 4u>{{coefficient00, coefficient01, coefficient10, coefficient11}},
+            ::ket::gate::detail::simd::is_vectorizable<RandomAccessIterator>{});
+        }
+
+        // D_i = (coefficient0, 0; 0, coefficient1)
+        template <typename ParallelPolicy, typename RandomAccessIterator, typename StateInteger, typename BitInteger, typename Complex>
+        inline bool diagonal(
+          ParallelPolicy const parallel_policy,
+          RandomAccessIterator const first, RandomAccessIterator const last,
+          ::ket::qubit<StateInteger, BitInteger> const qubit, Complex const& coefficient0, Complex const& coefficient1)
+        {
+          return ::ket::gate::detail::simd::do_diagonal(
+            parallel_policy, first, last, qubit, std::array<Complex, 2u>{{coefficient0, coefficient1}},
+            ::ket::gate::detail::simd::is_vectorizable<RandomAccessIterator>{});
+        }
+
+        // P_i = (0, coefficient01; coefficient10, 0)
+        template <typename ParallelPolicy, typename RandomAccessIterator, typename StateInteger, typename BitInteger, typename Complex>
+        inline bool anti_diagonal(
+          ParallelPolicy const parallel_policy,
+          RandomAccessIterator const first, RandomAccessIterator const last,
+          ::ket::qubit<StateInteger, BitInteger> const qubit, Complex const& coefficient01, Complex const& coefficient10)
+        {
+          return ::ket::gate::detail::simd::do_anti_diagonal(
+            parallel_policy, first, last, qubit, std::array<Complex, 2u>{{coefficient01, coefficient10}},
+            ::ket::gate::detail::simd::is_vectorizable<RandomAccessIterator>{});
+        }
+      } // namespace simd
+    } // namespace detail
+  } // namespace gate
+} // namespace ket
+
+
+# ifdef KET_GATE_DETAIL_SIMD_X86
+#   undef KET_GATE_DETAIL_SIMD_AVX2
+#   undef KET_GATE_DETAIL_SIMD_AVX512
+# endif
+
+#endif // KET_GATE_DETAIL_SIMD_HPP
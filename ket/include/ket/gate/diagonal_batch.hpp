@@ -0,0 +1,182 @@
+#ifndef KET_GATE_DIAGONAL_BATCH_HPP
+# define KET_GATE_DIAGONAL_BATCH_HPP
+
+# include <cassert>
+# include <cstddef>
+# include <vector>
+# include <iterator>
+# include <algorithm>
+# include <utility>
+# include <type_traits>
+
+# include <boost/range/size.hpp>
+# include <boost/range/value_type.hpp>
+
+# include <ket/qubit.hpp>
+# include <ket/meta/state_integer_of.hpp>
+# include <ket/meta/bit_integer_of.hpp>
+# include <ket/utility/loop_n.hpp>
+# include <ket/utility/integer_exp2.hpp>
+# include <ket/utility/integer_log2.hpp>
+
+// Number of qubits of each chunk of consecutive amplitudes in ::ket::gate::diagonal_batch
+# ifndef KET_GATE_DIAGONAL_BATCH_CHUNK_QUBITS
+#   define KET_GATE_DIAGONAL_BATCH_CHUNK_QUBITS 10
+# endif // KET_GATE_DIAGONAL_BATCH_CHUNK_QUBITS
+
+
+namespace ket
+{
+  namespace gate
+  {
+    namespace diagonal_batch_detail
+    {
+      // the index of table, whose n-th bit is the qubits[n]-th bit of index
+      template <typename StateInteger, typename BitInteger>
+      inline std::size_t table_index(
+        StateInteger const index,
+        typename std::vector<BitInteger>::const_iterator const qubits_first,
+        typename std::vector<BitInteger>::const_iterator const qubits_last)
+      {
+        auto result = std::size_t{0u};
+        auto bit = std::size_t{0u};
+        for (auto iter = qubits_first; iter != qubits_last; ++iter, ++bit)
+          result |= static_cast<std::size_t>((index >> *iter) bitand StateInteger{1u}) << bit;
+        return result;
+      }
+    } // namespace diagonal_batch_detail
+
+    // a_i -> tables[0][b_0(i)] tables[1][b_1(i)] ... a_i, where the n-th bit of b_k(i) is the qubits[k][n]-th bit of i.
+    // A run of diagonal gates, e.g. Z, phase shifts and exp(i theta ZZ), is described as tables of 2^boost::size(qubits[k]) coefficients,
+    // and it is applied in one sweep over the state rather than one sweep per gate.
+    // The state is processed chunk by chunk, each of which has 2^KET_GATE_DIAGONAL_BATCH_CHUNK_QUBITS amplitudes,
+    // and the coefficients of tables whose qubits are all outside of the chunk are multiplied once per chunk.
+    template <typename ParallelPolicy, typename RandomAccessIterator, typename TableRanges, typename QubitRanges>
+    inline void diagonal_batch(
+      ParallelPolicy const parallel_policy,
+      RandomAccessIterator const first, RandomAccessIterator const last,
+      TableRanges const& tables, QubitRanges const& qubits)
+    {
+      using qubit_type = typename boost::range_value<typename boost::range_value<QubitRanges>::type>::type;
+      using state_integer_type = typename ::ket::meta::state_integer_of<qubit_type>::type;
+      using bit_integer_type = typename ::ket::meta::bit_integer_of<qubit_type>::type;
+      static_assert(std::is_unsigned<state_integer_type>::value, "state_integer_type of qubit should be unsigned");
+      static_assert(std::is_unsigned<bit_integer_type>::value, "bit_integer_type of qubit should be unsigned");
+      static_assert(KET_GATE_DIAGONAL_BATCH_CHUNK_QUBITS > 0, "KET_GATE_DIAGONAL_BATCH_CHUNK_QUBITS should be positive");
+      assert(
+        ::ket::utility::integer_exp2<state_integer_type>(
+          ::ket::utility::integer_log2<bit_integer_type>(last - first))
+        == static_cast<state_integer_type>(last - first));
+      assert(boost::size(tables) == boost::size(qubits));
+
+      using complex_type = typename std::iterator_traits<RandomAccessIterator>::value_type;
+      auto const state_size = static_cast<state_integer_type>(last - first);
+      auto const num_chunk_qubits
+        = std::min(
+            static_cast<bit_integer_type>(KET_GATE_DIAGONAL_BATCH_CHUNK_QUBITS),
+            ::ket::utility::integer_log2<bit_integer_type>(state_size));
+
+      // tables are flattened and separated into "low" tables, some of whose qubits are in a chunk, and "high" tables
+      auto low_coefficients = std::vector<complex_type>{};
+      auto low_qubits = std::vector<bit_integer_type>{};
+      auto low_last_qubits = std::vector<std::size_t>{};
+      auto high_coefficients = std::vector<complex_type>{};
+      auto high_qubits = std::vector<bit_integer_type>{};
+      auto high_last_qubits = std::vector<std::size_t>{};
+
+      auto tables_iter = std::begin(tables);
+      for (auto const& table_qubits: qubits)
+      {
+        auto const& table = *tables_iter++;
+        assert(static_cast<std::size_t>(boost::size(table)) == ::ket::utility::integer_exp2<std::size_t>(boost::size(table_qubits)));
+
+        auto const is_low
+          = std::any_of(
+              std::begin(table_qubits), std::end(table_qubits),
+              [num_chunk_qubits](qubit_type const qubit) { return static_cast<bit_integer_type>(qubit) < num_chunk_qubits; });
+        auto& coefficients = is_low ? low_coefficients : high_coefficients;
+        auto& flat_qubits = is_low ? low_qubits : high_qubits;
+        auto& last_qubits = is_low ? low_last_qubits : high_last_qubits;
+
+        for (auto const& coefficient: table)
+          coefficients.push_back(static_cast<complex_type>(coefficient));
+        for (auto const qubit: table_qubits)
+          flat_qubits.push_back(static_cast<bit_integer_type>(qubit));
+        last_qubits.push_back(flat_qubits.size());
+      }
+
+      using ::ket::utility::loop_n;
+      loop_n(
+        parallel_policy,
+        state_size >> num_chunk_qubits,
+        [first, num_chunk_qubits,
+         &low_coefficients, &low_qubits, &low_last_qubits, &high_coefficients, &high_qubits, &high_last_qubits](
+          state_integer_type const chunk_index, int const)
+        {
+          auto const chunk_first_index = chunk_index << num_chunk_qubits;
+
+          auto chunk_coefficient = complex_type{1};
+          auto high_coefficients_first = std::begin(high_coefficients);
+          auto high_qubits_first = std::begin(high_qubits);
+          for (auto const last_qubit: high_last_qubits)
+          {
+            auto const high_qubits_last = std::begin(high_qubits) + last_qubit;
+            chunk_coefficient
+              *= high_coefficients_first[
+                   ::ket::gate::diagonal_batch_detail::table_index<state_integer_type, bit_integer_type>(
+                     chunk_first_index, high_qubits_first, high_qubits_last)];
+            high_coefficients_first += ::ket::utility::integer_exp2<std::size_t>(high_qubits_last - high_qubits_first);
+            high_qubits_first = high_qubits_last;
+          }
+
+          auto const chunk_size = state_integer_type{1u} << num_chunk_qubits;
+          for (auto index = chunk_first_index; index < chunk_first_index + chunk_size; ++index)
+          {
+            auto coefficient = chunk_coefficient;
+            auto low_coefficients_first = std::begin(low_coefficients);
+            auto low_qubits_first = std::begin(low_qubits);
+            for (auto const last_qubit: low_last_qubits)
+            {
+              auto const low_qubits_last = std::begin(low_qubits) + last_qubit;
+              coefficient
+                *= low_coefficients_first[
+                     ::ket::gate::diagonal_batch_detail::table_index<state_integer_type, bit_integer_type>(
+                       index, low_qubits_first, low_qubits_last)];
+              low_coefficients_first += ::ket::utility::integer_exp2<std::size_t>(low_qubits_last - low_qubits_first);
+              low_qubits_first = low_qubits_last;
+            }
+
+            first[index] *= coefficient;
+          }
+        });
+    }
+
+    template <typename RandomAccessIterator, typename TableRanges, typename QubitRanges>
+    inline void diagonal_batch(
+      RandomAccessIterator const first, RandomAccessIterator const last,
+      TableRanges const& tables, QubitRanges const& qubits)
+    { ::ket::gate::diagonal_batch(::ket::utility::policy::make_sequential(), first, last, tables, qubits); }
+
+    namespace ranges
+    {
+      template <typename ParallelPolicy, typename RandomAccessRange, typename TableRanges, typename QubitRanges>
+      inline typename std::enable_if<
+        ::ket::utility::policy::meta::is_loop_n_policy<ParallelPolicy>::value,
+        RandomAccessRange&>::type
+      diagonal_batch(
+        ParallelPolicy const parallel_policy,
+        RandomAccessRange& state, TableRanges const& tables, QubitRanges const& qubits)
+      {
+        ::ket::gate::diagonal_batch(parallel_policy, std::begin(state), std::end(state), tables, qubits);
+        return state;
+      }
+
+      template <typename RandomAccessRange, typename TableRanges, typename QubitRanges>
+      inline RandomAccessRange& diagonal_batch(RandomAccessRange& state, TableRanges const& tables, QubitRanges const& qubits)
+      { return ::ket::gate::ranges::diagonal_batch(::ket::utility::policy::make_sequential(), state, tables, qubits); }
+    } // namespace ranges
+  } // namespace gate
+} // namespace ket
+
+
+#endif // KET_GATE_DIAGONAL_BATCH_HPP
@@ -13,6 +13,7 @@
 # include <ket/qubit.hpp>
 # include <ket/control.hpp>
 # include <ket/gate/gate.hpp>
+# include <ket/gate/detail/simd.hpp>
 # include <ket/gate/meta/num_control_qubits.hpp>
 # include <ket/utility/loop_n.hpp>
 # include <ket/utility/integer_exp2.hpp>
@@ -57,6 +58,11 @@ namespace ket
       auto const cos_theta = real(phase_coefficient);
       auto const i_sin_theta = ::ket::utility::imaginary_unit<Complex>() * imag(phase_coefficient);
 
+      auto const cos_theta_coefficient = Complex{cos_theta};
+      if (::ket::gate::detail::simd::unitary(
+          parallel_policy, first, last, qubit, cos_theta_coefficient, i_sin_theta, i_sin_theta, cos_theta_coefficient))
+        return;
+
       using ::ket::utility::loop_n;
       loop_n(
         parallel_policy,
@@ -367,7 +373,7 @@ namespace ket
         ::ket::qubit<StateInteger, BitInteger> const qubit, Qubits const... qubits)
       {
         using complex_type = typename boost::range_value<RandomAccessRange>::type;
-        return ::ket::gate::ranges::exponential_pauli_x_coeff(parallel_policy, state, ::ket::utility::exp_i<complex_type>(phase), qubit);
+        return ::ket::gate::ranges::exponential_pauli_x_coeff(parallel_policy, state, ::ket::utility::exp_i<complex_type>(phase), qubit, qubits...);
       }
 
       template <typename RandomAccessRange, typename Real, typename StateInteger, typename BitInteger, typename... Qubits>
@@ -13,6 +13,7 @@
 # include <ket/qubit.hpp>
 # include <ket/control.hpp>
 # include <ket/gate/gate.hpp>
+# include <ket/gate/detail/simd.hpp>
 # include <ket/gate/meta/num_control_qubits.hpp>
 # include <ket/utility/loop_n.hpp>
 # include <ket/utility/integer_exp2.hpp>
@@ -57,6 +58,12 @@ namespace ket
       auto const cos_theta = real(phase_coefficient);
       auto const sin_theta = imag(phase_coefficient);
 
+      auto const cos_theta_coefficient = Complex{cos_theta};
+      auto const sin_theta_coefficient = Complex{sin_theta};
+      if (::ket::gate::detail::simd::unitary(
+          parallel_policy, first, last, qubit, cos_theta_coefficient, sin_theta_coefficient, -sin_theta_coefficient, cos_theta_coefficient))
+        return;
+
       using ::ket::utility::loop_n;
       loop_n(
         parallel_policy,
@@ -251,16 +258,19 @@ namespace ket
       auto const i_sin_theta = ::ket::utility::imaginary_unit<Complex>() * sin_theta;
 
       auto sin_part = Complex{};
-      switch (num_qubits % BitInteger{4u})
+      switch (num_target_qubits % BitInteger{4u})
       {
        case BitInteger{0u}:
         sin_part = i_sin_theta;
+        break;
 
        case BitInteger{1u}:
         sin_part = -sin_theta;
+        break;
 
        case BitInteger{2u}:
         sin_part = -i_sin_theta;
+        break;
 
        default: //case BitInteger{3u}:
         sin_part = sin_theta;
@@ -13,6 +13,7 @@
 # include <ket/qubit.hpp>
 # include <ket/control.hpp>
 # include <ket/gate/gate.hpp>
+# include <ket/gate/detail/simd.hpp>
 # include <ket/gate/meta/num_control_qubits.hpp>
 # include <ket/utility/loop_n.hpp>
 # include <ket/utility/integer_exp2.hpp>
@@ -55,6 +56,10 @@ namespace ket
       using std::conj;
       auto const conj_phase_coefficient = conj(phase_coefficient);
 
+      if (::ket::gate::detail::simd::diagonal(
+          parallel_policy, first, last, qubit, phase_coefficient, conj_phase_coefficient))
+        return;
+
       using ::ket::utility::loop_n;
       loop_n(
         parallel_policy,
@@ -7,6 +7,8 @@
 # include <iterator>
 # include <algorithm>
 # include <numeric>
+# include <functional>
+# include <vector>
 # include <utility>
 # include <type_traits>
 
@@ -14,7 +16,9 @@
 # include <ket/control.hpp>
 # include <ket/meta/state_integer_of.hpp>
 # include <ket/meta/bit_integer_of.hpp>
+# include <ket/gate/meta/num_control_qubits.hpp>
 # include <ket/utility/loop_n.hpp>
+# include <ket/utility/per_thread.hpp>
 # include <ket/utility/integer_exp2.hpp>
 # ifndef NDEBUG
 #   include <ket/utility/integer_log2.hpp>
@@ -74,27 +78,41 @@ namespace ket
         std::adjacent_difference(std::begin(result), std::end(result), std::begin(result));
       }
 
+      // offsets[n] is the bitwise OR of qubit_masks[i] for all set bits i of n
       template <typename StateInteger, std::size_t num_operated_qubits>
-      inline void make_indices(
+      inline void make_index_offsets(
         std::array<StateInteger, ::ket::utility::integer_exp2<std::size_t>(num_operated_qubits)>& result,
-        StateInteger const index_wo_qubits,
-        std::array<StateInteger, num_operated_qubits> const& qubit_masks,
-        std::array<StateInteger, num_operated_qubits + 1u> const& index_masks)
+        std::array<StateInteger, num_operated_qubits> const& qubit_masks)
       {
-        // xx0xx0xx0xx
         result[0u] = StateInteger{0u};
-        for (auto index_mask_index = std::size_t{0u}; index_mask_index < num_operated_qubits + std::size_t{1u}; ++index_mask_index)
-          result[0u] |= (index_wo_qubits bitand index_masks[index_mask_index]) << index_mask_index;
-
-        static constexpr auto num_indices = ::ket::utility::integer_exp2<std::size_t>(num_operated_qubits);
-        for (auto n = std::size_t{1u}; n < num_indices; ++n)
+        for (auto qubit_index = std::size_t{0u}; qubit_index < num_operated_qubits; ++qubit_index)
         {
-          result[n] = result[0u];
-          for (auto qubit_index = std::size_t{0u}; qubit_index < num_operated_qubits; ++qubit_index)
-            if (((StateInteger{1u} << qubit_index) bitand n) != StateInteger{0u})
-              result[n] |= qubit_masks[qubit_index];
+          auto const num_lower_indices = std::size_t{1u} << qubit_index;
+          for (auto n = std::size_t{0u}; n < num_lower_indices; ++n)
+            result[num_lower_indices + n] = result[n] bitor qubit_masks[qubit_index];
         }
       }
+
+      template <typename StateInteger, std::size_t num_operated_qubits>
+      inline StateInteger make_base_index(
+        StateInteger const index_wo_qubits, std::array<StateInteger, num_operated_qubits + 1u> const& index_masks)
+      {
+        // xx0xx0xx0xx
+        auto result = StateInteger{0u};
+        for (auto index_mask_index = std::size_t{0u}; index_mask_index < num_operated_qubits + std::size_t{1u}; ++index_mask_index)
+          result |= (index_wo_qubits bitand index_masks[index_mask_index]) << index_mask_index;
+
+        return result;
+      }
+
+      // each thread has its own indices, which are held by ::ket::utility::per_thread so that no cache line is shared with any other thread
+      template <typename StateInteger, std::size_t num_indices>
+      struct thread_indices
+      {
+        std::array<StateInteger, num_indices> indices;
+        StateInteger next_index_wo_qubits;
+        StateInteger base_index;
+      }; // struct thread_indices<StateInteger, num_indices>
     } // namespace gate_detail
 
     // USAGE:
@@ -117,6 +135,8 @@ namespace ket
     //     [](auto const first, auto const& indices, int const)
     //     { std::iter_swap(first + indices[0b10u], first + indices[0b11u]); },
     //     target_qubit, control_qubit);
+    // - indices is owned by the thread of thread_index, and the k-th bit of n in indices[n] corresponds to the k-th qubit.
+    //   Control qubits must be placed after target qubits, and only indices[n] whose control bits are all 1 are specified
     template <typename ParallelPolicy, typename RandomAccessIterator, typename Function, typename Qubit, typename... Qubits>
     inline void gate(
       ParallelPolicy const parallel_policy,
@@ -141,18 +161,54 @@ namespace ket
       auto index_masks = std::array<state_integer_type, num_operated_qubits + 1u>{};
       ::ket::gate::gate_detail::make_index_masks(index_masks, std::forward<Qubit>(qubit), std::forward<Qubits>(qubits)...);
 
-      auto indices = std::array<state_integer_type, ::ket::utility::integer_exp2<std::size_t>(num_operated_qubits)>{};
+      static constexpr auto num_indices = ::ket::utility::integer_exp2<std::size_t>(num_operated_qubits);
+      auto index_offsets = std::array<state_integer_type, num_indices>{};
+      ::ket::gate::gate_detail::make_index_offsets(index_offsets, qubit_masks);
+      auto const operated_qubits_mask
+        = std::accumulate(std::begin(qubit_masks), std::end(qubit_masks), state_integer_type{0u}, std::bit_or<state_integer_type>{});
+
+      // Control qubits are placed after target qubits, so only the last 2^(the number of target qubits) indices,
+      // whose control bits are all 1, are used in function. The other elements of indices are unspecified.
+      static constexpr auto num_control_qubits
+        = static_cast<std::size_t>(
+            ::ket::gate::meta::num_control_qubits<
+              bit_integer_type, typename std::decay<Qubit>::type, typename std::decay<Qubits>::type...>::value);
+      static constexpr auto first_used_indices_index
+        = ((std::size_t{1u} << num_control_qubits) - std::size_t{1u}) << (num_operated_qubits - num_control_qubits);
+
+      using thread_indices_type = ::ket::gate::gate_detail::thread_indices<state_integer_type, num_indices>;
+      auto thread_indices_of_threads
+        = ::ket::utility::per_thread<thread_indices_type>(
+            parallel_policy,
+            thread_indices_type{std::array<state_integer_type, num_indices>{}, compl state_integer_type{0u}, state_integer_type{0u}});
+
       using ::ket::utility::loop_n;
       loop_n(
         parallel_policy,
         static_cast<state_integer_type>(last - first) >> num_operated_qubits,
-        [first, &function, &qubit_masks, &index_masks, &indices](state_integer_type const index_wo_qubits, int const thread_index)
+        [first, &function, &index_masks, &index_offsets, operated_qubits_mask, &thread_indices_of_threads](
+          state_integer_type const index_wo_qubits, int const thread_index)
         {
+          auto& thread_indices = thread_indices_of_threads[thread_index];
+
+          // Consecutive iterations of a thread are usually consecutive index_wo_qubits's.
+          // In this case, the base index xx0xx0xx0xx is incremented by filling the operated bits with 1 before adding 1,
+          // which carries over them, instead of being rebuilt from index_masks.
+          if (index_wo_qubits == thread_indices.next_index_wo_qubits)
+            thread_indices.base_index
+              = ((thread_indices.base_index bitor operated_qubits_mask) + state_integer_type{1u}) bitand compl operated_qubits_mask;
+          else
+            thread_indices.base_index
+              = ::ket::gate::gate_detail::make_base_index<state_integer_type, num_operated_qubits>(index_wo_qubits, index_masks);
+          thread_indices.next_index_wo_qubits = index_wo_qubits + state_integer_type{1u};
+
           // ex. qubit_masks[0]=00000100000; qubit_masks[1]=00100000000; qubit_masks[2]=00000000100;
           // indices[0b000]=xx0xx0xx0xx; indices[0b001]=xx0xx1xx0xx; indices[0b010]=xx1xx0xx0xx; indices[0b011]=xx1xx1xx0xx;
           // indices[0b100]=xx0xx0xx1xx; indices[0b101]=xx0xx1xx1xx; indices[0b110]=xx1xx0xx1xx; indices[0b111]=xx1xx1xx1xx;
-          ::ket::gate::gate_detail::make_indices(indices, index_wo_qubits, qubit_masks, index_masks);
-          function(first, indices, thread_index);
+          for (auto n = first_used_indices_index; n < num_indices; ++n)
+            thread_indices.indices[n] = thread_indices.base_index bitor index_offsets[n];
+
+          function(first, static_cast<std::array<state_integer_type, num_indices> const&>(thread_indices.indices), thread_index);
         });
     }
 
@@ -13,6 +13,7 @@
 # include <ket/qubit.hpp>
 # include <ket/control.hpp>
 # include <ket/gate/gate.hpp>
+# include <ket/gate/detail/simd.hpp>
 # include <ket/utility/loop_n.hpp>
 # include <ket/utility/integer_exp2.hpp>
 # ifndef NDEBUG
@@ -44,6 +45,14 @@ namespace ket
       auto const lower_bits_mask = qubit_mask - StateInteger{1u};
       auto const upper_bits_mask = compl lower_bits_mask;
 
+      using complex_type = typename std::iterator_traits<RandomAccessIterator>::value_type;
+      using real_type = typename ::ket::utility::meta::real_of<complex_type>::type;
+      using boost::math::constants::one_div_root_two;
+      auto const coefficient = complex_type{one_div_root_two<real_type>()};
+      if (::ket::gate::detail::simd::unitary(
+          parallel_policy, first, last, qubit, coefficient, coefficient, coefficient, -coefficient))
+        return;
+
       using ::ket::utility::loop_n;
       loop_n(
         parallel_policy,
@@ -0,0 +1,253 @@
+#ifndef KET_GATE_MATRIX_HPP
+# define KET_GATE_MATRIX_HPP
+
+# include <cassert>
+# include <cstddef>
+# include <vector>
+# include <iterator>
+# include <algorithm>
+# include <numeric>
+# include <utility>
+# include <type_traits>
+
+# include <boost/range/size.hpp>
+# include <boost/range/value_type.hpp>
+
+# include <ket/qubit.hpp>
+# include <ket/meta/state_integer_of.hpp>
+# include <ket/meta/bit_integer_of.hpp>
+# include <ket/gate/detail/simd.hpp>
+# include <ket/utility/loop_n.hpp>
+# include <ket/utility/integer_exp2.hpp>
+# ifndef NDEBUG
+#   include <ket/utility/integer_log2.hpp>
+# endif
+
+// Number of groups of amplitudes multiplied by the matrix at once in ::ket::gate::matrix
+# ifndef KET_GATE_MATRIX_BLOCK_SIZE
+#   define KET_GATE_MATRIX_BLOCK_SIZE 8
+# endif // KET_GATE_MATRIX_BLOCK_SIZE
+
+
+namespace ket
+{
+  namespace gate
+  {
+    namespace matrix_detail
+    {
+      // offsets[i] = sum_{j: j-th bit of i is 1} 2^{qubits[j]}
+      template <typename StateInteger, typename QubitRange>
+      inline std::vector<StateInteger> make_offsets(QubitRange const& qubits)
+      {
+        auto const num_operated_qubits = static_cast<std::size_t>(boost::size(qubits));
+        auto const num_indices = ::ket::utility::integer_exp2<std::size_t>(num_operated_qubits);
+
+        auto result = std::vector<StateInteger>(num_indices, StateInteger{0u});
+        auto qubit_index = std::size_t{0u};
+        for (auto const& qubit: qubits)
+        {
+          auto const qubit_mask = StateInteger{1u} << qubit;
+          auto const index_mask = std::size_t{1u} << qubit_index++;
+          for (auto index = std::size_t{0u}; index < num_indices; ++index)
+            if ((index bitand index_mask) != std::size_t{0u})
+              result[index] |= qubit_mask;
+        }
+
+        return result;
+      }
+
+      // same as ::ket::gate::gate_detail::make_index_masks except that the number of qubits is given at runtime
+      template <typename StateInteger, typename QubitRange>
+      inline std::vector<StateInteger> make_index_masks(QubitRange const& qubits)
+      {
+        using qubit_type = typename boost::range_value<QubitRange>::type;
+        using bit_integer_type = typename ::ket::meta::bit_integer_of<qubit_type>::type;
+        auto const num_operated_qubits = static_cast<std::size_t>(boost::size(qubits));
+
+        auto sorted_qubits = std::vector<qubit_type>(std::begin(qubits), std::end(qubits));
+        std::sort(std::begin(sorted_qubits), std::end(sorted_qubits));
+
+        auto result = std::vector<StateInteger>(num_operated_qubits + std::size_t{1u});
+        for (auto index = std::size_t{0u}; index < num_operated_qubits; ++index)
+          result[index] = (StateInteger{1u} << (sorted_qubits[index] - static_cast<bit_integer_type>(index))) - StateInteger{1u};
+        result.back() = compl StateInteger{0u};
+
+        std::adjacent_difference(std::begin(result), std::end(result), std::begin(result));
+        return result;
+      }
+    } // namespace matrix_detail
+
+    // U_{i...j} (a_{0...0} |0...0> + ... + a_{1...1} |1...1>) = sum_{k,l} U_{kl} a_l |k>
+    // matrix is a row-major 2^m x 2^m matrix, where m = boost::size(qubits), and the n-th bit of row/column indices corresponds to qubits[n].
+    // ex. for CNOT (target: qubits[0], control: qubits[1]),
+    //   matrix = {1, 0, 0, 0,
+    //             0, 1, 0, 0,
+    //             0, 0, 0, 1,
+    //             0, 0, 1, 0};
+    // Amplitudes of KET_GATE_MATRIX_BLOCK_SIZE consecutive groups, each of which has 2^m amplitudes, are multiplied at once,
+    // so that each element of matrix is loaded once per block rather than once per group.
+    template <typename ParallelPolicy, typename RandomAccessIterator, typename RandomAccessRange, typename QubitRange>
+    inline void matrix(
+      ParallelPolicy const parallel_policy,
+      RandomAccessIterator const first, RandomAccessIterator const last,
+      RandomAccessRange const& matrix, QubitRange const& qubits)
+    {
+      using qubit_type = typename boost::range_value<QubitRange>::type;
+      using state_integer_type = typename ::ket::meta::state_integer_of<qubit_type>::type;
+      using bit_integer_type = typename ::ket::meta::bit_integer_of<qubit_type>::type;
+      static_assert(std::is_unsigned<state_integer_type>::value, "state_integer_type of qubit should be unsigned");
+      static_assert(std::is_unsigned<bit_integer_type>::value, "bit_integer_type of qubit should be unsigned");
+      static_assert(
+        KET_GATE_MATRIX_BLOCK_SIZE > 0 and (KET_GATE_MATRIX_BLOCK_SIZE bitand (KET_GATE_MATRIX_BLOCK_SIZE - 1)) == 0,
+        "KET_GATE_MATRIX_BLOCK_SIZE should be a power of two");
+      assert(
+        ::ket::utility::integer_exp2<state_integer_type>(
+          ::ket::utility::integer_log2<bit_integer_type>(last - first))
+        == static_cast<state_integer_type>(last - first));
+
+      auto const num_operated_qubits = static_cast<std::size_t>(boost::size(qubits));
+      auto const num_indices = ::ket::utility::integer_exp2<std::size_t>(num_operated_qubits);
+      assert(static_cast<std::size_t>(boost::size(matrix)) == num_indices * num_indices);
+      assert(::ket::utility::integer_exp2<state_integer_type>(num_operated_qubits) <= static_cast<state_integer_type>(last - first));
+
+      using complex_type = typename std::iterator_traits<RandomAccessIterator>::value_type;
+      auto const matrix_first = std::begin(matrix);
+      if (num_operated_qubits == std::size_t{1u}
+          and ::ket::gate::detail::simd::unitary(
+                parallel_policy, first, last, *std::begin(qubits),
+                static_cast<complex_type>(matrix_first[0u]), static_cast<complex_type>(matrix_first[1u]),
+                static_cast<complex_type>(matrix_first[2u]), static_cast<complex_type>(matrix_first[3u])))
+        return;
+
+      auto const offsets = ::ket::gate::matrix_detail::make_offsets<state_integer_type>(qubits);
+      auto const index_masks = ::ket::gate::matrix_detail::make_index_masks<state_integer_type>(qubits);
+
+      auto const num_groups = static_cast<state_integer_type>(last - first) >> num_operated_qubits;
+      auto const block_size
+        = static_cast<std::size_t>(std::min(num_groups, static_cast<state_integer_type>(KET_GATE_MATRIX_BLOCK_SIZE)));
+
+      // each thread has its own copy of amplitudes a_{0...0}, ..., a_{1...1} of each group in a block, which are stored column by column
+      auto const num_threads = static_cast<std::size_t>(::ket::utility::num_threads(parallel_policy));
+      auto const buffer_size = num_indices * block_size;
+      auto buffers = std::vector<complex_type>(num_threads * (buffer_size + block_size));
+      auto base_indices_buffers = std::vector<state_integer_type>(num_threads * block_size);
+
+      using ::ket::utility::loop_n;
+      loop_n(
+        parallel_policy,
+        num_groups / static_cast<state_integer_type>(block_size),
+        [first, matrix_first, num_operated_qubits, num_indices, block_size, buffer_size,
+         &offsets, &index_masks, &buffers, &base_indices_buffers](
+          state_integer_type const block_index, int const thread_index)
+        {
+          auto const base_indices = std::begin(base_indices_buffers) + thread_index * block_size;
+          for (auto group_index = std::size_t{0u}; group_index < block_size; ++group_index)
+          {
+            auto const index_wo_qubits = block_index * static_cast<state_integer_type>(block_size) + static_cast<state_integer_type>(group_index);
+
+            // xx0xx0xx0xx
+            auto base_index = state_integer_type{0u};
+            for (auto index_mask_index = std::size_t{0u}; index_mask_index < num_operated_qubits + std::size_t{1u}; ++index_mask_index)
+              base_index |= (index_wo_qubits bitand index_masks[index_mask_index]) << index_mask_index;
+            base_indices[group_index] = base_index;
+          }
+
+          auto const buffer_first = std::begin(buffers) + thread_index * (buffer_size + block_size);
+          for (auto column = std::size_t{0u}; column < num_indices; ++column)
+            for (auto group_index = std::size_t{0u}; group_index < block_size; ++group_index)
+              buffer_first[column * block_size + group_index] = first[base_indices[group_index] bitor offsets[column]];
+
+          auto const values = buffer_first + buffer_size;
+          for (auto row = std::size_t{0u}; row < num_indices; ++row)
+          {
+            std::fill(values, values + block_size, complex_type{});
+
+            auto const row_first = matrix_first + row * num_indices;
+            for (auto column = std::size_t{0u}; column < num_indices; ++column)
+            {
+              auto const element = static_cast<complex_type>(row_first[column]);
+              auto const column_first = buffer_first + column * block_size;
+              for (auto group_index = std::size_t{0u}; group_index < block_size; ++group_index)
+                values[group_index] += element * column_first[group_index];
+            }
+
+            for (auto group_index = std::size_t{0u}; group_index < block_size; ++group_index)
+              first[base_indices[group_index] bitor offsets[row]] = values[group_index];
+          }
+        });
+    }
+
+    template <typename RandomAccessIterator, typename RandomAccessRange, typename QubitRange>
+    inline void matrix(
+      RandomAccessIterator const first, RandomAccessIterator const last,
+      RandomAccessRange const& matrix, QubitRange const& qubits)
+    { ::ket::gate::matrix(::ket::utility::policy::make_sequential(), first, last, matrix, qubits); }
+
+    template <
+      typename ParallelPolicy, typename RandomAccessIterator, typename RandomAccessRange,
+      typename StateInteger, typename BitInteger, typename... Qubits>
+    inline void matrix(
+      ParallelPolicy const parallel_policy,
+      RandomAccessIterator const first, RandomAccessIterator const last,
+      RandomAccessRange const& matrix, ::ket::qubit<StateInteger, BitInteger> const qubit, Qubits const... qubits)
+    {
+      using qubit_type = ::ket::qubit<StateInteger, BitInteger>;
+      ::ket::gate::matrix(
+        parallel_policy, first, last, matrix,
+        std::vector<qubit_type>{qubit, qubits...});
+    }
+
+    template <
+      typename RandomAccessIterator, typename RandomAccessRange,
+      typename StateInteger, typename BitInteger, typename... Qubits>
+    inline void matrix(
+      RandomAccessIterator const first, RandomAccessIterator const last,
+      RandomAccessRange const& matrix, ::ket::qubit<StateInteger, BitInteger> const qubit, Qubits const... qubits)
+    { ::ket::gate::matrix(::ket::utility::policy::make_sequential(), first, last, matrix, qubit, qubits...); }
+
+    namespace ranges
+    {
+      template <typename ParallelPolicy, typename RandomAccessRange, typename MatrixRange, typename QubitRange>
+      inline typename std::enable_if<
+        ::ket::utility::policy::meta::is_loop_n_policy<ParallelPolicy>::value,
+        RandomAccessRange&>::type
+      matrix(
+        ParallelPolicy const parallel_policy,
+        RandomAccessRange& state, MatrixRange const& matrix, QubitRange const& qubits)
+      {
+        ::ket::gate::matrix(parallel_policy, std::begin(state), std::end(state), matrix, qubits);
+        return state;
+      }
+
+      template <typename RandomAccessRange, typename MatrixRange, typename QubitRange>
+      inline RandomAccessRange& matrix(RandomAccessRange& state, MatrixRange const& matrix, QubitRange const& qubits)
+      { return ::ket::gate::ranges::matrix(::ket::utility::policy::make_sequential(), state, matrix, qubits); }
+
+      template <
+        typename ParallelPolicy, typename RandomAccessRange, typename MatrixRange,
+        typename StateInteger, typename BitInteger, typename... Qubits>
+      inline typename std::enable_if<
+        ::ket::utility::policy::meta::is_loop_n_policy<ParallelPolicy>::value,
+        RandomAccessRange&>::type
+      matrix(
+        ParallelPolicy const parallel_policy,
+        RandomAccessRange& state, MatrixRange const& matrix,
+        ::ket::qubit<StateInteger, BitInteger> const qubit, Qubits const... qubits)
+      {
+        ::ket::gate::matrix(parallel_policy, std::begin(state), std::end(state), matrix, qubit, qubits...);
+        return state;
+      }
+
+      template <
+        typename RandomAccessRange, typename MatrixRange,
+        typename StateInteger, typename BitInteger, typename... Qubits>
+      inline RandomAccessRange& matrix(
+        RandomAccessRange& state, MatrixRange const& matrix,
+        ::ket::qubit<StateInteger, BitInteger> const qubit, Qubits const... qubits)
+      { return ::ket::gate::ranges::matrix(::ket::utility::policy::make_sequential(), state, matrix, qubit, qubits...); }
+    } // namespace ranges
+  } // namespace gate
+} // namespace ket
+
+
+#endif // KET_GATE_MATRIX_HPP
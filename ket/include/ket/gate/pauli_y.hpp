@@ -11,6 +11,7 @@
 # include <ket/qubit.hpp>
 # include <ket/control.hpp>
 # include <ket/gate/gate.hpp>
+# include <ket/gate/detail/simd.hpp>
 # include <ket/gate/meta/num_control_qubits.hpp>
 # include <ket/utility/loop_n.hpp>
 # include <ket/utility/integer_exp2.hpp>
@@ -44,6 +45,12 @@ namespace ket
       auto const lower_bits_mask = qubit_mask - StateInteger{1u};
       auto const upper_bits_mask = compl lower_bits_mask;
 
+      using complex_type = typename std::iterator_traits<RandomAccessIterator>::value_type;
+      auto const imaginary_unit = ::ket::utility::imaginary_unit<complex_type>();
+      if (::ket::gate::detail::simd::anti_diagonal(
+          parallel_policy, first, last, qubit, -imaginary_unit, imaginary_unit))
+        return;
+
       using ::ket::utility::loop_n;
       loop_n(
         parallel_policy,
@@ -211,12 +218,15 @@ namespace ket
       {
        case BitInteger{0u}:
         coefficient = complex_type{1};
+        break;
 
        case BitInteger{1u}:
         coefficient = ::ket::utility::imaginary_unit<complex_type>();
+        break;
 
        case BitInteger{2u}:
         coefficient = complex_type{-1};
+        break;
 
        default: //case BitInteger{3u}:
         coefficient = -::ket::utility::imaginary_unit<complex_type>();
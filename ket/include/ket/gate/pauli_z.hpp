@@ -11,6 +11,7 @@
 # include <ket/qubit.hpp>
 # include <ket/control.hpp>
 # include <ket/gate/gate.hpp>
+# include <ket/gate/detail/simd.hpp>
 # include <ket/gate/meta/num_control_qubits.hpp>
 # include <ket/utility/loop_n.hpp>
 # include <ket/utility/integer_exp2.hpp>
@@ -42,6 +43,12 @@ namespace ket
       auto const lower_bits_mask = qubit_mask - StateInteger{1u};
       auto const upper_bits_mask = compl lower_bits_mask;
 
+      using complex_type = typename std::iterator_traits<RandomAccessIterator>::value_type;
+      using real_type = typename ::ket::utility::meta::real_of<complex_type>::type;
+      if (::ket::gate::detail::simd::diagonal(
+          parallel_policy, first, last, qubit, complex_type{real_type{1}}, complex_type{real_type{-1}}))
+        return;
+
       using ::ket::utility::loop_n;
       loop_n(
         parallel_policy,
@@ -14,6 +14,7 @@
 # include <ket/qubit.hpp>
 # include <ket/control.hpp>
 # include <ket/gate/gate.hpp>
+# include <ket/gate/detail/simd.hpp>
 # include <ket/utility/loop_n.hpp>
 # include <ket/utility/integer_exp2.hpp>
 # ifndef NDEBUG
@@ -52,6 +53,11 @@ namespace ket
       auto const lower_bits_mask = qubit_mask - StateInteger{1u};
       auto const upper_bits_mask = compl lower_bits_mask;
 
+      using real_type = typename ::ket::utility::meta::real_of<Complex>::type;
+      if (::ket::gate::detail::simd::diagonal(
+          parallel_policy, first, last, qubit, Complex{real_type{1}}, phase_coefficient))
+        return;
+
       using ::ket::utility::loop_n;
       loop_n(
         parallel_policy,
@@ -316,6 +322,11 @@ namespace ket
       auto const lower_bits_mask = qubit_mask - StateInteger{1u};
       auto const upper_bits_mask = compl lower_bits_mask;
 
+      if (::ket::gate::detail::simd::unitary(
+          parallel_policy, first, last, qubit, complex_type{one_div_root_two<Real>()}, -one_div_root_two<Real>() * phase_coefficient2,
+          modified_phase_coefficient1, modified_phase_coefficient1 * phase_coefficient2))
+        return;
+
       using ::ket::utility::loop_n;
       loop_n(
         parallel_policy,
@@ -534,6 +545,11 @@ namespace ket
       auto const lower_bits_mask = qubit_mask - StateInteger{1u};
       auto const upper_bits_mask = compl lower_bits_mask;
 
+      if (::ket::gate::detail::simd::unitary(
+          parallel_policy, first, last, qubit, complex_type{one_div_root_two<Real>()}, one_div_root_two<Real>() * phase_coefficient1,
+          -modified_phase_coefficient2, modified_phase_coefficient2 * phase_coefficient1))
+        return;
+
       using ::ket::utility::loop_n;
       loop_n(
         parallel_policy,
@@ -755,6 +771,11 @@ namespace ket
       auto const lower_bits_mask = qubit_mask - StateInteger{1u};
       auto const upper_bits_mask = compl lower_bits_mask;
 
+      if (::ket::gate::detail::simd::unitary(
+          parallel_policy, first, last, qubit, complex_type{cosine}, -sine_phase_coefficient3,
+          sine * phase_coefficient2, cosine_phase_coefficient3 * phase_coefficient2))
+        return;
+
       using ::ket::utility::loop_n;
       loop_n(
         parallel_policy,
@@ -990,6 +1011,11 @@ namespace ket
       auto const lower_bits_mask = qubit_mask - StateInteger{1u};
       auto const upper_bits_mask = compl lower_bits_mask;
 
+      if (::ket::gate::detail::simd::unitary(
+          parallel_policy, first, last, qubit, complex_type{cosine}, sine_phase_coefficient2,
+          -sine * phase_coefficient3, cosine_phase_coefficient2 * phase_coefficient3))
+        return;
+
       using ::ket::utility::loop_n;
       loop_n(
         parallel_policy,
@@ -12,6 +12,7 @@
 # include <ket/qubit.hpp>
 # include <ket/control.hpp>
 # include <ket/gate/gate.hpp>
+# include <ket/gate/detail/simd.hpp>
 # include <ket/utility/loop_n.hpp>
 # include <ket/utility/integer_exp2.hpp>
 # ifndef NDEBUG
@@ -43,6 +44,15 @@ namespace ket
       auto const lower_bits_mask = qubit_mask - StateInteger{1u};
       auto const upper_bits_mask = compl lower_bits_mask;
 
+      using complex_type = typename std::iterator_traits<RandomAccessIterator>::value_type;
+      using real_type = typename ::ket::utility::meta::real_of<complex_type>::type;
+      using boost::math::constants::one_div_root_two;
+      auto const coefficient = complex_type{one_div_root_two<real_type>()};
+      auto const i_coefficient = ::ket::utility::imaginary_unit<complex_type>() * coefficient;
+      if (::ket::gate::detail::simd::unitary(
+          parallel_policy, first, last, qubit, coefficient, i_coefficient, i_coefficient, coefficient))
+        return;
+
       using ::ket::utility::loop_n;
       loop_n(
         parallel_policy,
@@ -213,6 +223,15 @@ namespace ket
       auto const lower_bits_mask = qubit_mask - StateInteger{1u};
       auto const upper_bits_mask = compl lower_bits_mask;
 
+      using complex_type = typename std::iterator_traits<RandomAccessIterator>::value_type;
+      using real_type = typename ::ket::utility::meta::real_of<complex_type>::type;
+      using boost::math::constants::one_div_root_two;
+      auto const coefficient = complex_type{one_div_root_two<real_type>()};
+      auto const minus_i_coefficient = -::ket::utility::imaginary_unit<complex_type>() * coefficient;
+      if (::ket::gate::detail::simd::unitary(
+          parallel_policy, first, last, qubit, coefficient, minus_i_coefficient, minus_i_coefficient, coefficient))
+        return;
+
       using ::ket::utility::loop_n;
       loop_n(
         parallel_policy,
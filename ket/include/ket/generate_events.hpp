@@ -1,16 +1,155 @@
 #ifndef KET_GENERATE_EVENTS_HPP
 # define KET_GENERATE_EVENTS_HPP
 
+# include <cstddef>
 # include <cmath>
 # include <vector>
 # include <iterator>
 # include <algorithm>
+# include <numeric>
+# include <random>
 
-# include <ket/utility/positive_random_value_upto.hpp>
+# include <ket/utility/loop_n.hpp>
+
+// Number of amplitudes of each block, whose total probability is stored in ::ket::generate_events
+# ifndef KET_GENERATE_EVENTS_BLOCK_SIZE
+#   define KET_GENERATE_EVENTS_BLOCK_SIZE 1024
+# endif // KET_GENERATE_EVENTS_BLOCK_SIZE
 
 
 namespace ket
 {
+  namespace generate_events_detail
+  {
+    // result[b] is the total probability of blocks 0, 1, ..., b, where the last block may have less than KET_GENERATE_EVENTS_BLOCK_SIZE amplitudes
+    template <typename ParallelPolicy, typename RandomAccessIterator>
+    inline std::vector<long double> cumulative_block_probabilities(
+      ParallelPolicy const parallel_policy,
+      RandomAccessIterator const first, RandomAccessIterator const last)
+    {
+      constexpr auto block_size = std::size_t{KET_GENERATE_EVENTS_BLOCK_SIZE};
+      auto const state_size = static_cast<std::size_t>(last - first);
+      auto result = std::vector<long double>((state_size + block_size - std::size_t{1u}) / block_size);
+
+      using ::ket::utility::loop_n;
+      loop_n(
+        parallel_policy, result.size(),
+        [first, state_size, &result](std::size_t const block_index, int const)
+        {
+          auto const block_first = block_index * block_size;
+          auto const block_last = std::min(block_first + block_size, state_size);
+
+          auto probability = 0.0l;
+          using std::norm;
+          for (auto index = block_first; index < block_last; ++index)
+            probability += static_cast<long double>(norm(first[index]));
+          result[block_index] = probability;
+        });
+
+      std::partial_sum(std::begin(result), std::end(result), std::begin(result));
+      return result;
+    }
+
+    // num_values random values in [0, maximum_value) in ascending order.
+    // They are generated from spacings of exponential random values, which needs O(num_values) operations without sorting.
+    template <typename RandomNumberGenerator>
+    inline std::vector<long double> sorted_random_values(
+      std::size_t const num_values, long double const maximum_value, RandomNumberGenerator& random_number_generator)
+    {
+      auto distribution = std::exponential_distribution<long double>{};
+      auto result = std::vector<long double>(num_values);
+
+      auto sum = 0.0l;
+      for (auto& value: result)
+      {
+        sum += distribution(random_number_generator);
+        value = sum;
+      }
+      sum += distribution(random_number_generator);
+
+      auto const multiplier = maximum_value / sum;
+      for (auto& value: result)
+        value *= multiplier;
+
+      return result;
+    }
+
+    // d_first[n] is the smallest index whose cumulative probability exceeds random_values[n], where random_values are sorted.
+    // Each block is read by only one thread, and only if some random values fall into it,
+    // so that this requires O(last - first + random_values.size()) operations and no writes to the state.
+    template <typename ParallelPolicy, typename RandomAccessIterator, typename OutputRandomAccessIterator>
+    inline void find_events(
+      ParallelPolicy const parallel_policy,
+      RandomAccessIterator const first, RandomAccessIterator const last,
+      std::vector<long double> const& cumulative_block_probabilities,
+      std::vector<long double> const& random_values,
+      OutputRandomAccessIterator const d_first)
+    {
+      constexpr auto block_size = std::size_t{KET_GENERATE_EVENTS_BLOCK_SIZE};
+      auto const state_size = static_cast<std::size_t>(last - first);
+      auto const num_blocks = cumulative_block_probabilities.size();
+      auto const num_values = random_values.size();
+      if (num_values == std::size_t{0u})
+        return;
+
+      // random values larger than the total probability because of rounding errors fall into the last block with nonzero probability
+      auto last_nonzero_block = num_blocks - std::size_t{1u};
+      while (last_nonzero_block > std::size_t{0u}
+             and cumulative_block_probabilities[last_nonzero_block] <= cumulative_block_probabilities[last_nonzero_block - std::size_t{1u}])
+        --last_nonzero_block;
+
+      // random_values[value_firsts[b]], ..., random_values[value_firsts[b + 1] - 1] fall into block b
+      auto value_firsts = std::vector<std::size_t>(num_blocks + std::size_t{1u}, num_values);
+      auto value_index = std::size_t{0u};
+      for (auto block_index = std::size_t{0u}; block_index < last_nonzero_block; ++block_index)
+      {
+        value_firsts[block_index] = value_index;
+        while (value_index < num_values and random_values[value_index] < cumulative_block_probabilities[block_index])
+          ++value_index;
+      }
+      value_firsts[last_nonzero_block] = value_index;
+
+      using value_type = typename std::iterator_traits<OutputRandomAccessIterator>::value_type;
+      using ::ket::utility::loop_n;
+      loop_n(
+        parallel_policy, num_blocks,
+        [first, state_size, d_first, &cumulative_block_probabilities, &random_values, &value_firsts](
+          std::size_t const block_index, int const)
+        {
+          auto value_index = value_firsts[block_index];
+          auto const value_last = value_firsts[block_index + std::size_t{1u}];
+          if (value_index >= value_last)
+            return;
+
+          auto const block_last = std::min(block_index * block_size + block_size, state_size);
+          auto index = block_index * block_size;
+          auto last_nonzero_index = index;
+          auto cumulative_probability
+            = block_index == std::size_t{0u} ? 0.0l : cumulative_block_probabilities[block_index - std::size_t{1u}];
+
+          for (; value_index < value_last; ++value_index)
+          {
+            using std::norm;
+            for (; index < block_last; ++index)
+            {
+              auto const probability = static_cast<long double>(norm(first[index]));
+              if (probability <= 0.0l)
+                continue;
+
+              last_nonzero_index = index;
+              if (random_values[value_index] < cumulative_probability + probability)
+                break;
+              cumulative_probability += probability;
+            }
+
+            d_first[value_index] = static_cast<value_type>(index < block_last ? index : last_nonzero_index);
+          }
+        });
+    }
+  } // namespace generate_events_detail
+
+  // The state is not modified. Events are drawn in ascending order of indices,
+  // so that the state is read about once even for millions of events, and then they are shuffled.
   template <
     typename ParallelPolicy,
     typename StateInteger, typename Allocator,
@@ -22,33 +161,17 @@ namespace ket
     int const num_events,
     RandomNumberGenerator& random_number_generator)
   {
-    result.clear();
-    result.reserve(num_events);
+    auto const cumulative_block_probabilities
+      = ::ket::generate_events_detail::cumulative_block_probabilities(parallel_policy, first, last);
+    auto const random_values
+      = ::ket::generate_events_detail::sorted_random_values(
+          static_cast<std::size_t>(num_events), cumulative_block_probabilities.back(), random_number_generator);
 
-    using complex_type = typename std::iterator_traits<RandomAccessIterator>::value_type;
-    ::ket::utility::transform_inclusive_scan(
-      parallel_policy, first, last, first,
-      [](complex_type const& lhs, complex_type const& rhs)
-      { using std::real; return static_cast<complex_type>(real(lhs) + real(rhs)); },
-      [](complex_type const& value)
-      { using std::norm; return static_cast<complex_type>(norm(value)); });
+    result.assign(num_events, StateInteger{0u});
+    ::ket::generate_events_detail::find_events(
+      parallel_policy, first, last, cumulative_block_probabilities, random_values, std::begin(result));
 
-    using std::real;
-    auto const total_probability = real(*std::prev(last));
-
-    for (auto event_index = int{0}; event_index < num_events; ++event_index)
-    {
-      RandomAccessIterator const found
-        = std::upper_bound(
-            first, last,
-            static_cast<complex_type>(
-              ::ket::utility::positive_random_value_upto(
-                total_probability, random_number_generator)),
-            [](complex_type const& lhs, complex_type const& rhs)
-            { return real(lhs) < real(rhs); });
-
-      result.push_back(found - first);
-    }
+    std::shuffle(std::begin(result), std::end(result), random_number_generator);
   }
 
   template <
@@ -1,29 +1,156 @@
 #ifndef KET_MPI_ALL_EXPECTATION_VALUES_HPP
 # define KET_MPI_ALL_EXPECTATION_VALUES_HPP
 
+# include <cstddef>
+# include <vector>
 # include <array>
+# include <iterator>
+# include <algorithm>
+# include <functional>
 # include <type_traits>
 
 # include <boost/optional.hpp>
 
 # include <boost/range/value_type.hpp>
+# include <boost/math/constants/constants.hpp>
 
 # include <yampi/environment.hpp>
 # include <yampi/datatype_base.hpp>
 # include <yampi/communicator.hpp>
+# include <yampi/buffer.hpp>
+# include <yampi/all_reduce.hpp>
+# include <yampi/reduce.hpp>
+# include <yampi/binary_operation.hpp>
 
+# include <ket/all_spin_expectation_values.hpp>
 # include <ket/qubit.hpp>
 # include <ket/utility/loop_n.hpp>
 # include <ket/utility/meta/real_of.hpp>
 # include <ket/mpi/qubit_permutation.hpp>
 # include <ket/mpi/spin_expectation_value.hpp>
 # include <ket/mpi/utility/simple_mpi.hpp>
+# include <ket/mpi/utility/complete_page_interchanges.hpp>
+# include <ket/mpi/utility/logger.hpp>
 
 
 namespace ket
 {
   namespace mpi
   {
+    namespace all_spin_expectation_values_detail
+    {
+      // Returns local sums for the spins of all qubits: flat_spins[3q], flat_spins[3q+1] and flat_spins[3q+2] are for qubit q,
+      // and flat_spins[3q+2] is not multiplied by 1/2.
+      // z components of all qubits and x and y components of local qubits are computed in one sweep of each data block,
+      // and then global qubits are brought into local qubits by calling interchange_qubits once to compute their x and y components.
+      template <
+        typename RealType, typename MpiPolicy, typename ParallelPolicy,
+        typename LocalState, typename StateInteger, typename BitInteger, typename Allocator,
+        typename InterchangeQubits>
+      inline std::vector<RealType> local_spins(
+        MpiPolicy const& mpi_policy, ParallelPolicy const parallel_policy,
+        LocalState& local_state,
+        ::ket::mpi::qubit_permutation<StateInteger, BitInteger, Allocator> const& permutation,
+        BitInteger const num_qubits,
+        yampi::communicator const& communicator, yampi::environment const& environment,
+        InterchangeQubits&& interchange_qubits)
+      {
+        auto const num_local_qubits
+          = static_cast<BitInteger>(::ket::mpi::utility::policy::num_local_qubits(mpi_policy, local_state, communicator, environment));
+        auto const data_block_size
+          = static_cast<StateInteger>(::ket::mpi::utility::policy::data_block_size(mpi_policy, local_state, communicator, environment));
+        auto const num_data_blocks
+          = static_cast<StateInteger>(::ket::mpi::utility::policy::num_data_blocks(mpi_policy, communicator, environment));
+        auto const rank = communicator.rank(environment);
+
+        auto spins = std::vector<long double>(3u * num_qubits);
+        auto data_block_spins = std::vector<long double>(3u * num_local_qubits + 1u);
+        ::ket::mpi::utility::complete_page_interchanges(local_state);
+
+        using qubit_type = ::ket::qubit<StateInteger, BitInteger>;
+        auto const last_qubit = qubit_type{num_qubits};
+        for (auto data_block_index = StateInteger{0u}; data_block_index < num_data_blocks; ++data_block_index)
+        {
+          std::fill(std::begin(data_block_spins), std::end(data_block_spins), 0.0l);
+          auto const data_block_first = std::begin(local_state) + data_block_index * data_block_size;
+          ::ket::all_spin_expectation_values_detail::add_spins(
+            parallel_policy, data_block_first, data_block_first + data_block_size, compl StateInteger{0u}, data_block_spins);
+
+          // z components of global qubits are determined by the norm of the data block
+          using ::ket::mpi::utility::rank_index_to_qubit_value;
+          auto const data_block_qubit_value
+            = rank_index_to_qubit_value(mpi_policy, local_state, rank, data_block_index * data_block_size);
+          auto const data_block_norm = data_block_spins.back();
+
+          for (auto qubit = qubit_type{BitInteger{0u}}; qubit < last_qubit; ++qubit)
+          {
+            auto const permutated_bit = static_cast<BitInteger>(permutation[qubit].qubit());
+            auto const spin_first = std::begin(spins) + 3u * static_cast<BitInteger>(qubit);
+            if (permutated_bit < num_local_qubits)
+              std::transform(
+                spin_first, spin_first + 3, std::begin(data_block_spins) + 3u * permutated_bit, spin_first,
+                std::plus<long double>{});
+            else if (((data_block_qubit_value >> permutated_bit) bitand StateInteger{1u}) == StateInteger{0u})
+              spin_first[2u] += data_block_norm;
+            else
+              spin_first[2u] -= data_block_norm;
+          }
+        }
+
+        auto global_qubits = std::vector<qubit_type>{};
+        for (auto qubit = qubit_type{BitInteger{0u}}; qubit < last_qubit; ++qubit)
+          if (static_cast<BitInteger>(permutation[qubit].qubit()) >= num_local_qubits)
+            global_qubits.push_back(qubit);
+
+        if (not global_qubits.empty())
+        {
+          interchange_qubits(global_qubits);
+          ::ket::mpi::utility::complete_page_interchanges(local_state);
+
+          auto bits_mask = StateInteger{0u};
+          for (auto const qubit: global_qubits)
+            bits_mask |= StateInteger{1u} << static_cast<BitInteger>(permutation[qubit].qubit());
+
+          for (auto data_block_index = StateInteger{0u}; data_block_index < num_data_blocks; ++data_block_index)
+          {
+            std::fill(std::begin(data_block_spins), std::end(data_block_spins), 0.0l);
+            auto const data_block_first = std::begin(local_state) + data_block_index * data_block_size;
+            ::ket::all_spin_expectation_values_detail::add_spins(
+              parallel_policy, data_block_first, data_block_first + data_block_size, bits_mask, data_block_spins);
+
+            for (auto const qubit: global_qubits)
+            {
+              auto const permutated_bit = static_cast<BitInteger>(permutation[qubit].qubit());
+              spins[3u * static_cast<BitInteger>(qubit)] += data_block_spins[3u * permutated_bit];
+              spins[3u * static_cast<BitInteger>(qubit) + 1u] += data_block_spins[3u * permutated_bit + 1u];
+            }
+          }
+        }
+
+        auto result = std::vector<RealType>(spins.size());
+        std::transform(
+          std::begin(spins), std::end(spins), std::begin(result),
+          [](long double const spin) { return static_cast<RealType>(spin); });
+        return result;
+      }
+
+      template <typename SpinsAllocator, typename RealType>
+      inline std::vector<std::array<RealType, 3u>, SpinsAllocator> to_spins(std::vector<RealType> const& flat_spins)
+      {
+        auto result = std::vector<std::array<RealType, 3u>, SpinsAllocator>(flat_spins.size() / 3u);
+
+        using boost::math::constants::half;
+        for (auto qubit = std::size_t{0u}; qubit < result.size(); ++qubit)
+        {
+          result[qubit][0u] = flat_spins[3u * qubit];
+          result[qubit][1u] = flat_spins[3u * qubit + 1u];
+          result[qubit][2u] = half<RealType>() * flat_spins[3u * qubit + 2u];
+        }
+
+        return result;
+      }
+    } // namespace all_spin_expectation_values_detail
+
     // all_reduce version
     template <
       typename SpinsAllocator,
@@ -46,21 +173,27 @@ namespace ket
       yampi::communicator const& communicator,
       yampi::environment const& environment)
     {
+      ::ket::mpi::utility::log_with_time_guard<char> print{"Spins", environment};
+
       using complex_type = typename boost::range_value<LocalState>::type;
       using real_type = typename ::ket::utility::meta::real_of<complex_type>::type;
-      using spin_type = std::array<real_type, 3u>;
-      auto result = std::vector<spin_type, SpinsAllocator>{};
-      result.reserve(num_qubits);
-
       using qubit_type = ::ket::qubit<StateInteger, BitInteger>;
-      auto const last_qubit = qubit_type{num_qubits};
-      for (auto qubit = qubit_type{BitInteger{0u}}; qubit < last_qubit; ++qubit)
-        result.push_back(
-          ::ket::mpi::spin_expectation_value(
-            mpi_policy, parallel_policy, local_state, qubit, permutation, buffer,
-            communicator, environment));
-
-      return result;
+      auto const local_spins
+        = ::ket::mpi::all_spin_expectation_values_detail::local_spins<real_type>(
+            mpi_policy, parallel_policy, local_state, permutation, num_qubits, communicator, environment,
+            [&](std::vector<qubit_type> const& global_qubits)
+            {
+              ::ket::mpi::utility::maybe_interchange_qubits(
+                mpi_policy, parallel_policy, local_state, global_qubits, permutation, buffer, communicator, environment);
+            });
+
+      auto spins = std::vector<real_type>(local_spins.size());
+      yampi::all_reduce(
+        yampi::make_buffer(std::begin(local_spins), std::end(local_spins)),
+        std::begin(spins), yampi::binary_operation(::yampi::plus_t()),
+        communicator, environment);
+
+      return ::ket::mpi::all_spin_expectation_values_detail::to_spins<SpinsAllocator>(spins);
     }
 
     template <
@@ -87,21 +220,27 @@ namespace ket
       yampi::communicator const& communicator,
       yampi::environment const& environment)
     {
+      ::ket::mpi::utility::log_with_time_guard<char> print{"Spins", environment};
+
       using complex_type = typename boost::range_value<LocalState>::type;
       using real_type = typename ::ket::utility::meta::real_of<complex_type>::type;
-      using spin_type = std::array<real_type, 3u>;
-      auto result = std::vector<spin_type, SpinsAllocator>{};
-      result.reserve(num_qubits);
-
       using qubit_type = ::ket::qubit<StateInteger, BitInteger>;
-      auto const last_qubit = qubit_type{num_qubits};
-      for (auto qubit = qubit_type{BitInteger{0u}}; qubit < last_qubit; ++qubit)
-        result.push_back(
-          ::ket::mpi::spin_expectation_value(
-            mpi_policy, parallel_policy, local_state, qubit, permutation, buffer,
-            real_datatype, complex_datatype, communicator, environment));
-
-      return result;
+      auto const local_spins
+        = ::ket::mpi::all_spin_expectation_values_detail::local_spins<real_type>(
+            mpi_policy, parallel_policy, local_state, permutation, num_qubits, communicator, environment,
+            [&](std::vector<qubit_type> const& global_qubits)
+            {
+              ::ket::mpi::utility::maybe_interchange_qubits(
+                mpi_policy, parallel_policy, local_state, global_qubits, permutation, buffer, complex_datatype, communicator, environment);
+            });
+
+      auto spins = std::vector<real_type>(local_spins.size());
+      yampi::all_reduce(
+        yampi::make_buffer(std::begin(local_spins), std::end(local_spins), real_datatype),
+        std::begin(spins), yampi::binary_operation(::yampi::plus_t()),
+        communicator, environment);
+
+      return ::ket::mpi::all_spin_expectation_values_detail::to_spins<SpinsAllocator>(spins);
     }
 
     template <
@@ -417,32 +556,29 @@ namespace ket
       yampi::communicator const& communicator,
       yampi::environment const& environment)
     {
-      auto const is_root = communicator.rank(environment) == root;
+      ::ket::mpi::utility::log_with_time_guard<char> print{"Spins", environment};
 
       using complex_type = typename boost::range_value<LocalState>::type;
       using real_type = typename ::ket::utility::meta::real_of<complex_type>::type;
-      using spin_type = std::array<real_type, 3u>;
-      auto result = std::vector<spin_type, SpinsAllocator>{};
-      if (is_root)
-        result.reserve(num_qubits);
-
       using qubit_type = ::ket::qubit<StateInteger, BitInteger>;
-      auto const last_qubit = qubit_type{num_qubits};
-      for (auto qubit = qubit_type{BitInteger{0u}}; qubit < last_qubit; ++qubit)
-      {
-        auto const maybe_expectation_value
-          = ::ket::mpi::spin_expectation_value(
-              mpi_policy, parallel_policy, local_state, qubit, permutation, buffer,
-              root, communicator, environment);
-
-        if (is_root and maybe_expectation_value)
-          result.push_back(*maybe_expectation_value);
-      }
-
-      if (not is_root)
+      auto const local_spins
+        = ::ket::mpi::all_spin_expectation_values_detail::local_spins<real_type>(
+            mpi_policy, parallel_policy, local_state, permutation, num_qubits, communicator, environment,
+            [&](std::vector<qubit_type> const& global_qubits)
+            {
+              ::ket::mpi::utility::maybe_interchange_qubits(
+                mpi_policy, parallel_policy, local_state, global_qubits, permutation, buffer, communicator, environment);
+            });
+
+      auto spins = std::vector<real_type>(local_spins.size());
+      yampi::reduce(
+        yampi::make_buffer(std::begin(local_spins), std::end(local_spins)), std::begin(spins), yampi::binary_operation(yampi::plus_t()),
+        root, communicator, environment);
+
+      if (communicator.rank(environment) != root)
         return boost::none;
 
-      return result;
+      return ::ket::mpi::all_spin_expectation_values_detail::to_spins<SpinsAllocator>(spins);
     }
 
     template <
@@ -471,32 +607,29 @@ namespace ket
       yampi::communicator const& communicator,
       yampi::environment const& environment)
     {
-      auto const is_root = communicator.rank(environment) == root;
+      ::ket::mpi::utility::log_with_time_guard<char> print{"Spins", environment};
 
       using complex_type = typename boost::range_value<LocalState>::type;
       using real_type = typename ::ket::utility::meta::real_of<complex_type>::type;
-      using spin_type = std::array<real_type, 3u>;
-      auto result = std::vector<spin_type, SpinsAllocator>{};
-      if (is_root)
-        result.reserve(num_qubits);
-
       using qubit_type = ::ket::qubit<StateInteger, BitInteger>;
-      auto const last_qubit = qubit_type{num_qubits};
-      for (auto qubit = qubit_type{BitInteger{0u}}; qubit < last_qubit; ++qubit)
-      {
-        auto const maybe_expectation_value
-          = ::ket::mpi::spin_expectation_value(
-              mpi_policy, parallel_policy, local_state, qubit, permutation, buffer,
-              real_datatype, complex_datatype, root, communicator, environment);
-
-        if (is_root and maybe_expectation_value)
-          result.push_back(*maybe_expectation_value);
-      }
-
-      if (not is_root)
+      auto const local_spins
+        = ::ket::mpi::all_spin_expectation_values_detail::local_spins<real_type>(
+            mpi_policy, parallel_policy, local_state, permutation, num_qubits, communicator, environment,
+            [&](std::vector<qubit_type> const& global_qubits)
+            {
+              ::ket::mpi::utility::maybe_interchange_qubits(
+                mpi_policy, parallel_policy, local_state, global_qubits, permutation, buffer, complex_datatype, communicator, environment);
+            });
+
+      auto spins = std::vector<real_type>(local_spins.size());
+      yampi::reduce(
+        yampi::make_buffer(std::begin(local_spins), std::end(local_spins), real_datatype), std::begin(spins), yampi::binary_operation(yampi::plus_t()),
+        root, communicator, environment);
+
+      if (communicator.rank(environment) != root)
         return boost::none;
 
-      return result;
+      return ::ket::mpi::all_spin_expectation_values_detail::to_spins<SpinsAllocator>(spins);
     }
 
     template <
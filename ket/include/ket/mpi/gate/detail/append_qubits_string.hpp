@@ -4,6 +4,7 @@
 # include <string>
 # ifdef KET_PRINT_LOG
 #   include <sstream>
+#   include <vector>
 #   include <utility>
 
 #   include <ket/qubit.hpp>
@@ -42,6 +43,18 @@ namespace ket
           ::ket::mpi::gate::detail::append_qubits_string_detail::insert(output_string_stream, ::ket::remove_control(qubits)...);
           return output_string_stream.str();
         }
+
+        template <typename Character, typename CharacterTraits, typename Allocator, typename StateInteger, typename BitInteger, typename QubitAllocator>
+        inline std::basic_string<Character, CharacterTraits, Allocator>
+        append_qubits_string(
+          std::basic_string<Character, CharacterTraits, Allocator> const& base_str,
+          std::vector< ::ket::qubit<StateInteger, BitInteger>, QubitAllocator > const& qubits)
+        {
+          auto output_string_stream = std::basic_ostringstream<Character, CharacterTraits, Allocator>{base_str, std::ios_base::ate};
+          for (auto const qubit: qubits)
+            output_string_stream << ' ' << qubit;
+          return output_string_stream.str();
+        }
 # else // KET_PRINT_LOG
         template <typename Character, typename CharacterTraits, typename Allocator, typename... Qubits>
         inline std::basic_string<Character, CharacterTraits, Allocator>
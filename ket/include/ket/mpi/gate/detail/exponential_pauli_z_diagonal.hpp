@@ -29,6 +29,7 @@
 # include <ket/mpi/qubit_permutation.hpp>
 # include <ket/mpi/utility/simple_mpi.hpp>
 # include <ket/mpi/utility/for_each_local_range.hpp>
+# include <ket/mpi/utility/complete_page_interchanges.hpp>
 # include <ket/mpi/utility/logger.hpp>
 # include <ket/mpi/gate/detail/append_qubits_string.hpp>
 # include <ket/mpi/gate/page/exponential_pauli_z_diagonal.hpp>
@@ -240,6 +241,7 @@ namespace ket
           auto const num_data_blocks
             = ::ket::mpi::utility::policy::num_data_blocks(mpi_policy, communicator, environment);
 
+          ::ket::mpi::utility::complete_page_interchanges(local_state);
           auto const first = std::begin(local_state);
           for (auto data_block_index = decltype(num_data_blocks){0u}; data_block_index < num_data_blocks; ++data_block_index)
             ::ket::gate::exponential_pauli_z_coeff(
@@ -0,0 +1,175 @@
+#ifndef KET_MPI_GATE_DIAGONAL_BATCH_HPP
+# define KET_MPI_GATE_DIAGONAL_BATCH_HPP
+
+# include <cassert>
+# include <cstddef>
+# include <string>
+# include <vector>
+# include <iterator>
+# include <algorithm>
+
+# include <boost/range/size.hpp>
+# include <boost/range/value_type.hpp>
+
+# include <yampi/environment.hpp>
+# include <yampi/datatype_base.hpp>
+# include <yampi/communicator.hpp>
+
+# include <ket/qubit.hpp>
+# include <ket/gate/diagonal_batch.hpp>
+# include <ket/mpi/qubit_permutation.hpp>
+# include <ket/mpi/utility/simple_mpi.hpp>
+# include <ket/mpi/utility/for_each_local_range.hpp>
+# include <ket/mpi/utility/logger.hpp>
+# include <ket/mpi/utility/detail/make_nonpage_qubits.hpp>
+# include <ket/mpi/gate/detail/append_qubits_string.hpp>
+
+
+namespace ket
+{
+  namespace mpi
+  {
+    namespace gate
+    {
+      namespace diagonal_batch_detail
+      {
+        template <typename ParallelPolicy, typename TableRanges, typename Qubit>
+        struct call_diagonal_batch
+        {
+          ParallelPolicy parallel_policy_;
+          TableRanges const& tables_;
+          std::vector<std::vector<Qubit>> const& qubits_;
+
+          call_diagonal_batch(
+            ParallelPolicy const parallel_policy, TableRanges const& tables, std::vector<std::vector<Qubit>> const& qubits) noexcept
+            : parallel_policy_{parallel_policy}, tables_{tables}, qubits_{qubits}
+          { }
+
+          template <typename RandomAccessIterator>
+          void operator()(RandomAccessIterator const first, RandomAccessIterator const last) const
+          { ::ket::gate::diagonal_batch(parallel_policy_, first, last, tables_, qubits_); }
+        }; // struct call_diagonal_batch<ParallelPolicy, TableRanges, Qubit>
+
+        template <typename ParallelPolicy, typename TableRanges, typename Qubit>
+        inline ::ket::mpi::gate::diagonal_batch_detail::call_diagonal_batch<ParallelPolicy, TableRanges, Qubit>
+        make_call_diagonal_batch(
+          ParallelPolicy const parallel_policy, TableRanges const& tables, std::vector<std::vector<Qubit>> const& qubits)
+        { return {parallel_policy, tables, qubits}; }
+
+        // qubits of all tables without duplicates, which are brought into local qubits at once
+        template <typename StateInteger, typename BitInteger, typename QubitAllocator, typename QubitsAllocator>
+        inline std::vector< ::ket::qubit<StateInteger, BitInteger> > operated_qubits(
+          std::vector<std::vector< ::ket::qubit<StateInteger, BitInteger>, QubitAllocator >, QubitsAllocator> const& qubits)
+        {
+          auto result = std::vector< ::ket::qubit<StateInteger, BitInteger> >{};
+          for (auto const& table_qubits: qubits)
+            for (auto const qubit: table_qubits)
+              if (std::find(std::begin(result), std::end(result), qubit) == std::end(result))
+                result.push_back(qubit);
+          return result;
+        }
+
+        template <
+          typename MpiPolicy, typename ParallelPolicy,
+          typename RandomAccessRange, typename TableRanges,
+          typename StateInteger, typename BitInteger, typename Allocator, typename QubitAllocator, typename QubitsAllocator>
+        inline RandomAccessRange& do_diagonal_batch(
+          MpiPolicy const& mpi_policy, ParallelPolicy const parallel_policy,
+          RandomAccessRange& local_state,
+          ::ket::mpi::qubit_permutation<StateInteger, BitInteger, Allocator>& permutation,
+          yampi::communicator const& communicator, yampi::environment const& environment,
+          TableRanges const& tables,
+          std::vector<std::vector< ::ket::qubit<StateInteger, BitInteger>, QubitAllocator >, QubitsAllocator> const& qubits)
+        {
+          // the tables are applied page by page, so page qubits are replaced by nonpage qubits
+          ::ket::mpi::utility::detail::make_nonpage_qubits(
+            mpi_policy, parallel_policy, local_state, permutation,
+            ::ket::mpi::gate::diagonal_batch_detail::operated_qubits(qubits), "diagonal_batch", communicator, environment);
+
+          using qubit_type = ::ket::qubit<StateInteger, BitInteger>;
+          auto permutated_qubits = std::vector<std::vector<qubit_type>>{};
+          permutated_qubits.reserve(qubits.size());
+          for (auto const& table_qubits: qubits)
+          {
+            permutated_qubits.emplace_back();
+            permutated_qubits.back().reserve(table_qubits.size());
+            for (auto const qubit: table_qubits)
+              permutated_qubits.back().push_back(permutation[qubit].qubit());
+          }
+
+          return ::ket::mpi::utility::for_each_local_range(
+            mpi_policy, local_state, communicator, environment,
+            ::ket::mpi::gate::diagonal_batch_detail::make_call_diagonal_batch(parallel_policy, tables, permutated_qubits));
+        }
+      } // namespace diagonal_batch_detail
+
+      // a_i -> tables[0][b_0(i)] tables[1][b_1(i)] ... a_i, see ::ket::gate::diagonal_batch.
+      // Qubits of all tables are brought into local qubits, and then the state is swept once
+      template <
+        typename MpiPolicy, typename ParallelPolicy,
+        typename RandomAccessRange, typename TableRanges,
+        typename StateInteger, typename BitInteger, typename QubitAllocator, typename QubitsAllocator,
+        typename Allocator, typename BufferAllocator>
+      inline RandomAccessRange& diagonal_batch(
+        MpiPolicy const& mpi_policy, ParallelPolicy const parallel_policy,
+        RandomAccessRange& local_state,
+        ::ket::mpi::qubit_permutation<StateInteger, BitInteger, Allocator>& permutation,
+        std::vector<typename boost::range_value<RandomAccessRange>::type, BufferAllocator>& buffer,
+        yampi::communicator const& communicator, yampi::environment const& environment,
+        TableRanges const& tables,
+        std::vector<std::vector< ::ket::qubit<StateInteger, BitInteger>, QubitAllocator >, QubitsAllocator> const& qubits)
+      {
+        assert(static_cast<std::size_t>(boost::size(tables)) == qubits.size());
+        auto const operated_qubits = ::ket::mpi::gate::diagonal_batch_detail::operated_qubits(qubits);
+        if (operated_qubits.empty())
+          return local_state;
+
+        ::ket::mpi::utility::log_with_time_guard<char> print{
+          ::ket::mpi::gate::detail::append_qubits_string(std::string{"DiagonalBatch"}, operated_qubits), environment};
+
+        ::ket::mpi::utility::maybe_interchange_qubits(
+          mpi_policy, parallel_policy,
+          local_state, operated_qubits, permutation, buffer, communicator, environment);
+
+        return ::ket::mpi::gate::diagonal_batch_detail::do_diagonal_batch(
+          mpi_policy, parallel_policy,
+          local_state, permutation, communicator, environment, tables, qubits);
+      }
+
+      template <
+        typename MpiPolicy, typename ParallelPolicy,
+        typename RandomAccessRange, typename TableRanges,
+        typename StateInteger, typename BitInteger, typename QubitAllocator, typename QubitsAllocator,
+        typename Allocator, typename BufferAllocator, typename DerivedDatatype>
+      inline RandomAccessRange& diagonal_batch(
+        MpiPolicy const& mpi_policy, ParallelPolicy const parallel_policy,
+        RandomAccessRange& local_state,
+        ::ket::mpi::qubit_permutation<StateInteger, BitInteger, Allocator>& permutation,
+        std::vector<typename boost::range_value<RandomAccessRange>::type, BufferAllocator>& buffer,
+        yampi::datatype_base<DerivedDatatype> const& datatype,
+        yampi::communicator const& communicator, yampi::environment const& environment,
+        TableRanges const& tables,
+        std::vector<std::vector< ::ket::qubit<StateInteger, BitInteger>, QubitAllocator >, QubitsAllocator> const& qubits)
+      {
+        assert(static_cast<std::size_t>(boost::size(tables)) == qubits.size());
+        auto const operated_qubits = ::ket::mpi::gate::diagonal_batch_detail::operated_qubits(qubits);
+        if (operated_qubits.empty())
+          return local_state;
+
+        ::ket::mpi::utility::log_with_time_guard<char> print{
+          ::ket::mpi::gate::detail::append_qubits_string(std::string{"DiagonalBatch"}, operated_qubits), environment};
+
+        ::ket::mpi::utility::maybe_interchange_qubits(
+          mpi_policy, parallel_policy,
+          local_state, operated_qubits, permutation, buffer, datatype, communicator, environment);
+
+        return ::ket::mpi::gate::diagonal_batch_detail::do_diagonal_batch(
+          mpi_policy, parallel_policy,
+          local_state, permutation, communicator, environment, tables, qubits);
+      }
+    } // namespace gate
+  } // namespace mpi
+} // namespace ket
+
+
+#endif // KET_MPI_GATE_DIAGONAL_BATCH_HPP
@@ -0,0 +1,270 @@
+#ifndef KET_MPI_GATE_MATRIX_HPP
+# define KET_MPI_GATE_MATRIX_HPP
+
+# include <cstddef>
+# include <string>
+# include <vector>
+# include <array>
+# include <iterator>
+
+# include <boost/range/size.hpp>
+# include <boost/range/value_type.hpp>
+
+# include <yampi/environment.hpp>
+# include <yampi/datatype_base.hpp>
+# include <yampi/communicator.hpp>
+
+# include <ket/qubit.hpp>
+# include <ket/gate/matrix.hpp>
+# include <ket/mpi/qubit_permutation.hpp>
+# include <ket/mpi/utility/simple_mpi.hpp>
+# include <ket/mpi/utility/for_each_local_range.hpp>
+# include <ket/mpi/utility/logger.hpp>
+# include <ket/mpi/utility/detail/make_nonpage_qubits.hpp>
+# include <ket/mpi/gate/detail/append_qubits_string.hpp>
+
+
+namespace ket
+{
+  namespace mpi
+  {
+    namespace gate
+    {
+      namespace matrix_detail
+      {
+        template <typename ParallelPolicy, typename MatrixRange, typename Qubit>
+        struct call_matrix
+        {
+          ParallelPolicy parallel_policy_;
+          MatrixRange const& matrix_;
+          std::vector<Qubit> const& qubits_;
+
+          call_matrix(ParallelPolicy const parallel_policy, MatrixRange const& matrix, std::vector<Qubit> const& qubits) noexcept
+            : parallel_policy_{parallel_policy}, matrix_{matrix}, qubits_{qubits}
+          { }
+
+          template <typename RandomAccessIterator>
+          void operator()(RandomAccessIterator const first, RandomAccessIterator const last) const
+          { ::ket::gate::matrix(parallel_policy_, first, last, matrix_, qubits_); }
+        }; // struct call_matrix<ParallelPolicy, MatrixRange, Qubit>
+
+        template <typename ParallelPolicy, typename MatrixRange, typename Qubit>
+        inline ::ket::mpi::gate::matrix_detail::call_matrix<ParallelPolicy, MatrixRange, Qubit>
+        make_call_matrix(ParallelPolicy const parallel_policy, MatrixRange const& matrix, std::vector<Qubit> const& qubits)
+        { return {parallel_policy, matrix, qubits}; }
+
+        template <
+          typename MpiPolicy, typename ParallelPolicy,
+          typename RandomAccessRange, typename MatrixRange,
+          typename StateInteger, typename BitInteger, typename Allocator, typename QubitRange>
+        inline RandomAccessRange& do_matrix(
+          MpiPolicy const& mpi_policy, ParallelPolicy const parallel_policy,
+          RandomAccessRange& local_state,
+          ::ket::mpi::qubit_permutation<StateInteger, BitInteger, Allocator>& permutation,
+          yampi::communicator const& communicator, yampi::environment const& environment,
+          MatrixRange const& matrix, QubitRange const& qubits)
+        {
+          // the matrix is applied page by page, so page qubits are replaced by nonpage qubits
+          ::ket::mpi::utility::detail::make_nonpage_qubits(
+            mpi_policy, parallel_policy, local_state, permutation, qubits, "matrix", communicator, environment);
+
+          using qubit_type = ::ket::qubit<StateInteger, BitInteger>;
+          auto permutated_qubits = std::vector<qubit_type>{};
+          permutated_qubits.reserve(boost::size(qubits));
+          for (auto const qubit: qubits)
+            permutated_qubits.push_back(permutation[qubit].qubit());
+
+          return ::ket::mpi::utility::for_each_local_range(
+            mpi_policy, local_state, communicator, environment,
+            ::ket::mpi::gate::matrix_detail::make_call_matrix(parallel_policy, matrix, permutated_qubits));
+        }
+      } // namespace matrix_detail
+
+      // U_{i...j} (a_{0...0} |0...0> + ... + a_{1...1} |1...1>) = sum_{k,l} U_{kl} a_l |k>
+      // See ::ket::gate::matrix for the layout of matrix
+      template <
+        typename MpiPolicy, typename ParallelPolicy,
+        typename RandomAccessRange, typename MatrixRange,
+        typename StateInteger, typename BitInteger,
+        typename Allocator, typename BufferAllocator, typename... Qubits>
+      inline RandomAccessRange& matrix(
+        MpiPolicy const& mpi_policy, ParallelPolicy const parallel_policy,
+        RandomAccessRange& local_state,
+        ::ket::mpi::qubit_permutation<StateInteger, BitInteger, Allocator>& permutation,
+        std::vector<typename boost::range_value<RandomAccessRange>::type, BufferAllocator>& buffer,
+        yampi::communicator const& communicator, yampi::environment const& environment,
+        MatrixRange const& matrix, ::ket::qubit<StateInteger, BitInteger> const qubit, Qubits const... qubits)
+      {
+        ::ket::mpi::utility::log_with_time_guard<char> print{
+          ::ket::mpi::gate::detail::append_qubits_string(std::string{"Matrix"}, qubit, qubits...), environment};
+
+        using qubit_type = ::ket::qubit<StateInteger, BitInteger>;
+        auto qubit_array = std::array<qubit_type, sizeof...(Qubits) + 1u>{qubit, qubits...};
+        ::ket::mpi::utility::maybe_interchange_qubits(
+          mpi_policy, parallel_policy,
+          local_state, qubit_array, permutation, buffer, communicator, environment);
+
+        return ::ket::mpi::gate::matrix_detail::do_matrix(
+          mpi_policy, parallel_policy,
+          local_state, permutation, communicator, environment, matrix, qubit_array);
+      }
+
+      template <
+        typename MpiPolicy, typename ParallelPolicy,
+        typename RandomAccessRange, typename MatrixRange,
+        typename StateInteger, typename BitInteger,
+        typename Allocator, typename BufferAllocator, typename DerivedDatatype, typename... Qubits>
+      inline RandomAccessRange& matrix(
+        MpiPolicy const& mpi_policy, ParallelPolicy const parallel_policy,
+        RandomAccessRange& local_state,
+        ::ket::mpi::qubit_permutation<StateInteger, BitInteger, Allocator>& permutation,
+        std::vector<typename boost::range_value<RandomAccessRange>::type, BufferAllocator>& buffer,
+        yampi::datatype_base<DerivedDatatype> const& datatype,
+        yampi::communicator const& communicator, yampi::environment const& environment,
+        MatrixRange const& matrix, ::ket::qubit<StateInteger, BitInteger> const qubit, Qubits const... qubits)
+      {
+        ::ket::mpi::utility::log_with_time_guard<char> print{
+          ::ket::mpi::gate::detail::append_qubits_string(std::string{"Matrix"}, qubit, qubits...), environment};
+
+        using qubit_type = ::ket::qubit<StateInteger, BitInteger>;
+        auto qubit_array = std::array<qubit_type, sizeof...(Qubits) + 1u>{qubit, qubits...};
+        ::ket::mpi::utility::maybe_interchange_qubits(
+          mpi_policy, parallel_policy,
+          local_state, qubit_array, permutation, buffer, datatype, communicator, environment);
+
+        return ::ket::mpi::gate::matrix_detail::do_matrix(
+          mpi_policy, parallel_policy,
+          local_state, permutation, communicator, environment, matrix, qubit_array);
+      }
+
+      template <
+        typename ParallelPolicy,
+        typename RandomAccessRange, typename MatrixRange,
+        typename StateInteger, typename BitInteger,
+        typename Allocator, typename BufferAllocator, typename... Qubits>
+      inline RandomAccessRange& matrix(
+        ParallelPolicy const parallel_policy,
+        RandomAccessRange& local_state,
+        ::ket::mpi::qubit_permutation<StateInteger, BitInteger, Allocator>& permutation,
+        std::vector<typename boost::range_value<RandomAccessRange>::type, BufferAllocator>& buffer,
+        yampi::communicator const& communicator, yampi::environment const& environment,
+        MatrixRange const& matrix, ::ket::qubit<StateInteger, BitInteger> const qubit, Qubits const... qubits)
+      {
+        return ::ket::mpi::gate::matrix(
+          ::ket::mpi::utility::policy::make_simple_mpi(), parallel_policy,
+          local_state, permutation, buffer, communicator, environment, matrix, qubit, qubits...);
+      }
+
+      template <
+        typename ParallelPolicy,
+        typename RandomAccessRange, typename MatrixRange,
+        typename StateInteger, typename BitInteger,
+        typename Allocator, typename BufferAllocator, typename DerivedDatatype, typename... Qubits>
+      inline RandomAccessRange& matrix(
+        ParallelPolicy const parallel_policy,
+        RandomAccessRange& local_state,
+        ::ket::mpi::qubit_permutation<StateInteger, BitInteger, Allocator>& permutation,
+        std::vector<typename boost::range_value<RandomAccessRange>::type, BufferAllocator>& buffer,
+        yampi::datatype_base<DerivedDatatype> const& datatype,
+        yampi::communicator const& communicator, yampi::environment const& environment,
+        MatrixRange const& matrix, ::ket::qubit<StateInteger, BitInteger> const qubit, Qubits const... qubits)
+      {
+        return ::ket::mpi::gate::matrix(
+          ::ket::mpi::utility::policy::make_simple_mpi(), parallel_policy,
+          local_state, permutation, buffer, datatype, communicator, environment, matrix, qubit, qubits...);
+      }
+
+      // The number of qubits is given at runtime, and each global qubit in qubits is interchanged with a local qubit separately.
+      template <
+        typename MpiPolicy, typename ParallelPolicy,
+        typename RandomAccessRange, typename MatrixRange,
+        typename StateInteger, typename BitInteger, typename QubitAllocator,
+        typename Allocator, typename BufferAllocator>
+      inline RandomAccessRange& matrix(
+        MpiPolicy const& mpi_policy, ParallelPolicy const parallel_policy,
+        RandomAccessRange& local_state,
+        ::ket::mpi::qubit_permutation<StateInteger, BitInteger, Allocator>& permutation,
+        std::vector<typename boost::range_value<RandomAccessRange>::type, BufferAllocator>& buffer,
+        yampi::communicator const& communicator, yampi::environment const& environment,
+        MatrixRange const& matrix, std::vector< ::ket::qubit<StateInteger, BitInteger>, QubitAllocator > const& qubits)
+      {
+        ::ket::mpi::utility::log_with_time_guard<char> print{
+          ::ket::mpi::gate::detail::append_qubits_string(std::string{"Matrix"}, qubits), environment};
+
+        ::ket::mpi::utility::maybe_interchange_qubits(
+          mpi_policy, parallel_policy,
+          local_state, qubits, permutation, buffer, communicator, environment);
+
+        return ::ket::mpi::gate::matrix_detail::do_matrix(
+          mpi_policy, parallel_policy,
+          local_state, permutation, communicator, environment, matrix, qubits);
+      }
+
+      template <
+        typename MpiPolicy, typename ParallelPolicy,
+        typename RandomAccessRange, typename MatrixRange,
+        typename StateInteger, typename BitInteger, typename QubitAllocator,
+        typename Allocator, typename BufferAllocator, typename DerivedDatatype>
+      inline RandomAccessRange& matrix(
+        MpiPolicy const& mpi_policy, ParallelPolicy const parallel_policy,
+        RandomAccessRange& local_state,
+        ::ket::mpi::qubit_permutation<StateInteger, BitInteger, Allocator>& permutation,
+        std::vector<typename boost::range_value<RandomAccessRange>::type, BufferAllocator>& buffer,
+        yampi::datatype_base<DerivedDatatype> const& datatype,
+        yampi::communicator const& communicator, yampi::environment const& environment,
+        MatrixRange const& matrix, std::vector< ::ket::qubit<StateInteger, BitInteger>, QubitAllocator > const& qubits)
+      {
+        ::ket::mpi::utility::log_with_time_guard<char> print{
+          ::ket::mpi::gate::detail::append_qubits_string(std::string{"Matrix"}, qubits), environment};
+
+        ::ket::mpi::utility::maybe_interchange_qubits(
+          mpi_policy, parallel_policy,
+          local_state, qubits, permutation, buffer, datatype, communicator, environment);
+
+        return ::ket::mpi::gate::matrix_detail::do_matrix(
+          mpi_policy, parallel_policy,
+          local_state, permutation, communicator, environment, matrix, qubits);
+      }
+
+      template <
+        typename ParallelPolicy,
+        typename RandomAccessRange, typename MatrixRange,
+        typename StateInteger, typename BitInteger, typename QubitAllocator,
+        typename Allocator, typename BufferAllocator>
+      inline RandomAccessRange& matrix(
+        ParallelPolicy const parallel_policy,
+        RandomAccessRange& local_state,
+        ::ket::mpi::qubit_permutation<StateInteger, BitInteger, Allocator>& permutation,
+        std::vector<typename boost::range_value<RandomAccessRange>::type, BufferAllocator>& buffer,
+        yampi::communicator const& communicator, yampi::environment const& environment,
+        MatrixRange const& matrix, std::vector< ::ket::qubit<StateInteger, BitInteger>, QubitAllocator > const& qubits)
+      {
+        return ::ket::mpi::gate::matrix(
+          ::ket::mpi::utility::policy::make_simple_mpi(), parallel_policy,
+          local_state, permutation, buffer, communicator, environment, matrix, qubits);
+      }
+
+      template <
+        typename ParallelPolicy,
+        typename RandomAccessRange, typename MatrixRange,
+        typename StateInteger, typename BitInteger, typename QubitAllocator,
+        typename Allocator, typename BufferAllocator, typename DerivedDatatype>
+      inline RandomAccessRange& matrix(
+        ParallelPolicy const parallel_policy,
+        RandomAccessRange& local_state,
+        ::ket::mpi::qubit_permutation<StateInteger, BitInteger, Allocator>& permutation,
+        std::vector<typename boost::range_value<RandomAccessRange>::type, BufferAllocator>& buffer,
+        yampi::datatype_base<DerivedDatatype> const& datatype,
+        yampi::communicator const& communicator, yampi::environment const& environment,
+        MatrixRange const& matrix, std::vector< ::ket::qubit<StateInteger, BitInteger>, QubitAllocator > const& qubits)
+      {
+        return ::ket::mpi::gate::matrix(
+          ::ket::mpi::utility::policy::make_simple_mpi(), parallel_policy,
+          local_state, permutation, buffer, datatype, communicator, environment, matrix, qubits);
+      }
+    } // namespace gate
+  } // namespace mpi
+} // namespace ket
+
+
+#endif // KET_MPI_GATE_MATRIX_HPP
@@ -28,6 +28,7 @@
 # include <ket/mpi/permutated.hpp>
 # include <ket/mpi/qubit_permutation.hpp>
 # include <ket/mpi/utility/simple_mpi.hpp>
+# include <ket/mpi/utility/complete_page_interchanges.hpp>
 # include <ket/mpi/utility/logger.hpp>
 # include <ket/mpi/gate/page/projective_measurement.hpp>
 # include <ket/mpi/page/is_on_page.hpp>
@@ -59,6 +60,7 @@ namespace ket
         ::ket::mpi::utility::maybe_interchange_qubits(
           mpi_policy, parallel_policy,
           local_state, qubits, permutation, buffer, communicator, environment);
+        ::ket::mpi::utility::complete_page_interchanges(local_state);
 
         auto const permutated_qubit = permutation[qubit];
         auto const is_qubit_on_page = ::ket::mpi::page::is_on_page(permutated_qubit, local_state);
@@ -126,6 +128,7 @@ namespace ket
         ::ket::mpi::utility::maybe_interchange_qubits(
           mpi_policy, parallel_policy,
           local_state, qubits, permutation, buffer, complex_datatype, communicator, environment);
+        ::ket::mpi::utility::complete_page_interchanges(local_state);
 
         auto const permutated_qubit = permutation[qubit];
         auto const is_qubit_on_page = ::ket::mpi::page::is_on_page(permutated_qubit, local_state);
@@ -1,9 +1,13 @@
 #ifndef KET_MPI_GENERATE_EVENTS_HPP
 # define KET_MPI_GENERATE_EVENTS_HPP
 
+# include <cstddef>
 # include <cmath>
 # include <vector>
 # include <iterator>
+# include <algorithm>
+# include <numeric>
+# include <random>
 
 # include <boost/range/size.hpp>
 # include <boost/range/value_type.hpp>
@@ -13,26 +17,57 @@
 # include <yampi/communicator.hpp>
 # include <yampi/rank.hpp>
 # include <yampi/buffer.hpp>
-# include <yampi/gather.hpp>
 # include <yampi/broadcast.hpp>
-# include <yampi/message_envelope.hpp>
-# include <yampi/algorithm/transform.hpp>
 
+# include <ket/generate_events.hpp>
 # include <ket/utility/loop_n.hpp>
-# include <ket/utility/positive_random_value_upto.hpp>
 # include <ket/utility/meta/real_of.hpp>
 # include <ket/mpi/qubit_permutation.hpp>
 # include <ket/mpi/utility/simple_mpi.hpp>
+# include <ket/mpi/utility/complete_page_interchanges.hpp>
 # include <ket/mpi/utility/logger.hpp>
-# include <ket/mpi/utility/fill.hpp>
-# include <ket/mpi/utility/transform_inclusive_scan_self.hpp>
-# include <ket/mpi/utility/upper_bound.hpp>
+# include <ket/mpi/utility/all_gather.hpp>
 
 
 namespace ket
 {
   namespace mpi
   {
+    namespace generate_events_detail
+    {
+      // nums_events[r] ~ multinomial distribution of num_events with probabilities total_probabilities[r] / sum total_probabilities,
+      // and seeds are seeds of random number generators for all ranks and for shuffling events
+      template <typename Real, typename StateInteger, typename RandomNumberGenerator>
+      inline void draw_nums_events_and_seeds(
+        std::vector<Real> const& total_probabilities, int const num_events,
+        std::vector<int>& nums_events, std::vector<StateInteger>& seeds,
+        RandomNumberGenerator& random_number_generator)
+      {
+        auto const num_ranks = total_probabilities.size();
+        auto last_nonzero_rank = num_ranks - std::size_t{1u};
+        while (last_nonzero_rank > std::size_t{0u} and total_probabilities[last_nonzero_rank] <= Real{0})
+          --last_nonzero_rank;
+
+        auto remaining_probability = std::accumulate(std::begin(total_probabilities), std::end(total_probabilities), 0.0l);
+        auto remaining_num_events = num_events;
+        std::fill(std::begin(nums_events), std::end(nums_events), 0);
+        for (auto rank_index = std::size_t{0u}; rank_index < last_nonzero_rank and remaining_num_events > 0; ++rank_index)
+        {
+          auto const probability
+            = std::min(1.0l, static_cast<long double>(total_probabilities[rank_index]) / remaining_probability);
+          auto distribution = std::binomial_distribution<int>{remaining_num_events, static_cast<double>(probability)};
+          nums_events[rank_index] = distribution(random_number_generator);
+
+          remaining_num_events -= nums_events[rank_index];
+          remaining_probability -= static_cast<long double>(total_probabilities[rank_index]);
+        }
+        nums_events[last_nonzero_rank] = remaining_num_events;
+
+        for (auto& seed: seeds)
+          seed = static_cast<StateInteger>(random_number_generator());
+      }
+    } // namespace generate_events_detail
+
     // generate_events
     template <
       typename MpiPolicy, typename ParallelPolicy,
@@ -52,88 +87,62 @@ namespace ket
     {
       ket::mpi::utility::log_with_time_guard<char> print{"Generate Events", environment};
 
-      result.clear();
-      result.reserve(num_events);
+      ::ket::mpi::utility::complete_page_interchanges(local_state);
+      auto const cumulative_block_probabilities
+        = ::ket::generate_events_detail::cumulative_block_probabilities(
+            parallel_policy, std::begin(local_state), std::end(local_state));
 
       using complex_type = typename boost::range_value<LocalState>::type;
-      using std::real;
-      auto const total_probability
-        = real(::ket::mpi::utility::transform_inclusive_scan_self(
-            parallel_policy, local_state,
-            [](complex_type const& lhs, complex_type const& rhs)
-            { using std::real; return static_cast<complex_type>(real(lhs) + real(rhs)); },
-            [](complex_type const& value)
-            { using std::norm; return static_cast<complex_type>(norm(value)); },
-            environment));
+      using real_type = typename ::ket::utility::meta::real_of<complex_type>::type;
+      auto const total_probability = static_cast<real_type>(cumulative_block_probabilities.back());
 
       auto const present_rank = communicator.rank(environment);
       constexpr auto root_rank = yampi::rank{0};
+      auto const num_ranks = communicator.size(environment);
 
-      using real_type = typename ::ket::utility::meta::real_of<complex_type>::type;
       auto total_probabilities = std::vector<real_type>{};
-      if (present_rank == root_rank)
-        total_probabilities.resize(communicator.size(environment));
-
-      yampi::gather(
-        yampi::make_buffer(total_probability), std::begin(total_probabilities),
-        root_rank, communicator, environment);
+      ::ket::mpi::utility::all_gather(total_probability, total_probabilities, communicator, environment);
 
+      // only one seed is broadcast, and all ranks draw the same numbers of events and seeds from it
+      auto shared_seed = StateInteger{};
       if (present_rank == root_rank)
-        ::ket::utility::ranges::inclusive_scan(
-          total_probabilities, std::begin(total_probabilities));
-
-      for (auto event_index = 0; event_index < num_events; ++event_index)
-      {
-        auto random_value = real_type{};
-        auto result_rank = yampi::rank{};
-        if (present_rank == root_rank)
-        {
-          random_value
-            = ::ket::utility::positive_random_value_upto(
-                total_probabilities.back(), random_number_generator);
-          result_rank
-            = static_cast<yampi::rank>(static_cast<StateInteger>(
-                std::upper_bound(
-                  std::begin(total_probabilities),
-                  std::end(total_probabilities), random_value)
-                - std::begin(total_probabilities)));
-        }
-
-        auto result_mpi_rank = result_rank.mpi_rank();
-        yampi::broadcast(yampi::make_buffer(result_mpi_rank), root_rank, communicator, environment);
-        result_rank = static_cast<yampi::rank>(result_mpi_rank);
-
-        yampi::algorithm::transform(
-          yampi::ignore_status,
-          yampi::make_buffer(random_value),
-          yampi::make_buffer(random_value),
-          [&total_probabilities, result_rank](real_type const random_value)
-          { return random_value - total_probabilities[result_rank.mpi_rank() - 1]; },
-          ::yampi::message_envelope(root_rank, result_rank, communicator),
-          environment);
-
-        auto permutated_result = StateInteger{};
-        if (present_rank == result_rank)
-        {
-          auto const local_result
-            = static_cast<StateInteger>(
-                ::ket::mpi::utility::upper_bound(
-                  local_state, static_cast<complex_type>(random_value),
-                  [](complex_type const& lhs, complex_type const& rhs)
-                  { using std::real; return real(lhs) < real(rhs); },
-                  environment));
-
-          using ::ket::mpi::utility::rank_index_to_qubit_value;
-          permutated_result
-            = rank_index_to_qubit_value(
-                mpi_policy, local_state, result_rank, local_result);
-        }
-
-        yampi::broadcast(yampi::make_buffer(permutated_result), result_rank, communicator, environment);
-
-        using ::ket::mpi::inverse_permutate_bits;
-        result.push_back(inverse_permutate_bits(permutation, permutated_result));
-      }
+        shared_seed = static_cast<StateInteger>(random_number_generator());
+      yampi::broadcast(yampi::make_buffer(shared_seed), root_rank, communicator, environment);
+
+      auto nums_events = std::vector<int>(num_ranks);
+      auto seeds = std::vector<StateInteger>(num_ranks + 1);
+      auto shared_random_number_generator
+        = RandomNumberGenerator(static_cast<typename RandomNumberGenerator::result_type>(shared_seed));
+      ::ket::mpi::generate_events_detail::draw_nums_events_and_seeds(
+        total_probabilities, num_events, nums_events, seeds, shared_random_number_generator);
+
+      // events of each rank are sampled locally, and the events of all ranks are concatenated in rank order
+      auto const local_num_events = nums_events[present_rank.mpi_rank()];
+      auto local_random_number_generator
+        = RandomNumberGenerator(static_cast<typename RandomNumberGenerator::result_type>(seeds[present_rank.mpi_rank()]));
+      auto const random_values
+        = ::ket::generate_events_detail::sorted_random_values(
+            static_cast<std::size_t>(local_num_events), cumulative_block_probabilities.back(), local_random_number_generator);
+
+      auto events = std::vector<StateInteger>(local_num_events, StateInteger{0u});
+      auto const events_first = std::begin(events);
+      ::ket::generate_events_detail::find_events(
+        parallel_policy, std::begin(local_state), std::end(local_state),
+        cumulative_block_probabilities, random_values, events_first);
+
+      using ::ket::mpi::utility::rank_index_to_qubit_value;
+      using ::ket::mpi::inverse_permutate_bits;
+      std::transform(
+        events_first, events_first + local_num_events, events_first,
+        [&mpi_policy, &local_state, &permutation, present_rank](StateInteger const local_index)
+        { return inverse_permutate_bits(permutation, rank_index_to_qubit_value(mpi_policy, local_state, present_rank, local_index)); });
+
+      ::ket::mpi::utility::all_gather_v(events, nums_events, result, communicator, environment);
+
+      // all ranks shuffle events in the same order
+      auto shuffle_random_number_generator
+        = RandomNumberGenerator(static_cast<typename RandomNumberGenerator::result_type>(seeds.back()));
+      std::shuffle(std::begin(result), std::end(result), shuffle_random_number_generator);
     }
 
     template <
@@ -157,88 +166,62 @@ namespace ket
     {
       ket::mpi::utility::log_with_time_guard<char> print{"Generate Events", environment};
 
-      result.clear();
-      result.reserve(num_events);
+      ::ket::mpi::utility::complete_page_interchanges(local_state);
+      auto const cumulative_block_probabilities
+        = ::ket::generate_events_detail::cumulative_block_probabilities(
+            parallel_policy, std::begin(local_state), std::end(local_state));
 
       using complex_type = typename boost::range_value<LocalState>::type;
-      using std::real;
-      auto const total_probability
-        = real(::ket::mpi::utility::transform_inclusive_scan_self(
-            parallel_policy, local_state,
-            [](complex_type const& lhs, complex_type const& rhs)
-            { using std::real; return static_cast<complex_type>(real(lhs) + real(rhs)); },
-            [](complex_type const& value)
-            { using std::norm; return static_cast<complex_type>(norm(value)); },
-            environment));
+      using real_type = typename ::ket::utility::meta::real_of<complex_type>::type;
+      auto const total_probability = static_cast<real_type>(cumulative_block_probabilities.back());
 
       auto const present_rank = communicator.rank(environment);
       constexpr auto root_rank = yampi::rank{0};
+      auto const num_ranks = communicator.size(environment);
 
-      using real_type = typename ::ket::utility::meta::real_of<complex_type>::type;
       auto total_probabilities = std::vector<real_type>{};
-      if (present_rank == root_rank)
-        total_probabilities.resize(communicator.size(environment));
-
-      yampi::gather(
-        yampi::make_buffer(total_probability, real_datatype), std::begin(total_probabilities),
-        root_rank, communicator, environment);
+      ::ket::mpi::utility::all_gather(total_probability, total_probabilities, real_datatype, communicator, environment);
 
+      // only one seed is broadcast, and all ranks draw the same numbers of events and seeds from it
+      auto shared_seed = StateInteger{};
       if (present_rank == root_rank)
-        ::ket::utility::ranges::inclusive_scan(
-          total_probabilities, std::begin(total_probabilities));
-
-      for (auto event_index = 0; event_index < num_events; ++event_index)
-      {
-        auto random_value = real_type{};
-        auto result_rank = yampi::rank{};
-        if (present_rank == root_rank)
-        {
-          random_value
-            = ::ket::utility::positive_random_value_upto(
-                total_probabilities.back(), random_number_generator);
-          result_rank
-            = static_cast<yampi::rank>(static_cast<StateInteger>(
-                std::upper_bound(
-                  std::begin(total_probabilities),
-                  std::end(total_probabilities), random_value)
-                - std::begin(total_probabilities)));
-        }
-
-        auto result_mpi_rank = result_rank.mpi_rank();
-        yampi::broadcast(yampi::make_buffer(result_mpi_rank), root_rank, communicator, environment);
-        result_rank = static_cast<yampi::rank>(result_mpi_rank);
-
-        yampi::algorithm::transform(
-          yampi::ignore_status,
-          yampi::make_buffer(random_value, real_datatype),
-          yampi::make_buffer(random_value, real_datatype),
-          [&total_probabilities, result_rank](real_type const random_value)
-          { return random_value - total_probabilities[result_rank.mpi_rank() - 1]; },
-          ::yampi::message_envelope(root_rank, result_rank, communicator),
-          environment);
-
-        StateInteger permutated_result;
-        if (present_rank == result_rank)
-        {
-          StateInteger const local_result
-            = static_cast<StateInteger>(
-                ::ket::mpi::utility::upper_bound(
-                  local_state, static_cast<complex_type>(random_value),
-                  [](complex_type const& lhs, complex_type const& rhs)
-                  { using std::real; return real(lhs) < real(rhs); },
-                  environment));
-
-          using ::ket::mpi::utility::rank_index_to_qubit_value;
-          permutated_result
-            = rank_index_to_qubit_value(
-                mpi_policy, local_state, result_rank, local_result);
-        }
-
-        yampi::broadcast(yampi::make_buffer(permutated_result, state_integer_datatype), result_rank, communicator, environment);
-
-        using ::ket::mpi::inverse_permutate_bits;
-        result.push_back(inverse_permutate_bits(permutation, permutated_result));
-      }
+        shared_seed = static_cast<StateInteger>(random_number_generator());
+      yampi::broadcast(yampi::make_buffer(shared_seed, state_integer_datatype), root_rank, communicator, environment);
+
+      auto nums_events = std::vector<int>(num_ranks);
+      auto seeds = std::vector<StateInteger>(num_ranks + 1);
+      auto shared_random_number_generator
+        = RandomNumberGenerator(static_cast<typename RandomNumberGenerator::result_type>(shared_seed));
+      ::ket::mpi::generate_events_detail::draw_nums_events_and_seeds(
+        total_probabilities, num_events, nums_events, seeds, shared_random_number_generator);
+
+      // events of each rank are sampled locally, and the events of all ranks are concatenated in rank order
+      auto const local_num_events = nums_events[present_rank.mpi_rank()];
+      auto local_random_number_generator
+        = RandomNumberGenerator(static_cast<typename RandomNumberGenerator::result_type>(seeds[present_rank.mpi_rank()]));
+      auto const random_values
+        = ::ket::generate_events_detail::sorted_random_values(
+            static_cast<std::size_t>(local_num_events), cumulative_block_probabilities.back(), local_random_number_generator);
+
+      auto events = std::vector<StateInteger>(local_num_events, StateInteger{0u});
+      auto const events_first = std::begin(events);
+      ::ket::generate_events_detail::find_events(
+        parallel_policy, std::begin(local_state), std::end(local_state),
+        cumulative_block_probabilities, random_values, events_first);
+
+      using ::ket::mpi::utility::rank_index_to_qubit_value;
+      using ::ket::mpi::inverse_permutate_bits;
+      std::transform(
+        events_first, events_first + local_num_events, events_first,
+        [&mpi_policy, &local_state, &permutation, present_rank](StateInteger const local_index)
+        { return inverse_permutate_bits(permutation, rank_index_to_qubit_value(mpi_policy, local_state, present_rank, local_index)); });
+
+      ::ket::mpi::utility::all_gather_v(events, nums_events, result, state_integer_datatype, communicator, environment);
+
+      // all ranks shuffle events in the same order
+      auto shuffle_random_number_generator
+        = RandomNumberGenerator(static_cast<typename RandomNumberGenerator::result_type>(seeds.back()));
+      std::shuffle(std::begin(result), std::end(result), shuffle_random_number_generator);
     }
 
     template <
@@ -1,9 +1,11 @@
 #ifndef KET_MPI_MEASURE_HPP
 # define KET_MPI_MEASURE_HPP
 
+# include <cstddef>
 # include <cmath>
 # include <vector>
 # include <iterator>
+# include <algorithm>
 
 # include <boost/range/size.hpp>
 # include <boost/range/value_type.hpp>
@@ -13,17 +15,16 @@
 # include <yampi/communicator.hpp>
 # include <yampi/rank.hpp>
 # include <yampi/buffer.hpp>
-# include <yampi/gather.hpp>
 # include <yampi/broadcast.hpp>
-# include <yampi/message_envelope.hpp>
-# include <yampi/algorithm/transform.hpp>
 
 # include <ket/utility/loop_n.hpp>
 # include <ket/utility/positive_random_value_upto.hpp>
 # include <ket/utility/meta/real_of.hpp>
 # include <ket/mpi/qubit_permutation.hpp>
 # include <ket/mpi/utility/simple_mpi.hpp>
+# include <ket/mpi/utility/complete_page_interchanges.hpp>
 # include <ket/mpi/utility/logger.hpp>
+# include <ket/mpi/utility/all_gather.hpp>
 # include <ket/mpi/utility/fill.hpp>
 # include <ket/mpi/utility/transform_inclusive_scan.hpp>
 # include <ket/mpi/utility/transform_inclusive_scan_self.hpp>
@@ -34,6 +35,30 @@ namespace ket
 {
   namespace mpi
   {
+    namespace measure_detail
+    {
+      // cumulative_total_probabilities[r] is the sum of total probabilities of ranks 0, 1, ..., r.
+      // The rank having random_value is returned, and random_value becomes the value relative to the first one of the rank
+      template <typename Real>
+      inline yampi::rank locate_random_value(std::vector<Real> const& cumulative_total_probabilities, Real& random_value)
+      {
+        auto const num_ranks = cumulative_total_probabilities.size();
+        auto const rank_index
+          = std::min(
+              static_cast<std::size_t>(
+                std::upper_bound(
+                  std::begin(cumulative_total_probabilities),
+                  std::end(cumulative_total_probabilities), random_value)
+                - std::begin(cumulative_total_probabilities)),
+              num_ranks - std::size_t{1u});
+
+        if (rank_index > std::size_t{0u})
+          random_value -= cumulative_total_probabilities[rank_index - std::size_t{1u}];
+
+        return yampi::rank{static_cast<int>(rank_index)};
+      }
+    } // namespace measure_detail
+
     // measure
     template <
       typename MpiPolicy, typename ParallelPolicy,
@@ -64,44 +89,22 @@ namespace ket
       constexpr auto root_rank = yampi::rank{0};
 
       using real_type = typename ::ket::utility::meta::real_of<complex_type>::type;
-      auto total_probabilities = std::vector<real_type>{};
-      if (present_rank == root_rank)
-        total_probabilities.resize(communicator.size(environment));
 
-      yampi::gather(
-        yampi::make_buffer(total_probability), std::begin(total_probabilities),
-        root_rank, communicator, environment);
+      // every rank has total probabilities of all ranks, so that only the random value is broadcast
+      auto total_probabilities = std::vector<real_type>{};
+      ::ket::mpi::utility::all_gather(total_probability, total_probabilities, communicator, environment);
+      ::ket::utility::ranges::inclusive_scan(
+        total_probabilities, std::begin(total_probabilities));
 
       auto random_value = real_type{};
-      auto result_rank = yampi::rank{};
       if (present_rank == root_rank)
-      {
-        ::ket::utility::ranges::inclusive_scan(
-          total_probabilities, std::begin(total_probabilities));
-
         random_value
           = ::ket::utility::positive_random_value_upto(
               total_probabilities.back(), random_number_generator);
-        result_rank
-          = static_cast<yampi::rank>(static_cast<StateInteger>(
-              std::upper_bound(
-                std::begin(total_probabilities),
-                std::end(total_probabilities), random_value)
-              - std::begin(total_probabilities)));
-      }
+      yampi::broadcast(yampi::make_buffer(random_value), root_rank, communicator, environment);
 
-      auto result_mpi_rank = result_rank.mpi_rank();
-      yampi::broadcast(yampi::make_buffer(result_mpi_rank), root_rank, communicator, environment);
-      result_rank = static_cast<yampi::rank>(result_mpi_rank);
-
-      yampi::algorithm::transform(
-        yampi::ignore_status,
-        yampi::make_buffer(random_value),
-        yampi::make_buffer(random_value),
-        [&total_probabilities, result_rank](real_type const random_value)
-        { return random_value - total_probabilities[result_rank.mpi_rank() - 1]; },
-        ::yampi::message_envelope(root_rank, result_rank, communicator),
-        environment);
+      auto const result_rank
+        = ::ket::mpi::measure_detail::locate_random_value(total_probabilities, random_value);
 
       auto permutated_result = StateInteger{};
       if (present_rank == result_rank)
@@ -121,6 +124,7 @@ namespace ket
 
         ::ket::mpi::utility::fill(
           mpi_policy, parallel_policy, local_state, complex_type{real_type{0}}, communicator, environment);
+        ::ket::mpi::utility::complete_page_interchanges(local_state);
         std::begin(local_state)[local_result] = complex_type{real_type{1}};
       }
       else
@@ -165,44 +169,21 @@ namespace ket
       auto const present_rank = communicator.rank(environment);
       constexpr auto root_rank = yampi::rank{0};
 
+      // every rank has total probabilities of all ranks, so that only the random value is broadcast
       auto total_probabilities = std::vector<real_type>{};
-      if (present_rank == root_rank)
-        total_probabilities.resize(communicator.size(environment));
-
-      yampi::gather(
-        yampi::make_buffer(total_probability, real_datatype), std::begin(total_probabilities),
-        root_rank, communicator, environment);
+      ::ket::mpi::utility::all_gather(total_probability, total_probabilities, real_datatype, communicator, environment);
+      ::ket::utility::ranges::inclusive_scan(
+        total_probabilities, std::begin(total_probabilities));
 
       auto random_value = real_type{};
-      auto result_rank = yampi::rank{};
       if (present_rank == root_rank)
-      {
-        ::ket::utility::ranges::inclusive_scan(
-          total_probabilities, std::begin(total_probabilities));
-
         random_value
           = ::ket::utility::positive_random_value_upto(
               total_probabilities.back(), random_number_generator);
-        result_rank
-          = static_cast<yampi::rank>(static_cast<StateInteger>(
-              std::upper_bound(
-                std::begin(total_probabilities),
-                std::end(total_probabilities), random_value)
-              - std::begin(total_probabilities)));
-      }
+      yampi::broadcast(yampi::make_buffer(random_value, real_datatype), root_rank, communicator, environment);
 
-      auto result_mpi_rank = result_rank.mpi_rank();
-      yampi::broadcast(yampi::make_buffer(result_mpi_rank), root_rank, communicator, environment);
-      result_rank = static_cast<yampi::rank>(result_mpi_rank);
-
-      yampi::algorithm::transform(
-        yampi::ignore_status,
-        yampi::make_buffer(random_value, real_datatype),
-        yampi::make_buffer(random_value, real_datatype),
-        [&total_probabilities, result_rank](real_type const random_value)
-        { return random_value - total_probabilities[result_rank.mpi_rank() - 1]; },
-        ::yampi::message_envelope(root_rank, result_rank, communicator),
-        environment);
+      auto const result_rank
+        = ::ket::mpi::measure_detail::locate_random_value(total_probabilities, random_value);
 
       auto permutated_result = StateInteger{};
       if (present_rank == result_rank)
@@ -222,6 +203,7 @@ namespace ket
 
         ::ket::mpi::utility::fill(
           mpi_policy, parallel_policy, local_state, complex_type{real_type{0}}, communicator, environment);
+        ::ket::mpi::utility::complete_page_interchanges(local_state);
         std::begin(local_state)[local_result] = complex_type{real_type{1}};
       }
       else
@@ -299,45 +281,21 @@ namespace ket
       auto const present_rank = communicator.rank(environment);
       constexpr auto root_rank = yampi::rank{0};
 
+      // every rank has total probabilities of all ranks, so that only the random value is broadcast
       auto total_probabilities = std::vector<real_type>{};
-      if (present_rank == root_rank)
-        total_probabilities.resize(communicator.size(environment));
-
-      using std::real;
-      yampi::gather(
-        yampi::make_buffer(partial_sum_probabilities.back()), std::begin(total_probabilities),
-        root_rank, communicator, environment);
+      ::ket::mpi::utility::all_gather(partial_sum_probabilities.back(), total_probabilities, communicator, environment);
+      ::ket::utility::ranges::inclusive_scan(
+        total_probabilities, std::begin(total_probabilities));
 
       auto random_value = real_type{};
-      auto result_rank = yampi::rank{};
       if (present_rank == root_rank)
-      {
-        ::ket::utility::ranges::inclusive_scan(
-          total_probabilities, std::begin(total_probabilities));
-
         random_value
           = ::ket::utility::positive_random_value_upto(
               total_probabilities.back(), random_number_generator);
-        result_rank
-          = static_cast<yampi::rank>(static_cast<StateInteger>(
-              std::upper_bound(
-                std::begin(total_probabilities),
-                std::end(total_probabilities), random_value)
-              - std::begin(total_probabilities)));
-      }
+      yampi::broadcast(yampi::make_buffer(random_value), root_rank, communicator, environment);
 
-      auto result_mpi_rank = result_rank.mpi_rank();
-      yampi::broadcast(yampi::make_buffer(result_mpi_rank), root_rank, communicator, environment);
-      result_rank = static_cast<yampi::rank>(result_mpi_rank);
-
-      yampi::algorithm::transform(
-        yampi::ignore_status,
-        yampi::make_buffer(random_value),
-        yampi::make_buffer(random_value),
-        [&total_probabilities, result_rank](real_type const random_value)
-        { return random_value - total_probabilities[result_rank.mpi_rank() - 1]; },
-        ::yampi::message_envelope(root_rank, result_rank, communicator),
-        environment);
+      auto const result_rank
+        = ::ket::mpi::measure_detail::locate_random_value(total_probabilities, random_value);
 
       auto permutated_result = StateInteger{};
       if (present_rank == result_rank)
@@ -355,6 +313,7 @@ namespace ket
 
         ::ket::mpi::utility::fill(
           mpi_policy, parallel_policy, local_state, complex_type{real_type{0}}, communicator, environment);
+        ::ket::mpi::utility::complete_page_interchanges(local_state);
         std::begin(local_state)[local_result] = complex_type{real_type{1}};
       }
       else
@@ -396,45 +355,21 @@ namespace ket
       auto const present_rank = communicator.rank(environment);
       constexpr auto root_rank = yampi::rank{0};
 
+      // every rank has total probabilities of all ranks, so that only the random value is broadcast
       auto total_probabilities = std::vector<real_type>{};
-      if (present_rank == root_rank)
-        total_probabilities.resize(communicator.size(environment));
-
-      using std::real;
-      yampi::gather(
-        yampi::make_buffer(partial_sum_probabilities.back(), real_datatype), std::begin(total_probabilities),
-        root_rank, communicator, environment);
+      ::ket::mpi::utility::all_gather(partial_sum_probabilities.back(), total_probabilities, real_datatype, communicator, environment);
+      ::ket::utility::ranges::inclusive_scan(
+        total_probabilities, std::begin(total_probabilities));
 
       auto random_value = real_type{};
-      auto result_rank = yampi::rank{};
       if (present_rank == root_rank)
-      {
-        ::ket::utility::ranges::inclusive_scan(
-          total_probabilities, std::begin(total_probabilities));
-
         random_value
           = ::ket::utility::positive_random_value_upto(
               total_probabilities.back(), random_number_generator);
-        result_rank
-          = static_cast<yampi::rank>(static_cast<StateInteger>(
-              std::upper_bound(
-                std::begin(total_probabilities),
-                std::end(total_probabilities), random_value)
-              - std::begin(total_probabilities)));
-      }
+      yampi::broadcast(yampi::make_buffer(random_value, real_datatype), root_rank, communicator, environment);
 
-      auto result_mpi_rank = result_rank.mpi_rank();
-      yampi::broadcast(yampi::make_buffer(result_mpi_rank), root_rank, communicator, environment);
-      result_rank = static_cast<yampi::rank>(result_mpi_rank);
-
-      yampi::algorithm::transform(
-        yampi::ignore_status,
-        yampi::make_buffer(random_value, real_datatype),
-        yampi::make_buffer(random_value, real_datatype),
-        [&total_probabilities, result_rank](real_type const random_value)
-        { return random_value - total_probabilities[result_rank.mpi_rank() - 1]; },
-        ::yampi::message_envelope(root_rank, result_rank, communicator),
-        environment);
+      auto const result_rank
+        = ::ket::mpi::measure_detail::locate_random_value(total_probabilities, random_value);
 
       auto permutated_result = StateInteger{};
       if (present_rank == result_rank)
@@ -452,6 +387,7 @@ namespace ket
 
         ::ket::mpi::utility::fill(
           mpi_policy, parallel_policy, local_state, complex_type{real_type{0}}, communicator, environment);
+        ::ket::mpi::utility::complete_page_interchanges(local_state);
         std::begin(local_state)[local_result] = complex_type{real_type{1}};
       }
       else
@@ -24,6 +24,7 @@
 # include <ket/utility/meta/real_of.hpp>
 # include <ket/mpi/qubit_permutation.hpp>
 # include <ket/mpi/utility/simple_mpi.hpp>
+# include <ket/mpi/utility/complete_page_interchanges.hpp>
 # include <ket/mpi/utility/fill.hpp>
 # include <ket/mpi/utility/logger.hpp>
 
@@ -77,6 +78,7 @@ namespace ket
         = static_cast<complex_type>(static_cast<real_type>(pow(static_cast<real_type>(num_exponents), -0.5)));
 
       auto const present_rank = communicator.rank(environment);
+      ::ket::mpi::utility::complete_page_interchanges(local_state);
       auto const first = std::begin(local_state);
       for (auto exponent = StateInteger{0u}; exponent < num_exponents; ++exponent)
       {
@@ -17,6 +17,9 @@
 # endif
 # include <array>
 # include <initializer_list>
+# ifdef KET_USE_ASYNC_PAGE_INTERCHANGE
+#   include <deque>
+# endif // KET_USE_ASYNC_PAGE_INTERCHANGE
 
 # include <boost/iterator/iterator_facade.hpp>
 
@@ -31,6 +34,9 @@
 # include <yampi/rank.hpp>
 # include <yampi/status.hpp>
 # include <yampi/algorithm/swap.hpp>
+# ifdef KET_USE_ASYNC_PAGE_INTERCHANGE
+#   include <mpi.h>
+# endif // KET_USE_ASYNC_PAGE_INTERCHANGE
 
 # include <ket/qubit.hpp>
 # include <ket/control.hpp>
@@ -42,12 +48,17 @@
 # include <ket/mpi/utility/simple_mpi.hpp>
 # include <ket/mpi/utility/for_each_local_range.hpp>
 # include <ket/mpi/utility/buffer_range.hpp>
+# include <ket/mpi/utility/complete_page_interchanges.hpp>
 # include <ket/mpi/utility/transform_inclusive_scan.hpp>
 # include <ket/mpi/utility/transform_inclusive_scan_self.hpp>
 # include <ket/mpi/utility/upper_bound.hpp>
 # include <ket/mpi/utility/detail/swap_permutated_local_qubits.hpp>
 # include <ket/mpi/utility/detail/for_each_in_diagonal_loop.hpp>
 # include <ket/mpi/utility/detail/swap_local_data.hpp>
+# ifdef KET_USE_ASYNC_PAGE_INTERCHANGE
+#   include <ket/mpi/utility/detail/check_mpi_error.hpp>
+#   include <ket/mpi/utility/detail/interchange_qubits.hpp>
+# endif // KET_USE_ASYNC_PAGE_INTERCHANGE
 
 # if __cplusplus >= 201703L
 #   define KET_is_nothrow_swappable std::is_nothrow_swappable
@@ -84,8 +95,9 @@ namespace ket
         { }
 
 
+        // interchanges of pages must have been completed by complete_page_interchanges() of the state
         typename State::value_type& dereference() const
-        { return const_cast<typename State::value_type&>((*state_ptr_)[index_]); }
+        { return const_cast<typename State::value_type&>(state_ptr_->element(index_)); }
 
         bool equal(state_iterator const& other) const
         { return state_ptr_ == other.state_ptr_ and index_ == other.index_; }
@@ -110,6 +122,23 @@ namespace ket
         ::ket::mpi::state_detail::state_iterator<State>& lhs,
         ::ket::mpi::state_detail::state_iterator<State>& rhs) noexcept
       { lhs.swap(rhs); }
+
+# ifdef KET_USE_ASYNC_PAGE_INTERCHANGE
+      // [first_index, last_index) of the page page_range_index is interchanged with the same range of target_rank.
+      // requests are empty until the interchange is posted, i.e. is_posted becomes true
+      struct page_interchange
+      {
+        std::size_t page_range_index;
+        std::size_t first_index;
+        std::size_t last_index;
+        MPI_Datatype mpi_datatype;
+        int num_datatypes_per_element;
+        int target_rank;
+        MPI_Comm mpi_comm;
+        bool is_posted;
+        std::vector<MPI_Request> requests;
+      }; // struct page_interchange
+# endif // KET_USE_ASYNC_PAGE_INTERCHANGE
     } // namespace state_detail
 
 
@@ -133,8 +162,25 @@ namespace ket
       std::size_t num_page_qubits_;
       std::size_t num_pages_; // 1u << num_page_qubits_
       std::size_t num_data_blocks_;
+# ifndef KET_USE_ASYNC_PAGE_INTERCHANGE
+      static constexpr std::size_t num_buffer_pages = 1u;
       std::vector<page_range_type> page_ranges_;
       page_range_type buffer_range_;
+# else // KET_USE_ASYNC_PAGE_INTERCHANGE
+      static constexpr std::size_t num_buffer_pages = 2u;
+      // completing interchanges does not change values of elements, so const member functions also complete them
+      mutable std::vector<page_range_type> page_ranges_;
+      mutable page_range_type buffer_range_;
+      // the second interchange in page_interchanges_ receives data into spare_buffer_range_
+      // while the front one receives data into buffer_range_
+      mutable page_range_type spare_buffer_range_;
+      // interchanges started by start_page_interchange but not completed yet. They are completed in order,
+      // and the front two are in flight unless they interchange the same page
+      mutable std::deque< ::ket::mpi::state_detail::page_interchange > page_interchanges_{};
+# endif // KET_USE_ASYNC_PAGE_INTERCHANGE
+
+      template <typename State>
+      friend class ::ket::mpi::state_detail::state_iterator;
 
      public:
       using size_type = typename data_type::size_type;
@@ -149,30 +195,69 @@ namespace ket
       using const_reverse_iterator = std::reverse_iterator<const_iterator>;
 
       state() = delete;
-      ~state() noexcept = default;
-      state(state const&) = default;
-      state& operator=(state const&) = default;
+      // buffers of interchanges in flight must not be freed
+      ~state() noexcept { complete_page_interchanges(); }
+
+      // page ranges refer to elements of data_, so they are rebased onto the copied data_
+      state(state const& other)
+        : data_{waited(other).data_},
+          num_local_qubits_{other.num_local_qubits_},
+          num_page_qubits_{other.num_page_qubits_},
+          num_pages_{other.num_pages_},
+          num_data_blocks_{other.num_data_blocks_},
+          page_ranges_{rebase_page_ranges(other.page_ranges_, std::begin(other.data_), data_)},
+          buffer_range_{rebase_page_range(other.buffer_range_, std::begin(other.data_), data_)}
+# ifdef KET_USE_ASYNC_PAGE_INTERCHANGE
+          , spare_buffer_range_{rebase_page_range(other.spare_buffer_range_, std::begin(other.data_), data_)}
+# endif // KET_USE_ASYNC_PAGE_INTERCHANGE
+      { }
+
+      state& operator=(state const& other)
+      {
+        if (this == std::addressof(other))
+          return *this;
+
+        complete_page_interchanges();
+        other.complete_page_interchanges();
+        data_ = other.data_;
+        num_local_qubits_ = other.num_local_qubits_;
+        num_page_qubits_ = other.num_page_qubits_;
+        num_pages_ = other.num_pages_;
+        num_data_blocks_ = other.num_data_blocks_;
+        page_ranges_ = rebase_page_ranges(other.page_ranges_, std::begin(other.data_), data_);
+        buffer_range_ = rebase_page_range(other.buffer_range_, std::begin(other.data_), data_);
+# ifdef KET_USE_ASYNC_PAGE_INTERCHANGE
+        spare_buffer_range_ = rebase_page_range(other.spare_buffer_range_, std::begin(other.data_), data_);
+# endif // KET_USE_ASYNC_PAGE_INTERCHANGE
+        return *this;
+      }
+
+      // moving data_ keeps its elements in place, so page ranges and interchanges in flight are moved as they are
       state(state&&) = default;
-      state& operator=(state&&) = default;
+
+      state& operator=(state&& other)
+      {
+        complete_page_interchanges();
+        swap(other);
+        return *this;
+      }
 
       state(state const& other, allocator_type const& allocator)
-        : data_{other.data_, allocator},
+        : data_{waited(other).data_, allocator},
           num_local_qubits_{other.num_local_qubits_},
           num_page_qubits_{other.num_page_qubits_},
           num_pages_{other.num_pages_},
           num_data_blocks_{other.num_data_blocks_},
-          page_ranges_{other.page_ranges_},
-          buffer_range_{other.buffer_range_}
+          page_ranges_{rebase_page_ranges(other.page_ranges_, std::begin(other.data_), data_)},
+          buffer_range_{rebase_page_range(other.buffer_range_, std::begin(other.data_), data_)}
+# ifdef KET_USE_ASYNC_PAGE_INTERCHANGE
+          , spare_buffer_range_{rebase_page_range(other.spare_buffer_range_, std::begin(other.data_), data_)}
+# endif // KET_USE_ASYNC_PAGE_INTERCHANGE
       { }
 
+      // elements are moved into another storage if allocator is different from that of other
       state(state&& other, allocator_type const& allocator)
-        : data_{std::move(other.data_), allocator},
-          num_local_qubits_{std::move(other.num_local_qubits_)},
-          num_page_qubits_{std::move(other.num_page_qubits_)},
-          num_pages_{std::move(other.num_pages_)},
-          num_data_blocks_{std::move(other.num_data_blocks_)},
-          page_ranges_{std::move(other.page_ranges_)},
-          buffer_range_{std::move(other.buffer_range_)}
+        : state{std::move(other), std::begin(waited(other).data_), allocator}
       { }
 
       state(std::initializer_list<value_type> initializer_list, allocator_type const& allocator = allocator_type())
@@ -183,6 +268,9 @@ namespace ket
           num_data_blocks_{std::size_t{1u}},
           page_ranges_{generate_initial_page_ranges(data_, num_pages_, num_data_blocks_)},
           buffer_range_{generate_initial_buffer_range(data_, num_pages_, num_data_blocks_)}
+# ifdef KET_USE_ASYNC_PAGE_INTERCHANGE
+          , spare_buffer_range_{generate_initial_spare_buffer_range(data_, num_pages_, num_data_blocks_)}
+# endif // KET_USE_ASYNC_PAGE_INTERCHANGE
       {
         assert(::ket::utility::integer_exp2<std::size_t>(num_local_qubits_) == initializer_list.size());
         assert(num_local_qubits_ > num_page_qubits_);
@@ -197,6 +285,9 @@ namespace ket
           num_data_blocks_{std::size_t{1u}},
           page_ranges_{generate_initial_page_ranges(data_, num_pages_, num_data_blocks_)},
           buffer_range_{generate_initial_buffer_range(data_, num_pages_, num_data_blocks_)}
+# ifdef KET_USE_ASYNC_PAGE_INTERCHANGE
+          , spare_buffer_range_{generate_initial_spare_buffer_range(data_, num_pages_, num_data_blocks_)}
+# endif // KET_USE_ASYNC_PAGE_INTERCHANGE
       {
         assert(::ket::utility::integer_exp2<std::size_t>(num_local_qubits_) == initializer_list.size());
         assert(num_page_qubits_ >= BitInteger{1u} and num_local_qubits_ > num_page_qubits_);
@@ -211,6 +302,9 @@ namespace ket
           num_data_blocks_{static_cast<std::size_t>(num_data_blocks)},
           page_ranges_{generate_initial_page_ranges(data_, num_pages_, num_data_blocks_)},
           buffer_range_{generate_initial_buffer_range(data_, num_pages_, num_data_blocks_)}
+# ifdef KET_USE_ASYNC_PAGE_INTERCHANGE
+          , spare_buffer_range_{generate_initial_spare_buffer_range(data_, num_pages_, num_data_blocks_)}
+# endif // KET_USE_ASYNC_PAGE_INTERCHANGE
       {
         assert(::ket::utility::integer_exp2<std::size_t>(num_local_qubits_) * num_data_blocks_ == initializer_list.size());
         assert(num_page_qubits_ >= BitInteger{1u} and num_local_qubits_ > num_page_qubits_);
@@ -235,6 +329,9 @@ namespace ket
           num_data_blocks_{std::size_t{1u}},
           page_ranges_{generate_initial_page_ranges(data_, num_pages_, num_data_blocks_)},
           buffer_range_{generate_initial_buffer_range(data_, num_pages_, num_data_blocks_)}
+# ifdef KET_USE_ASYNC_PAGE_INTERCHANGE
+          , spare_buffer_range_{generate_initial_spare_buffer_range(data_, num_pages_, num_data_blocks_)}
+# endif // KET_USE_ASYNC_PAGE_INTERCHANGE
       { assert(num_page_qubits_ >= BitInteger{1u} and num_local_qubits_ > num_page_qubits_); }
 
       template <typename MpiPolicy, typename BitInteger, typename StateInteger, typename PermutationAllocator>
@@ -254,6 +351,9 @@ namespace ket
           num_data_blocks_{static_cast<std::size_t>(::ket::mpi::utility::policy::num_data_blocks(mpi_policy, communicator, environment))},
           page_ranges_{generate_initial_page_ranges(data_, num_pages_, num_data_blocks_)},
           buffer_range_{generate_initial_buffer_range(data_, num_pages_, num_data_blocks_)}
+# ifdef KET_USE_ASYNC_PAGE_INTERCHANGE
+          , spare_buffer_range_{generate_initial_spare_buffer_range(data_, num_pages_, num_data_blocks_)}
+# endif // KET_USE_ASYNC_PAGE_INTERCHANGE
       { assert(num_page_qubits_ >= BitInteger{1u} and num_local_qubits_ > num_page_qubits_); }
 
       void assign(std::initializer_list<value_type> initializer_list)
@@ -266,6 +366,7 @@ namespace ket
       template <typename BitInteger, typename StateInteger>
       void assign(std::initializer_list<value_type> initializer_list, BitInteger const num_page_qubits, StateInteger const num_data_blocks)
       {
+        complete_page_interchanges();
         initialize_data(data_, initializer_list, std::size_t{1u} << num_page_qubits, static_cast<std::size_t>(num_data_blocks));
 
         num_local_qubits_ = ::ket::utility::integer_log2(initializer_list.size() / num_data_blocks);
@@ -278,6 +379,9 @@ namespace ket
 
         page_ranges_ = generate_initial_page_ranges(data_, num_pages_, num_data_blocks_);
         buffer_range_ = generate_initial_buffer_range(data_, num_pages_, num_data_blocks_);
+# ifdef KET_USE_ASYNC_PAGE_INTERCHANGE
+        spare_buffer_range_ = generate_initial_spare_buffer_range(data_, num_pages_, num_data_blocks_);
+# endif // KET_USE_ASYNC_PAGE_INTERCHANGE
       }
 
       template <typename BitInteger, typename StateInteger, typename PermutationAllocator>
@@ -301,6 +405,7 @@ namespace ket
         yampi::communicator const& communicator,
         yampi::environment const& environment)
       {
+        complete_page_interchanges();
         initialize_data(data_, mpi_policy, num_local_qubits, StateInteger{1u} << num_page_qubits, initial_integer, permutation, communicator, environment);
 
         num_local_qubits_ = static_cast<std::size_t>(num_local_qubits);
@@ -312,6 +417,9 @@ namespace ket
 
         page_ranges_ = generate_initial_page_ranges(data_, num_pages_, num_data_blocks_);
         buffer_range_ = generate_initial_buffer_range(data_, num_pages_, num_data_blocks_);
+# ifdef KET_USE_ASYNC_PAGE_INTERCHANGE
+        spare_buffer_range_ = generate_initial_spare_buffer_range(data_, num_pages_, num_data_blocks_);
+# endif // KET_USE_ASYNC_PAGE_INTERCHANGE
       }
 
       template <typename PairOrTuple>
@@ -336,6 +444,7 @@ namespace ket
         std::pair<DataBlockIndex, PageIndex> const& data_block_page_indices2)
       {
         assert(data_block_page_indices1 != data_block_page_indices2);
+        complete_page_interchanges();
         using std::swap;
         swap(
           page_ranges_[page_range_index(data_block_page_indices1)],
@@ -346,6 +455,7 @@ namespace ket
       void swap_buffer_and_page(
         std::pair<DataBlockIndex, PageIndex> const& data_block_page_indices)
       {
+        complete_page_interchanges();
         using std::swap;
         swap(buffer_range_, page_ranges_[page_range_index(data_block_page_indices)]);
       }
@@ -368,6 +478,7 @@ namespace ket
           nonpage_index2 >= decltype(nonpage_index2){0u}
           and nonpage_index2 < ::ket::utility::integer_exp2<size_type>(num_local_qubits_ - num_page_qubits_));
 
+        complete_page_interchanges();
         using std::swap;
         swap(
           std::begin(page_ranges_[page_range_index(data_block_page_nonpage_indices1)])[nonpage_index1],
@@ -376,10 +487,70 @@ namespace ket
 
       template <typename DataBlockIndex, typename PageIndex>
       page_range_type const& page_range(std::pair<DataBlockIndex, PageIndex> const& data_block_page_indices) const
-      { return page_ranges_[page_range_index(data_block_page_indices)]; }
+      {
+        complete_page_interchanges();
+        return page_ranges_[page_range_index(data_block_page_indices)];
+      }
 
       page_range_type const& buffer_range() const
-      { return buffer_range_; }
+      {
+        complete_page_interchanges();
+        return buffer_range_;
+      }
+
+      // completes all interchanges started by start_page_interchange.
+      // Call this before accessing elements through iterators; member functions taking indices or page indices call this first
+      void complete_page_interchanges() const
+      {
+# ifdef KET_USE_ASYNC_PAGE_INTERCHANGE
+        while (not page_interchanges_.empty())
+          complete_front_page_interchange();
+# endif // KET_USE_ASYNC_PAGE_INTERCHANGE
+      }
+
+# ifdef KET_USE_ASYNC_PAGE_INTERCHANGE
+      // [first_index, last_index) of the page is interchanged with the same range of target_rank,
+      // and each element is sent as num_datatypes_per_element elements of mpi_datatype.
+      // The interchange is completed lazily by for_each_page or complete_page_interchanges
+      template <typename DataBlockIndex, typename PageIndex, typename NonpageIndex>
+      void start_page_interchange(
+        std::pair<DataBlockIndex, PageIndex> const& data_block_page_indices,
+        NonpageIndex const first_index, NonpageIndex const last_index,
+        MPI_Datatype const mpi_datatype, int const num_datatypes_per_element,
+        yampi::rank const target_rank, yampi::communicator const& communicator)
+      {
+        assert(last_index >= first_index);
+        page_interchanges_.push_back(
+          ::ket::mpi::state_detail::page_interchange{
+            page_range_index(data_block_page_indices),
+            static_cast<std::size_t>(first_index), static_cast<std::size_t>(last_index),
+            mpi_datatype, num_datatypes_per_element, target_rank.mpi_rank(), communicator.mpi_comm(),
+            false, std::vector<MPI_Request>{}});
+
+        post_page_interchanges();
+      }
+
+      // function(first, last) is called for each page in the same order as page_range_index.
+      // Each page is passed to function as soon as its interchanges are completed, and the following two interchanges are in flight meanwhile.
+      // Communication is progressed by MPI_Testall between pages on the calling thread, so MPI_THREAD_FUNNELED is enough
+      template <typename Function>
+      void for_each_page(Function&& function) const
+      {
+        auto const num_page_ranges = page_ranges_.size();
+        for (auto index = std::size_t{0u}; index < num_page_ranges; ++index)
+        {
+          test_page_interchanges();
+          while (std::any_of(
+                   std::begin(page_interchanges_), std::end(page_interchanges_),
+                   [index](::ket::mpi::state_detail::page_interchange const& page_interchange)
+                   { return page_interchange.page_range_index == index; }))
+            complete_front_page_interchange();
+
+          auto const& page_range = page_ranges_[index];
+          function(std::begin(page_range), std::end(page_range));
+        }
+      }
+# endif // KET_USE_ASYNC_PAGE_INTERCHANGE
 
       std::size_t num_local_qubits() const noexcept { assert(num_local_qubits_ > num_page_qubits_); return num_local_qubits_; }
       std::size_t num_page_qubits() const noexcept { assert(num_page_qubits_ >= std::size_t{1u}); return num_page_qubits_; }
@@ -393,6 +564,7 @@ namespace ket
       // Element access
       reference at(size_type const index)
       {
+        complete_page_interchanges();
         return data_.at(
           (std::begin(page_ranges_[page_range_index(get_data_block_page_indices(index))]) - std::begin(data_))
           + get_nonpage_index(index));
@@ -400,6 +572,7 @@ namespace ket
 
       const_reference at(size_type const index) const
       {
+        complete_page_interchanges();
         return data_.at(
           (std::begin(page_ranges_[page_range_index(get_data_block_page_indices(index))]) - std::begin(data_))
           + get_nonpage_index(index));
@@ -408,22 +581,24 @@ namespace ket
       reference operator[](size_type const index)
       {
         assert(index < ::ket::utility::integer_exp2<size_type>(num_local_qubits_) * num_data_blocks_);
-        return std::begin(page_ranges_[page_range_index(get_data_block_page_indices(index))])[get_nonpage_index(index)];
+        complete_page_interchanges();
+        return element(index);
       }
 
       const_reference operator[](size_type const index) const
       {
         assert(index < ::ket::utility::integer_exp2<size_type>(num_local_qubits_) * num_data_blocks_);
-        return std::begin(page_ranges_[page_range_index(get_data_block_page_indices(index))])[get_nonpage_index(index)];
+        complete_page_interchanges();
+        return element(index);
       }
 
-      reference front() { return *std::begin(page_ranges_[page_range_index(get_data_block_page_indices(0u))]); }
-      const_reference front() const { return *std::begin(page_ranges_[page_range_index(get_data_block_page_indices(0u))]); }
+      reference front() { return *std::begin(page_range(get_data_block_page_indices(0u))); }
+      const_reference front() const { return *std::begin(page_range(get_data_block_page_indices(0u))); }
 
-      reference back() { return *--std::end(page_ranges_[page_range_index(get_data_block_page_indices((1u << num_local_qubits_) - 1u))]); }
-      const_reference back() const { return *--std::end(page_ranges_[page_range_index(get_data_block_page_indices((1u << num_local_qubits_) - 1u))]); }
+      reference back() { return *--std::end(page_range(get_data_block_page_indices((1u << num_local_qubits_) - 1u))); }
+      const_reference back() const { return *--std::end(page_range(get_data_block_page_indices((1u << num_local_qubits_) - 1u))); }
 
-      // Iterators
+      // Iterators: dereferencing them does not complete interchanges, so call complete_page_interchanges before using them
       iterator begin() noexcept { return iterator{*this, 0}; }
       const_iterator begin() const noexcept { return const_iterator{*this, 0}; }
       const_iterator cbegin() const noexcept { return const_iterator{*this, 0}; }
@@ -441,10 +616,10 @@ namespace ket
       const_reverse_iterator crend() const noexcept { return const_reverse_iterator{this->cbegin()}; }
 
       // Capacity
-      size_type size() const noexcept { return data_.size() - boost::size(buffer_range_); }
-      size_type max_size() const noexcept { return data_.max_size() - boost::size(buffer_range_); }
-      void reserve(size_type const new_capacity) { data_.reserve(new_capacity + boost::size(buffer_range_)); }
-      size_type capacity() const noexcept { return data_.capacity() - boost::size(buffer_range_); }
+      size_type size() const noexcept { return data_.size() - num_buffer_pages * boost::size(buffer_range_); }
+      size_type max_size() const noexcept { return data_.max_size() - num_buffer_pages * boost::size(buffer_range_); }
+      void reserve(size_type const new_capacity) { data_.reserve(new_capacity + num_buffer_pages * boost::size(buffer_range_)); }
+      size_type capacity() const noexcept { return data_.capacity() - num_buffer_pages * boost::size(buffer_range_); }
       void shrink_to_fit() { data_.shrink_to_fit(); }
 
       // Modifiers
@@ -464,16 +639,162 @@ namespace ket
         swap(num_data_blocks_, other.num_data_blocks_);
         swap(page_ranges_, other.page_ranges_);
         swap(buffer_range_, other.buffer_range_);
+# ifdef KET_USE_ASYNC_PAGE_INTERCHANGE
+        swap(spare_buffer_range_, other.spare_buffer_range_);
+        swap(page_interchanges_, other.page_interchanges_);
+# endif // KET_USE_ASYNC_PAGE_INTERCHANGE
       }
 
      private:
+      state(state&& other, typename data_type::const_iterator const other_data_first, allocator_type const& allocator)
+        : data_{std::move(other.data_), allocator},
+          num_local_qubits_{std::move(other.num_local_qubits_)},
+          num_page_qubits_{std::move(other.num_page_qubits_)},
+          num_pages_{std::move(other.num_pages_)},
+          num_data_blocks_{std::move(other.num_data_blocks_)},
+          page_ranges_{rebase_page_ranges(other.page_ranges_, other_data_first, data_)},
+          buffer_range_{rebase_page_range(other.buffer_range_, other_data_first, data_)}
+# ifdef KET_USE_ASYNC_PAGE_INTERCHANGE
+          , spare_buffer_range_{rebase_page_range(other.spare_buffer_range_, other_data_first, data_)}
+# endif // KET_USE_ASYNC_PAGE_INTERCHANGE
+      { }
+
+      static state const& waited(state const& other)
+      {
+        other.complete_page_interchanges();
+        return other;
+      }
+
+      // page_range refers to elements of the data whose first element is old_data_first
+      static page_range_type rebase_page_range(
+        page_range_type const& page_range, typename data_type::const_iterator const old_data_first, data_type& new_data)
+      {
+        auto const new_data_first = std::begin(new_data);
+        return boost::make_iterator_range(
+          new_data_first + (std::begin(page_range) - old_data_first), new_data_first + (std::end(page_range) - old_data_first));
+      }
+
+      static std::vector<page_range_type> rebase_page_ranges(
+        std::vector<page_range_type> const& page_ranges, typename data_type::const_iterator const old_data_first, data_type& new_data)
+      {
+        auto result = std::vector<page_range_type>{};
+        result.reserve(page_ranges.size());
+        for (auto const& page_range: page_ranges)
+          result.push_back(rebase_page_range(page_range, old_data_first, new_data));
+        return result;
+      }
+
+      reference element(size_type const index)
+      { return std::begin(page_ranges_[page_range_index(get_data_block_page_indices(index))])[get_nonpage_index(index)]; }
+
+      const_reference element(size_type const index) const
+      { return std::begin(page_ranges_[page_range_index(get_data_block_page_indices(index))])[get_nonpage_index(index)]; }
+
+# ifdef KET_USE_ASYNC_PAGE_INTERCHANGE
+      // the front interchange receives data into buffer_range_, and the second one into spare_buffer_range_.
+      // The second one is not posted if it interchanges the same page as the front one because it has to send the received data
+      void post_page_interchanges() const
+      {
+        if (page_interchanges_.empty())
+          return;
+
+        auto& front_page_interchange = page_interchanges_.front();
+        if (not front_page_interchange.is_posted)
+          post_page_interchange(front_page_interchange, buffer_range_);
+
+        if (page_interchanges_.size() == std::size_t{1u})
+          return;
+
+        auto& next_page_interchange = page_interchanges_[1u];
+        if (not next_page_interchange.is_posted
+            and next_page_interchange.page_range_index != front_page_interchange.page_range_index)
+          post_page_interchange(next_page_interchange, spare_buffer_range_);
+      }
+
+      void post_page_interchange(
+        ::ket::mpi::state_detail::page_interchange& page_interchange, page_range_type const& buffer_range) const
+      {
+        assert(not page_interchange.is_posted);
+        auto const& page_range = page_ranges_[page_interchange.page_range_index];
+        auto const page_first = std::begin(page_range);
+        auto const buffer_first = std::begin(buffer_range);
+
+        // the interchange is divided into chunks so that the count of each message fits in int
+        auto const size = page_interchange.last_index - page_interchange.first_index;
+        auto const chunk_size = std::size_t{KET_MPI_INTERCHANGE_CHUNK_SIZE};
+        auto const num_chunks = (size + chunk_size - std::size_t{1u}) / chunk_size;
+        page_interchange.requests.assign(std::size_t{2u} * num_chunks, MPI_REQUEST_NULL);
+        constexpr auto tag = 0;
+        for (auto chunk_index = std::size_t{0u}; chunk_index < num_chunks; ++chunk_index)
+        {
+          auto const chunk_first_index = page_interchange.first_index + chunk_index * chunk_size;
+          auto const count
+            = static_cast<int>(std::min(chunk_size, page_interchange.last_index - chunk_first_index)) * page_interchange.num_datatypes_per_element;
+
+          ::ket::mpi::utility::detail::check_mpi_error(
+            MPI_Irecv(
+              std::addressof(buffer_first[chunk_first_index]), count, page_interchange.mpi_datatype,
+              page_interchange.target_rank, tag, page_interchange.mpi_comm,
+              std::addressof(page_interchange.requests[std::size_t{2u} * chunk_index])),
+            "MPI_Irecv");
+          ::ket::mpi::utility::detail::check_mpi_error(
+            MPI_Isend(
+              std::addressof(page_first[chunk_first_index]), count, page_interchange.mpi_datatype,
+              page_interchange.target_rank, tag, page_interchange.mpi_comm,
+              std::addressof(page_interchange.requests[std::size_t{2u} * chunk_index + std::size_t{1u}])),
+            "MPI_Isend");
+        }
+
+        // the other elements are copied to the buffer while the interchange is in flight
+        std::copy(page_first, page_first + page_interchange.first_index, buffer_first);
+        std::copy(page_first + page_interchange.last_index, std::end(page_range), buffer_first + page_interchange.last_index);
+        page_interchange.is_posted = true;
+      }
+
+      void complete_front_page_interchange() const
+      {
+        assert(not page_interchanges_.empty());
+        auto& page_interchange = page_interchanges_.front();
+        assert(page_interchange.is_posted);
+        ::ket::mpi::utility::detail::check_mpi_error(
+          MPI_Waitall(static_cast<int>(page_interchange.requests.size()), page_interchange.requests.data(), MPI_STATUSES_IGNORE),
+          "MPI_Waitall");
+
+        // the old storage of the page becomes free, and the next interchange has been receiving data into spare_buffer_range_ if posted
+        using std::swap;
+        swap(buffer_range_, page_ranges_[page_interchange.page_range_index]);
+        swap(buffer_range_, spare_buffer_range_);
+        page_interchanges_.pop_front();
+
+        post_page_interchanges();
+      }
+
+      // completes interchanges from the front as long as their requests have been completed. Calling MPI_Testall also progresses
+      // communication on MPI libraries which do not progress it unless MPI functions are called
+      void test_page_interchanges() const
+      {
+        while (not page_interchanges_.empty())
+        {
+          auto& requests = page_interchanges_.front().requests;
+          auto is_completed = 0;
+          ::ket::mpi::utility::detail::check_mpi_error(
+            MPI_Testall(static_cast<int>(requests.size()), requests.data(), std::addressof(is_completed), MPI_STATUSES_IGNORE),
+            "MPI_Testall");
+          if (is_completed == 0)
+            return;
+
+          complete_front_page_interchange();
+        }
+      }
+
+# endif // KET_USE_ASYNC_PAGE_INTERCHANGE
       void initialize_data(
         data_type& data,
         std::initializer_list<value_type> initializer_list,
         std::size_t const num_pages, std::size_t const num_data_blocks) const
       {
         auto const state_size = initializer_list.size();
-        auto const data_size = state_size + state_size / num_pages / num_data_blocks;
+        auto const data_size = state_size + num_buffer_pages * (state_size / num_pages / num_data_blocks);
 
         assert(state_size % (num_pages * num_data_blocks) == 0);
 
@@ -500,7 +821,7 @@ namespace ket
         auto const data_block_size = ::ket::utility::integer_exp2<std::size_t>(num_local_qubits);
         auto const num_data_blocks = ::ket::mpi::utility::policy::num_data_blocks(mpi_policy, communicator, environment);
         auto const state_size = data_block_size * static_cast<std::size_t>(num_data_blocks);
-        auto const data_size = state_size + data_block_size / static_cast<std::size_t>(num_pages);
+        auto const data_size = state_size + num_buffer_pages * (data_block_size / static_cast<std::size_t>(num_pages));
 
         assert(state_size % (num_pages * num_data_blocks) == 0);
 
@@ -551,8 +872,8 @@ namespace ket
       std::vector<page_range_type>
       generate_initial_page_ranges(data_type& data, std::size_t const num_pages, std::size_t const num_data_blocks) const
       {
-        assert(data.size() % (num_pages * num_data_blocks + 1u) == 0u);
-        auto const page_size = static_cast<size_type>(data.size() / (num_pages * num_data_blocks + 1u));
+        assert(data.size() % (num_pages * num_data_blocks + num_buffer_pages) == 0u);
+        auto const page_size = static_cast<size_type>(data.size() / (num_pages * num_data_blocks + num_buffer_pages));
 
         auto result = std::vector<page_range_type>{};
         result.reserve(num_pages * num_data_blocks);
@@ -567,13 +888,25 @@ namespace ket
 
       page_range_type generate_initial_buffer_range(data_type& data, std::size_t const num_pages, std::size_t const num_data_blocks) const
       {
-        assert(data.size() % (num_pages * num_data_blocks + 1u) == 0u);
-        auto const page_size = static_cast<size_type>(data.size() / (num_pages * num_data_blocks + 1u));
+        assert(data.size() % (num_pages * num_data_blocks + num_buffer_pages) == 0u);
+        auto const page_size = static_cast<size_type>(data.size() / (num_pages * num_data_blocks + num_buffer_pages));
 
         return boost::make_iterator_range(
           std::begin(data) + num_pages * num_data_blocks * page_size,
           std::begin(data) + (num_pages * num_data_blocks + 1u) * page_size);
       }
+# ifdef KET_USE_ASYNC_PAGE_INTERCHANGE
+
+      page_range_type generate_initial_spare_buffer_range(data_type& data, std::size_t const num_pages, std::size_t const num_data_blocks) const
+      {
+        assert(data.size() % (num_pages * num_data_blocks + num_buffer_pages) == 0u);
+        auto const page_size = static_cast<size_type>(data.size() / (num_pages * num_data_blocks + num_buffer_pages));
+
+        return boost::make_iterator_range(
+          std::begin(data) + (num_pages * num_data_blocks + 1u) * page_size,
+          std::begin(data) + (num_pages * num_data_blocks + 2u) * page_size);
+      }
+# endif // KET_USE_ASYNC_PAGE_INTERCHANGE
 
      public:
       std::pair<size_type, size_type> get_data_block_page_indices(size_type const index) const
@@ -816,6 +1149,7 @@ namespace ket
           yampi::rank const target_rank,
           yampi::communicator const& communicator, yampi::environment const& environment)
         {
+# ifndef KET_USE_ASYNC_PAGE_INTERCHANGE
           using page_range_type
             = typename ::ket::mpi::state<Complex, has_page_qubits, Allocator>::page_range_type;
           using page_iterator
@@ -823,16 +1157,38 @@ namespace ket
           do_call(
             local_state, data_block_index, data_block_size,
             source_local_first_index, source_local_last_index,
-            [target_rank, &communicator, &environment](
-              page_iterator const first, page_iterator const last,
-              page_iterator const buffer_first, page_iterator const buffer_last)
+            [&local_state, target_rank, &communicator, &environment](
+              std::pair<StateInteger, StateInteger> const& data_block_page_indices,
+              StateInteger const first_index, StateInteger const last_index)
+            {
+              swap_page(
+                local_state, data_block_page_indices, first_index, last_index,
+                [target_rank, &communicator, &environment](
+                  page_iterator const first, page_iterator const last,
+                  page_iterator const buffer_first, page_iterator const buffer_last)
+                {
+                  yampi::algorithm::swap(
+                    yampi::ignore_status,
+                    yampi::make_buffer(first, last),
+                    yampi::make_buffer(buffer_first, buffer_last),
+                    target_rank, communicator, environment);
+                });
+            });
+# else // KET_USE_ASYNC_PAGE_INTERCHANGE
+          static_cast<void>(environment);
+          // elements are sent as bytes because local states are the same type in all processes
+          do_call(
+            local_state, data_block_index, data_block_size,
+            source_local_first_index, source_local_last_index,
+            [&local_state, target_rank, &communicator](
+              std::pair<StateInteger, StateInteger> const& data_block_page_indices,
+              StateInteger const first_index, StateInteger const last_index)
             {
-              yampi::algorithm::swap(
-                yampi::ignore_status,
-                yampi::make_buffer(first, last),
-                yampi::make_buffer(buffer_first, buffer_last),
-                target_rank, communicator, environment);
+              local_state.start_page_interchange(
+                data_block_page_indices, first_index, last_index,
+                MPI_BYTE, static_cast<int>(sizeof(Complex)), target_rank, communicator);
             });
+# endif // KET_USE_ASYNC_PAGE_INTERCHANGE
         }
 
         template <
@@ -847,6 +1203,7 @@ namespace ket
           yampi::datatype_base<DerivedDatatype> const& datatype, yampi::rank const target_rank,
           yampi::communicator const& communicator, yampi::environment const& environment)
         {
+# ifndef KET_USE_ASYNC_PAGE_INTERCHANGE
           using page_range_type
             = typename ::ket::mpi::state<Complex, has_page_qubits, Allocator>::page_range_type;
           using page_iterator
@@ -854,26 +1211,49 @@ namespace ket
           do_call(
             local_state, data_block_index, data_block_size,
             source_local_first_index, source_local_last_index,
-            [&datatype, target_rank, &communicator, &environment](
-              page_iterator const first, page_iterator const last,
-              page_iterator const buffer_first, page_iterator const buffer_last)
+            [&local_state, &datatype, target_rank, &communicator, &environment](
+              std::pair<StateInteger, StateInteger> const& data_block_page_indices,
+              StateInteger const first_index, StateInteger const last_index)
+            {
+              swap_page(
+                local_state, data_block_page_indices, first_index, last_index,
+                [&datatype, target_rank, &communicator, &environment](
+                  page_iterator const first, page_iterator const last,
+                  page_iterator const buffer_first, page_iterator const buffer_last)
+                {
+                  yampi::algorithm::swap(
+                    yampi::ignore_status,
+                    yampi::make_buffer(first, last, datatype),
+                    yampi::make_buffer(buffer_first, buffer_last, datatype),
+                    target_rank, communicator, environment);
+                });
+            });
+# else // KET_USE_ASYNC_PAGE_INTERCHANGE
+          static_cast<void>(environment);
+          do_call(
+            local_state, data_block_index, data_block_size,
+            source_local_first_index, source_local_last_index,
+            [&local_state, &datatype, target_rank, &communicator](
+              std::pair<StateInteger, StateInteger> const& data_block_page_indices,
+              StateInteger const first_index, StateInteger const last_index)
             {
-              yampi::algorithm::swap(
-                yampi::ignore_status,
-                yampi::make_buffer(first, last, datatype),
-                yampi::make_buffer(buffer_first, buffer_last, datatype),
-                target_rank, communicator, environment);
+              local_state.start_page_interchange(
+                data_block_page_indices, first_index, last_index,
+                datatype.mpi_datatype(), 1, target_rank, communicator);
             });
+# endif // KET_USE_ASYNC_PAGE_INTERCHANGE
         }
 
        private:
+        // interchange_page(data_block_page_indices, first_index, last_index) is called for each page,
+        // where [first_index, last_index) is the range of nonpage indices to be interchanged
         template <
           typename Allocator, typename Complex, typename StateInteger, typename Function>
         static void do_call(
           ::ket::mpi::state<Complex, has_page_qubits, Allocator>& local_state,
           StateInteger const data_block_index, StateInteger const data_block_size,
           StateInteger const source_local_first_index, StateInteger const source_local_last_index,
-          Function&& yampi_swap)
+          Function&& interchange_page)
         {
           assert(data_block_index >= StateInteger{0u} and data_block_index < local_state.num_data_blocks());
           assert(data_block_size == ::ket::utility::integer_exp2<std::size_t>(local_state.num_local_qubits()));
@@ -891,16 +1271,12 @@ namespace ket
             = static_cast<StateInteger>(front_data_block_page_indices.second);
           auto const back_page_index
             = static_cast<StateInteger>(back_data_block_page_indices.second);
+          // page_range() is not used here because it completes interchanges started by the previous pages
+          auto const page_size
+            = ::ket::utility::integer_exp2<StateInteger>(local_state.num_local_qubits() - local_state.num_page_qubits());
 
           for (auto page_index = front_page_index; page_index <= back_page_index; ++page_index)
           {
-            auto const page_range = local_state.page_range(std::make_pair(data_block_index, page_index));
-            auto const page_size = boost::size(page_range);
-
-            auto const page_first = std::begin(page_range);
-            auto const page_last = std::end(page_range);
-            auto const buffer_first = std::begin(local_state.buffer_range());
-
             auto const first_index
               = page_index == front_page_index
                 ? static_cast<StateInteger>(local_state.get_nonpage_index(data_block_index * data_block_size + source_local_first_index))
@@ -908,21 +1284,39 @@ namespace ket
             auto const last_index
               = page_index == back_page_index
                 ? static_cast<StateInteger>(local_state.get_nonpage_index(data_block_index * data_block_size + source_local_last_index - 1u) + 1u)
-                : static_cast<StateInteger>(page_size);
+                : page_size;
 
-            auto const the_first = page_first + first_index;
-            auto const the_last = page_first + last_index;
-            auto const the_buffer_first = buffer_first + first_index;
-            auto const the_buffer_last = buffer_first + last_index;
+            interchange_page(std::make_pair(data_block_index, page_index), first_index, last_index);
+          }
+        }
 
-            std::copy(page_first, the_first, buffer_first);
-            std::copy(the_last, page_last, the_buffer_last);
+# ifndef KET_USE_ASYNC_PAGE_INTERCHANGE
+        template <
+          typename Allocator, typename Complex, typename StateInteger, typename Function>
+        static void swap_page(
+          ::ket::mpi::state<Complex, has_page_qubits, Allocator>& local_state,
+          std::pair<StateInteger, StateInteger> const& data_block_page_indices,
+          StateInteger const first_index, StateInteger const last_index,
+          Function&& yampi_swap)
+        {
+          auto const page_range = local_state.page_range(data_block_page_indices);
+          auto const page_first = std::begin(page_range);
+          auto const page_last = std::end(page_range);
+          auto const buffer_first = std::begin(local_state.buffer_range());
 
-            yampi_swap(the_first, the_last, the_buffer_first, the_buffer_last);
+          auto const the_first = page_first + first_index;
+          auto const the_last = page_first + last_index;
+          auto const the_buffer_first = buffer_first + first_index;
+          auto const the_buffer_last = buffer_first + last_index;
 
-            local_state.swap_buffer_and_page(std::make_pair(data_block_index, page_index));
-          }
+          std::copy(page_first, the_first, buffer_first);
+          std::copy(the_last, page_last, the_buffer_last);
+
+          yampi_swap(the_first, the_last, the_buffer_first, the_buffer_last);
+
+          local_state.swap_buffer_and_page(data_block_page_indices);
         }
+# endif // KET_USE_ASYNC_PAGE_INTERCHANGE
       }; // struct interchange_qubits<has_page_qubits>
 
       template <bool has_page_qubits>
@@ -936,6 +1330,11 @@ namespace ket
           Function&& function)
         {
           // Gates should not be on page qubits
+# ifdef KET_USE_ASYNC_PAGE_INTERCHANGE
+          // pages are processed while the interchanges of the following pages are in flight
+          local_state.for_each_page(std::forward<Function>(function));
+          return local_state;
+# else // KET_USE_ASYNC_PAGE_INTERCHANGE
           auto const num_data_blocks = local_state.num_data_blocks();
           auto const num_pages = local_state.num_pages();
           for (auto data_block_index = std::size_t{0u}; data_block_index < num_data_blocks; ++data_block_index)
@@ -944,6 +1343,7 @@ namespace ket
                 std::begin(local_state.page_range(std::make_pair(data_block_index, page_index))),
                 std::end(local_state.page_range(std::make_pair(data_block_index, page_index))));
           return local_state;
+# endif // KET_USE_ASYNC_PAGE_INTERCHANGE
         }
 
         template <typename MpiPolicy, typename Complex, typename Allocator, typename Function>
@@ -954,6 +1354,10 @@ namespace ket
           Function&& function)
         {
           // Gates should not be on page qubits
+# ifdef KET_USE_ASYNC_PAGE_INTERCHANGE
+          local_state.for_each_page(std::forward<Function>(function));
+          return local_state;
+# else // KET_USE_ASYNC_PAGE_INTERCHANGE
           auto const num_data_blocks = local_state.num_data_blocks();
           auto const num_pages = local_state.num_pages();
           for (auto data_block_index = std::size_t{0u}; data_block_index < num_data_blocks; ++data_block_index)
@@ -962,6 +1366,7 @@ namespace ket
                 std::begin(local_state.page_range(std::make_pair(data_block_index, page_index))),
                 std::end(local_state.page_range(std::make_pair(data_block_index, page_index))));
           return local_state;
+# endif // KET_USE_ASYNC_PAGE_INTERCHANGE
         }
       }; // struct for_each_local_range<has_page_qubits>
 
@@ -2844,6 +3249,13 @@ namespace ket
           }
         }; // struct for_each_local_range< ::ket::mpi::state<Complex, has_page_qubits, Allocator> >
 
+        template <typename Complex, typename Allocator>
+        struct complete_page_interchanges< ::ket::mpi::state<Complex, true, Allocator> >
+        {
+          static void call(::ket::mpi::state<Complex, true, Allocator> const& local_state)
+          { local_state.complete_page_interchanges(); }
+        }; // struct complete_page_interchanges< ::ket::mpi::state<Complex, true, Allocator> >
+
         template <typename LocalState_>
         struct swap_local_data;
 
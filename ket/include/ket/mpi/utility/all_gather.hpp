@@ -0,0 +1,164 @@
+#ifndef KET_MPI_UTILITY_ALL_GATHER_HPP
+# define KET_MPI_UTILITY_ALL_GATHER_HPP
+
+# include <cassert>
+# include <cstddef>
+# include <vector>
+# include <iterator>
+# include <algorithm>
+# include <limits>
+# include <memory>
+
+# include <mpi.h>
+
+# include <yampi/environment.hpp>
+# include <yampi/datatype_base.hpp>
+# include <yampi/communicator.hpp>
+
+# include <ket/mpi/utility/detail/check_mpi_error.hpp>
+
+
+namespace ket
+{
+  namespace mpi
+  {
+    namespace utility
+    {
+      namespace all_gather_detail
+      {
+        // Counts and displacements of MPI_Allgatherv are int, and they are given in units of datatype,
+        // which is num_units_per_value times as many as values, e.g. bytes for MPI_BYTE.
+        // If the result has INT_MAX units or more, values are gathered by several MPI_Allgatherv's,
+        // each of which gathers at most max_count values from every rank
+        template <typename Value, typename Allocator1, typename Allocator2>
+        inline void all_gather_v(
+          std::vector<Value, Allocator1> const& local_values, std::vector<int> const& counts,
+          std::vector<Value, Allocator2>& result,
+          std::size_t const num_units_per_value, MPI_Datatype const datatype,
+          yampi::communicator const& communicator, yampi::environment const& environment)
+        {
+          auto const num_ranks = counts.size();
+          assert(num_ranks == static_cast<std::size_t>(communicator.size(environment)));
+          assert(std::all_of(std::begin(counts), std::end(counts), [](int const count) { return count >= 0; }));
+          auto const present_rank_index = static_cast<std::size_t>(communicator.rank(environment).mpi_rank());
+          assert(local_values.size() == static_cast<std::size_t>(counts[present_rank_index]));
+
+          auto offsets = std::vector<std::size_t>(num_ranks + std::size_t{1u}, std::size_t{0u});
+          for (auto rank_index = std::size_t{0u}; rank_index < num_ranks; ++rank_index)
+            offsets[rank_index + 1u] = offsets[rank_index] + static_cast<std::size_t>(counts[rank_index]);
+          result.resize(offsets.back());
+
+          constexpr auto max_num_units = static_cast<std::size_t>(std::numeric_limits<int>::max());
+          if (offsets.back() * num_units_per_value <= max_num_units)
+          {
+            auto unit_counts = std::vector<int>(num_ranks);
+            auto unit_displacements = std::vector<int>(num_ranks);
+            for (auto rank_index = std::size_t{0u}; rank_index < num_ranks; ++rank_index)
+            {
+              unit_counts[rank_index] = static_cast<int>(static_cast<std::size_t>(counts[rank_index]) * num_units_per_value);
+              unit_displacements[rank_index] = static_cast<int>(offsets[rank_index] * num_units_per_value);
+            }
+
+            ::ket::mpi::utility::detail::check_mpi_error(
+              MPI_Allgatherv(
+                local_values.data(), unit_counts[present_rank_index], datatype,
+                result.data(), unit_counts.data(), unit_displacements.data(), datatype, communicator.mpi_comm()),
+              "MPI_Allgatherv");
+            return;
+          }
+
+          auto const max_count = std::max(std::size_t{1u}, max_num_units / (num_ranks * num_units_per_value));
+          auto const num_calls
+            = (static_cast<std::size_t>(*std::max_element(std::begin(counts), std::end(counts))) + max_count - std::size_t{1u}) / max_count;
+
+          auto buffer = std::vector<Value>{};
+          buffer.reserve(num_ranks * max_count);
+          auto call_counts = std::vector<std::size_t>(num_ranks);
+          auto unit_counts = std::vector<int>(num_ranks);
+          auto unit_displacements = std::vector<int>(num_ranks);
+          for (auto call_index = std::size_t{0u}; call_index < num_calls; ++call_index)
+          {
+            auto const first_index = call_index * max_count;
+            auto num_values = std::size_t{0u};
+            for (auto rank_index = std::size_t{0u}; rank_index < num_ranks; ++rank_index)
+            {
+              auto const count = static_cast<std::size_t>(counts[rank_index]);
+              call_counts[rank_index] = count > first_index ? std::min(count - first_index, max_count) : std::size_t{0u};
+              unit_counts[rank_index] = static_cast<int>(call_counts[rank_index] * num_units_per_value);
+              unit_displacements[rank_index] = static_cast<int>(num_values * num_units_per_value);
+              num_values += call_counts[rank_index];
+            }
+            buffer.resize(num_values);
+
+            ::ket::mpi::utility::detail::check_mpi_error(
+              MPI_Allgatherv(
+                local_values.data() + std::min(first_index, local_values.size()), unit_counts[present_rank_index], datatype,
+                buffer.data(), unit_counts.data(), unit_displacements.data(), datatype, communicator.mpi_comm()),
+              "MPI_Allgatherv");
+
+            auto buffer_iter = std::begin(buffer);
+            for (auto rank_index = std::size_t{0u}; rank_index < num_ranks; ++rank_index)
+            {
+              auto const buffer_next_iter = buffer_iter + call_counts[rank_index];
+              std::copy(buffer_iter, buffer_next_iter, std::begin(result) + (offsets[rank_index] + first_index));
+              buffer_iter = buffer_next_iter;
+            }
+          }
+        }
+      } // namespace all_gather_detail
+
+      // result[r] is value of rank r
+      template <typename Value, typename Allocator>
+      inline void all_gather(
+        Value const& value, std::vector<Value, Allocator>& result,
+        yampi::communicator const& communicator, yampi::environment const& environment)
+      {
+        result.resize(communicator.size(environment));
+        ::ket::mpi::utility::detail::check_mpi_error(
+          MPI_Allgather(
+            std::addressof(value), static_cast<int>(sizeof(Value)), MPI_BYTE,
+            result.data(), static_cast<int>(sizeof(Value)), MPI_BYTE, communicator.mpi_comm()),
+          "MPI_Allgather");
+      }
+
+      template <typename Value, typename Allocator, typename DerivedDatatype>
+      inline void all_gather(
+        Value const& value, std::vector<Value, Allocator>& result,
+        yampi::datatype_base<DerivedDatatype> const& datatype,
+        yampi::communicator const& communicator, yampi::environment const& environment)
+      {
+        result.resize(communicator.size(environment));
+        ::ket::mpi::utility::detail::check_mpi_error(
+          MPI_Allgather(
+            std::addressof(value), 1, datatype.mpi_datatype(),
+            result.data(), 1, datatype.mpi_datatype(), communicator.mpi_comm()),
+          "MPI_Allgather");
+      }
+
+      // result is the concatenation of local_values of all ranks, where counts[r] is local_values.size() of rank r
+      template <typename Value, typename Allocator1, typename Allocator2>
+      inline void all_gather_v(
+        std::vector<Value, Allocator1> const& local_values, std::vector<int> const& counts,
+        std::vector<Value, Allocator2>& result,
+        yampi::communicator const& communicator, yampi::environment const& environment)
+      {
+        ::ket::mpi::utility::all_gather_detail::all_gather_v(
+          local_values, counts, result, sizeof(Value), MPI_BYTE, communicator, environment);
+      }
+
+      template <typename Value, typename Allocator1, typename Allocator2, typename DerivedDatatype>
+      inline void all_gather_v(
+        std::vector<Value, Allocator1> const& local_values, std::vector<int> const& counts,
+        std::vector<Value, Allocator2>& result,
+        yampi::datatype_base<DerivedDatatype> const& datatype,
+        yampi::communicator const& communicator, yampi::environment const& environment)
+      {
+        ::ket::mpi::utility::all_gather_detail::all_gather_v(
+          local_values, counts, result, std::size_t{1u}, datatype.mpi_datatype(), communicator, environment);
+      }
+    } // namespace utility
+  } // namespace mpi
+} // namespace ket
+
+
+#endif // KET_MPI_UTILITY_ALL_GATHER_HPP
@@ -0,0 +1,32 @@
+#ifndef KET_MPI_UTILITY_COMPLETE_PAGE_INTERCHANGES_HPP
+# define KET_MPI_UTILITY_COMPLETE_PAGE_INTERCHANGES_HPP
+
+
+namespace ket
+{
+  namespace mpi
+  {
+    namespace utility
+    {
+      namespace dispatch
+      {
+        template <typename LocalState_>
+        struct complete_page_interchanges
+        {
+          template <typename LocalState>
+          static void call(LocalState const&)
+          { }
+        }; // struct complete_page_interchanges<LocalState_>
+      } // namespace dispatch
+
+      // Interchanges of pages may be in flight after ::ket::mpi::utility::maybe_interchange_qubits if KET_USE_ASYNC_PAGE_INTERCHANGE is defined.
+      // Call this before accessing elements of local_state through its iterators
+      template <typename LocalState>
+      inline void complete_page_interchanges(LocalState const& local_state)
+      { ::ket::mpi::utility::dispatch::complete_page_interchanges<LocalState>::call(local_state); }
+    } // namespace utility
+  } // namespace mpi
+} // namespace ket
+
+
+#endif // KET_MPI_UTILITY_COMPLETE_PAGE_INTERCHANGES_HPP
@@ -13,6 +13,7 @@
 
 # include <ket/mpi/qubit_permutation.hpp>
 # include <ket/mpi/utility/simple_mpi.hpp>
+# include <ket/mpi/utility/complete_page_interchanges.hpp>
 
 
 namespace ket
@@ -36,6 +37,7 @@ namespace ket
           yampi::communicator const& communicator,
           yampi::environment const& environment)
         {
+          ::ket::mpi::utility::complete_page_interchanges(local_state);
           auto const first = std::begin(local_state);
           auto const present_rank = communicator.rank(environment);
 
@@ -0,0 +1,32 @@
+#ifndef KET_MPI_UTILITY_DETAIL_CHECK_MPI_ERROR_HPP
+# define KET_MPI_UTILITY_DETAIL_CHECK_MPI_ERROR_HPP
+
+# include <string>
+
+# include <mpi.h>
+
+# include <yampi/error.hpp>
+
+
+namespace ket
+{
+  namespace mpi
+  {
+    namespace utility
+    {
+      namespace detail
+      {
+        // For MPI functions without yampi wrappers, e.g. nonblocking transfers of chunks and shared-memory windows.
+        // Throws yampi::error as yampi wrappers do
+        inline void check_mpi_error(int const error_code, std::string const& where)
+        {
+          if (error_code != MPI_SUCCESS)
+            throw yampi::error{error_code, where};
+        }
+      } // namespace detail
+    } // namespace utility
+  } // namespace mpi
+} // namespace ket
+
+
+#endif // KET_MPI_UTILITY_DETAIL_CHECK_MPI_ERROR_HPP
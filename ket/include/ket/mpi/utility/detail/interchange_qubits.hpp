@@ -2,8 +2,11 @@
 # define KET_MPI_UTILITY_DETAIL_INTERCHANGE_QUBITS_HPP
 
 # include <cassert>
+# include <cstddef>
 # include <vector>
 # include <iterator>
+# include <algorithm>
+# include <memory>
 # include <utility>
 # include <type_traits>
 
@@ -12,10 +15,28 @@
 # include <yampi/environment.hpp>
 # include <yampi/datatype_base.hpp>
 # include <yampi/communicator.hpp>
-# include <yampi/buffer.hpp>
 # include <yampi/rank.hpp>
+# include <yampi/tag.hpp>
+# include <yampi/buffer.hpp>
 # include <yampi/status.hpp>
-# include <yampi/algorithm/swap.hpp>
+# include <yampi/request.hpp>
+# include <yampi/send.hpp>
+# include <yampi/receive.hpp>
+
+# include <ket/mpi/utility/detail/interchange_transport.hpp>
+# ifdef KET_USE_SHARED_MEMORY_INTERCHANGE
+#   include <ket/mpi/utility/shared_memory.hpp>
+# endif // KET_USE_SHARED_MEMORY_INTERCHANGE
+
+// Number of elements of each chunk transferred at once in ::ket::mpi::utility::detail::interchange_qubits
+# ifndef KET_MPI_INTERCHANGE_CHUNK_SIZE
+#   define KET_MPI_INTERCHANGE_CHUNK_SIZE 65536
+# endif // KET_MPI_INTERCHANGE_CHUNK_SIZE
+
+// Maximal number of chunks in flight at the same time in ::ket::mpi::utility::detail::interchange_qubits
+# ifndef KET_MPI_INTERCHANGE_QUEUE_DEPTH
+#   define KET_MPI_INTERCHANGE_QUEUE_DEPTH 4
+# endif // KET_MPI_INTERCHANGE_QUEUE_DEPTH
 
 
 namespace ket
@@ -24,6 +45,149 @@ namespace ket
   {
     namespace utility
     {
+      namespace interchange_qubits_detail
+      {
+        // Both processes of an interchange must divide it into the same chunks, so the chunk size depends only on data_block_size,
+        // which is the same in all processes, and not on buffer, which is resized by pipelined_swap.
+        // Buffer for KET_MPI_INTERCHANGE_QUEUE_DEPTH chunks is not larger than data_block_size
+        template <typename StateInteger>
+        inline std::size_t chunk_size(StateInteger const data_block_size)
+        {
+          return std::max(
+            std::size_t{1u},
+            std::min(std::size_t{KET_MPI_INTERCHANGE_CHUNK_SIZE}, static_cast<std::size_t>(data_block_size) / std::size_t{KET_MPI_INTERCHANGE_QUEUE_DEPTH}));
+        }
+
+        // [first, last) is interchanged with the same range of target_rank chunk by chunk.
+        // Up to KET_MPI_INTERCHANGE_QUEUE_DEPTH chunks are in flight by nonblocking send/receive at the same time,
+        // and received data of the oldest chunk is copied to the state while the following chunks are transferred.
+        // make_buffer(chunk_first, chunk_last) makes a yampi::buffer of a chunk.
+        template <typename Complex, typename Allocator, typename MakeBuffer>
+        inline void pipelined_swap(
+          Complex* const first, Complex* const last,
+          std::vector<Complex, Allocator>& buffer, std::size_t const chunk_size, MakeBuffer const& make_buffer,
+          yampi::rank const target_rank, yampi::communicator const& communicator, yampi::environment const& environment)
+        {
+          assert(last >= first);
+          auto const size = static_cast<std::size_t>(last - first);
+          if (size == std::size_t{0u})
+            return;
+
+          auto const the_chunk_size = std::min(chunk_size, size);
+          auto const num_chunks = (size + the_chunk_size - std::size_t{1u}) / the_chunk_size;
+          auto const num_slots = std::min(num_chunks, std::size_t{KET_MPI_INTERCHANGE_QUEUE_DEPTH});
+          if (buffer.size() < num_slots * the_chunk_size)
+            buffer.resize(num_slots * the_chunk_size);
+
+          // requests[2s] and requests[2s+1] are for receiving and sending the chunk whose data is in the s-th slot of buffer
+          auto requests = std::vector<yampi::request>(std::size_t{2u} * num_slots);
+          auto const tag = yampi::tag{0};
+
+          auto const chunk_count
+            = [size, the_chunk_size](std::size_t const chunk_index)
+              { return std::min(the_chunk_size, size - chunk_index * the_chunk_size); };
+          auto const post_chunk
+            = [first, &buffer, the_chunk_size, num_slots, &make_buffer, target_rank, tag,
+               &communicator, &environment, &requests, &chunk_count](std::size_t const chunk_index)
+              {
+                auto const slot_index = chunk_index % num_slots;
+                auto const slot_first = buffer.data() + slot_index * the_chunk_size;
+                auto const chunk_first = first + chunk_index * the_chunk_size;
+                auto const count = chunk_count(chunk_index);
+
+                yampi::receive(
+                  requests[std::size_t{2u} * slot_index], make_buffer(slot_first, slot_first + count),
+                  target_rank, tag, communicator, environment);
+                yampi::send(
+                  requests[std::size_t{2u} * slot_index + std::size_t{1u}], make_buffer(chunk_first, chunk_first + count),
+                  target_rank, tag, communicator, environment);
+              };
+
+          for (auto chunk_index = std::size_t{0u}; chunk_index < num_slots; ++chunk_index)
+            post_chunk(chunk_index);
+
+          for (auto chunk_index = std::size_t{0u}; chunk_index < num_chunks; ++chunk_index)
+          {
+            auto const slot_index = chunk_index % num_slots;
+            requests[std::size_t{2u} * slot_index].wait(yampi::ignore_status, environment);
+            requests[std::size_t{2u} * slot_index + std::size_t{1u}].wait(yampi::ignore_status, environment);
+
+            auto const slot_first = std::begin(buffer) + slot_index * the_chunk_size;
+            std::copy(slot_first, slot_first + chunk_count(chunk_index), first + chunk_index * the_chunk_size);
+
+            if (chunk_index + num_slots < num_chunks)
+              post_chunk(chunk_index + num_slots);
+          }
+        }
+
+# ifdef KET_USE_INTERCHANGE_TRANSPORT
+        // Same as above, but each chunk is encoded by ::ket::mpi::utility::interchange_transport_detail::encode before sending it,
+        // and the received bytes are decoded into the state. The format is chosen for each chunk by the sender.
+        // Each slot of receive_buffer can hold a chunk in any format, and decode does not need the exact number of received bytes
+        template <typename Complex>
+        inline void pipelined_swap(
+          Complex* const first, Complex* const last, std::size_t const chunk_size,
+          yampi::rank const target_rank, yampi::communicator const& communicator, yampi::environment const& environment)
+        {
+          assert(last >= first);
+          auto const size = static_cast<std::size_t>(last - first);
+          if (size == std::size_t{0u})
+            return;
+
+          auto const the_chunk_size = std::min(chunk_size, size);
+          auto const num_chunks = (size + the_chunk_size - std::size_t{1u}) / the_chunk_size;
+          auto const num_slots = std::min(num_chunks, std::size_t{KET_MPI_INTERCHANGE_QUEUE_DEPTH});
+          auto const max_slot_size = ::ket::mpi::utility::interchange_transport_detail::max_encoded_size<Complex>(the_chunk_size);
+          auto send_buffer = std::vector<char>(num_slots * max_slot_size);
+          auto receive_buffer = std::vector<char>(num_slots * max_slot_size);
+
+          auto requests = std::vector<yampi::request>(std::size_t{2u} * num_slots);
+          auto const tag = yampi::tag{0};
+
+          auto const chunk_count
+            = [size, the_chunk_size](std::size_t const chunk_index)
+              { return std::min(the_chunk_size, size - chunk_index * the_chunk_size); };
+          auto const post_chunk
+            = [first, the_chunk_size, num_slots, max_slot_size, &send_buffer, &receive_buffer,
+               target_rank, tag, &communicator, &environment, &requests, &chunk_count](std::size_t const chunk_index)
+              {
+                auto const slot_index = chunk_index % num_slots;
+                auto const chunk_first = first + chunk_index * the_chunk_size;
+                auto const send_slot_first = send_buffer.data() + slot_index * max_slot_size;
+                auto const encoded_size
+                  = ::ket::mpi::utility::interchange_transport_detail::encode(
+                      chunk_first, chunk_first + chunk_count(chunk_index), send_slot_first);
+
+                auto const receive_slot_first = receive_buffer.data() + slot_index * max_slot_size;
+                yampi::receive(
+                  requests[std::size_t{2u} * slot_index], yampi::make_buffer(receive_slot_first, receive_slot_first + max_slot_size),
+                  target_rank, tag, communicator, environment);
+                yampi::send(
+                  requests[std::size_t{2u} * slot_index + std::size_t{1u}], yampi::make_buffer(send_slot_first, send_slot_first + encoded_size),
+                  target_rank, tag, communicator, environment);
+              };
+
+          for (auto chunk_index = std::size_t{0u}; chunk_index < num_slots; ++chunk_index)
+            post_chunk(chunk_index);
+
+          for (auto chunk_index = std::size_t{0u}; chunk_index < num_chunks; ++chunk_index)
+          {
+            auto const slot_index = chunk_index % num_slots;
+            requests[std::size_t{2u} * slot_index].wait(yampi::ignore_status, environment);
+            requests[std::size_t{2u} * slot_index + std::size_t{1u}].wait(yampi::ignore_status, environment);
+
+            auto const chunk_first = first + chunk_index * the_chunk_size;
+            ::ket::mpi::utility::interchange_transport_detail::decode(
+              receive_buffer.data() + slot_index * max_slot_size, max_slot_size,
+              chunk_first, chunk_first + chunk_count(chunk_index));
+
+            if (chunk_index + num_slots < num_chunks)
+              post_chunk(chunk_index + num_slots);
+          }
+        }
+# endif // KET_USE_INTERCHANGE_TRANSPORT
+      } // namespace interchange_qubits_detail
+
       namespace dispatch
       {
         template <typename LocalState_>
@@ -41,58 +205,24 @@ namespace ket
           {
             assert(source_local_last_index >= source_local_first_index);
 
-            auto const first = std::begin(local_state) + data_block_index * data_block_size + source_local_first_index;
-            auto const last = std::begin(local_state) + data_block_index * data_block_size + source_local_last_index;
+            auto const first = std::addressof(*std::begin(local_state)) + data_block_index * data_block_size + source_local_first_index;
+            auto const last = std::addressof(*std::begin(local_state)) + data_block_index * data_block_size + source_local_last_index;
+
+# ifdef KET_USE_SHARED_MEMORY_INTERCHANGE
+            if (::ket::mpi::utility::shared_memory_swap(first, last, target_rank, communicator, environment))
+              return;
+# endif // KET_USE_SHARED_MEMORY_INTERCHANGE
 
-#ifndef BRAKET_ENABLE_MULTIPLE_USES_OF_BUFFER_FOR_ONE_DATA_TRANSFER_IF_NO_PAGE_EXISTS
-            buffer.resize(source_local_last_index - source_local_first_index);
-            yampi::algorithm::swap(
-              yampi::ignore_status,
-              yampi::make_buffer(first, last),
-              yampi::make_buffer(std::begin(buffer), std::end(buffer)),
+# ifndef KET_USE_INTERCHANGE_TRANSPORT
+            using complex_pointer = decltype(first);
+            ::ket::mpi::utility::interchange_qubits_detail::pipelined_swap(
+              first, last, buffer, ::ket::mpi::utility::interchange_qubits_detail::chunk_size(data_block_size),
+              [](complex_pointer const chunk_first, complex_pointer const chunk_last) { return yampi::make_buffer(chunk_first, chunk_last); },
               target_rank, communicator, environment);
-            std::copy(std::begin(buffer), std::end(buffer), first);
-#else // BRAKET_ENABLE_MULTIPLE_USES_OF_BUFFER_FOR_ONE_DATA_TRANSFER_IF_NO_PAGE_EXISTS
-            if (buffer.empty())
-            {
-              buffer.resize(source_local_last_index - source_local_first_index);
-              yampi::algorithm::swap(
-                yampi::ignore_status,
-                yampi::make_buffer(first, last),
-                yampi::make_buffer(std::begin(buffer), std::end(buffer)),
-                target_rank, communicator, environment);
-              std::copy(std::begin(buffer), std::end(buffer), first);
-            }
-            else
-            {
-              auto const buffer_size = buffer.size();
-              auto const num_iterations = (source_local_last_index - source_local_first_index) / buffer_size;
-
-              auto present_first = first;
-              for (auto count = decltype(num_iterations){0}; count < num_iterations; ++count)
-              {
-                yampi::algorithm::swap(
-                  yampi::ignore_status,
-                  yampi::make_buffer(present_first, present_first + buffer_size),
-                  yampi::make_buffer(std::begin(buffer), std::end(buffer)),
-                  target_rank, communicator, environment);
-                std::copy(std::begin(buffer), std::end(buffer), present_first);
-
-                present_first += buffer_size;
-              }
-
-              auto const remainder_size = (source_local_last_index - source_local_first_index) % buffer_size;
-              if (remainder_size > decltype(remainder_size){0})
-              {
-                yampi::algorithm::swap(
-                  yampi::ignore_status,
-                  yampi::make_buffer(present_first, present_first + remainder_size),
-                  yampi::make_buffer(std::begin(buffer), std::begin(buffer) + remainder_size),
-                  target_rank, communicator, environment);
-                std::copy(std::begin(buffer), std::begin(buffer) + remainder_size, present_first);
-              }
-            }
-#endif // BRAKET_ENABLE_MULTIPLE_USES_OF_BUFFER_FOR_ONE_DATA_TRANSFER_IF_NO_PAGE_EXISTS
+# else // KET_USE_INTERCHANGE_TRANSPORT
+            ::ket::mpi::utility::interchange_qubits_detail::pipelined_swap(
+              first, last, ::ket::mpi::utility::interchange_qubits_detail::chunk_size(data_block_size), target_rank, communicator, environment);
+# endif // KET_USE_INTERCHANGE_TRANSPORT
           }
 
           template <typename LocalState, typename Allocator, typename StateInteger, typename DerivedDatatype>
@@ -107,58 +237,27 @@ namespace ket
           {
             assert(source_local_last_index >= source_local_first_index);
 
-            auto const first = std::begin(local_state) + data_block_index * data_block_size + source_local_first_index;
-            auto const last = std::begin(local_state) + data_block_index * data_block_size + source_local_last_index;
+            auto const first = std::addressof(*std::begin(local_state)) + data_block_index * data_block_size + source_local_first_index;
+            auto const last = std::addressof(*std::begin(local_state)) + data_block_index * data_block_size + source_local_last_index;
+
+# ifdef KET_USE_SHARED_MEMORY_INTERCHANGE
+            if (::ket::mpi::utility::shared_memory_swap(first, last, target_rank, communicator, environment))
+              return;
+# endif // KET_USE_SHARED_MEMORY_INTERCHANGE
 
-#ifndef BRAKET_ENABLE_MULTIPLE_USES_OF_BUFFER_FOR_ONE_DATA_TRANSFER_IF_NO_PAGE_EXISTS
-            buffer.resize(source_local_last_index - source_local_first_index);
-            yampi::algorithm::swap(
-              yampi::ignore_status,
-              yampi::make_buffer(first, last, datatype),
-              yampi::make_buffer(std::begin(buffer), std::end(buffer), datatype),
+# ifndef KET_USE_INTERCHANGE_TRANSPORT
+            using complex_pointer = decltype(first);
+            ::ket::mpi::utility::interchange_qubits_detail::pipelined_swap(
+              first, last, buffer, ::ket::mpi::utility::interchange_qubits_detail::chunk_size(data_block_size),
+              [&datatype](complex_pointer const chunk_first, complex_pointer const chunk_last)
+              { return yampi::make_buffer(chunk_first, chunk_last, datatype); },
               target_rank, communicator, environment);
-            std::copy(std::begin(buffer), std::end(buffer), first);
-#else // BRAKET_ENABLE_MULTIPLE_USES_OF_BUFFER_FOR_ONE_DATA_TRANSFER_IF_NO_PAGE_EXISTS
-            if (buffer.empty())
-            {
-              buffer.resize(source_local_last_index - source_local_first_index);
-              yampi::algorithm::swap(
-                yampi::ignore_status,
-                yampi::make_buffer(first, last, datatype),
-                yampi::make_buffer(std::begin(buffer), std::end(buffer), datatype),
-                target_rank, communicator, environment);
-              std::copy(std::begin(buffer), std::end(buffer), first);
-            }
-            else
-            {
-              auto const buffer_size = buffer.size();
-              auto const num_iterations = (source_local_last_index - source_local_first_index) / buffer_size;
-
-              auto present_first = first;
-              for (auto count = decltype(num_iterations){0}; count < num_iterations; ++count)
-              {
-                yampi::algorithm::swap(
-                  yampi::ignore_status,
-                  yampi::make_buffer(present_first, present_first + buffer_size, datatype),
-                  yampi::make_buffer(std::begin(buffer), std::end(buffer), datatype),
-                  target_rank, communicator, environment);
-                std::copy(std::begin(buffer), std::end(buffer), present_first);
-
-                present_first += buffer_size;
-              }
-
-              auto const remainder_size = (source_local_last_index - source_local_first_index) % buffer_size;
-              if (remainder_size > decltype(remainder_size){0})
-              {
-                yampi::algorithm::swap(
-                  yampi::ignore_status,
-                  yampi::make_buffer(present_first, present_first + remainder_size, datatype),
-                  yampi::make_buffer(std::begin(buffer), std::begin(buffer) + remainder_size, datatype),
-                  target_rank, communicator, environment);
-                std::copy(std::begin(buffer), std::begin(buffer) + remainder_size, present_first);
-              }
-            }
-#endif // BRAKET_ENABLE_MULTIPLE_USES_OF_BUFFER_FOR_ONE_DATA_TRANSFER_IF_NO_PAGE_EXISTS
+# else // KET_USE_INTERCHANGE_TRANSPORT
+            // encoded amplitudes are sent as bytes, so datatype is not used
+            static_cast<void>(datatype);
+            ::ket::mpi::utility::interchange_qubits_detail::pipelined_swap(
+              first, last, ::ket::mpi::utility::interchange_qubits_detail::chunk_size(data_block_size), target_rank, communicator, environment);
+# endif // KET_USE_INTERCHANGE_TRANSPORT
           }
         }; // struct interchange_qubits<LocalState_>
       } // namespace dispatch
@@ -0,0 +1,349 @@
+#ifndef KET_MPI_UTILITY_DETAIL_INTERCHANGE_TRANSPORT_HPP
+# define KET_MPI_UTILITY_DETAIL_INTERCHANGE_TRANSPORT_HPP
+
+# include <cassert>
+# include <cstddef>
+# include <cstdint>
+# include <cstring>
+# include <complex>
+# include <algorithm>
+# include <memory>
+# include <stdexcept>
+# include <type_traits>
+
+/*
+ * Transport of amplitudes in ::ket::mpi::utility::detail::interchange_qubits
+ *   Each chunk is encoded with the precision and the format chosen by the sender, and both are recorded in its first byte,
+ *   so the receiver decodes it without any handshake even if processes choose differently.
+ *   The sender uses ::ket::mpi::utility::interchange_precision() and ::ket::mpi::utility::is_interchange_compressed(),
+ *   which can be changed at run time. Their initial values are given by the following macros.
+ *   KET_USE_SINGLE_PRECISION_INTERCHANGE: amplitudes are sent as std::complex<float>.
+ *   KET_USE_BFLOAT16_INTERCHANGE: amplitudes are sent as pairs of bfloat16, i.e. upper 16 bits of float rounded to nearest even.
+ *     Squared norm of rounding errors is accumulated in ::ket::mpi::utility::interchange_error().
+ *   KET_USE_COMPRESSED_INTERCHANGE: runs of exact zeros are sent as their lengths.
+ *     Each chunk is sent in this format only if it is smaller than the plain format, so sparse states benefit from it.
+ * Any of them enables the transport, and so does KET_USE_INTERCHANGE_TRANSPORT with full precision and no compression.
+ */
+# if defined(KET_USE_SINGLE_PRECISION_INTERCHANGE) || defined(KET_USE_BFLOAT16_INTERCHANGE) || defined(KET_USE_COMPRESSED_INTERCHANGE)
+#   ifndef KET_USE_INTERCHANGE_TRANSPORT
+#     define KET_USE_INTERCHANGE_TRANSPORT
+#   endif
+# endif
+
+
+namespace ket
+{
+  namespace mpi
+  {
+    namespace utility
+    {
+      enum class transport_precision : unsigned char { full = 0u, single = 1u, bfloat16 = 2u };
+
+      // precision of amplitudes sent by this process
+      inline ::ket::mpi::utility::transport_precision& interchange_precision() noexcept
+      {
+# if defined(KET_USE_BFLOAT16_INTERCHANGE)
+        static auto result = ::ket::mpi::utility::transport_precision::bfloat16;
+# elif defined(KET_USE_SINGLE_PRECISION_INTERCHANGE)
+        static auto result = ::ket::mpi::utility::transport_precision::single;
+# else
+        static auto result = ::ket::mpi::utility::transport_precision::full;
+# endif
+        return result;
+      }
+
+      // true if this process sends runs of exact zeros as their lengths
+      inline bool& is_interchange_compressed() noexcept
+      {
+# ifdef KET_USE_COMPRESSED_INTERCHANGE
+        static auto result = true;
+# else // KET_USE_COMPRESSED_INTERCHANGE
+        static auto result = false;
+# endif // KET_USE_COMPRESSED_INTERCHANGE
+        return result;
+      }
+
+      // squared norm of differences between sent amplitudes and received ones in this process,
+      // which is nonzero only if reduced precision is used
+      inline long double& interchange_error() noexcept
+      {
+        static long double result = 0.0l;
+        return result;
+      }
+
+      namespace interchange_transport_detail
+      {
+        // wire<Complex, precision>::size bytes are sent for each amplitude
+        template <typename Complex, ::ket::mpi::utility::transport_precision precision>
+        struct wire;
+
+        template <typename Complex>
+        struct wire<Complex, ::ket::mpi::utility::transport_precision::full>
+        {
+          static constexpr std::size_t size = sizeof(Complex);
+
+          static char* put(char* const out, Complex const& value, long double&)
+          {
+            std::memcpy(out, std::addressof(value), size);
+            return out + size;
+          }
+
+          static char const* get(char const* const in, Complex& value)
+          {
+            std::memcpy(std::addressof(value), in, size);
+            return in + size;
+          }
+        }; // struct wire<Complex, ::ket::mpi::utility::transport_precision::full>
+
+        template <typename Complex>
+        inline void add_error(Complex const& value, long double const sent_real, long double const sent_imag, long double& error)
+        {
+          using std::real;
+          using std::imag;
+          auto const real_error = static_cast<long double>(real(value)) - sent_real;
+          auto const imag_error = static_cast<long double>(imag(value)) - sent_imag;
+          error += real_error * real_error + imag_error * imag_error;
+        }
+
+        template <typename Complex>
+        struct wire<Complex, ::ket::mpi::utility::transport_precision::single>
+        {
+          static constexpr std::size_t size = 2u * sizeof(float);
+
+          static char* put(char* const out, Complex const& value, long double& error)
+          {
+            using std::real;
+            using std::imag;
+            float const parts[2] = {static_cast<float>(real(value)), static_cast<float>(imag(value))};
+            ::ket::mpi::utility::interchange_transport_detail::add_error(value, parts[0], parts[1], error);
+            std::memcpy(out, parts, size);
+            return out + size;
+          }
+
+          static char const* get(char const* const in, Complex& value)
+          {
+            float parts[2];
+            std::memcpy(parts, in, size);
+            using real_type = typename std::remove_cv<decltype(std::real(value))>::type;
+            value = Complex{static_cast<real_type>(parts[0]), static_cast<real_type>(parts[1])};
+            return in + size;
+          }
+        }; // struct wire<Complex, ::ket::mpi::utility::transport_precision::single>
+
+        // upper 16 bits of float, rounded to nearest even. Amplitudes are assumed to be finite
+        inline std::uint16_t to_bfloat16(float const value) noexcept
+        {
+          auto bits = std::uint32_t{};
+          std::memcpy(std::addressof(bits), std::addressof(value), sizeof(float));
+          bits += std::uint32_t{0x7fffu} + ((bits >> 16u) bitand std::uint32_t{1u});
+          return static_cast<std::uint16_t>(bits >> 16u);
+        }
+
+        inline float from_bfloat16(std::uint16_t const value) noexcept
+        {
+          auto const bits = static_cast<std::uint32_t>(value) << 16u;
+          auto result = float{};
+          std::memcpy(std::addressof(result), std::addressof(bits), sizeof(float));
+          return result;
+        }
+
+        template <typename Complex>
+        struct wire<Complex, ::ket::mpi::utility::transport_precision::bfloat16>
+        {
+          static constexpr std::size_t size = 2u * sizeof(std::uint16_t);
+
+          static char* put(char* const out, Complex const& value, long double& error)
+          {
+            using std::real;
+            using std::imag;
+            std::uint16_t const parts[2]
+              = {::ket::mpi::utility::interchange_transport_detail::to_bfloat16(static_cast<float>(real(value))),
+                 ::ket::mpi::utility::interchange_transport_detail::to_bfloat16(static_cast<float>(imag(value)))};
+            ::ket::mpi::utility::interchange_transport_detail::add_error(
+              value,
+              ::ket::mpi::utility::interchange_transport_detail::from_bfloat16(parts[0]),
+              ::ket::mpi::utility::interchange_transport_detail::from_bfloat16(parts[1]), error);
+            std::memcpy(out, parts, size);
+            return out + size;
+          }
+
+          static char const* get(char const* const in, Complex& value)
+          {
+            std::uint16_t parts[2];
+            std::memcpy(parts, in, size);
+            using real_type = typename std::remove_cv<decltype(std::real(value))>::type;
+            value
+              = Complex{
+                  static_cast<real_type>(::ket::mpi::utility::interchange_transport_detail::from_bfloat16(parts[0])),
+                  static_cast<real_type>(::ket::mpi::utility::interchange_transport_detail::from_bfloat16(parts[1]))};
+            return in + size;
+          }
+        }; // struct wire<Complex, ::ket::mpi::utility::transport_precision::bfloat16>
+
+        // format of encoded chunks, whose first byte is format_tag + 2 * precision
+        //   plain:      [tag] [wire value] * n
+        //   run-length: [tag] ([number of zeros] [number of values] [wire value] * (number of values)) * (number of runs)
+        constexpr unsigned char plain_tag = 0u;
+        constexpr unsigned char run_length_tag = 1u;
+        using run_length_type = std::uint32_t;
+
+        // the size for full precision, which is the largest one, so that chunks in any precision can be received
+        template <typename Complex>
+        inline std::size_t max_encoded_size(std::size_t const num_elements) noexcept
+        { return std::size_t{1u} + num_elements * std::max(sizeof(Complex), std::size_t{2u} * sizeof(float)); }
+
+        template <typename Complex>
+        inline bool is_zero(Complex const& value)
+        {
+          using std::real;
+          using std::imag;
+          return real(value) == 0 and imag(value) == 0;
+        }
+
+        template < ::ket::mpi::utility::transport_precision precision, typename Complex>
+        inline std::size_t encode(Complex const* const first, Complex const* const last, char* const out, bool const is_compressed)
+        {
+          using wire_type = ::ket::mpi::utility::interchange_transport_detail::wire<Complex, precision>;
+          auto const precision_bits = static_cast<unsigned char>(2u * static_cast<unsigned char>(precision));
+          auto error = 0.0l;
+          auto const plain_size = std::size_t{1u} + static_cast<std::size_t>(last - first) * wire_type::size;
+
+          if (is_compressed)
+          {
+            auto iter = out;
+            *iter++ = static_cast<char>(::ket::mpi::utility::interchange_transport_detail::run_length_tag + precision_bits);
+            auto const out_last = out + plain_size;
+
+            auto element_iter = first;
+            while (element_iter != last)
+            {
+              auto const zeros_first = element_iter;
+              while (element_iter != last and ::ket::mpi::utility::interchange_transport_detail::is_zero(*element_iter))
+                ++element_iter;
+              auto const values_first = element_iter;
+              while (element_iter != last and not ::ket::mpi::utility::interchange_transport_detail::is_zero(*element_iter))
+                ++element_iter;
+
+              auto const num_zeros = static_cast<run_length_type>(values_first - zeros_first);
+              auto const num_values = static_cast<run_length_type>(element_iter - values_first);
+              if (out_last - iter < static_cast<std::ptrdiff_t>(2u * sizeof(run_length_type) + num_values * wire_type::size))
+              {
+                // falls back to the plain format
+                error = 0.0l;
+                iter = nullptr;
+                break;
+              }
+
+              std::memcpy(iter, std::addressof(num_zeros), sizeof(run_length_type));
+              iter += sizeof(run_length_type);
+              std::memcpy(iter, std::addressof(num_values), sizeof(run_length_type));
+              iter += sizeof(run_length_type);
+              for (auto value_iter = values_first; value_iter != element_iter; ++value_iter)
+                iter = wire_type::put(iter, *value_iter, error);
+            }
+
+            if (iter != nullptr)
+            {
+              ::ket::mpi::utility::interchange_error() += error;
+              return static_cast<std::size_t>(iter - out);
+            }
+          }
+
+          auto plain_iter = out;
+          *plain_iter++ = static_cast<char>(::ket::mpi::utility::interchange_transport_detail::plain_tag + precision_bits);
+          for (auto element_iter = first; element_iter != last; ++element_iter)
+            plain_iter = wire_type::put(plain_iter, *element_iter, error);
+          ::ket::mpi::utility::interchange_error() += error;
+          return plain_size;
+        }
+
+        // encodes [first, last) into out, which has max_encoded_size<Complex>(last - first) bytes, and returns the number of written bytes
+        template <typename Complex>
+        inline std::size_t encode(Complex const* const first, Complex const* const last, char* const out)
+        {
+          auto const is_compressed = ::ket::mpi::utility::is_interchange_compressed();
+          switch (::ket::mpi::utility::interchange_precision())
+          {
+           case ::ket::mpi::utility::transport_precision::single:
+            return ::ket::mpi::utility::interchange_transport_detail::encode< ::ket::mpi::utility::transport_precision::single>(
+              first, last, out, is_compressed);
+           case ::ket::mpi::utility::transport_precision::bfloat16:
+            return ::ket::mpi::utility::interchange_transport_detail::encode< ::ket::mpi::utility::transport_precision::bfloat16>(
+              first, last, out, is_compressed);
+           default:
+            return ::ket::mpi::utility::interchange_transport_detail::encode< ::ket::mpi::utility::transport_precision::full>(
+              first, last, out, is_compressed);
+          }
+        }
+
+        template < ::ket::mpi::utility::transport_precision precision, typename Complex>
+        inline void decode(
+          char const* const in, std::size_t const size, unsigned char const format_tag, Complex* const first, Complex* const last)
+        {
+          using wire_type = ::ket::mpi::utility::interchange_transport_detail::wire<Complex, precision>;
+          auto iter = in + 1;
+          // in_last is only used by assertions
+          auto const in_last = in + size;
+          static_cast<void>(in_last);
+
+          if (format_tag == ::ket::mpi::utility::interchange_transport_detail::plain_tag)
+          {
+            for (auto element_iter = first; element_iter != last; ++element_iter)
+              iter = wire_type::get(iter, *element_iter);
+            assert(iter <= in_last);
+            return;
+          }
+
+          // runs cover all elements, so decoding stops at last
+          auto element_iter = first;
+          while (element_iter != last)
+          {
+            assert(in_last - iter >= static_cast<std::ptrdiff_t>(2u * sizeof(run_length_type)));
+            auto num_zeros = run_length_type{};
+            std::memcpy(std::addressof(num_zeros), iter, sizeof(run_length_type));
+            iter += sizeof(run_length_type);
+            auto num_values = run_length_type{};
+            std::memcpy(std::addressof(num_values), iter, sizeof(run_length_type));
+            iter += sizeof(run_length_type);
+
+            assert(static_cast<std::size_t>(last - element_iter) >= static_cast<std::size_t>(num_zeros) + num_values);
+            std::fill(element_iter, element_iter + num_zeros, Complex{});
+            element_iter += num_zeros;
+            for (auto count = run_length_type{0u}; count < num_values; ++count)
+              iter = wire_type::get(iter, *element_iter++);
+          }
+          assert(iter <= in_last);
+        }
+
+        // decodes [first, last) from in, which has at least the encoded bytes and at most size bytes, in the precision and the format recorded by the sender
+        template <typename Complex>
+        inline void decode(char const* const in, std::size_t const size, Complex* const first, Complex* const last)
+        {
+          assert(size >= std::size_t{1u});
+          auto const tag = static_cast<unsigned char>(*in);
+          auto const format_tag = static_cast<unsigned char>(tag % 2u);
+          switch (tag / 2u)
+          {
+           case static_cast<unsigned char>(::ket::mpi::utility::transport_precision::full):
+            ::ket::mpi::utility::interchange_transport_detail::decode< ::ket::mpi::utility::transport_precision::full>(
+              in, size, format_tag, first, last);
+            return;
+           case static_cast<unsigned char>(::ket::mpi::utility::transport_precision::single):
+            ::ket::mpi::utility::interchange_transport_detail::decode< ::ket::mpi::utility::transport_precision::single>(
+              in, size, format_tag, first, last);
+            return;
+           case static_cast<unsigned char>(::ket::mpi::utility::transport_precision::bfloat16):
+            ::ket::mpi::utility::interchange_transport_detail::decode< ::ket::mpi::utility::transport_precision::bfloat16>(
+              in, size, format_tag, first, last);
+            return;
+           default:
+            throw std::runtime_error{"unknown format of received amplitudes in ket::mpi::utility::detail::interchange_qubits"};
+          }
+        }
+      } // namespace interchange_transport_detail
+    } // namespace utility
+  } // namespace mpi
+} // namespace ket
+
+
+#endif // KET_MPI_UTILITY_DETAIL_INTERCHANGE_TRANSPORT_HPP
@@ -1,6 +1,8 @@
 #ifndef KET_MPI_UTILITY_DETAIL_MAKE_LOCAL_SWAP_QUBIT_HPP
 # define KET_MPI_UTILITY_DETAIL_MAKE_LOCAL_SWAP_QUBIT_HPP
 
+# include <cassert>
+# include <cstddef>
 # include <algorithm>
 # include <iterator>
 # include <type_traits>
@@ -14,6 +16,7 @@
 # include <ket/utility/contains.hpp>
 # include <ket/mpi/permutated.hpp>
 # include <ket/mpi/qubit_permutation.hpp>
+# include <ket/mpi/utility/lookahead.hpp>
 # include <ket/mpi/utility/detail/swap_permutated_local_qubits.hpp>
 
 
@@ -35,6 +38,7 @@ namespace ket
           LocalState& local_state,
           ::ket::mpi::qubit_permutation<StateInteger, BitInteger, Allocator>& permutation,
           UnswappableQubits const& unswappable_qubits,
+          ::ket::mpi::utility::lookahead const* const maybe_lookahead,
           ::ket::mpi::permutated< ::ket::qubit<StateInteger, BitInteger> > const permutated_local_swap_qubit,
           StateInteger const num_data_blocks, StateInteger const data_block_size,
           yampi::communicator const& communicator, yampi::environment const& environment)
@@ -49,23 +53,60 @@ namespace ket
           using ::ket::mpi::inverse;
           auto const local_swap_qubit = inverse(permutation)[permutated_local_swap_qubit];
 
-          if (not ::ket::utility::contains(
-                std::begin(unswappable_qubits), std::end(unswappable_qubits),
-                local_swap_qubit))
-            return local_swap_qubit;
-
           auto permutated_other_qubit = permutated_local_swap_qubit;
-          auto other_qubit = qubit_type{};
-          do
+          auto other_qubit = local_swap_qubit;
+          if (maybe_lookahead == nullptr)
           {
-            --permutated_other_qubit;
-            using ::ket::mpi::inverse;
-            other_qubit = inverse(permutation)[permutated_other_qubit];
+            if (not ::ket::utility::contains(
+                  std::begin(unswappable_qubits), std::end(unswappable_qubits),
+                  local_swap_qubit))
+              return local_swap_qubit;
+
+            do
+            {
+              --permutated_other_qubit;
+              using ::ket::mpi::inverse;
+              other_qubit = inverse(permutation)[permutated_other_qubit];
+            }
+            while (
+              ::ket::utility::contains(
+                std::begin(unswappable_qubits), std::end(unswappable_qubits),
+                other_qubit));
+          }
+          else
+          {
+            // The qubit whose next use is the furthest is chosen from swappable qubits not above permutated_local_swap_qubit.
+            // Ties are broken in favor of the upper qubit, so the present local swap qubit is kept if possible.
+            auto is_found = false;
+            auto furthest_next_use = std::size_t{0u};
+            auto permutated_qubit = permutated_local_swap_qubit;
+            while (true)
+            {
+              using ::ket::mpi::inverse;
+              auto const qubit = inverse(permutation)[permutated_qubit];
+              if (not ::ket::utility::contains(
+                    std::begin(unswappable_qubits), std::end(unswappable_qubits),
+                    qubit))
+              {
+                auto const next_use = maybe_lookahead->next_use(static_cast<std::size_t>(static_cast<BitInteger>(qubit)));
+                if (not is_found or next_use > furthest_next_use)
+                {
+                  is_found = true;
+                  furthest_next_use = next_use;
+                  permutated_other_qubit = permutated_qubit;
+                  other_qubit = qubit;
+                }
+              }
+
+              if (permutated_qubit.qubit() == qubit_type{0u})
+                break;
+              --permutated_qubit;
+            }
+            assert(is_found);
+
+            if (permutated_other_qubit == permutated_local_swap_qubit)
+              return local_swap_qubit;
           }
-          while (
-            ::ket::utility::contains(
-              std::begin(unswappable_qubits), std::end(unswappable_qubits),
-              other_qubit));
 
           ::ket::mpi::utility::detail::swap_permutated_local_qubits(
             parallel_policy, local_state,
@@ -76,6 +117,25 @@ namespace ket
 
           return inverse(permutation)[permutated_local_swap_qubit];
         }
+
+        template <
+          typename ParallelPolicy, typename LocalState,
+          typename StateInteger, typename BitInteger, typename Allocator,
+          typename UnswappableQubits>
+        inline ::ket::qubit<StateInteger, BitInteger>
+        make_local_swap_qubit(
+          ParallelPolicy const parallel_policy,
+          LocalState& local_state,
+          ::ket::mpi::qubit_permutation<StateInteger, BitInteger, Allocator>& permutation,
+          UnswappableQubits const& unswappable_qubits,
+          ::ket::mpi::permutated< ::ket::qubit<StateInteger, BitInteger> > const permutated_local_swap_qubit,
+          StateInteger const num_data_blocks, StateInteger const data_block_size,
+          yampi::communicator const& communicator, yampi::environment const& environment)
+        {
+          return ::ket::mpi::utility::detail::make_local_swap_qubit(
+            parallel_policy, local_state, permutation, unswappable_qubits, nullptr, permutated_local_swap_qubit,
+            num_data_blocks, data_block_size, communicator, environment);
+        }
       } // namespace detail
     } // namespace utility
   } // namespace mpi
@@ -0,0 +1,70 @@
+#ifndef KET_MPI_UTILITY_DETAIL_MAKE_NONPAGE_QUBITS_HPP
+# define KET_MPI_UTILITY_DETAIL_MAKE_NONPAGE_QUBITS_HPP
+
+# include <string>
+# include <iterator>
+
+# include <yampi/communicator.hpp>
+# include <yampi/environment.hpp>
+
+# include <ket/qubit.hpp>
+# include <ket/utility/contains.hpp>
+# include <ket/mpi/permutated.hpp>
+# include <ket/mpi/qubit_permutation.hpp>
+# include <ket/mpi/page/is_on_page.hpp>
+# include <ket/mpi/gate/page/unsupported_page_gate_operation.hpp>
+# include <ket/mpi/utility/simple_mpi.hpp>
+# include <ket/mpi/utility/detail/swap_permutated_local_qubits.hpp>
+
+
+namespace ket
+{
+  namespace mpi
+  {
+    namespace utility
+    {
+      namespace detail
+      {
+        // Swaps each page qubit in qubits, which should be local qubits, with the lowest nonpage qubit not in qubits,
+        // so that gates without page implementations, e.g. ::ket::gate::matrix, can be applied page by page.
+        // Throws ::ket::mpi::gate::page::unsupported_page_gate_operation if qubits do not fit in nonpage qubits
+        template <
+          typename MpiPolicy, typename ParallelPolicy, typename LocalState,
+          typename StateInteger, typename BitInteger, typename Allocator, typename Qubits>
+        inline void make_nonpage_qubits(
+          MpiPolicy const& mpi_policy, ParallelPolicy const parallel_policy,
+          LocalState& local_state,
+          ::ket::mpi::qubit_permutation<StateInteger, BitInteger, Allocator>& permutation,
+          Qubits const& qubits, std::string const& gate_name,
+          yampi::communicator const& communicator, yampi::environment const& environment)
+        {
+          for (auto const qubit: qubits)
+          {
+            auto const permutated_qubit = permutation[qubit];
+            if (not ::ket::mpi::page::is_on_page(permutated_qubit, local_state))
+              continue;
+
+            auto permutated_other_qubit = ::ket::mpi::make_permutated(::ket::make_qubit<StateInteger>(BitInteger{0u}));
+            using ::ket::mpi::inverse;
+            while (::ket::utility::contains(std::begin(qubits), std::end(qubits), inverse(permutation)[permutated_other_qubit]))
+              ++permutated_other_qubit;
+            if (::ket::mpi::page::is_on_page(permutated_other_qubit, local_state))
+              throw ::ket::mpi::gate::page::unsupported_page_gate_operation{gate_name};
+
+            auto const other_qubit = inverse(permutation)[permutated_other_qubit];
+            ::ket::mpi::utility::detail::swap_permutated_local_qubits(
+              parallel_policy, local_state, permutated_qubit, permutated_other_qubit,
+              static_cast<StateInteger>(::ket::mpi::utility::policy::num_data_blocks(mpi_policy, communicator, environment)),
+              static_cast<StateInteger>(::ket::mpi::utility::policy::data_block_size(mpi_policy, local_state, communicator, environment)),
+              communicator, environment);
+            using ::ket::mpi::permutate;
+            permutate(permutation, qubit, other_qubit);
+          }
+        }
+      } // namespace detail
+    } // namespace utility
+  } // namespace mpi
+} // namespace ket
+
+
+#endif // KET_MPI_UTILITY_DETAIL_MAKE_NONPAGE_QUBITS_HPP
@@ -0,0 +1,61 @@
+#ifndef KET_MPI_UTILITY_LOOKAHEAD_HPP
+# define KET_MPI_UTILITY_LOOKAHEAD_HPP
+
+# include <cassert>
+# include <cstddef>
+# include <vector>
+# include <algorithm>
+# include <iterator>
+# include <limits>
+
+
+namespace ket
+{
+  namespace mpi
+  {
+    namespace utility
+    {
+      // lookahead has, for each (unpermutated) qubit, indices of upcoming operations acting on the qubit.
+      // MPI policies having a pointer to lookahead choose local swap qubits which will not be used for the longest time (Belady's algorithm).
+      class lookahead
+      {
+        std::vector<std::vector<std::size_t>> operation_indices_; // operation_indices_[qubit] is sorted
+        std::size_t present_operation_index_;
+
+       public:
+        lookahead() : operation_indices_{}, present_operation_index_{0u} { }
+
+        explicit lookahead(std::size_t const num_qubits)
+          : operation_indices_(num_qubits), present_operation_index_{0u}
+        { }
+
+        std::size_t num_qubits() const noexcept { return operation_indices_.size(); }
+
+        // operation_index should not be less than operation indices added before
+        void add_use(std::size_t const qubit, std::size_t const operation_index)
+        {
+          assert(qubit < operation_indices_.size());
+          assert(operation_indices_[qubit].empty() or operation_indices_[qubit].back() <= operation_index);
+          operation_indices_[qubit].push_back(operation_index);
+        }
+
+        std::size_t present_operation_index() const noexcept { return present_operation_index_; }
+        void present_operation_index(std::size_t const operation_index) noexcept { present_operation_index_ = operation_index; }
+
+        // index of the first operation acting on qubit after the present operation, or std::numeric_limits<std::size_t>::max() if there is no such operation
+        std::size_t next_use(std::size_t const qubit) const
+        {
+          if (qubit >= operation_indices_.size())
+            return std::numeric_limits<std::size_t>::max();
+
+          auto const& indices = operation_indices_[qubit];
+          auto const found = std::upper_bound(std::begin(indices), std::end(indices), present_operation_index_);
+          return found == std::end(indices) ? std::numeric_limits<std::size_t>::max() : *found;
+        }
+      }; // class lookahead
+    } // namespace utility
+  } // namespace mpi
+} // namespace ket
+
+
+#endif // KET_MPI_UTILITY_LOOKAHEAD_HPP
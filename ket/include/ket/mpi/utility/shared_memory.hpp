@@ -0,0 +1,298 @@
+#ifndef KET_MPI_UTILITY_SHARED_MEMORY_HPP
+# define KET_MPI_UTILITY_SHARED_MEMORY_HPP
+
+# include <cassert>
+# include <cstddef>
+# include <vector>
+# include <algorithm>
+# include <iterator>
+# include <memory>
+# include <new>
+
+# include <mpi.h>
+
+# include <yampi/environment.hpp>
+# include <yampi/communicator.hpp>
+# include <yampi/rank.hpp>
+# include <yampi/buffer.hpp>
+# include <yampi/status.hpp>
+# include <yampi/algorithm/swap.hpp>
+
+# include <ket/mpi/utility/detail/check_mpi_error.hpp>
+
+
+namespace ket
+{
+  namespace mpi
+  {
+    namespace utility
+    {
+      namespace shared_memory_detail
+      {
+        inline MPI_Comm& node_communicator_storage()
+        {
+          static auto result = MPI_Comm{MPI_COMM_NULL};
+          return result;
+        }
+
+        // processes which can share memory with this process, which is created by ::ket::mpi::utility::create_node_communicator
+        inline MPI_Comm node_communicator()
+        {
+          auto const result = ::ket::mpi::utility::shared_memory_detail::node_communicator_storage();
+          assert(result != MPI_COMM_NULL);
+          return result;
+        }
+
+        // [first, last) of this process is in window, whose segments of other processes are given by MPI_Win_shared_query.
+        // node_ranks[r] is the rank in node_communicator() of rank r of communicator, or MPI_UNDEFINED if r is on another node
+        struct segment
+        {
+          char* first;
+          char* last;
+          MPI_Win window;
+          MPI_Comm communicator;
+          int node_rank;
+          std::vector<int> node_ranks;
+        }; // struct segment
+
+        inline std::vector<segment>& segments()
+        {
+          static auto result = std::vector<segment>{};
+          return result;
+        }
+
+        inline segment const* find_segment(void const* const pointer)
+        {
+          auto const& all_segments = ::ket::mpi::utility::shared_memory_detail::segments();
+          auto const found
+            = std::find_if(
+                std::begin(all_segments), std::end(all_segments),
+                [pointer](segment const& value)
+                { return static_cast<char const*>(pointer) >= value.first and static_cast<char const*>(pointer) < value.last; });
+          return found == std::end(all_segments) ? nullptr : std::addressof(*found);
+        }
+
+        // ranks of communicator are translated into ranks of node_communicator() only once here, not at each swap
+        inline std::vector<int> translate_ranks(MPI_Comm const communicator)
+        {
+          auto size = 0;
+          ::ket::mpi::utility::detail::check_mpi_error(MPI_Comm_size(communicator, std::addressof(size)), "MPI_Comm_size");
+          auto ranks = std::vector<int>(static_cast<std::size_t>(size));
+          for (auto rank = 0; rank < size; ++rank)
+            ranks[static_cast<std::size_t>(rank)] = rank;
+          auto result = std::vector<int>(static_cast<std::size_t>(size), MPI_UNDEFINED);
+
+          auto group = MPI_Group{};
+          ::ket::mpi::utility::detail::check_mpi_error(MPI_Comm_group(communicator, std::addressof(group)), "MPI_Comm_group");
+          auto node_group = MPI_Group{};
+          ::ket::mpi::utility::detail::check_mpi_error(
+            MPI_Comm_group(::ket::mpi::utility::shared_memory_detail::node_communicator(), std::addressof(node_group)),
+            "MPI_Comm_group");
+          ::ket::mpi::utility::detail::check_mpi_error(
+            MPI_Group_translate_ranks(group, size, ranks.data(), node_group, result.data()),
+            "MPI_Group_translate_ranks");
+          MPI_Group_free(std::addressof(node_group));
+          MPI_Group_free(std::addressof(group));
+          return result;
+        }
+
+        inline void* allocate(std::size_t const num_bytes, MPI_Comm const communicator)
+        {
+          auto const node_communicator = ::ket::mpi::utility::shared_memory_detail::node_communicator();
+
+          // each segment may be placed near the process owning it
+          auto info = MPI_Info{};
+          ::ket::mpi::utility::detail::check_mpi_error(MPI_Info_create(std::addressof(info)), "MPI_Info_create");
+          ::ket::mpi::utility::detail::check_mpi_error(
+            MPI_Info_set(info, "alloc_shared_noncontig", "true"), "MPI_Info_set");
+
+          auto result = static_cast<void*>(nullptr);
+          auto window = MPI_Win{};
+          ::ket::mpi::utility::detail::check_mpi_error(
+            MPI_Win_allocate_shared(
+              static_cast<MPI_Aint>(num_bytes), 1, info, node_communicator, std::addressof(result), std::addressof(window)),
+            "MPI_Win_allocate_shared");
+          MPI_Info_free(std::addressof(info));
+
+          // the passive target epoch is kept open until deallocation, so that MPI_Win_sync can be called at any time
+          ::ket::mpi::utility::detail::check_mpi_error(
+            MPI_Win_lock_all(MPI_MODE_NOCHECK, window), "MPI_Win_lock_all");
+
+          auto node_rank = 0;
+          ::ket::mpi::utility::detail::check_mpi_error(
+            MPI_Comm_rank(node_communicator, std::addressof(node_rank)), "MPI_Comm_rank");
+          ::ket::mpi::utility::shared_memory_detail::segments().push_back(
+            segment{
+              static_cast<char*>(result), static_cast<char*>(result) + num_bytes, window,
+              communicator, node_rank, ::ket::mpi::utility::shared_memory_detail::translate_ranks(communicator)});
+          return result;
+        }
+
+        inline void deallocate(void* const pointer) noexcept
+        {
+          auto& all_segments = ::ket::mpi::utility::shared_memory_detail::segments();
+          auto const found
+            = std::find_if(
+                std::begin(all_segments), std::end(all_segments),
+                [pointer](segment const& value) { return value.first == static_cast<char*>(pointer); });
+          assert(found != std::end(all_segments));
+
+          // errors cannot be thrown from deallocation, so they are only asserted
+          auto window = found->window;
+          all_segments.erase(found);
+          auto const unlock_result = MPI_Win_unlock_all(window);
+          assert(unlock_result == MPI_SUCCESS);
+          static_cast<void>(unlock_result);
+          auto const free_result = MPI_Win_free(std::addressof(window));
+          assert(free_result == MPI_SUCCESS);
+          static_cast<void>(free_result);
+        }
+
+        // handshake with target_rank, which sends value to target_rank and returns the value of target_rank.
+        // This also makes preceding writes to the shared memory visible to target_rank
+        inline unsigned long synchronize(
+          MPI_Win const window, unsigned long value, yampi::rank const target_rank,
+          yampi::communicator const& communicator, yampi::environment const& environment)
+        {
+          ::ket::mpi::utility::detail::check_mpi_error(MPI_Win_sync(window), "MPI_Win_sync");
+          auto target_value = 0ul;
+          yampi::algorithm::swap(
+            yampi::ignore_status, yampi::make_buffer(value), yampi::make_buffer(target_value),
+            target_rank, communicator, environment);
+          ::ket::mpi::utility::detail::check_mpi_error(MPI_Win_sync(window), "MPI_Win_sync");
+          return target_value;
+        }
+      } // namespace shared_memory_detail
+
+      // creates the communicator of processes on the same node by MPI_Comm_split_type if it has not been created yet.
+      // This is collective over MPI_COMM_WORLD, so call this in all processes before shared_memory_allocator allocates memory,
+      // e.g. in constructors of local states, not lazily in the allocation
+      inline void create_node_communicator()
+      {
+        auto& node_communicator = ::ket::mpi::utility::shared_memory_detail::node_communicator_storage();
+        if (node_communicator != MPI_COMM_NULL)
+          return;
+
+        ::ket::mpi::utility::detail::check_mpi_error(
+          MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, std::addressof(node_communicator)),
+          "MPI_Comm_split_type");
+      }
+
+      // frees the communicator created by create_node_communicator at the end of the scope, which must be
+      // after memory allocated by shared_memory_allocator is deallocated and before MPI_Finalize.
+      // Construct this after yampi::environment and before local states
+      class node_communicator_guard
+      {
+       public:
+        node_communicator_guard() = default;
+        ~node_communicator_guard() noexcept
+        {
+          auto& node_communicator = ::ket::mpi::utility::shared_memory_detail::node_communicator_storage();
+          if (node_communicator == MPI_COMM_NULL)
+            return;
+
+          auto const result = MPI_Comm_free(std::addressof(node_communicator));
+          assert(result == MPI_SUCCESS);
+          static_cast<void>(result);
+        }
+
+        node_communicator_guard(node_communicator_guard const&) = delete;
+        node_communicator_guard& operator=(node_communicator_guard const&) = delete;
+        node_communicator_guard(node_communicator_guard&&) = delete;
+        node_communicator_guard& operator=(node_communicator_guard&&) = delete;
+      }; // class node_communicator_guard
+
+      // shared_memory_allocator<T> allocates memory in an MPI-3 shared-memory window over the processes on the same node.
+      // Allocation and deallocation are collective over these processes, so this should be used only for containers
+      // allocated and deallocated at the same time in all processes, e.g. local state vectors whose size never changes.
+      // The memory is swapped by shared_memory_swap only with processes of the communicator given to the constructor
+      template <typename T>
+      class shared_memory_allocator
+      {
+        MPI_Comm communicator_;
+
+       public:
+        using value_type = T;
+
+        shared_memory_allocator() noexcept : communicator_{MPI_COMM_WORLD} { }
+        explicit shared_memory_allocator(yampi::communicator const& communicator) noexcept
+          : communicator_{communicator.mpi_comm()}
+        { }
+        template <typename U>
+        shared_memory_allocator(shared_memory_allocator<U> const& other) noexcept
+          : communicator_{other.mpi_comm()}
+        { }
+
+        MPI_Comm mpi_comm() const noexcept { return communicator_; }
+
+        T* allocate(std::size_t const n)
+        {
+          if (n > static_cast<std::size_t>(-1) / sizeof(T))
+            throw std::bad_alloc{};
+          return static_cast<T*>(::ket::mpi::utility::shared_memory_detail::allocate(n * sizeof(T), communicator_));
+        }
+
+        void deallocate(T* const pointer, std::size_t) noexcept
+        { ::ket::mpi::utility::shared_memory_detail::deallocate(pointer); }
+      }; // class shared_memory_allocator<T>
+
+      template <typename T, typename U>
+      inline bool operator==(shared_memory_allocator<T> const& lhs, shared_memory_allocator<U> const& rhs) noexcept
+      { return lhs.mpi_comm() == rhs.mpi_comm(); }
+
+      template <typename T, typename U>
+      inline bool operator!=(shared_memory_allocator<T> const& lhs, shared_memory_allocator<U> const& rhs) noexcept
+      { return not (lhs == rhs); }
+
+      // If [first, last) is allocated by shared_memory_allocator and target_rank is on the same node,
+      // [first, last) is swapped in place with the range given by target_rank to its own call of this function,
+      // which is the same pairing as MPI_Sendrecv of the two ranges, and true is returned.
+      // The two ranges may be at different offsets, e.g. the upper half of this process and the lower half of target_rank,
+      // so that their offsets are exchanged first. Each of the two processes swaps a half of the range.
+      // Otherwise nothing is done and false is returned.
+      template <typename Value>
+      inline bool shared_memory_swap(
+        Value* const first, Value* const last, yampi::rank const target_rank,
+        yampi::communicator const& communicator, yampi::environment const& environment)
+      {
+        assert(last >= first);
+        auto const segment = ::ket::mpi::utility::shared_memory_detail::find_segment(first);
+        if (segment == nullptr or segment->communicator != communicator.mpi_comm())
+          return false;
+
+        auto const node_target = segment->node_ranks[static_cast<std::size_t>(target_rank.mpi_rank())];
+        if (node_target == MPI_UNDEFINED)
+          return false;
+
+        auto target_segment_size = MPI_Aint{};
+        auto target_displacement_unit = 0;
+        auto target_segment_first = static_cast<void*>(nullptr);
+        ::ket::mpi::utility::detail::check_mpi_error(
+          MPI_Win_shared_query(
+            segment->window, node_target,
+            std::addressof(target_segment_size), std::addressof(target_displacement_unit), std::addressof(target_segment_first)),
+          "MPI_Win_shared_query");
+
+        // the target process must not be touching its range before the swap and must not read our range until the swap finishes
+        auto const offset = static_cast<unsigned long>(reinterpret_cast<char*>(first) - segment->first);
+        auto const target_offset
+          = ::ket::mpi::utility::shared_memory_detail::synchronize(segment->window, offset, target_rank, communicator, environment);
+        auto const target_first = reinterpret_cast<Value*>(static_cast<char*>(target_segment_first) + target_offset);
+        assert(reinterpret_cast<char*>(target_first + (last - first)) <= static_cast<char*>(target_segment_first) + target_segment_size);
+
+        auto const size = last - first;
+        auto const half_size = size / 2;
+        auto const is_lower = segment->node_rank < node_target;
+        auto const swap_offset = is_lower ? decltype(size){0} : half_size;
+        auto const count = is_lower ? half_size : size - half_size;
+        std::swap_ranges(first + swap_offset, first + swap_offset + count, target_first + swap_offset);
+
+        ::ket::mpi::utility::shared_memory_detail::synchronize(segment->window, 0ul, target_rank, communicator, environment);
+        return true;
+      }
+    } // namespace utility
+  } // namespace mpi
+} // namespace ket
+
+
+#endif // KET_MPI_UTILITY_SHARED_MEMORY_HPP
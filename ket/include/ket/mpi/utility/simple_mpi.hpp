@@ -13,6 +13,8 @@
 # include <utility>
 # include <array>
 # include <type_traits>
+# include <limits>
+# include <memory>
 
 # include <boost/range/value_type.hpp>
 # include <boost/range/size.hpp>
@@ -41,6 +43,7 @@
 #   include <ket/mpi/page/is_on_page.hpp>
 #   include <ket/mpi/page/none_on_page.hpp>
 # endif
+# include <ket/mpi/utility/lookahead.hpp>
 # include <ket/mpi/utility/detail/make_local_swap_qubit.hpp>
 # include <ket/mpi/utility/detail/interchange_qubits.hpp>
 # include <ket/mpi/utility/detail/for_each_in_diagonal_loop.hpp>
@@ -50,6 +53,12 @@
 #   include <ket/mpi/qubit_permutation_io.hpp>
 # endif
 
+// Maximal number of nonlocal qubits interchanged with local qubits at once
+// in ::ket::mpi::utility::maybe_interchange_qubits whose qubits are given by std::vector
+# ifndef KET_MPI_MAX_NUM_QUBITS_INTERCHANGED_AT_ONCE
+#   define KET_MPI_MAX_NUM_QUBITS_INTERCHANGED_AT_ONCE 4
+# endif // KET_MPI_MAX_NUM_QUBITS_INTERCHANGED_AT_ONCE
+
 
 namespace ket
 {
@@ -61,12 +70,25 @@ namespace ket
       {
         class simple_mpi
         {
+          ::ket::mpi::utility::lookahead const* maybe_lookahead_;
+
          public:
-          explicit simple_mpi() noexcept { }
+          explicit simple_mpi() noexcept : maybe_lookahead_{nullptr} { }
+
+          // lookahead should outlive this policy
+          explicit simple_mpi(::ket::mpi::utility::lookahead const& lookahead) noexcept
+            : maybe_lookahead_{std::addressof(lookahead)}
+          { }
+
+          // upcoming operations used to choose local swap qubits, or nullptr
+          ::ket::mpi::utility::lookahead const* maybe_lookahead() const noexcept { return maybe_lookahead_; }
         }; // class simple_mpi
 
         inline simple_mpi make_simple_mpi() noexcept { return simple_mpi();  }
 
+        inline simple_mpi make_simple_mpi(::ket::mpi::utility::lookahead const& lookahead) noexcept
+        { return simple_mpi{lookahead}; }
+
         namespace meta
         {
           template <typename T>
@@ -404,7 +426,7 @@ namespace ket
             for (auto index = std::size_t{0u}; index < num_qubits_of_operation; ++index)
             {
               if (permutated_global_swap_qubits[index] >= least_global_permutated_qubit)
-                return;
+                continue;
 
               call_lower_maybe_interchange_qubits(
                 index,
@@ -500,7 +522,7 @@ namespace ket
               local_swap_qubits[index]
                 = ::ket::mpi::utility::detail::make_local_swap_qubit(
                     parallel_policy, local_state, permutation,
-                    unswappable_qubits, permutated_local_swap_qubits[index],
+                    unswappable_qubits, mpi_policy.maybe_lookahead(), permutated_local_swap_qubits[index],
                     num_data_blocks, data_block_size, communicator, environment);
             }
 
@@ -1640,6 +1662,164 @@ namespace ket
           local_state, qubits, permutation, buffer, datatype, communicator, environment);
       }
 
+      namespace simple_mpi_detail
+      {
+        template <typename StateInteger, typename BitInteger, typename QubitAllocator>
+        inline std::array< ::ket::qubit<StateInteger, BitInteger>, std::numeric_limits<StateInteger>::digits >
+        make_unswappable_qubits(std::vector< ::ket::qubit<StateInteger, BitInteger>, QubitAllocator > const& qubits)
+        {
+          auto result = std::array< ::ket::qubit<StateInteger, BitInteger>, std::numeric_limits<StateInteger>::digits >{};
+          assert(not qubits.empty());
+          assert(qubits.size() <= result.size());
+
+          // unused elements are filled with the first qubit, which is unswappable anyway
+          std::fill(std::begin(result), std::end(result), qubits.front());
+          std::copy(std::begin(qubits), std::end(qubits), std::begin(result));
+          return result;
+        }
+
+        // nonlocal qubits in qubits, which would be interchanged with local qubits
+        template <
+          typename MpiPolicy, typename LocalState,
+          typename StateInteger, typename BitInteger, typename QubitAllocator, typename Allocator>
+        inline std::vector< ::ket::qubit<StateInteger, BitInteger> > nonlocal_qubits(
+          MpiPolicy const& mpi_policy, LocalState const& local_state,
+          std::vector< ::ket::qubit<StateInteger, BitInteger>, QubitAllocator > const& qubits,
+          ::ket::mpi::qubit_permutation<StateInteger, BitInteger, Allocator> const& permutation,
+          yampi::communicator const& communicator, yampi::environment const& environment)
+        {
+          using permutated_qubit_type = ::ket::mpi::permutated< ::ket::qubit<StateInteger, BitInteger> >;
+          auto const least_nonlocal_permutated_qubit
+            = permutated_qubit_type{::ket::mpi::utility::policy::num_local_qubits(mpi_policy, local_state, communicator, environment)};
+
+          auto result = std::vector< ::ket::qubit<StateInteger, BitInteger> >{};
+          result.reserve(qubits.size());
+          std::copy_if(
+            std::begin(qubits), std::end(qubits), std::back_inserter(result),
+            [&permutation, least_nonlocal_permutated_qubit](::ket::qubit<StateInteger, BitInteger> const qubit)
+            { return permutation[qubit] >= least_nonlocal_permutated_qubit; });
+          return result;
+        }
+
+        // Interchanges first num_qubits qubits of [qubits_first, ...) with local qubits at once, where num_qubits <= max_num_qubits.
+        // All of them are exchanged in one step, so that each amplitude is transferred at most once.
+        template <std::size_t max_num_qubits>
+        struct maybe_interchange_qubits_at_once
+        {
+          template <
+            typename MpiPolicy, typename ParallelPolicy, typename LocalState,
+            typename StateInteger, typename BitInteger, typename QubitIterator, std::size_t num_unswappable_qubits,
+            typename Allocator, typename BufferAllocator, typename... Arguments>
+          static void call(
+            std::size_t const num_qubits,
+            MpiPolicy const& mpi_policy, ParallelPolicy const parallel_policy,
+            LocalState& local_state, QubitIterator const qubits_first,
+            std::array< ::ket::qubit<StateInteger, BitInteger>, num_unswappable_qubits > const& unswappable_qubits,
+            ::ket::mpi::qubit_permutation<StateInteger, BitInteger, Allocator>& permutation,
+            std::vector<typename boost::range_value<LocalState>::type, BufferAllocator>& buffer,
+            Arguments&&... arguments)
+          {
+            assert(num_qubits <= max_num_qubits);
+            if (num_qubits < max_num_qubits)
+            {
+              ::ket::mpi::utility::simple_mpi_detail::maybe_interchange_qubits_at_once<max_num_qubits - 1u>::call(
+                num_qubits, mpi_policy, parallel_policy, local_state, qubits_first, unswappable_qubits,
+                permutation, buffer, std::forward<Arguments>(arguments)...);
+              return;
+            }
+
+            auto qubits = std::array< ::ket::qubit<StateInteger, BitInteger>, max_num_qubits >{};
+            std::copy(qubits_first, qubits_first + max_num_qubits, std::begin(qubits));
+
+            using maybe_interchange_qubits_impl
+              = ::ket::mpi::utility::dispatch::maybe_interchange_qubits<max_num_qubits, MpiPolicy>;
+            maybe_interchange_qubits_impl::call(
+              mpi_policy, parallel_policy,
+              local_state, qubits, unswappable_qubits, permutation, buffer, std::forward<Arguments>(arguments)...);
+          }
+        }; // struct maybe_interchange_qubits_at_once<max_num_qubits>
+
+        template <>
+        struct maybe_interchange_qubits_at_once<0u>
+        {
+          template <
+            typename MpiPolicy, typename ParallelPolicy, typename LocalState,
+            typename StateInteger, typename BitInteger, typename QubitIterator, std::size_t num_unswappable_qubits,
+            typename Allocator, typename BufferAllocator, typename... Arguments>
+          static void call(
+            std::size_t const, MpiPolicy const&, ParallelPolicy const, LocalState&, QubitIterator const,
+            std::array< ::ket::qubit<StateInteger, BitInteger>, num_unswappable_qubits > const&,
+            ::ket::mpi::qubit_permutation<StateInteger, BitInteger, Allocator>&,
+            std::vector<typename boost::range_value<LocalState>::type, BufferAllocator>&,
+            Arguments&&...)
+          { }
+        }; // struct maybe_interchange_qubits_at_once<0u>
+      } // namespace simple_mpi_detail
+
+      // The number of qubits is given at runtime: nonlocal qubits in qubits are interchanged with local qubits
+      // KET_MPI_MAX_NUM_QUBITS_INTERCHANGED_AT_ONCE qubits at a time,
+      // and qubits already brought into local qubits are never swapped out by the following interchanges.
+      template <
+        typename MpiPolicy, typename ParallelPolicy, typename LocalState,
+        typename StateInteger, typename BitInteger, typename QubitAllocator,
+        typename Allocator, typename BufferAllocator>
+      void maybe_interchange_qubits(
+        MpiPolicy const& mpi_policy, ParallelPolicy const parallel_policy,
+        LocalState& local_state,
+        std::vector< ::ket::qubit<StateInteger, BitInteger>, QubitAllocator > const& qubits,
+        ::ket::mpi::qubit_permutation<StateInteger, BitInteger, Allocator>& permutation,
+        std::vector<typename boost::range_value<LocalState>::type, BufferAllocator>& buffer,
+        yampi::communicator const& communicator,
+        yampi::environment const& environment)
+      {
+        assert(
+          static_cast<StateInteger>(qubits.size())
+          <= static_cast<StateInteger>(::ket::mpi::utility::policy::num_local_qubits(mpi_policy, local_state, communicator, environment)));
+
+        auto const unswappable_qubits = ::ket::mpi::utility::simple_mpi_detail::make_unswappable_qubits(qubits);
+        auto const nonlocal_qubits
+          = ::ket::mpi::utility::simple_mpi_detail::nonlocal_qubits(
+              mpi_policy, local_state, qubits, permutation, communicator, environment);
+
+        constexpr auto max_num_qubits = std::size_t{KET_MPI_MAX_NUM_QUBITS_INTERCHANGED_AT_ONCE};
+        for (auto first = std::size_t{0u}; first < nonlocal_qubits.size(); first += max_num_qubits)
+          ::ket::mpi::utility::simple_mpi_detail::maybe_interchange_qubits_at_once<max_num_qubits>::call(
+            std::min(max_num_qubits, nonlocal_qubits.size() - first),
+            mpi_policy, parallel_policy, local_state, std::begin(nonlocal_qubits) + first, unswappable_qubits,
+            permutation, buffer, communicator, environment);
+      }
+
+      template <
+        typename MpiPolicy, typename ParallelPolicy, typename LocalState,
+        typename StateInteger, typename BitInteger, typename QubitAllocator,
+        typename Allocator, typename BufferAllocator, typename DerivedDatatype>
+      void maybe_interchange_qubits(
+        MpiPolicy const& mpi_policy, ParallelPolicy const parallel_policy,
+        LocalState& local_state,
+        std::vector< ::ket::qubit<StateInteger, BitInteger>, QubitAllocator > const& qubits,
+        ::ket::mpi::qubit_permutation<StateInteger, BitInteger, Allocator>& permutation,
+        std::vector<typename boost::range_value<LocalState>::type, BufferAllocator>& buffer,
+        yampi::datatype_base<DerivedDatatype> const& datatype,
+        yampi::communicator const& communicator,
+        yampi::environment const& environment)
+      {
+        assert(
+          static_cast<StateInteger>(qubits.size())
+          <= static_cast<StateInteger>(::ket::mpi::utility::policy::num_local_qubits(mpi_policy, local_state, communicator, environment)));
+
+        auto const unswappable_qubits = ::ket::mpi::utility::simple_mpi_detail::make_unswappable_qubits(qubits);
+        auto const nonlocal_qubits
+          = ::ket::mpi::utility::simple_mpi_detail::nonlocal_qubits(
+              mpi_policy, local_state, qubits, permutation, communicator, environment);
+
+        constexpr auto max_num_qubits = std::size_t{KET_MPI_MAX_NUM_QUBITS_INTERCHANGED_AT_ONCE};
+        for (auto first = std::size_t{0u}; first < nonlocal_qubits.size(); first += max_num_qubits)
+          ::ket::mpi::utility::simple_mpi_detail::maybe_interchange_qubits_at_once<max_num_qubits>::call(
+            std::min(max_num_qubits, nonlocal_qubits.size() - first),
+            mpi_policy, parallel_policy, local_state, std::begin(nonlocal_qubits) + first, unswappable_qubits,
+            permutation, buffer, datatype, communicator, environment);
+      }
+
       template <typename MpiPolicy, typename LocalState, typename StateInteger>
       inline StateInteger rank_index_to_qubit_value(
         MpiPolicy const& mpi_policy, LocalState const& local_state, yampi::rank const rank, StateInteger const index)
@@ -0,0 +1,71 @@
+#ifndef KET_MPI_UTILITY_TOPOLOGY_HPP
+# define KET_MPI_UTILITY_TOPOLOGY_HPP
+
+# include <memory>
+
+# include <mpi.h>
+
+# include <yampi/environment.hpp>
+# include <yampi/communicator.hpp>
+
+# include <ket/mpi/utility/detail/check_mpi_error.hpp>
+
+
+namespace ket
+{
+  namespace mpi
+  {
+    namespace utility
+    {
+      // Processes of communicator are renumbered so that processes on the same node, which are found by MPI_Comm_split_type, have contiguous ranks.
+      // Then lower bits of ranks, i.e. lower global qubits of simple_mpi and unit_mpi policies, are exchanged within a node.
+      // Nodes are ordered by their lowest ranks, so that rank 0 is not changed.
+      // If the numbers of processes of all nodes are not the same, the order of processes is not changed.
+      inline yampi::communicator make_node_major_communicator(
+        yampi::communicator const& communicator, yampi::environment const& environment)
+      {
+        auto const rank = communicator.rank(environment).mpi_rank();
+
+        auto node_communicator = MPI_Comm{};
+        ::ket::mpi::utility::detail::check_mpi_error(
+          MPI_Comm_split_type(communicator.mpi_comm(), MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, std::addressof(node_communicator)),
+          "MPI_Comm_split_type");
+        auto node_rank = 0;
+        ::ket::mpi::utility::detail::check_mpi_error(
+          MPI_Comm_rank(node_communicator, std::addressof(node_rank)), "MPI_Comm_rank");
+        auto node_size = 0;
+        ::ket::mpi::utility::detail::check_mpi_error(
+          MPI_Comm_size(node_communicator, std::addressof(node_size)), "MPI_Comm_size");
+
+        // the process of node rank 0 has the lowest rank of its node, and node_index is its rank among such processes
+        auto leader_communicator = MPI_Comm{};
+        ::ket::mpi::utility::detail::check_mpi_error(
+          MPI_Comm_split(communicator.mpi_comm(), node_rank == 0 ? 0 : MPI_UNDEFINED, rank, std::addressof(leader_communicator)),
+          "MPI_Comm_split");
+        auto node_index = 0;
+        if (leader_communicator != MPI_COMM_NULL)
+        {
+          ::ket::mpi::utility::detail::check_mpi_error(
+            MPI_Comm_rank(leader_communicator, std::addressof(node_index)), "MPI_Comm_rank");
+          MPI_Comm_free(std::addressof(leader_communicator));
+        }
+        ::ket::mpi::utility::detail::check_mpi_error(
+          MPI_Bcast(std::addressof(node_index), 1, MPI_INT, 0, node_communicator), "MPI_Bcast");
+        MPI_Comm_free(std::addressof(node_communicator));
+
+        // min_max_node_sizes[0] is the minimum and -min_max_node_sizes[1] is the maximum
+        int const local_node_sizes[2] = {node_size, -node_size};
+        int min_max_node_sizes[2];
+        ::ket::mpi::utility::detail::check_mpi_error(
+          MPI_Allreduce(local_node_sizes, min_max_node_sizes, 2, MPI_INT, MPI_MIN, communicator.mpi_comm()),
+          "MPI_Allreduce");
+
+        auto const key = min_max_node_sizes[0] == -min_max_node_sizes[1] ? node_index * node_size + node_rank : rank;
+        return yampi::communicator{communicator, yampi::color{0}, key, environment};
+      }
+    } // namespace utility
+  } // namespace mpi
+} // namespace ket
+
+
+#endif // KET_MPI_UTILITY_TOPOLOGY_HPP
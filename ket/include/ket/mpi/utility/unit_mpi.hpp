@@ -7,6 +7,7 @@
 #   include <iostream>
 # endif
 # include <vector>
+# include <memory>
 # include <algorithm>
 # include <numeric>
 # include <iterator>
@@ -43,6 +44,7 @@
 #   include <ket/mpi/page/is_on_page.hpp>
 # endif
 # include <ket/mpi/utility/simple_mpi.hpp>
+# include <ket/mpi/utility/lookahead.hpp>
 # include <ket/mpi/utility/detail/make_local_swap_qubit.hpp>
 # include <ket/mpi/utility/detail/interchange_qubits.hpp>
 # include <ket/mpi/utility/detail/for_each_in_diagonal_loop.hpp>
@@ -111,6 +113,8 @@ namespace ket
           StateInteger num_data_blocks_in_process_b_; // k, num_data_blocks_in_process_a_ == num_data_blocks_in_process_b_ + 1;
           NumProcesses num_processes_a_per_unit_; // m, num_processes_b_per_unit_ == num_processes_per_unit_ - num_processes_a_per_unit_;
 
+          ::ket::mpi::utility::lookahead const* maybe_lookahead_;
+
          public:
           unit_mpi(BitInteger const num_unit_qubits, NumProcesses const num_processes_per_unit)
             : num_unit_qubits_{num_unit_qubits},
@@ -118,7 +122,8 @@ namespace ket
               num_data_blocks_in_process_b_{
                 ::ket::utility::integer_exp2<StateInteger>(num_unit_qubits) / static_cast<StateInteger>(num_processes_per_unit)},
               num_processes_a_per_unit_{
-                ::ket::utility::integer_exp2<NumProcesses>(num_unit_qubits) % num_processes_per_unit}
+                ::ket::utility::integer_exp2<NumProcesses>(num_unit_qubits) % num_processes_per_unit},
+              maybe_lookahead_{nullptr}
           {
             assert(num_unit_qubits >= BitInteger{1u});
             assert(
@@ -126,6 +131,13 @@ namespace ket
               and num_processes_per_unit <= ::ket::utility::integer_exp2<NumProcesses>(num_unit_qubits));
           }
 
+          // lookahead should outlive this policy
+          unit_mpi(
+            BitInteger const num_unit_qubits, NumProcesses const num_processes_per_unit,
+            ::ket::mpi::utility::lookahead const& lookahead)
+            : unit_mpi{num_unit_qubits, num_processes_per_unit}
+          { maybe_lookahead_ = std::addressof(lookahead); }
+
           // K
           BitInteger const& num_unit_qubits() const noexcept { return num_unit_qubits_; }
           // n_u
@@ -135,6 +147,9 @@ namespace ket
           StateInteger const& num_data_blocks_in_process_b() const noexcept { return num_data_blocks_in_process_b_; }
           // m
           NumProcesses const& num_processes_a_per_unit() const noexcept { return num_processes_a_per_unit_; }
+
+          // upcoming operations used to choose local swap qubits, or nullptr
+          ::ket::mpi::utility::lookahead const* maybe_lookahead() const noexcept { return maybe_lookahead_; }
         }; // class unit_mpi<StateInteger, BitInteger, NumProcesses>
 
         template <typename StateInteger, typename BitInteger, typename NumProcesses>
@@ -142,6 +157,12 @@ namespace ket
           BitInteger const num_unit_qubits, NumProcesses const num_unit_processes) noexcept
         { return { num_unit_qubits, num_unit_processes }; }
 
+        template <typename StateInteger, typename BitInteger, typename NumProcesses>
+        inline ::ket::mpi::utility::policy::unit_mpi<StateInteger, BitInteger, NumProcesses> make_unit_mpi(
+          BitInteger const num_unit_qubits, NumProcesses const num_unit_processes,
+          ::ket::mpi::utility::lookahead const& lookahead) noexcept
+        { return { num_unit_qubits, num_unit_processes, lookahead }; }
+
         namespace meta
         {
           template <typename T>
@@ -732,7 +753,7 @@ namespace ket
               local_swap_qubits[index]
                 = ::ket::mpi::utility::detail::make_local_swap_qubit(
                     parallel_policy, local_state, permutation,
-                    unswappable_qubits, permutated_local_swap_qubits[index],
+                    unswappable_qubits, mpi_policy.maybe_lookahead(), permutated_local_swap_qubits[index],
                     num_data_blocks, data_block_size, communicator, environment);
             }
 
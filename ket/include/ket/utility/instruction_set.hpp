@@ -0,0 +1,36 @@
+#ifndef KET_UTILITY_INSTRUCTION_SET_HPP
+# define KET_UTILITY_INSTRUCTION_SET_HPP
+
+
+namespace ket
+{
+  namespace utility
+  {
+    enum class instruction_set : int { scalar, avx2, avx512 };
+
+    namespace instruction_set_detail
+    {
+      inline ::ket::utility::instruction_set detect_instruction_set()
+      {
+# if !defined(KET_NO_SIMD) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f"))
+          return ::ket::utility::instruction_set::avx512;
+        if (__builtin_cpu_supports("avx2") and __builtin_cpu_supports("fma"))
+          return ::ket::utility::instruction_set::avx2;
+# endif // !defined(KET_NO_SIMD) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+        return ::ket::utility::instruction_set::scalar;
+      }
+    } // namespace instruction_set_detail
+
+    // the widest SIMD instruction set supported by the running CPU, which is checked by CPUID only once
+    inline ::ket::utility::instruction_set supported_instruction_set()
+    {
+      static auto const result = ::ket::utility::instruction_set_detail::detect_instruction_set();
+      return result;
+    }
+  } // namespace utility
+} // namespace ket
+
+
+#endif // KET_UTILITY_INSTRUCTION_SET_HPP
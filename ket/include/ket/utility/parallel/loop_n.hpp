@@ -6,13 +6,12 @@
 # include <iterator>
 # include <numeric>
 # include <utility>
-# include <mutex> // lock_guard and unique_lock; mutex unless using OpenMP
+# include <mutex> // lock_guard
 # if defined(_OPENMP) && defined(KET_USE_OPENMP)
 #   include <stdexcept>
 # else // defined(_OPENMP) && defined(KET_USE_OPENMP)
 #   include <thread>
-#   include <future>
-#   include <condition_variable>
+#   include <atomic>
 # endif // defined(_OPENMP) && defined(KET_USE_OPENMP)
 # include <type_traits>
 
@@ -23,6 +22,10 @@
 # endif // defined(_OPENMP) && defined(KET_USE_OPENMP)
 
 # include <ket/utility/loop_n.hpp>
+# include <ket/utility/per_thread.hpp>
+# if !(defined(_OPENMP) && defined(KET_USE_OPENMP))
+#   include <ket/utility/parallel/thread_pool.hpp>
+# endif // !(defined(_OPENMP) && defined(KET_USE_OPENMP))
 
 
 namespace ket
@@ -211,41 +214,25 @@ namespace ket
 
           auto const num_threads
             = static_cast<NumThreads>(::ket::utility::num_threads(parallel_policy));
-          auto const num_futures = num_threads - NumThreads{1u};
-          auto futures = std::vector<std::future<void>>{};
-          futures.reserve(num_futures);
-
           auto const local_num_counts = static_cast<NumThreads>(n) / num_threads;
           auto const remainder = static_cast<NumThreads>(n) % num_threads;
-          auto first_count = Integer{0};
-
-          for (auto thread_index = NumThreads{0u}; thread_index < num_futures; ++thread_index)
-          {
-            auto const last_count
-              = static_cast<Integer>(
-                  local_num_counts * (thread_index + NumThreads{1u})
-                  + std::min(remainder, thread_index + NumThreads{1u}));
-
-            futures.push_back(std::async(
-              std::launch::async,
-              [&function, first_count, last_count, thread_index]
-              {
-                for (auto count = first_count; count < last_count; ++count)
-                  function(count, static_cast<int>(thread_index));
-              }));
 
-            first_count = last_count;
-          }
-
-          auto const last_count
-            = static_cast<Integer>(
-                local_num_counts * num_threads + std::min(remainder, num_threads));
-
-          for (auto count = first_count; count < last_count; ++count)
-            std::forward<Function>(function)(count, static_cast<int>(num_futures));
-
-          for (auto const& future: futures)
-            future.wait();
+          // Each thread takes a contiguous block of counts ordered by thread_index, which inclusive_scan relies on
+          ::ket::utility::thread_pool::instance().run(
+            static_cast<int>(num_threads),
+            [&function, local_num_counts, remainder](int const thread_index)
+            {
+              auto const index = static_cast<NumThreads>(thread_index);
+              auto const first_count
+                = static_cast<Integer>(local_num_counts * index + std::min(remainder, index));
+              auto const last_count
+                = static_cast<Integer>(
+                    local_num_counts * (index + NumThreads{1u})
+                    + std::min(remainder, index + NumThreads{1u}));
+
+              for (auto count = first_count; count < last_count; ++count)
+                function(count, thread_index);
+            });
         }
       }; // struct loop_n< ::ket::utility::policy::parallel<NumThreads>, Integer >
 # endif // defined(_OPENMP) && defined(KET_USE_OPENMP)
@@ -343,9 +330,8 @@ namespace ket
       template <typename NumThreads>
       class execute< ::ket::utility::policy::parallel<NumThreads> >
       {
-        std::mutex mutex_;
-        std::condition_variable cond_;
-        std::vector<int> barrier_counters_;
+        ::ket::utility::spin_barrier barrier_;
+        std::atomic<int> num_single_arrivals_;
 
         typedef ::ket::utility::policy::parallel<NumThreads> parallel_policy_type;
         friend class loop_n_in_execute<parallel_policy_type>;
@@ -354,8 +340,8 @@ namespace ket
 
        public:
         execute()
-          : mutex_{}, cond_{}, barrier_counters_{}
-        { barrier_counters_.reserve(64); }
+          : barrier_{}, num_single_arrivals_{0}
+        { }
 
         template <typename Function>
         void invoke(
@@ -364,26 +350,13 @@ namespace ket
         {
           assert(::ket::utility::num_threads(parallel_policy) > 0u);
 
-          auto const num_threads
-            = static_cast<NumThreads>(::ket::utility::num_threads(parallel_policy));
-          barrier_counters_.push_back(num_threads);
-
-          auto const num_futures = num_threads - NumThreads{1u};
-          auto futures = std::vector<std::future<void>>{};
-          futures.reserve(num_futures);
-
-          for (auto thread_index = NumThreads{0u}; thread_index < num_futures; ++thread_index)
-          {
-            futures.push_back(std::async(
-              std::launch::async,
-              [&function, thread_index, this]
-              { function(static_cast<int>(thread_index), *this); }));
-          }
-
-          std::forward<Function>(function)(static_cast<int>(num_futures), *this);
+          auto const num_threads = static_cast<int>(::ket::utility::num_threads(parallel_policy));
+          barrier_.reset(num_threads);
+          num_single_arrivals_.store(0, std::memory_order_relaxed);
 
-          for (auto const& future: futures)
-            future.wait();
+          ::ket::utility::thread_pool::instance().run(
+            num_threads,
+            [&function, this](int const thread_index) { function(thread_index, *this); });
         }
       }; // class execute< ::ket::utility::policy::parallel<NumThreads> >
 
@@ -418,27 +391,9 @@ namespace ket
       struct barrier< ::ket::utility::policy::parallel<NumThreads> >
       {
         static void call(
-          ::ket::utility::policy::parallel<NumThreads> const parallel_policy,
+          ::ket::utility::policy::parallel<NumThreads> const,
           ::ket::utility::dispatch::execute< ::ket::utility::policy::parallel<NumThreads> >& executor)
-        {
-          auto const index
-            = static_cast<std::size_t>(executor.barrier_counters_.size()) - std::size_t{1u};
-
-          if (executor.barrier_counters_[index] == 1)
-          {
-            std::lock_guard<std::mutex> lock{executor.mutex_};
-            executor.barrier_counters_.push_back(
-              static_cast<int>(::ket::utility::num_threads(parallel_policy)));
-            --executor.barrier_counters_[index];
-            executor.cond_.notify_all();
-            return;
-          }
-
-          auto lock = std::unique_lock<std::mutex>{executor.mutex_};
-          --executor.barrier_counters_[index];
-          executor.cond_.wait(
-            lock, [&executor, index] { return executor.barrier_counters_[index] == 0; });
-        }
+        { executor.barrier_.arrive_and_wait(); }
       }; // struct barrier< ::ket::utility::policy::parallel<NumThreads> >
 
       template <typename NumThreads>
@@ -450,30 +405,13 @@ namespace ket
           ::ket::utility::dispatch::execute< ::ket::utility::policy::parallel<NumThreads> >& executor,
           Function&& function)
         {
-          auto const index
-            = static_cast<std::size_t>(executor.barrier_counters_.size()) - std::size_t{1u};
-
-          if (executor.barrier_counters_[index]
-              == static_cast<int>(::ket::utility::num_threads(parallel_policy)))
-          {
-            std::lock_guard<std::mutex> lock{executor.mutex_};
+          // The first thread arriving at this single_execute calls function, and the others wait at the barrier.
+          // Every thread passes the barrier before the next single_execute, so arrivals come in multiples of num_threads.
+          auto const num_threads = static_cast<int>(::ket::utility::num_threads(parallel_policy));
+          if (executor.num_single_arrivals_.fetch_add(1, std::memory_order_relaxed) % num_threads == 0)
             function();
-          }
-
-          if (executor.barrier_counters_[index] == 1)
-          {
-            std::lock_guard<std::mutex> lock{executor.mutex_};
-            executor.barrier_counters_.push_back(
-              static_cast<int>(::ket::utility::num_threads(parallel_policy)));
-            --executor.barrier_counters_[index];
-            executor.cond_.notify_all();
-            return;
-          }
 
-          auto lock = std::unique_lock<std::mutex>{executor.mutex_};
-          --executor.barrier_counters_[index];
-          executor.cond_.wait(
-            lock, [&executor, index] { return executor.barrier_counters_[index] == 0; });
+          executor.barrier_.arrive_and_wait();
         }
       }; // struct single_execute< ::ket::utility::policy::parallel<NumThreads> >
 # endif // defined(_OPENMP) && defined(KET_USE_OPENMP)
@@ -493,29 +431,25 @@ namespace ket
           std::forward_iterator_tag const)
         {
           auto is_calleds
-            = std::vector<int>(
-                static_cast<int>(::ket::utility::num_threads(parallel_policy)),
-                static_cast<int>(false));
+            = ::ket::utility::per_thread<int>(parallel_policy, static_cast<int>(false));
           auto iters
-            = std::vector<ForwardIterator>(::ket::utility::num_threads(parallel_policy));
-          auto is_calleds_first = std::begin(is_calleds);
-          auto iters_first = std::begin(iters);
+            = ::ket::utility::per_thread<ForwardIterator>(parallel_policy);
 
           using ::ket::utility::loop_n;
           using difference_type
             = typename std::iterator_traits<ForwardIterator>::difference_type;
           loop_n(
             parallel_policy, std::distance(first, last),
-            [first, &value, is_calleds_first, iters_first](
+            [first, &value, &is_calleds, &iters](
               difference_type const n, int const thread_index)
             {
-              if (not static_cast<bool>(is_calleds_first[thread_index]))
+              if (not static_cast<bool>(is_calleds[thread_index]))
               {
-                iters_first[thread_index] = first;
-                std::advance(iters_first[thread_index], n);
-                is_calleds_first[thread_index] = static_cast<int>(true);
+                iters[thread_index] = first;
+                std::advance(iters[thread_index], n);
+                is_calleds[thread_index] = static_cast<int>(true);
               }
-              *iters_first[thread_index]++ = value;
+              *iters[thread_index]++ = value;
             });
         }
 
@@ -548,40 +482,32 @@ namespace ket
           ForwardIterator const first, ForwardIterator const last,
           std::forward_iterator_tag const)
         {
-          auto is_calleds
-            = std::vector<int>(
-                ::ket::utility::num_threads(parallel_policy), static_cast<int>(false));
-          auto iters
-            = std::vector<ForwardIterator>(::ket::utility::num_threads(parallel_policy));
+          auto is_calleds = ::ket::utility::per_thread<int>(parallel_policy, static_cast<int>(false));
+          auto iters = ::ket::utility::per_thread<ForwardIterator>(parallel_policy);
           using value_type = typename std::iterator_traits<ForwardIterator>::value_type;
-          auto partial_sums
-            = std::vector<value_type>(::ket::utility::num_threads(parallel_policy));
-
-          auto is_calleds_first = std::begin(is_calleds);
-          auto iters_first = std::begin(iters);
-          auto partial_sums_first = std::begin(partial_sums);
+          auto partial_sums = ::ket::utility::per_thread<value_type>(parallel_policy);
 
           using ::ket::utility::loop_n;
           using difference_type
             = typename std::iterator_traits<ForwardIterator>::difference_type;
           loop_n(
             parallel_policy, std::distance(first, last),
-            [first, is_calleds_first, iters_first, partial_sums_first](
+            [first, &is_calleds, &iters, &partial_sums](
               difference_type const n, int const thread_index)
             {
-              if (not is_calleds_first[thread_index])
+              if (not is_calleds[thread_index])
               {
-                iters_first[thread_index] = first;
-                std::advance(iters_first[thread_index], n);
+                iters[thread_index] = first;
+                std::advance(iters[thread_index], n);
 
-                partial_sums_first[thread_index] = *iters_first[thread_index]++;
-                is_calleds_first[thread_index] = static_cast<int>(true);
+                partial_sums[thread_index] = *iters[thread_index]++;
+                is_calleds[thread_index] = static_cast<int>(true);
               }
               else
-                partial_sums_first[thread_index] += *iters_first[thread_index]++;
+                partial_sums[thread_index] += *iters[thread_index]++;
             });
 
-          return std::accumulate(std::next(partial_sums_first), std::end(partial_sums), *partial_sums_first);
+          return partial_sums.reduce();
         }
 
         template <typename RandomAccessIterator>
@@ -590,34 +516,28 @@ namespace ket
           RandomAccessIterator const first, RandomAccessIterator const last,
           std::random_access_iterator_tag const)
         {
-          auto is_calleds
-            = std::vector<int>(
-                ::ket::utility::num_threads(parallel_policy), static_cast<int>(false));
+          auto is_calleds = ::ket::utility::per_thread<int>(parallel_policy, static_cast<int>(false));
           using value_type
             = typename std::iterator_traits<RandomAccessIterator>::value_type;
-          auto partial_sums
-            = std::vector<value_type>(::ket::utility::num_threads(parallel_policy));
-
-          auto is_calleds_first = std::begin(is_calleds);
-          auto partial_sums_first = std::begin(partial_sums);
+          auto partial_sums = ::ket::utility::per_thread<value_type>(parallel_policy);
 
           using ::ket::utility::loop_n;
           using difference_type
             = typename std::iterator_traits<RandomAccessIterator>::difference_type;
           loop_n(
             parallel_policy, last - first,
-            [first, is_calleds_first, partial_sums_first](difference_type const n, int const thread_index)
+            [first, &is_calleds, &partial_sums](difference_type const n, int const thread_index)
             {
-              if (not is_calleds_first[thread_index])
+              if (not is_calleds[thread_index])
               {
-                partial_sums_first[thread_index] = first[n];
-                is_calleds_first[thread_index] = static_cast<int>(true);
+                partial_sums[thread_index] = first[n];
+                is_calleds[thread_index] = static_cast<int>(true);
               }
               else
-                partial_sums_first[thread_index] += first[n];
+                partial_sums[thread_index] += first[n];
             });
 
-          return std::accumulate(std::next(partial_sums_first), std::end(partial_sums), *partial_sums_first);
+          return partial_sums.reduce();
         }
 
         template <typename ForwardIterator, typename Value>
@@ -626,38 +546,31 @@ namespace ket
           ForwardIterator const first, ForwardIterator const last, Value const initial_value,
           std::forward_iterator_tag const)
         {
-          auto is_calleds
-            = std::vector<int>(
-                ::ket::utility::num_threads(parallel_policy), static_cast<int>(false));
-          auto iters
-            = std::vector<ForwardIterator>(::ket::utility::num_threads(parallel_policy));
-          auto partial_sums = std::vector<Value>(::ket::utility::num_threads(parallel_policy));
-
-          auto is_calleds_first = std::begin(is_calleds);
-          auto iters_first = std::begin(iters);
-          auto partial_sums_first = std::begin(partial_sums);
+          auto is_calleds = ::ket::utility::per_thread<int>(parallel_policy, static_cast<int>(false));
+          auto iters = ::ket::utility::per_thread<ForwardIterator>(parallel_policy);
+          auto partial_sums = ::ket::utility::per_thread<Value>(parallel_policy);
 
           using ::ket::utility::loop_n;
           using difference_type
             = typename std::iterator_traits<ForwardIterator>::difference_type;
           loop_n(
             parallel_policy, std::distance(first, last),
-            [first, is_calleds_first, iters_first, partial_sums_first](
+            [first, &is_calleds, &iters, &partial_sums](
               difference_type const n, int const thread_index)
             {
-              if (not is_calleds_first[thread_index])
+              if (not is_calleds[thread_index])
               {
-                iters_first[thread_index] = first;
-                std::advance(iters_first[thread_index], n);
+                iters[thread_index] = first;
+                std::advance(iters[thread_index], n);
 
-                partial_sums_first[thread_index] = *iters_first[thread_index]++;
-                is_calleds_first[thread_index] = static_cast<int>(true);
+                partial_sums[thread_index] = *iters[thread_index]++;
+                is_calleds[thread_index] = static_cast<int>(true);
               }
               else
-                partial_sums_first[thread_index] += *iters_first[thread_index]++;
+                partial_sums[thread_index] += *iters[thread_index]++;
             });
 
-          return std::accumulate(partial_sums_first, std::end(partial_sums), initial_value);
+          return initial_value + partial_sums.reduce();
         }
 
         template <typename RandomAccessIterator, typename Value>
@@ -666,32 +579,27 @@ namespace ket
           RandomAccessIterator const first, RandomAccessIterator const last, Value const initial_value,
           std::random_access_iterator_tag const)
         {
-          auto is_calleds
-            = std::vector<int>(
-                ::ket::utility::num_threads(parallel_policy), static_cast<int>(false));
-          auto partial_sums = std::vector<Value>(::ket::utility::num_threads(parallel_policy));
-
-          auto is_calleds_first = std::begin(is_calleds);
-          auto partial_sums_first = std::begin(partial_sums);
+          auto is_calleds = ::ket::utility::per_thread<int>(parallel_policy, static_cast<int>(false));
+          auto partial_sums = ::ket::utility::per_thread<Value>(parallel_policy);
 
           using ::ket::utility::loop_n;
           using difference_type
             = typename std::iterator_traits<RandomAccessIterator>::difference_type;
           loop_n(
             parallel_policy, last - first,
-            [first, is_calleds_first, partial_sums_first](
+            [first, &is_calleds, &partial_sums](
               difference_type const n, int const thread_index)
             {
-              if (not is_calleds_first[thread_index])
+              if (not is_calleds[thread_index])
               {
-                partial_sums_first[thread_index] = first[n];
-                is_calleds_first[thread_index] = static_cast<int>(true);
+                partial_sums[thread_index] = first[n];
+                is_calleds[thread_index] = static_cast<int>(true);
               }
               else
-                partial_sums_first[thread_index] += first[n];
+                partial_sums[thread_index] += first[n];
             });
 
-          return std::accumulate(partial_sums_first, std::end(partial_sums), initial_value);
+          return initial_value + partial_sums.reduce();
         }
 
         template <typename ForwardIterator, typename Value, typename BinaryOperation>
@@ -701,16 +609,9 @@ namespace ket
           Value const initial_value, BinaryOperation binary_operation,
           std::forward_iterator_tag const)
         {
-          auto is_calleds
-            = std::vector<int>(
-                ::ket::utility::num_threads(parallel_policy), static_cast<int>(false));
-          auto iters
-            = std::vector<ForwardIterator>(::ket::utility::num_threads(parallel_policy));
-          auto partial_sums = std::vector<Value>(::ket::utility::num_threads(parallel_policy));
-
-          auto is_calleds_first = std::begin(is_calleds);
-          auto iters_first = std::begin(iters);
-          auto partial_sums_first = std::begin(partial_sums);
+          auto is_calleds = ::ket::utility::per_thread<int>(parallel_policy, static_cast<int>(false));
+          auto iters = ::ket::utility::per_thread<ForwardIterator>(parallel_policy);
+          auto partial_sums = ::ket::utility::per_thread<Value>(parallel_policy);
 
           using ::ket::utility::loop_n;
           using difference_type
@@ -718,24 +619,24 @@ namespace ket
           loop_n(
             parallel_policy, std::distance(first, last),
             [first, initial_value, binary_operation,
-             is_calleds_first, iters_first, partial_sums_first](
+             &is_calleds, &iters, &partial_sums](
               difference_type const n, int const thread_index)
             {
-              if (not is_calleds_first[thread_index])
+              if (not is_calleds[thread_index])
               {
-                iters_first[thread_index] = first;
-                std::advance(iters_first[thread_index], n);
+                iters[thread_index] = first;
+                std::advance(iters[thread_index], n);
 
-                partial_sums_first[thread_index] = *iters_first[thread_index]++;
-                is_calleds_first[thread_index] = static_cast<int>(true);
+                partial_sums[thread_index] = *iters[thread_index]++;
+                is_calleds[thread_index] = static_cast<int>(true);
               }
               else
-                partial_sums_first[thread_index]
+                partial_sums[thread_index]
                   = binary_operation(
-                      partial_sums_first[thread_index], *iters_first[thread_index]++);
+                      partial_sums[thread_index], *iters[thread_index]++);
             });
 
-          return std::accumulate(partial_sums_first, std::end(partial_sums), initial_value, binary_operation);
+          return binary_operation(initial_value, partial_sums.reduce(binary_operation));
         }
 
         template <typename RandomAccessIterator, typename Value, typename BinaryOperation>
@@ -745,33 +646,28 @@ namespace ket
           Value const initial_value, BinaryOperation binary_operation,
           std::random_access_iterator_tag const)
         {
-          auto is_calleds
-            = std::vector<int>(
-                ::ket::utility::num_threads(parallel_policy), static_cast<int>(false));
-          auto partial_sums = std::vector<Value>(::ket::utility::num_threads(parallel_policy));
-
-          auto is_calleds_first = std::begin(is_calleds);
-          auto partial_sums_first = std::begin(partial_sums);
+          auto is_calleds = ::ket::utility::per_thread<int>(parallel_policy, static_cast<int>(false));
+          auto partial_sums = ::ket::utility::per_thread<Value>(parallel_policy);
 
           using ::ket::utility::loop_n;
           using difference_type
             = typename std::iterator_traits<RandomAccessIterator>::difference_type;
           loop_n(
             parallel_policy, last - first,
-            [first, binary_operation, is_calleds_first, partial_sums_first](
+            [first, binary_operation, &is_calleds, &partial_sums](
               difference_type const n, int const thread_index)
             {
-              if (not is_calleds_first[thread_index])
+              if (not is_calleds[thread_index])
               {
-                partial_sums_first[thread_index] = first[n];
-                is_calleds_first[thread_index] = static_cast<int>(true);
+                partial_sums[thread_index] = first[n];
+                is_calleds[thread_index] = static_cast<int>(true);
               }
               else
-                partial_sums_first[thread_index]
-                  = binary_operation(partial_sums_first[thread_index], first[n]);
+                partial_sums[thread_index]
+                  = binary_operation(partial_sums[thread_index], first[n]);
             });
 
-          return std::accumulate(partial_sums_first, std::end(partial_sums), initial_value, binary_operation);
+          return binary_operation(initial_value, partial_sums.reduce(binary_operation));
         }
       }; // struct reduce< ::ket::utility::policy::parallel<NumThreads> >
     } // namespace dispatch
@@ -790,45 +686,35 @@ namespace ket
           ForwardIterator2 const first2, Value const initial_value,
           std::forward_iterator_tag const, std::forward_iterator_tag const)
         {
-          auto is_calleds
-            = std::vector<int>(
-                ::ket::utility::num_threads(parallel_policy), static_cast<int>(false));
-          auto iters1
-            = std::vector<ForwardIterator1>(::ket::utility::num_threads(parallel_policy));
-          auto iters2
-            = std::vector<ForwardIterator2>(::ket::utility::num_threads(parallel_policy));
-          auto partial_sums
-            = std::vector<Value>(::ket::utility::num_threads(parallel_policy));
-
-          auto is_calleds_first = std::begin(is_calleds);
-          auto iters1_first = std::begin(iters1);
-          auto iters2_first = std::begin(iters2);
-          auto partial_sums_first = std::begin(partial_sums);
+          auto is_calleds = ::ket::utility::per_thread<int>(parallel_policy, static_cast<int>(false));
+          auto iters1 = ::ket::utility::per_thread<ForwardIterator1>(parallel_policy);
+          auto iters2 = ::ket::utility::per_thread<ForwardIterator2>(parallel_policy);
+          auto partial_sums = ::ket::utility::per_thread<Value>(parallel_policy);
 
           using ::ket::utility::loop_n;
           using difference_type
             = typename std::iterator_traits<ForwardIterator1>::difference_type;
           loop_n(
             parallel_policy, std::distance(first1, last1),
-            [first1, first2, is_calleds_first, iters1_first, iters2_first, partial_sums_first](
+            [first1, first2, &is_calleds, &iters1, &iters2, &partial_sums](
               difference_type const n, int const thread_index)
             {
-              if (not is_calleds_first[thread_index])
+              if (not is_calleds[thread_index])
               {
-                iters1_first[thread_index] = first1;
-                std::advance(iters1_first[thread_index], n);
+                iters1[thread_index] = first1;
+                std::advance(iters1[thread_index], n);
 
-                iters2_first[thread_index] = first2;
-                std::advance(iters2_first[thread_index], n);
+                iters2[thread_index] = first2;
+                std::advance(iters2[thread_index], n);
 
-                partial_sums_first[thread_index] = *iters1_first[thread_index]++ * *iters2_first[thread_index]++;
-                is_calleds_first[thread_index] = static_cast<int>(true);
+                partial_sums[thread_index] = *iters1[thread_index]++ * *iters2[thread_index]++;
+                is_calleds[thread_index] = static_cast<int>(true);
               }
               else
-                partial_sums_first[thread_index] += *iters1_first[thread_index]++ * *iters2_first[thread_index]++;
+                partial_sums[thread_index] += *iters1[thread_index]++ * *iters2[thread_index]++;
             });
 
-          return std::accumulate(partial_sums_first, std::end(partial_sums), initial_value);
+          return initial_value + partial_sums.reduce();
         }
 
         template <typename RandomAccessIterator, typename ForwardIterator, typename Value>
@@ -838,39 +724,31 @@ namespace ket
           ForwardIterator const first2, Value const initial_value,
           std::random_access_iterator_tag const, std::forward_iterator_tag const)
         {
-          auto is_calleds
-            = std::vector<int>(
-                ::ket::utility::num_threads(parallel_policy), static_cast<int>(false));
-          auto iters2
-            = std::vector<ForwardIterator>(::ket::utility::num_threads(parallel_policy));
-          auto partial_sums
-            = std::vector<Value>(::ket::utility::num_threads(parallel_policy));
-
-          auto is_calleds_first = std::begin(is_calleds);
-          auto iters2_first = std::begin(iters2);
-          auto partial_sums_first = std::begin(partial_sums);
+          auto is_calleds = ::ket::utility::per_thread<int>(parallel_policy, static_cast<int>(false));
+          auto iters2 = ::ket::utility::per_thread<ForwardIterator>(parallel_policy);
+          auto partial_sums = ::ket::utility::per_thread<Value>(parallel_policy);
 
           using ::ket::utility::loop_n;
           using difference_type
             = typename std::iterator_traits<RandomAccessIterator>::difference_type;
           loop_n(
             parallel_policy, last1 - first1,
-            [first1, first2, is_calleds_first, iters2_first, partial_sums_first](
+            [first1, first2, &is_calleds, &iters2, &partial_sums](
               difference_type const n, int const thread_index)
             {
-              if (not is_calleds_first[thread_index])
+              if (not is_calleds[thread_index])
               {
-                iters2_first[thread_index] = first2;
-                std::advance(iters2_first[thread_index], n);
+                iters2[thread_index] = first2;
+                std::advance(iters2[thread_index], n);
 
-                partial_sums_first[thread_index] = first1[n] * *iters2_first[thread_index]++;
-                is_calleds_first[thread_index] = static_cast<int>(true);
+                partial_sums[thread_index] = first1[n] * *iters2[thread_index]++;
+                is_calleds[thread_index] = static_cast<int>(true);
               }
               else
-                partial_sums_first[thread_index] += first1[n] * *iters2_first[thread_index]++;
+                partial_sums[thread_index] += first1[n] * *iters2[thread_index]++;
             });
 
-          return std::accumulate(partial_sums_first, std::end(partial_sums), initial_value);
+          return initial_value + partial_sums.reduce();
         }
 
         template <typename ForwardIterator, typename RandomAccessIterator, typename Value>
@@ -880,39 +758,31 @@ namespace ket
           RandomAccessIterator const first2, Value const initial_value,
           std::forward_iterator_tag const, std::random_access_iterator_tag const)
         {
-          auto is_calleds
-            = std::vector<int>(
-                ::ket::utility::num_threads(parallel_policy), static_cast<int>(false));
-          auto iters1
-            = std::vector<ForwardIterator>(::ket::utility::num_threads(parallel_policy));
-          auto partial_sums
-            = std::vector<Value>(::ket::utility::num_threads(parallel_policy));
-
-          auto is_calleds_first = std::begin(is_calleds);
-          auto iters1_first = std::begin(iters1);
-          auto partial_sums_first = std::begin(partial_sums);
+          auto is_calleds = ::ket::utility::per_thread<int>(parallel_policy, static_cast<int>(false));
+          auto iters1 = ::ket::utility::per_thread<ForwardIterator>(parallel_policy);
+          auto partial_sums = ::ket::utility::per_thread<Value>(parallel_policy);
 
           using ::ket::utility::loop_n;
           using difference_type
             = typename std::iterator_traits<ForwardIterator>::difference_type;
           loop_n(
             parallel_policy, std::distance(first1, last1),
-            [first1, first2, is_calleds_first, iters1_first, partial_sums_first](
+            [first1, first2, &is_calleds, &iters1, &partial_sums](
               difference_type const n, int const thread_index)
             {
-              if (not is_calleds_first[thread_index])
+              if (not is_calleds[thread_index])
               {
-                iters1_first[thread_index] = first1;
-                std::advance(iters1_first[thread_index], n);
+                iters1[thread_index] = first1;
+                std::advance(iters1[thread_index], n);
 
-                partial_sums_first[thread_index] = *iters1_first[thread_index]++ * first2[n];
-                is_calleds_first[thread_index] = static_cast<int>(true);
+                partial_sums[thread_index] = *iters1[thread_index]++ * first2[n];
+                is_calleds[thread_index] = static_cast<int>(true);
               }
               else
-                partial_sums_first[thread_index] += *iters1_first[thread_index]++ * first2[n];
+                partial_sums[thread_index] += *iters1[thread_index]++ * first2[n];
             });
 
-          return std::accumulate(partial_sums_first, std::end(partial_sums), initial_value);
+          return initial_value + partial_sums.reduce();
         }
 
         template <typename RandomAccessIterator1, typename RandomAccessIterator2, typename Value>
@@ -922,33 +792,27 @@ namespace ket
           RandomAccessIterator2 const first2, Value const initial_value,
           std::random_access_iterator_tag const, std::random_access_iterator_tag const)
         {
-          auto is_calleds
-            = std::vector<int>(
-                ::ket::utility::num_threads(parallel_policy), static_cast<int>(false));
-          auto partial_sums
-            = std::vector<Value>(::ket::utility::num_threads(parallel_policy));
-
-          auto is_calleds_first = std::begin(is_calleds);
-          auto partial_sums_first = std::begin(partial_sums);
+          auto is_calleds = ::ket::utility::per_thread<int>(parallel_policy, static_cast<int>(false));
+          auto partial_sums = ::ket::utility::per_thread<Value>(parallel_policy);
 
           using ::ket::utility::loop_n;
           using difference_type
             = typename std::iterator_traits<RandomAccessIterator1>::difference_type;
           loop_n(
             parallel_policy, last1 - first1,
-            [first1, first2, is_calleds_first, partial_sums_first](
+            [first1, first2, &is_calleds, &partial_sums](
               difference_type const n, int const thread_index)
             {
-              if (not is_calleds_first[thread_index])
+              if (not is_calleds[thread_index])
               {
-                partial_sums_first[thread_index] = first1[n] * first2[n];
-                is_calleds_first[thread_index] = static_cast<int>(true);
+                partial_sums[thread_index] = first1[n] * first2[n];
+                is_calleds[thread_index] = static_cast<int>(true);
               }
               else
-                partial_sums_first[thread_index] += first1[n] * first2[n];
+                partial_sums[thread_index] += first1[n] * first2[n];
             });
 
-          return std::accumulate(partial_sums_first, std::end(partial_sums), initial_value);
+          return initial_value + partial_sums.reduce();
         }
 
         template <
@@ -962,20 +826,10 @@ namespace ket
           BinaryTransformOperation binary_transform_operation,
           std::forward_iterator_tag const, std::forward_iterator_tag const)
         {
-          auto is_calleds
-            = std::vector<int>(
-                ::ket::utility::num_threads(parallel_policy), static_cast<int>(false));
-          auto iters1
-            = std::vector<ForwardIterator1>(::ket::utility::num_threads(parallel_policy));
-          auto iters2
-            = std::vector<ForwardIterator2>(::ket::utility::num_threads(parallel_policy));
-          auto partial_sums
-            = std::vector<Value>(::ket::utility::num_threads(parallel_policy));
-
-          auto is_calleds_first = std::begin(is_calleds);
-          auto iters1_first = std::begin(iters1);
-          auto iters2_first = std::begin(iters2);
-          auto partial_sums_first = std::begin(partial_sums);
+          auto is_calleds = ::ket::utility::per_thread<int>(parallel_policy, static_cast<int>(false));
+          auto iters1 = ::ket::utility::per_thread<ForwardIterator1>(parallel_policy);
+          auto iters2 = ::ket::utility::per_thread<ForwardIterator2>(parallel_policy);
+          auto partial_sums = ::ket::utility::per_thread<Value>(parallel_policy);
 
           using ::ket::utility::loop_n;
           using difference_type
@@ -983,31 +837,31 @@ namespace ket
           loop_n(
             parallel_policy, std::distance(first1, last1),
             [first1, first2, binary_reduction_operation, binary_transform_operation,
-             is_calleds_first, iters1_first, iters2_first, partial_sums_first](
+             &is_calleds, &iters1, &iters2, &partial_sums](
               difference_type const n, int const thread_index)
             {
-              if (not is_calleds_first[thread_index])
+              if (not is_calleds[thread_index])
               {
-                iters1_first[thread_index] = first1;
-                std::advance(iters1_first[thread_index], n);
+                iters1[thread_index] = first1;
+                std::advance(iters1[thread_index], n);
 
-                iters2_first[thread_index] = first2;
-                std::advance(iters2_first[thread_index], n);
+                iters2[thread_index] = first2;
+                std::advance(iters2[thread_index], n);
 
-                partial_sums_first[thread_index]
+                partial_sums[thread_index]
                   = binary_transform_operation(
-                      *iters1_first[thread_index]++, *iters2_first[thread_index]++);
-                is_calleds_first[thread_index] = static_cast<int>(true);
+                      *iters1[thread_index]++, *iters2[thread_index]++);
+                is_calleds[thread_index] = static_cast<int>(true);
               }
               else
-                partial_sums_first[thread_index]
+                partial_sums[thread_index]
                   = binary_reduction_operation(
-                      partial_sums_first[thread_index],
+                      partial_sums[thread_index],
                       binary_transform_operation(
-                        *iters1_first[thread_index]++, *iters2_first[thread_index]++));
+                        *iters1[thread_index]++, *iters2[thread_index]++));
             });
 
-          return std::accumulate(partial_sums_first, std::end(partial_sums), initial_value, binary_reduction_operation);
+          return binary_reduction_operation(initial_value, partial_sums.reduce(binary_reduction_operation));
         }
 
         template <
@@ -1021,17 +875,9 @@ namespace ket
           BinaryTransformOperation binary_transform_operation,
           std::random_access_iterator_tag const, std::forward_iterator_tag const)
         {
-          auto is_calleds
-            = std::vector<int>(
-                ::ket::utility::num_threads(parallel_policy), static_cast<int>(false));
-          auto iters2
-            = std::vector<ForwardIterator>(::ket::utility::num_threads(parallel_policy));
-          auto partial_sums
-            = std::vector<Value>(::ket::utility::num_threads(parallel_policy));
-
-          auto is_calleds_first = std::begin(is_calleds);
-          auto iters2_first = std::begin(iters2);
-          auto partial_sums_first = std::begin(partial_sums);
+          auto is_calleds = ::ket::utility::per_thread<int>(parallel_policy, static_cast<int>(false));
+          auto iters2 = ::ket::utility::per_thread<ForwardIterator>(parallel_policy);
+          auto partial_sums = ::ket::utility::per_thread<Value>(parallel_policy);
 
           using ::ket::utility::loop_n;
           using difference_type
@@ -1039,26 +885,26 @@ namespace ket
           loop_n(
             parallel_policy, last1 - first1,
             [first1, first2, binary_reduction_operation, binary_transform_operation,
-             is_calleds_first, iters2_first, partial_sums_first](
+             &is_calleds, &iters2, &partial_sums](
               difference_type const n, int const thread_index)
             {
-              if (not is_calleds_first[thread_index])
+              if (not is_calleds[thread_index])
               {
-                iters2_first[thread_index] = first2;
-                std::advance(iters2_first[thread_index], n);
+                iters2[thread_index] = first2;
+                std::advance(iters2[thread_index], n);
 
-                partial_sums_first[thread_index]
-                  = binary_transform_operation(first1[n], *iters2_first[thread_index]++);
-                is_calleds_first[thread_index] = static_cast<int>(true);
+                partial_sums[thread_index]
+                  = binary_transform_operation(first1[n], *iters2[thread_index]++);
+                is_calleds[thread_index] = static_cast<int>(true);
               }
               else
-                partial_sums_first[thread_index]
+                partial_sums[thread_index]
                   = binary_reduction_operation(
-                      partial_sums_first[thread_index],
-                      binary_transform_operation(first1[n], *iters2_first[thread_index]++));
+                      partial_sums[thread_index],
+                      binary_transform_operation(first1[n], *iters2[thread_index]++));
             });
 
-          return std::accumulate(partial_sums_first, std::end(partial_sums), initial_value, binary_reduction_operation);
+          return binary_reduction_operation(initial_value, partial_sums.reduce(binary_reduction_operation));
         }
 
         template <
@@ -1072,17 +918,9 @@ namespace ket
           BinaryTransformOperation binary_transform_operation,
           std::forward_iterator_tag const, std::random_access_iterator_tag const)
         {
-          auto is_calleds
-            = std::vector<int>(
-                ::ket::utility::num_threads(parallel_policy), static_cast<int>(false));
-          auto iters1
-            = std::vector<ForwardIterator>(::ket::utility::num_threads(parallel_policy));
-          auto partial_sums
-            = std::vector<Value>(::ket::utility::num_threads(parallel_policy));
-
-          auto is_calleds_first = std::begin(is_calleds);
-          auto iters1_first = std::begin(iters1);
-          auto partial_sums_first = std::begin(partial_sums);
+          auto is_calleds = ::ket::utility::per_thread<int>(parallel_policy, static_cast<int>(false));
+          auto iters1 = ::ket::utility::per_thread<ForwardIterator>(parallel_policy);
+          auto partial_sums = ::ket::utility::per_thread<Value>(parallel_policy);
 
           using ::ket::utility::loop_n;
           using difference_type
@@ -1090,26 +928,26 @@ namespace ket
           loop_n(
             parallel_policy, std::distance(first1, last1),
             [first1, first2, binary_reduction_operation, binary_transform_operation,
-             is_calleds_first, iters1_first, partial_sums_first](
+             &is_calleds, &iters1, &partial_sums](
               difference_type const n, int const thread_index)
             {
-              if (not is_calleds_first[thread_index])
+              if (not is_calleds[thread_index])
               {
-                iters1_first[thread_index] = first1;
-                std::advance(iters1_first[thread_index], n);
+                iters1[thread_index] = first1;
+                std::advance(iters1[thread_index], n);
 
-                partial_sums_first[thread_index]
-                  = binary_transform_operation(*iters1_first[thread_index]++, first2[n]);
-                is_calleds_first[thread_index] = static_cast<int>(true);
+                partial_sums[thread_index]
+                  = binary_transform_operation(*iters1[thread_index]++, first2[n]);
+                is_calleds[thread_index] = static_cast<int>(true);
               }
               else
-                partial_sums_first[thread_index]
+                partial_sums[thread_index]
                   = binary_reduction_operation(
-                      partial_sums_first[thread_index],
-                      binary_transform_operation(*iters1_first[thread_index]++, first2[n]));
+                      partial_sums[thread_index],
+                      binary_transform_operation(*iters1[thread_index]++, first2[n]));
             });
 
-          return std::accumulate(partial_sums_first, std::end(partial_sums), initial_value, binary_reduction_operation);
+          return binary_reduction_operation(initial_value, partial_sums.reduce(binary_reduction_operation));
         }
 
         template <
@@ -1123,14 +961,8 @@ namespace ket
           BinaryTransformOperation binary_transform_operation,
           std::random_access_iterator_tag const, std::random_access_iterator_tag const)
         {
-          auto is_calleds
-            = std::vector<int>(
-                ::ket::utility::num_threads(parallel_policy), static_cast<int>(false));
-          auto partial_sums
-            = std::vector<Value>(::ket::utility::num_threads(parallel_policy));
-
-          auto is_calleds_first = std::begin(is_calleds);
-          auto partial_sums_first = std::begin(partial_sums);
+          auto is_calleds = ::ket::utility::per_thread<int>(parallel_policy, static_cast<int>(false));
+          auto partial_sums = ::ket::utility::per_thread<Value>(parallel_policy);
 
           using ::ket::utility::loop_n;
           using difference_type
@@ -1138,22 +970,22 @@ namespace ket
           loop_n(
             parallel_policy, last1 - first1,
             [first1, first2, binary_reduction_operation, binary_transform_operation,
-             is_calleds_first, partial_sums_first](
+             &is_calleds, &partial_sums](
               difference_type const n, int const thread_index)
             {
-              if (not is_calleds_first[thread_index])
+              if (not is_calleds[thread_index])
               {
-                partial_sums_first[thread_index] = binary_transform_operation(first1[n], first2[n]);
-                is_calleds_first[thread_index] = static_cast<int>(true);
+                partial_sums[thread_index] = binary_transform_operation(first1[n], first2[n]);
+                is_calleds[thread_index] = static_cast<int>(true);
               }
               else
-                partial_sums_first[thread_index]
+                partial_sums[thread_index]
                   = binary_reduction_operation(
-                      partial_sums_first[thread_index],
+                      partial_sums[thread_index],
                       binary_transform_operation(first1[n], first2[n]));
             });
 
-          return std::accumulate(partial_sums_first, std::end(partial_sums), initial_value, binary_reduction_operation);
+          return binary_reduction_operation(initial_value, partial_sums.reduce(binary_reduction_operation));
         }
 
         template <
@@ -1167,17 +999,9 @@ namespace ket
           UnaryTransformOperation unary_transform_operation,
           std::forward_iterator_tag const)
         {
-          auto is_calleds
-            = std::vector<int>(
-                ::ket::utility::num_threads(parallel_policy), static_cast<int>(false));
-          auto iters
-            = std::vector<ForwardIterator>(::ket::utility::num_threads(parallel_policy));
-          auto partial_sums
-            = std::vector<Value>(::ket::utility::num_threads(parallel_policy));
-
-          auto is_calleds_first = std::begin(is_calleds);
-          auto iters_first = std::begin(iters);
-          auto partial_sums_first = std::begin(partial_sums);
+          auto is_calleds = ::ket::utility::per_thread<int>(parallel_policy, static_cast<int>(false));
+          auto iters = ::ket::utility::per_thread<ForwardIterator>(parallel_policy);
+          auto partial_sums = ::ket::utility::per_thread<Value>(parallel_policy);
 
           using ::ket::utility::loop_n;
           using difference_type
@@ -1185,26 +1009,26 @@ namespace ket
           loop_n(
             parallel_policy, std::distance(first, last),
             [first, binary_reduction_operation, unary_transform_operation,
-             is_calleds_first, iters_first, partial_sums_first](
+             &is_calleds, &iters, &partial_sums](
               difference_type const n, int const thread_index)
             {
-              if (not is_calleds_first[thread_index])
+              if (not is_calleds[thread_index])
               {
-                iters_first[thread_index] = first;
-                std::advance(iters_first[thread_index], n);
+                iters[thread_index] = first;
+                std::advance(iters[thread_index], n);
 
-                partial_sums_first[thread_index]
-                  = unary_transform_operation(*iters_first[thread_index]++);
-                is_calleds_first[thread_index] = static_cast<int>(true);
+                partial_sums[thread_index]
+                  = unary_transform_operation(*iters[thread_index]++);
+                is_calleds[thread_index] = static_cast<int>(true);
               }
               else
-                partial_sums_first[thread_index]
+                partial_sums[thread_index]
                   = binary_reduction_operation(
-                      partial_sums_first[thread_index],
-                      unary_transform_operation(*iters_first[thread_index]++));
+                      partial_sums[thread_index],
+                      unary_transform_operation(*iters[thread_index]++));
             });
 
-          return std::accumulate(partial_sums_first, std::end(partial_sums), initial_value, binary_reduction_operation);
+          return binary_reduction_operation(initial_value, partial_sums.reduce(binary_reduction_operation));
         }
 
         template <
@@ -1218,14 +1042,8 @@ namespace ket
           UnaryTransformOperation unary_transform_operation,
           std::random_access_iterator_tag const)
         {
-          auto is_calleds
-            = std::vector<int>(
-                ::ket::utility::num_threads(parallel_policy), static_cast<int>(false));
-          auto partial_sums
-            = std::vector<Value>(::ket::utility::num_threads(parallel_policy));
-
-          auto is_calleds_first = std::begin(is_calleds);
-          auto partial_sums_first = std::begin(partial_sums);
+          auto is_calleds = ::ket::utility::per_thread<int>(parallel_policy, static_cast<int>(false));
+          auto partial_sums = ::ket::utility::per_thread<Value>(parallel_policy);
 
           using ::ket::utility::loop_n;
           using difference_type
@@ -1233,21 +1051,21 @@ namespace ket
           loop_n(
             parallel_policy, last - first,
             [first, binary_reduction_operation, unary_transform_operation,
-             is_calleds_first, partial_sums_first](
+             &is_calleds, &partial_sums](
               difference_type const n, int const thread_index)
             {
-              if (not is_calleds_first[thread_index])
+              if (not is_calleds[thread_index])
               {
-                partial_sums_first[thread_index] = unary_transform_operation(first[n]);
-                is_calleds_first[thread_index] = static_cast<int>(true);
+                partial_sums[thread_index] = unary_transform_operation(first[n]);
+                is_calleds[thread_index] = static_cast<int>(true);
               }
               else
-                partial_sums_first[thread_index]
+                partial_sums[thread_index]
                   = binary_reduction_operation(
-                      partial_sums_first[thread_index], unary_transform_operation(first[n]));
+                      partial_sums[thread_index], unary_transform_operation(first[n]));
             });
 
-          return std::accumulate(partial_sums_first, std::end(partial_sums), initial_value, binary_reduction_operation);
+          return binary_reduction_operation(initial_value, partial_sums.reduce(binary_reduction_operation));
         }
       }; // struct transform_reduce< ::ket::utility::policy::parallel<NumThreads> >
     } // namespace dispatch
@@ -1259,72 +1077,62 @@ namespace ket
       template <
         typename ParallelPolicy,
         typename RangeSize, typename ForwardIterator, typename BinaryOperation,
-        typename Allocator1, typename Value, typename Allocator2, typename Allocator3>
+        typename Value>
       inline void post_inclusive_scan(
         ParallelPolicy const parallel_policy,
         RangeSize const range_size, ForwardIterator d_first, BinaryOperation binary_operation,
-        std::vector<int, Allocator1>& is_calleds,
-        std::vector<Value, Allocator2>& partial_sums,
-        std::vector<ForwardIterator, Allocator3>& outs)
+        ::ket::utility::per_thread<int>& is_calleds,
+        ::ket::utility::per_thread<Value>& partial_sums,
+        ::ket::utility::per_thread<ForwardIterator>& outs)
       {
-        auto is_calleds_first = std::begin(is_calleds);
-        auto partial_sums_first = std::begin(partial_sums);
-        auto outs_first = std::begin(outs);
+        is_calleds.fill(static_cast<int>(false));
 
-        std::fill(is_calleds_first, std::end(is_calleds), static_cast<int>(false));
-
-        std::partial_sum(
-          partial_sums_first, std::end(partial_sums),
-          partial_sums_first, binary_operation);
+        partial_sums.partial_sum(binary_operation);
 
         using ::ket::utility::loop_n;
         loop_n(
           parallel_policy, range_size,
-          [d_first, binary_operation, is_calleds_first, partial_sums_first, outs_first](
+          [d_first, binary_operation, &is_calleds, &partial_sums, &outs](
             RangeSize const n, int const thread_index)
           {
             if (thread_index == 0)
               return;
 
-            if (not is_calleds_first[thread_index])
+            if (not is_calleds[thread_index])
             {
-              outs_first[thread_index] = d_first;
-              std::advance(outs_first[thread_index], n);
-              is_calleds_first[thread_index] = static_cast<int>(true);
+              outs[thread_index] = d_first;
+              std::advance(outs[thread_index], n);
+              is_calleds[thread_index] = static_cast<int>(true);
             }
 
-            *outs_first[thread_index]++
+            *outs[thread_index]++
               = binary_operation(
-                  partial_sums_first[thread_index - 1], *outs_first[thread_index]);
+                  partial_sums[thread_index - 1], *outs[thread_index]);
           });
       }
 
       template <
         typename ParallelPolicy,
         typename RangeSize, typename RandomAccessIterator, typename BinaryOperation,
-        typename Value, typename Allocator>
+        typename Value>
       inline void post_inclusive_scan(
         ParallelPolicy const parallel_policy,
         RangeSize const range_size, RandomAccessIterator d_first, BinaryOperation binary_operation,
-        std::vector<Value, Allocator>& partial_sums)
+        ::ket::utility::per_thread<Value>& partial_sums)
       {
-        auto partial_sums_first = std::begin(partial_sums);
-
-        std::partial_sum(
-          partial_sums_first, std::end(partial_sums),
-          partial_sums_first, binary_operation);
+        partial_sums.partial_sum(binary_operation);
 
         using ::ket::utility::loop_n;
         loop_n(
           parallel_policy, range_size,
-          [d_first, binary_operation, partial_sums_first](
+          [d_first, binary_operation, &partial_sums](
             RangeSize const n, int const thread_index)
           {
             if (thread_index == 0)
               return;
 
             d_first[n]
-              = binary_operation(partial_sums_first[thread_index - 1], d_first[n]);
+              = binary_operation(partial_sums[thread_index - 1], d_first[n]);
           });
       }
     } // namespace parallel_loop_n_detail
@@ -1342,66 +1150,58 @@ namespace ket
           std::forward_iterator_tag const, std::forward_iterator_tag const)
         {
           auto is_calleds
-            = std::vector<int>(
-                ::ket::utility::num_threads(parallel_policy), static_cast<int>(false));
+            = ::ket::utility::per_thread<int>(parallel_policy, static_cast<int>(false));
           auto iters
-            = std::vector<ForwardIterator1>(::ket::utility::num_threads(parallel_policy));
+            = ::ket::utility::per_thread<ForwardIterator1>(parallel_policy);
           auto outs
-            = std::vector<ForwardIterator2>(::ket::utility::num_threads(parallel_policy));
+            = ::ket::utility::per_thread<ForwardIterator2>(parallel_policy);
           using value_type = typename std::iterator_traits<ForwardIterator1>::value_type;
           auto partial_sums
-            = std::vector<value_type>(::ket::utility::num_threads(parallel_policy));
-
-          auto is_calleds_first = std::begin(is_calleds);
-          auto iters_first = std::begin(iters);
-          auto outs_first = std::begin(outs);
-          auto partial_sums_first = std::begin(partial_sums);
+            = ::ket::utility::per_thread<value_type>(parallel_policy);
 
           using ::ket::utility::loop_n;
           using difference_type
             = typename std::iterator_traits<ForwardIterator1>::difference_type;
           loop_n(
             parallel_policy, std::distance(first, last),
-            [first, d_first, is_calleds_first, iters_first, outs_first, partial_sums_first](
+            [first, d_first, &is_calleds, &iters, &outs, &partial_sums](
               difference_type const n, int const thread_index)
             {
-              if (not is_calleds_first[thread_index])
+              if (not is_calleds[thread_index])
               {
-                iters_first[thread_index] = first;
-                outs_first[thread_index] = d_first;
-                std::advance(iters_first[thread_index], n);
-                std::advance(outs_first[thread_index], n);
+                iters[thread_index] = first;
+                outs[thread_index] = d_first;
+                std::advance(iters[thread_index], n);
+                std::advance(outs[thread_index], n);
 
-                partial_sums_first[thread_index] = *iters_first[thread_index]++;
-                is_calleds_first[thread_index] = static_cast<int>(true);
+                partial_sums[thread_index] = *iters[thread_index]++;
+                is_calleds[thread_index] = static_cast<int>(true);
               }
               else
-                partial_sums_first[thread_index] += *iters_first[thread_index]++;
+                partial_sums[thread_index] += *iters[thread_index]++;
 
-              *outs_first[thread_index]++ = partial_sums_first[thread_index];
+              *outs[thread_index]++ = partial_sums[thread_index];
             });
 
-          std::partial_sum(
-            partial_sums_first, std::end(partial_sums), partial_sums_first);
-          std::fill(
-            is_calleds_first, std::end(is_calleds), static_cast<int>(false));
+          partial_sums.partial_sum();
+          is_calleds.fill(static_cast<int>(false));
 
           loop_n(
             parallel_policy, std::distance(first, last),
-            [d_first, is_calleds_first, outs_first, partial_sums_first](
+            [d_first, &is_calleds, &outs, &partial_sums](
               difference_type const n, int const thread_index)
             {
               if (thread_index == 0)
                 return;
 
-              if (not is_calleds_first[thread_index])
+              if (not is_calleds[thread_index])
               {
-                outs_first[thread_index] = d_first;
-                std::advance(outs_first[thread_index], n);
-                is_calleds_first[thread_index] = static_cast<int>(true);
+                outs[thread_index] = d_first;
+                std::advance(outs[thread_index], n);
+                is_calleds[thread_index] = static_cast<int>(true);
               }
 
-              *outs_first[thread_index]++ += partial_sums_first[thread_index - 1];
+              *outs[thread_index]++ += partial_sums[thread_index - 1];
             });
 
           return outs.back();
@@ -1415,46 +1215,41 @@ namespace ket
           std::random_access_iterator_tag const, std::random_access_iterator_tag const)
         {
           auto is_calleds
-            = std::vector<int>(
-                ::ket::utility::num_threads(parallel_policy), static_cast<int>(false));
+            = ::ket::utility::per_thread<int>(parallel_policy, static_cast<int>(false));
           using value_type
             = typename std::iterator_traits<RandomAccessIterator1>::value_type;
-          auto partial_sums = std::vector<value_type>(::ket::utility::num_threads(parallel_policy));
-
-          auto is_calleds_first = std::begin(is_calleds);
-          auto partial_sums_first = std::begin(partial_sums);
+          auto partial_sums = ::ket::utility::per_thread<value_type>(parallel_policy);
 
           using ::ket::utility::loop_n;
           using difference_type
             = typename std::iterator_traits<RandomAccessIterator1>::difference_type;
           loop_n(
             parallel_policy, last - first,
-            [first, d_first, is_calleds_first, partial_sums_first](
+            [first, d_first, &is_calleds, &partial_sums](
               difference_type const n, int const thread_index)
             {
-              if (not is_calleds_first[thread_index])
+              if (not is_calleds[thread_index])
               {
-                partial_sums_first[thread_index] = first[n];
-                is_calleds_first[thread_index] = static_cast<int>(true);
+                partial_sums[thread_index] = first[n];
+                is_calleds[thread_index] = static_cast<int>(true);
               }
               else
-                partial_sums_first[thread_index] += first[n];
+                partial_sums[thread_index] += first[n];
 
-              d_first[n] = partial_sums_first[thread_index];
+              d_first[n] = partial_sums[thread_index];
             });
 
-          std::partial_sum(
-            partial_sums_first, std::end(partial_sums), partial_sums_first);
+          partial_sums.partial_sum();
 
           loop_n(
             parallel_policy, last - first,
-            [d_first, partial_sums_first](
+            [d_first, &partial_sums](
               difference_type const n, int const thread_index)
             {
               if (thread_index == 0)
                 return;
 
-              d_first[n] += partial_sums_first[thread_index - 1];
+              d_first[n] += partial_sums[thread_index - 1];
             });
 
           return d_first + (last - first);
@@ -1471,20 +1266,14 @@ namespace ket
           std::forward_iterator_tag const, std::forward_iterator_tag const)
         {
           auto is_calleds
-            = std::vector<int>(
-                ::ket::utility::num_threads(parallel_policy), static_cast<int>(false));
+            = ::ket::utility::per_thread<int>(parallel_policy, static_cast<int>(false));
           auto iters
-            = std::vector<ForwardIterator1>(::ket::utility::num_threads(parallel_policy));
+            = ::ket::utility::per_thread<ForwardIterator1>(parallel_policy);
           auto outs
-            = std::vector<ForwardIterator2>(::ket::utility::num_threads(parallel_policy));
+            = ::ket::utility::per_thread<ForwardIterator2>(parallel_policy);
           using value_type = typename std::iterator_traits<ForwardIterator1>::value_type;
           auto partial_sums
-            = std::vector<value_type>(::ket::utility::num_threads(parallel_policy));
-
-          auto is_calleds_first = std::begin(is_calleds);
-          auto iters_first = std::begin(iters);
-          auto outs_first = std::begin(outs);
-          auto partial_sums_first = std::begin(partial_sums);
+            = ::ket::utility::per_thread<value_type>(parallel_policy);
 
           using ::ket::utility::loop_n;
           using difference_type
@@ -1492,25 +1281,25 @@ namespace ket
           loop_n(
             parallel_policy, std::distance(first, last),
             [first, d_first, binary_operation,
-             is_calleds_first, iters_first, outs_first, partial_sums_first](
+             &is_calleds, &iters, &outs, &partial_sums](
               difference_type const n, int const thread_index)
             {
-              if (not is_calleds_first[thread_index])
+              if (not is_calleds[thread_index])
               {
-                iters_first[thread_index] = first;
-                outs_first[thread_index] = d_first;
-                std::advance(iters_first[thread_index], n);
-                std::advance(outs_first[thread_index], n);
+                iters[thread_index] = first;
+                outs[thread_index] = d_first;
+                std::advance(iters[thread_index], n);
+                std::advance(outs[thread_index], n);
 
-                partial_sums_first[thread_index] = *iters_first[thread_index]++;
-                is_calleds_first[thread_index] = static_cast<int>(true);
+                partial_sums[thread_index] = *iters[thread_index]++;
+                is_calleds[thread_index] = static_cast<int>(true);
               }
               else
-                partial_sums_first[thread_index]
+                partial_sums[thread_index]
                   = binary_operation(
-                      partial_sums_first[thread_index], *iters_first[thread_index]++);
+                      partial_sums[thread_index], *iters[thread_index]++);
 
-              *outs_first[thread_index]++ = partial_sums_first[thread_index];
+              *outs[thread_index]++ = partial_sums[thread_index];
             });
 
           ::ket::utility::parallel_loop_n_detail::post_inclusive_scan(
@@ -1531,34 +1320,30 @@ namespace ket
           std::random_access_iterator_tag const, std::random_access_iterator_tag const)
         {
           auto is_calleds
-            = std::vector<int>(
-                ::ket::utility::num_threads(parallel_policy), static_cast<int>(false));
+            = ::ket::utility::per_thread<int>(parallel_policy, static_cast<int>(false));
           using value_type
             = typename std::iterator_traits<RandomAccessIterator1>::value_type;
           auto partial_sums
-            = std::vector<value_type>(::ket::utility::num_threads(parallel_policy));
-
-          auto is_calleds_first = std::begin(is_calleds);
-          auto partial_sums_first = std::begin(partial_sums);
+            = ::ket::utility::per_thread<value_type>(parallel_policy);
 
           using ::ket::utility::loop_n;
           using difference_type
             = typename std::iterator_traits<RandomAccessIterator1>::difference_type;
           loop_n(
             parallel_policy, last - first,
-            [first, d_first, binary_operation, is_calleds_first, partial_sums_first](
+            [first, d_first, binary_operation, &is_calleds, &partial_sums](
               difference_type const n, int const thread_index)
             {
-              if (not is_calleds_first[thread_index])
+              if (not is_calleds[thread_index])
               {
-                partial_sums_first[thread_index] = first[n];
-                is_calleds_first[thread_index] = static_cast<int>(true);
+                partial_sums[thread_index] = first[n];
+                is_calleds[thread_index] = static_cast<int>(true);
               }
               else
-                partial_sums_first[thread_index]
-                  = binary_operation(partial_sums_first[thread_index], first[n]);
+                partial_sums[thread_index]
+                  = binary_operation(partial_sums[thread_index], first[n]);
 
-              d_first[n] = partial_sums_first[thread_index];
+              d_first[n] = partial_sums[thread_index];
             });
 
           ::ket::utility::parallel_loop_n_detail::post_inclusive_scan(
@@ -1578,20 +1363,14 @@ namespace ket
           std::forward_iterator_tag const, std::forward_iterator_tag const)
         {
           auto is_calleds
-            = std::vector<int>(
-                ::ket::utility::num_threads(parallel_policy), static_cast<int>(false));
+            = ::ket::utility::per_thread<int>(parallel_policy, static_cast<int>(false));
           auto iters
-            = std::vector<ForwardIterator1>(::ket::utility::num_threads(parallel_policy));
+            = ::ket::utility::per_thread<ForwardIterator1>(parallel_policy);
           auto outs
-            = std::vector<ForwardIterator2>(::ket::utility::num_threads(parallel_policy));
+            = ::ket::utility::per_thread<ForwardIterator2>(parallel_policy);
           using value_type = typename std::iterator_traits<ForwardIterator1>::value_type;
           auto partial_sums
-            = std::vector<value_type>(::ket::utility::num_threads(parallel_policy));
-
-          auto is_calleds_first = std::begin(is_calleds);
-          auto iters_first = std::begin(iters);
-          auto outs_first = std::begin(outs);
-          auto partial_sums_first = std::begin(partial_sums);
+            = ::ket::utility::per_thread<value_type>(parallel_policy);
 
           using ::ket::utility::loop_n;
           using difference_type
@@ -1599,28 +1378,28 @@ namespace ket
           loop_n(
             parallel_policy, std::distance(first, last),
             [first, d_first, binary_operation, initial_value,
-             is_calleds_first, iters_first, outs_first, partial_sums_first](
+             &is_calleds, &iters, &outs, &partial_sums](
               difference_type const n, int const thread_index)
             {
-              if (not is_calleds_first[thread_index])
+              if (not is_calleds[thread_index])
               {
-                iters_first[thread_index] = first;
-                outs_first[thread_index] = d_first;
-                std::advance(iters_first[thread_index], n);
-                std::advance(outs_first[thread_index], n);
+                iters[thread_index] = first;
+                outs[thread_index] = d_first;
+                std::advance(iters[thread_index], n);
+                std::advance(outs[thread_index], n);
 
-                partial_sums_first[thread_index]
+                partial_sums[thread_index]
                   = thread_index == 0
-                    ? binary_operation(initial_value, *iters_first[0]++)
-                    : *iters_first[thread_index]++;
-                is_calleds_first[thread_index] = static_cast<int>(true);
+                    ? binary_operation(initial_value, *iters[0]++)
+                    : *iters[thread_index]++;
+                is_calleds[thread_index] = static_cast<int>(true);
               }
               else
-                partial_sums_first[thread_index]
+                partial_sums[thread_index]
                   = binary_operation(
-                      partial_sums_first[thread_index], *iters_first[thread_index]++);
+                      partial_sums[thread_index], *iters[thread_index]++);
 
-              *outs_first[thread_index]++ = partial_sums_first[thread_index];
+              *outs[thread_index]++ = partial_sums[thread_index];
             });
 
           ::ket::utility::parallel_loop_n_detail::post_inclusive_scan(
@@ -1641,36 +1420,32 @@ namespace ket
           std::random_access_iterator_tag const, std::random_access_iterator_tag const)
         {
           auto is_calleds
-            = std::vector<int>(
-                ::ket::utility::num_threads(parallel_policy), static_cast<int>(false));
+            = ::ket::utility::per_thread<int>(parallel_policy, static_cast<int>(false));
           using value_type = typename std::iterator_traits<RandomAccessIterator1>::value_type;
           auto partial_sums
-            = std::vector<value_type>(::ket::utility::num_threads(parallel_policy));
-
-          auto is_calleds_first = std::begin(is_calleds);
-          auto partial_sums_first = std::begin(partial_sums);
+            = ::ket::utility::per_thread<value_type>(parallel_policy);
 
           using ::ket::utility::loop_n;
           using difference_type
             = typename std::iterator_traits<RandomAccessIterator1>::difference_type;
           loop_n(
             parallel_policy, last - first,
-            [first, d_first, binary_operation, initial_value, is_calleds_first, partial_sums_first](
+            [first, d_first, binary_operation, initial_value, &is_calleds, &partial_sums](
               difference_type const n, int const thread_index)
             {
-              if (not is_calleds_first[thread_index])
+              if (not is_calleds[thread_index])
               {
-                partial_sums_first[thread_index]
+                partial_sums[thread_index]
                   = thread_index == 0
                     ? binary_operation(initial_value, first[n])
                     : first[n];
-                is_calleds_first[thread_index] = static_cast<int>(true);
+                is_calleds[thread_index] = static_cast<int>(true);
               }
               else
-                partial_sums_first[thread_index]
-                  = binary_operation(partial_sums_first[thread_index], first[n]);
+                partial_sums[thread_index]
+                  = binary_operation(partial_sums[thread_index], first[n]);
 
-              d_first[n] = partial_sums_first[thread_index];
+              d_first[n] = partial_sums[thread_index];
             });
 
           ::ket::utility::parallel_loop_n_detail::post_inclusive_scan(
@@ -1699,20 +1474,14 @@ namespace ket
           std::forward_iterator_tag const, std::forward_iterator_tag const)
         {
           auto is_calleds
-            = std::vector<int>(
-                ::ket::utility::num_threads(parallel_policy), static_cast<int>(false));
+            = ::ket::utility::per_thread<int>(parallel_policy, static_cast<int>(false));
           auto iters
-            = std::vector<ForwardIterator1>(::ket::utility::num_threads(parallel_policy));
+            = ::ket::utility::per_thread<ForwardIterator1>(parallel_policy);
           auto outs
-            = std::vector<ForwardIterator2>(::ket::utility::num_threads(parallel_policy));
+            = ::ket::utility::per_thread<ForwardIterator2>(parallel_policy);
           using value_type = typename std::iterator_traits<ForwardIterator1>::value_type;
           auto partial_sums
-            = std::vector<value_type>(::ket::utility::num_threads(parallel_policy));
-
-          auto is_calleds_first = std::begin(is_calleds);
-          auto iters_first = std::begin(iters);
-          auto outs_first = std::begin(outs);
-          auto partial_sums_first = std::begin(partial_sums);
+            = ::ket::utility::per_thread<value_type>(parallel_policy);
 
           using ::ket::utility::loop_n;
           using difference_type
@@ -1720,27 +1489,27 @@ namespace ket
           loop_n(
             parallel_policy, std::distance(first, last),
             [first, d_first, binary_operation, unary_operation,
-             is_calleds_first, iters_first, outs_first, partial_sums_first](
+             &is_calleds, &iters, &outs, &partial_sums](
               difference_type const n, int const thread_index)
             {
-              if (not is_calleds_first[thread_index])
+              if (not is_calleds[thread_index])
               {
-                iters_first[thread_index] = first;
-                outs_first[thread_index] = d_first;
-                std::advance(iters_first[thread_index], n);
-                std::advance(outs_first[thread_index], n);
-
-                partial_sums_first[thread_index]
-                  = unary_operation(*iters_first[thread_index]++);
-                is_calleds_first[thread_index] = static_cast<int>(true);
+                iters[thread_index] = first;
+                outs[thread_index] = d_first;
+                std::advance(iters[thread_index], n);
+                std::advance(outs[thread_index], n);
+
+                partial_sums[thread_index]
+                  = unary_operation(*iters[thread_index]++);
+                is_calleds[thread_index] = static_cast<int>(true);
               }
               else
-                partial_sums_first[thread_index]
+                partial_sums[thread_index]
                   = binary_operation(
-                      partial_sums_first[thread_index],
-                      unary_operation(*iters_first[thread_index]++));
+                      partial_sums[thread_index],
+                      unary_operation(*iters[thread_index]++));
 
-              *outs_first[thread_index]++ = partial_sums_first[thread_index];
+              *outs[thread_index]++ = partial_sums[thread_index];
             });
 
           ::ket::utility::parallel_loop_n_detail::post_inclusive_scan(
@@ -1761,14 +1530,10 @@ namespace ket
           std::random_access_iterator_tag const, std::random_access_iterator_tag const)
         {
           auto is_calleds
-            = std::vector<int>(
-                ::ket::utility::num_threads(parallel_policy), static_cast<int>(false));
+            = ::ket::utility::per_thread<int>(parallel_policy, static_cast<int>(false));
           using value_type = typename std::iterator_traits<RandomAccessIterator1>::value_type;
           auto partial_sums
-            = std::vector<value_type>(::ket::utility::num_threads(parallel_policy));
-
-          auto is_calleds_first = std::begin(is_calleds);
-          auto partial_sums_first = std::begin(partial_sums);
+            = ::ket::utility::per_thread<value_type>(parallel_policy);
 
           using ::ket::utility::loop_n;
           using difference_type
@@ -1776,20 +1541,20 @@ namespace ket
           loop_n(
             parallel_policy, last - first,
             [first, d_first, binary_operation, unary_operation,
-             is_calleds_first, partial_sums_first](
+             &is_calleds, &partial_sums](
               difference_type const n, int const thread_index)
             {
-              if (not is_calleds_first[thread_index])
+              if (not is_calleds[thread_index])
               {
-                partial_sums_first[thread_index] = unary_operation(first[n]);
-                is_calleds_first[thread_index] = static_cast<int>(true);
+                partial_sums[thread_index] = unary_operation(first[n]);
+                is_calleds[thread_index] = static_cast<int>(true);
               }
               else
-                partial_sums_first[thread_index]
+                partial_sums[thread_index]
                   = binary_operation(
-                      partial_sums_first[thread_index], unary_operation(first[n]));
+                      partial_sums[thread_index], unary_operation(first[n]));
 
-              d_first[n] = partial_sums_first[thread_index];
+              d_first[n] = partial_sums[thread_index];
             });
 
           ::ket::utility::parallel_loop_n_detail::post_inclusive_scan(
@@ -1810,20 +1575,14 @@ namespace ket
           std::forward_iterator_tag const, std::forward_iterator_tag const)
         {
           auto is_calleds
-            = std::vector<int>(
-                ::ket::utility::num_threads(parallel_policy), static_cast<int>(false));
+            = ::ket::utility::per_thread<int>(parallel_policy, static_cast<int>(false));
           auto iters
-            = std::vector<ForwardIterator1>(::ket::utility::num_threads(parallel_policy));
+            = ::ket::utility::per_thread<ForwardIterator1>(parallel_policy);
           auto outs
-            = std::vector<ForwardIterator2>(::ket::utility::num_threads(parallel_policy));
+            = ::ket::utility::per_thread<ForwardIterator2>(parallel_policy);
           using value_type = typename std::iterator_traits<ForwardIterator1>::value_type;
           auto partial_sums
-            = std::vector<value_type>(::ket::utility::num_threads(parallel_policy));
-
-          auto is_calleds_first = std::begin(is_calleds);
-          auto iters_first = std::begin(iters);
-          auto outs_first = std::begin(outs);
-          auto partial_sums_first = std::begin(partial_sums);
+            = ::ket::utility::per_thread<value_type>(parallel_policy);
 
           using ::ket::utility::loop_n;
           typedef
@@ -1832,30 +1591,30 @@ namespace ket
           loop_n(
             parallel_policy, std::distance(first, last),
             [first, d_first, binary_operation, unary_operation, initial_value,
-             is_calleds_first, iters_first, outs_first, partial_sums_first](
+             &is_calleds, &iters, &outs, &partial_sums](
               difference_type const n, int const thread_index)
             {
-              if (not is_calleds_first[thread_index])
+              if (not is_calleds[thread_index])
               {
-                iters_first[thread_index] = first;
-                outs_first[thread_index] = d_first;
-                std::advance(iters_first[thread_index], n);
-                std::advance(outs_first[thread_index], n);
+                iters[thread_index] = first;
+                outs[thread_index] = d_first;
+                std::advance(iters[thread_index], n);
+                std::advance(outs[thread_index], n);
 
-                partial_sums_first[thread_index]
+                partial_sums[thread_index]
                   = thread_index == 0
                     ? binary_operation(
-                        initial_value, unary_operation(*iters_first[thread_index]++))
-                    : unary_operation(*iters_first[thread_index]++);
-                is_calleds_first[thread_index] = static_cast<int>(true);
+                        initial_value, unary_operation(*iters[thread_index]++))
+                    : unary_operation(*iters[thread_index]++);
+                is_calleds[thread_index] = static_cast<int>(true);
               }
               else
-                partial_sums_first[thread_index]
+                partial_sums[thread_index]
                   = binary_operation(
-                      partial_sums_first[thread_index],
-                      unary_operation(*iters_first[thread_index]++));
+                      partial_sums[thread_index],
+                      unary_operation(*iters[thread_index]++));
 
-              *outs_first[thread_index]++ = partial_sums_first[thread_index];
+              *outs[thread_index]++ = partial_sums[thread_index];
             });
 
           ::ket::utility::parallel_loop_n_detail::post_inclusive_scan(
@@ -1877,14 +1636,10 @@ namespace ket
           std::random_access_iterator_tag const, std::random_access_iterator_tag const)
         {
           auto is_calleds
-            = std::vector<int>(
-                ::ket::utility::num_threads(parallel_policy), static_cast<int>(false));
+            = ::ket::utility::per_thread<int>(parallel_policy, static_cast<int>(false));
           using value_type = typename std::iterator_traits<RandomAccessIterator1>::value_type;
           auto partial_sums
-            = std::vector<value_type>(::ket::utility::num_threads(parallel_policy));
-
-          auto is_calleds_first = std::begin(is_calleds);
-          auto partial_sums_first = std::begin(partial_sums);
+            = ::ket::utility::per_thread<value_type>(parallel_policy);
 
           using ::ket::utility::loop_n;
           using difference_type
@@ -1892,24 +1647,24 @@ namespace ket
           loop_n(
             parallel_policy, last - first,
             [first, d_first, binary_operation, unary_operation,
-             initial_value, is_calleds_first, partial_sums_first](
+             initial_value, &is_calleds, &partial_sums](
               difference_type const n, int const thread_index)
             {
-              if (not is_calleds_first[thread_index])
+              if (not is_calleds[thread_index])
               {
-                partial_sums_first[thread_index]
+                partial_sums[thread_index]
                   = thread_index == 0
                     ? binary_operation(
                         initial_value, unary_operation(first[n]))
                     : unary_operation(first[n]);
-                is_calleds_first[thread_index] = static_cast<int>(true);
+                is_calleds[thread_index] = static_cast<int>(true);
               }
               else
-                partial_sums_first[thread_index]
+                partial_sums[thread_index]
                   = binary_operation(
-                      partial_sums_first[thread_index], unary_operation(first[n]));
+                      partial_sums[thread_index], unary_operation(first[n]));
 
-              d_first[n] = partial_sums_first[thread_index];
+              d_first[n] = partial_sums[thread_index];
             });
 
           ::ket::utility::parallel_loop_n_detail::post_inclusive_scan(
@@ -0,0 +1,401 @@
+#ifndef KET_UTILITY_PARALLEL_THREAD_POOL_HPP
+# define KET_UTILITY_PARALLEL_THREAD_POOL_HPP
+
+# include <cassert>
+# include <cstddef>
+# include <cstdint>
+# include <vector>
+# include <memory>
+# include <utility>
+# include <thread>
+# include <future>
+# include <mutex>
+# include <condition_variable>
+# include <atomic>
+# include <exception>
+# include <type_traits>
+# if defined(KET_USE_THREAD_AFFINITY) && defined(__linux__)
+#   include <pthread.h>
+#   include <sched.h>
+# endif // defined(KET_USE_THREAD_AFFINITY) && defined(__linux__)
+
+// Number of busy-wait iterations before a waiting thread starts yielding (or sleeping, for idle workers)
+# ifndef KET_THREAD_POOL_SPIN_COUNT
+#   define KET_THREAD_POOL_SPIN_COUNT 2048
+# endif // KET_THREAD_POOL_SPIN_COUNT
+
+
+namespace ket
+{
+  namespace utility
+  {
+    namespace thread_pool_detail
+    {
+      inline void cpu_relax() noexcept
+      {
+# if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+# elif defined(__aarch64__)
+        asm volatile("yield" ::: "memory");
+# endif
+      }
+
+      template <typename Predicate>
+      inline bool spin(Predicate&& predicate)
+      {
+        for (auto count = 0; count < KET_THREAD_POOL_SPIN_COUNT; ++count)
+        {
+          if (predicate())
+            return true;
+
+          ::ket::utility::thread_pool_detail::cpu_relax();
+        }
+
+        return predicate();
+      }
+
+      template <typename Predicate>
+      inline void spin_then_yield(Predicate&& predicate)
+      {
+        if (::ket::utility::thread_pool_detail::spin(predicate))
+          return;
+
+        while (not predicate())
+          std::this_thread::yield();
+      }
+
+# if defined(KET_USE_THREAD_AFFINITY) && defined(__linux__)
+      // CPUs this process is allowed to run on (e.g. restricted by mpirun's binding), in ascending order
+      inline std::vector<int> const& allowed_cpus()
+      {
+        static auto const result
+          = []
+            {
+              auto cpus = std::vector<int>{};
+
+              cpu_set_t cpu_set;
+              CPU_ZERO(&cpu_set);
+              if (sched_getaffinity(0, sizeof(cpu_set_t), &cpu_set) != 0)
+                return cpus;
+
+              for (auto cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+                if (CPU_ISSET(cpu, &cpu_set))
+                  cpus.push_back(cpu);
+
+              return cpus;
+            }();
+
+        return result;
+      }
+
+      inline void pin_current_thread(std::size_t const index) noexcept
+      {
+        auto const& cpus = ::ket::utility::thread_pool_detail::allowed_cpus();
+        if (cpus.empty())
+          return;
+
+        cpu_set_t cpu_set;
+        CPU_ZERO(&cpu_set);
+        CPU_SET(cpus[index % cpus.size()], &cpu_set);
+        pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpu_set);
+      }
+# else // defined(KET_USE_THREAD_AFFINITY) && defined(__linux__)
+      inline void pin_current_thread(std::size_t const) noexcept { }
+# endif // defined(KET_USE_THREAD_AFFINITY) && defined(__linux__)
+
+      // true while the current thread runs a function given to ::ket::utility::thread_pool::run
+      inline bool& is_in_task() noexcept
+      {
+        static thread_local auto result = false;
+        return result;
+      }
+
+      class in_task_guard
+      {
+        bool was_in_task_;
+
+       public:
+        in_task_guard() noexcept
+          : was_in_task_{::ket::utility::thread_pool_detail::is_in_task()}
+        { ::ket::utility::thread_pool_detail::is_in_task() = true; }
+
+        ~in_task_guard() noexcept { ::ket::utility::thread_pool_detail::is_in_task() = was_in_task_; }
+
+        in_task_guard(in_task_guard const&) = delete;
+        in_task_guard& operator=(in_task_guard const&) = delete;
+        in_task_guard(in_task_guard&&) = delete;
+        in_task_guard& operator=(in_task_guard&&) = delete;
+      }; // class in_task_guard
+    } // namespace thread_pool_detail
+
+
+    // Sense-reversing barrier: waiting threads spin for a while and then yield, so that
+    // short phases in ::ket::utility::execute do not pay for a mutex and a condition variable.
+    class spin_barrier
+    {
+      int num_threads_;
+      std::atomic<int> num_remaining_;
+      std::atomic<unsigned int> generation_;
+
+     public:
+      explicit spin_barrier(int const num_threads = 1) noexcept
+        : num_threads_{num_threads}, num_remaining_{num_threads}, generation_{0u}
+      { }
+
+      spin_barrier(spin_barrier const&) = delete;
+      spin_barrier& operator=(spin_barrier const&) = delete;
+      spin_barrier(spin_barrier&&) = delete;
+      spin_barrier& operator=(spin_barrier&&) = delete;
+
+      // not thread-safe: call only while no thread waits on this barrier
+      void reset(int const num_threads) noexcept
+      {
+        assert(num_threads > 0);
+        num_threads_ = num_threads;
+        num_remaining_.store(num_threads, std::memory_order_relaxed);
+      }
+
+      void arrive_and_wait() noexcept
+      {
+        auto const generation = generation_.load(std::memory_order_acquire);
+
+        if (num_remaining_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+          num_remaining_.store(num_threads_, std::memory_order_relaxed);
+          generation_.fetch_add(1u, std::memory_order_release);
+          return;
+        }
+
+        ::ket::utility::thread_pool_detail::spin_then_yield(
+          [this, generation] { return generation_.load(std::memory_order_acquire) != generation; });
+      }
+    }; // class spin_barrier
+
+
+    // Persistent fork/join worker pool used by ::ket::utility::policy::parallel unless OpenMP is used.
+    // run(num_threads, function) calls function(thread_index) for thread_index = 0, ..., num_threads-1.
+    // The calling thread takes thread_index = num_threads-1, and worker threads are created lazily and
+    // kept alive until the end of the program. Nested calls from a running function and concurrent calls
+    // from other threads fall back to temporary threads so that each thread_index still runs concurrently.
+    // With KET_USE_THREAD_AFFINITY, the w-th worker, which always takes thread_index = w, is pinned to the w-th
+    // allowed CPU. The calling thread is not pinned; the (num_threads-1)-th allowed CPU is left for it.
+    class thread_pool
+    {
+      using task_type = void(*)(void*, int);
+
+      std::vector<std::thread> workers_;
+
+      std::mutex run_mutex_;
+
+      std::mutex sleep_mutex_;
+      std::condition_variable sleep_cond_;
+      std::atomic<int> num_sleeping_workers_;
+
+      // The upper 32 bits count generations, and the lower 32 bits are the number of active workers in the generation.
+      // Both are published by one store so that a worker never combines a generation with the count of another one
+      std::atomic<std::uint64_t> generation_;
+      std::atomic<int> num_remaining_workers_;
+      std::atomic<bool> is_stopped_;
+
+      // written before generation_ is published, and kept until all active workers of the generation finish
+      task_type task_;
+      void* task_data_;
+
+      std::mutex error_mutex_;
+      std::exception_ptr error_;
+
+     public:
+      thread_pool()
+        : workers_{}, run_mutex_{}, sleep_mutex_{}, sleep_cond_{}, num_sleeping_workers_{0},
+          generation_{0u}, num_remaining_workers_{0}, is_stopped_{false},
+          task_{nullptr}, task_data_{nullptr},
+          error_mutex_{}, error_{}
+      { }
+
+      ~thread_pool() noexcept
+      {
+        {
+          std::lock_guard<std::mutex> lock{sleep_mutex_};
+          is_stopped_.store(true);
+        }
+        sleep_cond_.notify_all();
+
+        for (auto& worker: workers_)
+          worker.join();
+      }
+
+      thread_pool(thread_pool const&) = delete;
+      thread_pool& operator=(thread_pool const&) = delete;
+      thread_pool(thread_pool&&) = delete;
+      thread_pool& operator=(thread_pool&&) = delete;
+
+      static thread_pool& instance()
+      {
+        static thread_pool result;
+        return result;
+      }
+
+      std::size_t num_workers() const noexcept { return workers_.size(); }
+
+      template <typename Function>
+      void run(int const num_threads, Function&& function)
+      {
+        assert(num_threads > 0);
+
+        if (num_threads == 1)
+        {
+          function(0);
+          return;
+        }
+
+        // a nested call must not lock run_mutex_ again if this thread already owns it
+        if (::ket::utility::thread_pool_detail::is_in_task())
+        {
+          run_on_temporary_threads(num_threads, function);
+          return;
+        }
+
+        auto lock = std::unique_lock<std::mutex>{run_mutex_, std::try_to_lock};
+        if (not lock.owns_lock())
+        {
+          run_on_temporary_threads(num_threads, function);
+          return;
+        }
+
+        auto const num_workers = static_cast<std::size_t>(num_threads - 1);
+        while (workers_.size() < num_workers)
+          workers_.emplace_back(&thread_pool::work, this, workers_.size(), generation_.load(std::memory_order_relaxed));
+
+        using function_type = typename std::remove_reference<Function>::type;
+        task_
+          = [](void* data, int const thread_index)
+            { (*static_cast<function_type*>(data))(thread_index); };
+        task_data_ = static_cast<void*>(std::addressof(function));
+        error_ = nullptr;
+        num_remaining_workers_.store(num_threads - 1, std::memory_order_relaxed);
+
+        // fork: only this thread writes generation_ because run_mutex_ is locked.
+        // The store is sequentially consistent (thus a release store) to pair with num_sleeping_workers_ below
+        auto const last_generation = generation_.load(std::memory_order_relaxed);
+        generation_.store(
+          (((last_generation >> 32u) + std::uint64_t{1u}) << 32u) bitor static_cast<std::uint64_t>(num_threads - 1),
+          std::memory_order_seq_cst);
+        if (num_sleeping_workers_.load(std::memory_order_seq_cst) > 0)
+        {
+          { std::lock_guard<std::mutex> sleep_lock{sleep_mutex_}; }
+          sleep_cond_.notify_all();
+        }
+
+        auto maybe_error = std::exception_ptr{};
+        try
+        {
+          ::ket::utility::thread_pool_detail::in_task_guard guard{};
+          function(num_threads - 1);
+        }
+        catch (...)
+        {
+          maybe_error = std::current_exception();
+        }
+
+        // join
+        ::ket::utility::thread_pool_detail::spin_then_yield(
+          [this] { return num_remaining_workers_.load(std::memory_order_acquire) == 0; });
+
+        if (not maybe_error)
+          maybe_error = error_;
+        task_ = nullptr;
+        task_data_ = nullptr;
+
+        if (maybe_error)
+          std::rethrow_exception(maybe_error);
+      }
+
+     private:
+      void work(std::size_t const worker_index, std::uint64_t last_generation)
+      {
+        ::ket::utility::thread_pool_detail::pin_current_thread(worker_index);
+        ::ket::utility::thread_pool_detail::is_in_task() = true;
+
+        while (true)
+        {
+          auto const is_ready
+            = [this, last_generation]
+              {
+                return generation_.load(std::memory_order_seq_cst) != last_generation
+                  or is_stopped_.load(std::memory_order_relaxed);
+              };
+
+          if (not ::ket::utility::thread_pool_detail::spin(is_ready))
+          {
+            auto lock = std::unique_lock<std::mutex>{sleep_mutex_};
+            num_sleeping_workers_.fetch_add(1, std::memory_order_seq_cst);
+            sleep_cond_.wait(lock, is_ready);
+            num_sleeping_workers_.fetch_sub(1, std::memory_order_relaxed);
+          }
+
+          if (is_stopped_.load(std::memory_order_relaxed))
+            return;
+
+          // task_ and task_data_ of this generation are visible after the acquire load, and they are not
+          // overwritten until this worker finishes if it is active
+          last_generation = generation_.load(std::memory_order_acquire);
+          auto const num_active_workers = static_cast<std::size_t>(last_generation bitand std::uint64_t{0xffffffffu});
+          if (worker_index >= num_active_workers)
+            continue;
+
+          try
+          {
+            task_(task_data_, static_cast<int>(worker_index));
+          }
+          catch (...)
+          {
+            std::lock_guard<std::mutex> lock{error_mutex_};
+            if (not error_)
+              error_ = std::current_exception();
+          }
+
+          num_remaining_workers_.fetch_sub(1, std::memory_order_release);
+        }
+      }
+
+      template <typename Function>
+      static void run_on_temporary_threads(int const num_threads, Function& function)
+      {
+        auto const num_futures = num_threads - 1;
+        auto futures = std::vector<std::future<void>>{};
+        futures.reserve(num_futures);
+
+        for (auto thread_index = 0; thread_index < num_futures; ++thread_index)
+          futures.push_back(std::async(
+            std::launch::async, [&function, thread_index] { function(thread_index); }));
+
+        auto maybe_error = std::exception_ptr{};
+        try
+        {
+          function(num_futures);
+        }
+        catch (...)
+        {
+          maybe_error = std::current_exception();
+        }
+
+        for (auto& future: futures)
+          try
+          {
+            future.get();
+          }
+          catch (...)
+          {
+            if (not maybe_error)
+              maybe_error = std::current_exception();
+          }
+
+        if (maybe_error)
+          std::rethrow_exception(maybe_error);
+      }
+    }; // class thread_pool
+  } // namespace utility
+} // namespace ket
+
+
+#endif // KET_UTILITY_PARALLEL_THREAD_POOL_HPP
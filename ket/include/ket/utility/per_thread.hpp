@@ -0,0 +1,95 @@
+#ifndef KET_UTILITY_PER_THREAD_HPP
+# define KET_UTILITY_PER_THREAD_HPP
+
+# include <cassert>
+# include <cstddef>
+# include <vector>
+# include <functional>
+# include <type_traits>
+
+# include <ket/utility/loop_n.hpp>
+
+// Size of the padding after each value of ::ket::utility::per_thread, which should be at least the cache line size
+# ifndef KET_UTILITY_CACHE_LINE_SIZE
+#   define KET_UTILITY_CACHE_LINE_SIZE 64
+# endif // KET_UTILITY_CACHE_LINE_SIZE
+
+
+namespace ket
+{
+  namespace utility
+  {
+    // per_thread<T> has one value of T for each thread of a parallel policy, e.g. a partial sum of a reduction.
+    // Each value is followed by KET_UTILITY_CACHE_LINE_SIZE bytes of padding, so that
+    // no two threads write to the same cache line when each thread updates only per_thread[thread_index].
+    template <typename T>
+    class per_thread
+    {
+      struct slot
+      {
+        T value;
+        char padding[KET_UTILITY_CACHE_LINE_SIZE];
+      }; // struct slot
+
+      std::vector<slot> slots_;
+
+     public:
+      using value_type = T;
+      using reference = T&;
+      using const_reference = T const&;
+      using size_type = std::size_t;
+
+      template <typename ParallelPolicy>
+      explicit per_thread(
+        ParallelPolicy const parallel_policy, T const& initial_value = T{},
+        typename std::enable_if< ::ket::utility::policy::meta::is_loop_n_policy<ParallelPolicy>::value >::type* = nullptr)
+        : slots_(::ket::utility::num_threads(parallel_policy), slot{initial_value, {}})
+      { assert(not slots_.empty()); }
+
+      reference operator[](size_type const thread_index) noexcept { return slots_[thread_index].value; }
+      const_reference operator[](size_type const thread_index) const noexcept { return slots_[thread_index].value; }
+
+      size_type size() const noexcept { return slots_.size(); }
+
+      reference back() noexcept { return slots_.back().value; }
+      const_reference back() const noexcept { return slots_.back().value; }
+
+      void fill(T const& value)
+      {
+        for (auto& slot: slots_)
+          slot.value = value;
+      }
+
+      // per_thread[i] -> per_thread[0] op per_thread[1] op ... op per_thread[i], which is used by scans
+      template <typename BinaryOperation>
+      void partial_sum(BinaryOperation binary_operation)
+      {
+        for (auto index = size_type{1u}; index < slots_.size(); ++index)
+          slots_[index].value = binary_operation(slots_[index - 1u].value, slots_[index].value);
+      }
+
+      void partial_sum() { partial_sum(std::plus<T>{}); }
+
+      // values are combined in a binary tree, (v0 op v1) op (v2 op v3), ..., whose depth is log2(size())
+      template <typename BinaryOperation>
+      T reduce(BinaryOperation binary_operation) const
+      {
+        auto values = std::vector<T>{};
+        values.reserve(slots_.size());
+        for (auto const& slot: slots_)
+          values.push_back(slot.value);
+
+        for (auto stride = size_type{1u}; stride < values.size(); stride *= size_type{2u})
+          for (auto index = size_type{0u}; index + stride < values.size(); index += size_type{2u} * stride)
+            values[index] = binary_operation(values[index], values[index + stride]);
+
+        return values.front();
+      }
+
+      T reduce() const { return reduce(std::plus<T>{}); }
+    }; // class per_thread<T>
+  } // namespace utility
+} // namespace ket
+
+
+#endif // KET_UTILITY_PER_THREAD_HPP